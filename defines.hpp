@@ -65,6 +65,8 @@ auto constexpr TMP_OFFSETS_EXT = OFFSET_EXT EXTENSION_TMP;
 #define CITY_ROADS_FILE_TAG "city_roads"
 #define DESCRIPTIONS_FILE_TAG "descriptions"
 #define MAXSPEEDS_FILE_TAG "maxspeeds"
+#define LANDMARKS_FILE_TAG "landmarks"
+#define CELL_OVERLAY_FILE_TAG "cell_overlay"
 #define ROUTING_WORLD_FILE_TAG "routing_world"
 
 #define READY_FILE_EXTENSION ".ready"
@@ -0,0 +1,160 @@
+#include "generator/cell_overlay_generator.hpp"
+
+#include "routing/cell_overlay.hpp"
+#include "routing/edge_estimator.hpp"
+#include "routing/geometry.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/index_graph_loader.hpp"
+#include "routing/road_index.hpp"
+
+#include "routing_common/car_model.hpp"
+
+#include "indexer/data_source.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "geometry/latlon.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/math.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "defines.hpp"
+
+namespace routing_builder
+{
+using namespace routing;
+
+namespace
+{
+// Leaf cells are small enough to customize a cell by Dijkstra from every its enter quickly.
+uint32_t constexpr kMaxLeafCellJoints = 1024;
+uint8_t constexpr kMaxDepth = 24;
+// Every upper level cell consists of 2^kLevelBits cells of the lower level.
+uint8_t constexpr kLevelBits = 4;
+
+struct JointPoint
+{
+  Joint::Id m_jointId;
+  ms::LatLon m_point;
+};
+
+// Splits the joints by the median of the longer side of their bounding box recursively.
+// The first bisection defines the most significant bit of the leaf cell id.
+void Bisect(std::vector<JointPoint>::iterator begin, std::vector<JointPoint>::iterator end, uint8_t depth,
+            uint32_t cell, std::vector<uint32_t> & jointCells)
+{
+  if (depth == 0 || std::distance(begin, end) < 2)
+  {
+    // Ids of the leaf cells have the same bits count even if the bisection stops earlier.
+    for (auto it = begin; it != end; ++it)
+      jointCells[it->m_jointId] = cell << depth;
+    return;
+  }
+
+  double minLat = std::numeric_limits<double>::max();
+  double maxLat = std::numeric_limits<double>::lowest();
+  double minLon = std::numeric_limits<double>::max();
+  double maxLon = std::numeric_limits<double>::lowest();
+  for (auto it = begin; it != end; ++it)
+  {
+    minLat = std::min(minLat, it->m_point.m_lat);
+    maxLat = std::max(maxLat, it->m_point.m_lat);
+    minLon = std::min(minLon, it->m_point.m_lon);
+    maxLon = std::max(maxLon, it->m_point.m_lon);
+  }
+
+  bool const byLat = maxLat - minLat > (maxLon - minLon) * std::cos(math::DegToRad((minLat + maxLat) / 2.0));
+  auto const middle = begin + std::distance(begin, end) / 2;
+  std::nth_element(begin, middle, end, [byLat](JointPoint const & lhs, JointPoint const & rhs)
+  { return byLat ? lhs.m_point.m_lat < rhs.m_point.m_lat : lhs.m_point.m_lon < rhs.m_point.m_lon; });
+
+  Bisect(begin, middle, depth - 1, cell << 1, jointCells);
+  Bisect(middle, end, depth - 1, (cell << 1) | 1, jointCells);
+}
+}  // namespace
+
+bool BuildCellOverlay(std::string const & mwmPath, std::string const & country,
+                      CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  try
+  {
+    base::Timer timer;
+
+    std::shared_ptr<VehicleModelInterface> vehicleModel =
+        CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+    auto estimator = EdgeEstimator::Create(VehicleType::Car, *vehicleModel, nullptr /* trafficStash */,
+                                           nullptr /* dataSource */, nullptr /* numMvmIds */);
+
+    MwmValue mwmValue(platform::LocalCountryFile::MakeTemporary(mwmPath));
+    // Keep all roads of the mwm in memory, every road is used by the customization.
+    IndexGraph graph(std::make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmPath, vehicleModel),
+                                                std::numeric_limits<size_t>::max() /* roadsCacheSizeBytes */),
+                     estimator);
+    DeserializeIndexGraph(mwmValue, VehicleType::Car, graph);
+
+    uint32_t const numJoints = graph.GetNumJoints();
+    auto const depth = static_cast<uint8_t>(
+        std::min(static_cast<double>(kMaxDepth),
+                 std::ceil(std::log2(std::max(1.0, static_cast<double>(numJoints) / kMaxLeafCellJoints)))));
+    if (depth == 0)
+    {
+      LOG(LINFO, ("No cell overlay for", mwmPath, "with", numJoints, "joints"));
+      return true;
+    }
+
+    std::vector<JointPoint> points;
+    points.reserve(numJoints);
+    std::vector<bool> added(numJoints, false);
+    graph.ForEachRoad([&](uint32_t featureId, RoadJointIds const & roadJoints)
+    {
+      auto const & road = graph.GetRoadGeometry(featureId);
+      roadJoints.ForEachJoint([&](uint32_t pointId, Joint::Id jointId)
+      {
+        if (added[jointId] || pointId >= road.GetPointsCount())
+          return;
+        added[jointId] = true;
+        points.push_back({jointId, road.GetPoint(pointId)});
+      });
+    });
+
+    // Joints without geometry are in cell 0.
+    std::vector<uint32_t> jointCells(numJoints, 0);
+    Bisect(points.begin(), points.end(), depth, 0 /* cell */, jointCells);
+
+    // The top level has at least 2^kLevelBits cells.
+    std::vector<uint8_t> levelShifts = {0};
+    while (depth - levelShifts.back() >= 2 * kLevelBits)
+      levelShifts.push_back(levelShifts.back() + kLevelBits);
+
+    CellOverlay overlay(graph, depth, std::move(levelShifts), std::move(jointCells));
+    LOG(LINFO, ("Cell overlay of", mwmPath, "has", overlay.GetLevelsCount(), "levels and", 1U << depth,
+                "leaf cells with", overlay.GetTransitionsCount(), "transitions, elapsed:", timer.ElapsedSeconds()));
+
+    overlay.Customize(graph);
+
+    FilesContainerW cont(mwmPath, FileWriter::OP_WRITE_EXISTING);
+    auto writer = cont.GetWriter(CELL_OVERLAY_FILE_TAG);
+    overlay.Serialize(*writer);
+
+    LOG(LINFO, (CELL_OVERLAY_FILE_TAG, "section of", mwmPath, "is built, elapsed:", timer.ElapsedSeconds(),
+                "seconds"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Error while building", CELL_OVERLAY_FILE_TAG, "section in", mwmPath, ". Message:", e.Msg()));
+    return false;
+  }
+}
+}  // namespace routing_builder
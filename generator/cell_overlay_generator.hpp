@@ -0,0 +1,15 @@
+#pragma once
+
+#include "generator/routing_index_generator.hpp"
+
+#include <string>
+
+namespace routing_builder
+{
+/// \brief Partitions the car routing graph of the mwm into multi-level cells by recursive geometric bisection
+/// of the joints, calculates car route weights through the cells and builds CELL_OVERLAY_FILE_TAG section.
+/// \note Before a call of this method ROUTING_FILE_TAG, city_roads and maxspeeds sections should be built,
+/// because the weights should be the same as the ones of the routing.
+bool BuildCellOverlay(std::string const & mwmPath, std::string const & country,
+                      CountryParentNameGetterFn const & countryParentNameGetterFn);
+}  // namespace routing_builder
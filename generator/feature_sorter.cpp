@@ -383,7 +383,9 @@ bool GenerateFinalFeatures(feature::GenerateInfo const & info, std::string const
       coordBits -= ((scales::GetUpperScale() - scales::GetUpperWorldScale()) / 2);
 
     header.SetType(static_cast<DataHeader::MapType>(mapType));
-    header.SetGeometryCodingParams(serial::GeometryCodingParams(coordBits, midPoints.GetCenter()));
+    serial::GeometryCodingParams cp(coordBits, midPoints.GetCenter());
+    cp.SetDeltasEncoding(GetDeltasEncoding(DatSectionHeader::Version::Latest));
+    header.SetGeometryCodingParams(cp);
     if (isWorldOrWorldCoasts)
       header.SetScales(g_arrWorldScales);
     else
@@ -54,7 +54,8 @@ void OrderTextFileByLine(std::string const & filename)
 std::vector<std::vector<std::string>> GetAffiliations(std::vector<FeatureBuilder> const & fbs,
                                                       AffiliationInterface const & affiliation, size_t threadsCount)
 {
-  base::ComputationalThreadPool pool(threadsCount);
+  // One tiny task per feature, so the pool with per-thread queues is used.
+  base::WorkStealingThreadPool pool(threadsCount);
   std::vector<std::future<std::vector<std::string>>> futuresAffiliations;
   for (auto const & fb : fbs)
   {
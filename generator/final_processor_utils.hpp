@@ -7,7 +7,7 @@
 
 #include "base/file_name_utils.hpp"
 #include "base/string_utils.hpp"
-#include "base/thread_pool_computational.hpp"
+#include "base/thread_pool_work_stealing.hpp"
 
 #include "defines.hpp"
 
@@ -24,7 +24,7 @@ void ForEachMwmTmp(std::string const & temporaryMwmPath, ToDo && toDo, size_t th
 {
   Platform::FilesList fileList;
   Platform::GetFilesByExt(temporaryMwmPath, DATA_FILE_EXTENSION_TMP, fileList);
-  base::ComputationalThreadPool pool(threadsCount);
+  base::WorkStealingThreadPool pool(threadsCount);
   for (auto const & filename : fileList)
   {
     auto countryName = filename;
@@ -49,7 +49,7 @@ std::vector<std::vector<std::string>> AppendToMwmTmp(std::vector<feature::Featur
     for (auto const & country : affiliations[i])
       countryToFbsIndexes[country].emplace_back(i);
 
-  base::ComputationalThreadPool pool(threadsCount);
+  base::WorkStealingThreadPool pool(threadsCount);
   for (auto && p : countryToFbsIndexes)
   {
     pool.SubmitWork([&, country = std::move(p.first), indexes = std::move(p.second)]()
@@ -25,7 +25,8 @@ struct GenerateInfo
   enum class OsmSourceType
   {
     XML,
-    O5M
+    O5M,
+    PBF
   };
 
   // Directory for .mwm.tmp files.
@@ -80,6 +81,8 @@ struct GenerateInfo
       m_osmFileType = OsmSourceType::XML;
     else if (type == "o5m")
       m_osmFileType = OsmSourceType::O5M;
+    else if (type == "pbf")
+      m_osmFileType = OsmSourceType::PBF;
     else
       LOG(LCRITICAL, ("Unknown source type:", type));
   }
@@ -0,0 +1,230 @@
+#include "testing/testing.hpp"
+
+#include "generator/osm_element.hpp"
+#include "generator/osm_pbf_source.hpp"
+#include "generator/osm_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace osm_pbf_source_test
+{
+using namespace generator;
+using std::string, std::vector;
+
+// Minimal protobuf writer to build test PBF files.
+class Message
+{
+public:
+  Message & Varint(uint32_t field, uint64_t value)
+  {
+    Key(field, 0);
+    WriteVarint(value);
+    return *this;
+  }
+
+  Message & SVarint(uint32_t field, int64_t value) { return Varint(field, ZigZag(value)); }
+
+  Message & Bytes(uint32_t field, string const & value)
+  {
+    Key(field, 2);
+    WriteVarint(value.size());
+    m_data += value;
+    return *this;
+  }
+
+  Message & Sub(uint32_t field, Message const & message) { return Bytes(field, message.m_data); }
+
+  Message & PackedVarint(uint32_t field, vector<uint64_t> const & values)
+  {
+    Message packed;
+    for (auto v : values)
+      packed.WriteVarint(v);
+    return Bytes(field, packed.m_data);
+  }
+
+  Message & PackedDeltaSVarint(uint32_t field, vector<int64_t> const & values)
+  {
+    Message packed;
+    int64_t prev = 0;
+    for (auto v : values)
+    {
+      packed.WriteVarint(ZigZag(v - prev));
+      prev = v;
+    }
+    return Bytes(field, packed.m_data);
+  }
+
+  string const & Data() const { return m_data; }
+
+private:
+  static uint64_t ZigZag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+
+  void Key(uint32_t field, uint32_t type) { WriteVarint((field << 3) | type); }
+
+  void WriteVarint(uint64_t v)
+  {
+    while (v >= 0x80)
+    {
+      m_data.push_back(static_cast<char>((v & 0x7F) | 0x80));
+      v >>= 7;
+    }
+    m_data.push_back(static_cast<char>(v));
+  }
+
+  string m_data;
+};
+
+void AppendBlob(string & file, string const & type, Message const & block, bool compress)
+{
+  Message blob;
+  if (compress)
+  {
+    string compressed;
+    coding::ZLib::Deflate const deflate(coding::ZLib::Deflate::Format::ZLib,
+                                        coding::ZLib::Deflate::Level::BestCompression);
+    TEST(deflate(block.Data(), std::back_inserter(compressed)), ());
+    blob.Varint(2 /* raw_size */, block.Data().size()).Bytes(3 /* zlib_data */, compressed);
+  }
+  else
+  {
+    blob.Bytes(1 /* raw */, block.Data());
+  }
+
+  Message header;
+  header.Bytes(1 /* type */, type).Varint(3 /* datasize */, blob.Data().size());
+
+  auto const size = static_cast<uint32_t>(header.Data().size());
+  file.push_back(static_cast<char>(size >> 24));
+  file.push_back(static_cast<char>(size >> 16));
+  file.push_back(static_cast<char>(size >> 8));
+  file.push_back(static_cast<char>(size));
+  file += header.Data();
+  file += blob.Data();
+}
+
+string MakeHeader()
+{
+  string file;
+  Message header;
+  header.Bytes(4, "OsmSchema-V0.6").Bytes(4, "DenseNodes").Bytes(16, "test");
+  AppendBlob(file, "OSMHeader", header, false /* compress */);
+  return file;
+}
+
+// Strings: 0 - empty, 1 - "name", 2 - "Cafe", 3 - "highway", 4 - "primary", 5 - "type", 6 - "route", 7 - "outer".
+Message MakeStringTable()
+{
+  Message table;
+  for (auto const & s : {"", "name", "Cafe", "highway", "primary", "type", "route", "outer"})
+    table.Bytes(1, s);
+  return table;
+}
+
+UNIT_TEST(OSM_PBF_Source_ReadAllEntityTypes)
+{
+  Message dense;
+  dense.PackedDeltaSVarint(1, {10, 11, 15})
+      .PackedDeltaSVarint(8, {555000000, 555000100, 555001000})
+      .PackedDeltaSVarint(9, {376000000, 376000200, 376002000})
+      .PackedVarint(10, {0, 1, 2, 0, 0});
+
+  Message way;
+  way.Varint(1, 20).PackedVarint(2, {3}).PackedVarint(3, {4}).PackedDeltaSVarint(8, {10, 11, 15});
+
+  Message relation;
+  relation.Varint(1, 30)
+      .PackedVarint(2, {5})
+      .PackedVarint(3, {6})
+      .PackedVarint(8, {7, 0})
+      .PackedDeltaSVarint(9, {20, 15})
+      .PackedVarint(10, {1, 0});
+
+  Message block;
+  block.Sub(1, MakeStringTable())
+      .Sub(2, Message().Sub(2, dense))
+      .Sub(2, Message().Sub(3, way))
+      .Sub(2, Message().Sub(4, relation))
+      .Varint(17, 100);
+
+  string file = MakeHeader();
+  AppendBlob(file, "OSMData", block, true /* compress */);
+
+  std::istringstream stream(file);
+  SourceReader reader(stream);
+  vector<OsmElement> elements;
+  ProcessOsmElementsFromPbf(reader, [&elements](OsmElement && e) { elements.push_back(std::move(e)); });
+
+  TEST_EQUAL(elements.size(), 5, ());
+
+  TEST(elements[0].IsNode(), ());
+  TEST_EQUAL(elements[0].m_id, 10, ());
+  TEST(AlmostEqualAbs(elements[0].m_lat, 55.5, 1e-9), ());
+  TEST(AlmostEqualAbs(elements[0].m_lon, 37.6, 1e-9), ());
+  TEST(elements[0].Tags().empty(), ());
+
+  TEST_EQUAL(elements[1].m_id, 11, ());
+  TEST(AlmostEqualAbs(elements[1].m_lat, 55.50001, 1e-9), ());
+  TEST_EQUAL(elements[1].GetTag("name"), "Cafe", ());
+
+  TEST_EQUAL(elements[2].m_id, 15, ());
+  TEST(elements[2].Tags().empty(), ());
+
+  TEST(elements[3].IsWay(), ());
+  TEST_EQUAL(elements[3].m_id, 20, ());
+  TEST_EQUAL(elements[3].Nodes(), vector<uint64_t>({10, 11, 15}), ());
+  TEST_EQUAL(elements[3].GetTag("highway"), "primary", ());
+
+  TEST(elements[4].IsRelation(), ());
+  TEST_EQUAL(elements[4].m_id, 30, ());
+  TEST_EQUAL(elements[4].GetTag("type"), "route", ());
+  auto const & members = elements[4].Members();
+  TEST_EQUAL(members.size(), 2, ());
+  TEST(members[0] == OsmElement::Member(20, OsmElement::EntityType::Way, "outer"), ());
+  TEST(members[1] == OsmElement::Member(15, OsmElement::EntityType::Node, ""), ());
+}
+
+UNIT_TEST(OSM_PBF_Source_ParallelDecodingKeepsOrder)
+{
+  size_t constexpr kBlobsCount = 50;
+  size_t constexpr kNodesPerBlob = 100;
+
+  string file = MakeHeader();
+  for (size_t i = 0; i < kBlobsCount; ++i)
+  {
+    vector<int64_t> ids, coords;
+    for (size_t j = 0; j < kNodesPerBlob; ++j)
+    {
+      ids.push_back(static_cast<int64_t>(i * kNodesPerBlob + j + 1));
+      coords.push_back(static_cast<int64_t>(j));
+    }
+
+    Message block;
+    block.Sub(1, MakeStringTable())
+        .Sub(2, Message().Sub(2, Message().PackedDeltaSVarint(1, ids).PackedDeltaSVarint(8, coords).PackedDeltaSVarint(
+                                     9, coords)));
+    AppendBlob(file, "OSMData", block, i % 2 == 0 /* compress */);
+  }
+
+  std::istringstream stream(file);
+  SourceReader reader(stream);
+  ProcessorOsmElementsFromPbf processor(reader, 4 /* threadsCount */);
+
+  uint64_t expectedId = 1;
+  OsmElement element;
+  while (processor.TryRead(element))
+  {
+    TEST_EQUAL(element.m_id, expectedId, ());
+    ++expectedId;
+    element.Clear();
+  }
+  TEST_EQUAL(expectedId, kBlobsCount * kNodesPerBlob + 1, ());
+}
+}  // namespace osm_pbf_source_test
@@ -0,0 +1,80 @@
+#include "testing/testing.hpp"
+
+#include "generator/search_index_runs.hpp"
+
+#include "search/search_index_values.hpp"
+
+#include "indexer/trie_builder.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/writer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace search_index_runs_test
+{
+using namespace indexer;
+
+using Key = KeyValueRuns::Key;
+using Value = KeyValueRuns::Value;
+using TrieBuilder = trie::Builder<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>;
+
+UNIT_TEST(KeyValueRuns_SpilledRunsMakeTheSameTrie)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<uint32_t> lengthDist(1, 6);
+  std::uniform_int_distribution<uint32_t> charDist('a', 'e');
+  std::uniform_int_distribution<uint64_t> valueDist(0, 1000);
+
+  uint32_t constexpr kRunsCount = 3;
+  size_t constexpr kMaxBytes = 4096;
+  std::vector<KeyValueRuns> runs;
+  for (uint32_t i = 0; i < kRunsCount; ++i)
+    runs.emplace_back(GetPlatform().TmpPathForFile("search_index_runs_test." + std::to_string(i) + "."), kMaxBytes);
+
+  std::vector<KeyValueRuns::KeyValuePair> pairs;
+  for (uint32_t i = 0; i < 10000; ++i)
+  {
+    Key key(lengthDist(rng));
+    for (auto & c : key)
+      c = charDist(rng);
+    auto const value = valueDist(rng);
+
+    // Equal pairs are added to the trie once.
+    runs[i % kRunsCount].emplace_back(key, value);
+    pairs.emplace_back(key, Value(value));
+  }
+
+  for (auto & run : runs)
+  {
+    run.Finish();
+    TEST_GREATER(run.GetRunFiles().size(), 2, ());
+  }
+
+  std::vector<uint8_t> merged;
+  {
+    MemWriter<std::vector<uint8_t>> writer(merged);
+    SingleValueSerializer<Value> serializer;
+    TrieBuilder builder(writer, serializer);
+    MergeRuns(runs, [&builder](Key const & key, Value const & value) { builder.Add(key, value); });
+    builder.Finish();
+  }
+
+  std::sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+  std::vector<uint8_t> expected;
+  {
+    MemWriter<std::vector<uint8_t>> writer(expected);
+    SingleValueSerializer<Value> serializer;
+    trie::Build<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>(writer, serializer, pairs);
+  }
+
+  TEST(!expected.empty(), ());
+  TEST(merged == expected, ());
+}
+}  // namespace search_index_runs_test
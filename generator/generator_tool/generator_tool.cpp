@@ -1,6 +1,7 @@
 #include "generator/altitude_generator.hpp"
 #include "generator/borders.hpp"
 #include "generator/camera_info_collector.hpp"
+#include "generator/cell_overlay_generator.hpp"
 #include "generator/centers_table_builder.hpp"
 #include "generator/check_model.hpp"
 #include "generator/cities_boundaries_builder.hpp"
@@ -12,6 +13,7 @@
 #include "generator/feature_sorter.hpp"
 #include "generator/generate_info.hpp"
 #include "generator/isolines_section_builder.hpp"
+#include "generator/landmarks_generator.hpp"
 #include "generator/maxspeeds_builder.hpp"
 #include "generator/metalines_builder.hpp"
 #include "generator/osm_source.hpp"
@@ -72,7 +74,7 @@ DEFINE_bool(emit_coasts, false, "Push coasts features from intermediate file to
 
 // Generator settings and paths.
 DEFINE_string(osm_file_name, "", "Input osm area file.");
-DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m].");
+DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m, pbf].");
 DEFINE_string(data_path, "", GetDataPathHelp());
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_string(intermediate_data_path, "", "Path to stored intermediate data.");
@@ -129,6 +131,11 @@ DEFINE_bool(generate_cameras, false, "Generate section with speed cameras info."
 DEFINE_bool(make_city_roads, false,
             "Calculates which roads lie inside cities and makes a section with ids of these roads.");
 DEFINE_bool(generate_maxspeed, false, "Generate section with maxspeed of road features.");
+DEFINE_uint64(landmarks_count, 0,
+              "Count (up to 16) of landmarks for the car routing A* heuristic. "
+              "If it is not zero, landmarks section is built with make_routing_index.");
+DEFINE_bool(make_cell_overlay, false,
+            "Build multi-level cell overlay section for the car routing inside mwm with make_routing_index.");
 
 // Sponsored-related.
 DEFINE_string(complex_hierarchy_data, "", "Path to complex hierarchy in csv format.");
@@ -252,7 +259,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   if (FLAGS_preprocess)
   {
     LOG(LINFO, ("Generating intermediate data ...."));
-    if (!GenerateIntermediateData(genInfo))
+    if (!GenerateIntermediateData(genInfo, threadsCount))
       return EXIT_FAILURE;
   }
 
@@ -346,7 +353,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     {
       LOG(LINFO, ("Generating index for", dataFile));
 
-      if (!indexer::BuildIndexFromDataFile(dataFile, FLAGS_intermediate_data_path + country))
+      if (!indexer::BuildIndexFromDataFile(dataFile, FLAGS_intermediate_data_path + country, threadsCount))
         LOG(LCRITICAL, ("Error generating index."));
     }
 
@@ -486,6 +493,21 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
         LOG(LINFO, ("Generating maxspeeds section for", dataFile, "using", maxspeedsFilename));
         BuildMaxspeedsSection(routingGraph.get(), dataFile, osmToFeatureFilename, maxspeedsFilename);
       }
+
+      // Landmark weights depend on the routing graph, city roads and maxspeeds, so they are built last.
+      if (FLAGS_landmarks_count != 0)
+      {
+        LOG(LINFO, ("Generating", LANDMARKS_FILE_TAG, "section for", dataFile));
+        if (!BuildLandmarks(dataFile, country, *countryParentGetter, FLAGS_landmarks_count))
+          LOG(LERROR, ("Generating landmarks error for", dataFile));
+      }
+
+      if (FLAGS_make_cell_overlay)
+      {
+        LOG(LINFO, ("Generating", CELL_OVERLAY_FILE_TAG, "section for", dataFile));
+        if (!BuildCellOverlay(dataFile, country, *countryParentGetter))
+          LOG(LERROR, ("Generating cell overlay error for", dataFile));
+      }
     }
 
     if (FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm || FLAGS_make_transit_cross_mwm_experimental)
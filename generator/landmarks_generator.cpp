@@ -0,0 +1,281 @@
+#include "generator/landmarks_generator.hpp"
+
+#include "routing/edge_estimator.hpp"
+#include "routing/geometry.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/index_graph_loader.hpp"
+#include "routing/landmarks.hpp"
+#include "routing/road_index.hpp"
+
+#include "routing_common/car_model.hpp"
+
+#include "indexer/data_source.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "defines.hpp"
+
+namespace routing_builder
+{
+using namespace routing;
+
+namespace
+{
+double constexpr kInf = std::numeric_limits<double>::infinity();
+
+// Directed graph of joints in compressed sparse row form.
+struct JointGraph
+{
+  struct Edge
+  {
+    Joint::Id m_target;
+    double m_weight;
+  };
+
+  template <typename F>
+  void ForEachEdge(Joint::Id jointId, F && f) const
+  {
+    for (uint32_t i = m_offsets[jointId]; i < m_offsets[jointId + 1]; ++i)
+      f(m_edges[i]);
+  }
+
+  std::vector<uint32_t> m_offsets;
+  std::vector<Edge> m_edges;
+};
+
+struct RawEdge
+{
+  Joint::Id m_source;
+  Joint::Id m_target;
+  double m_weight;
+};
+
+JointGraph MakeJointGraph(std::vector<RawEdge> const & edges, uint32_t numJoints, bool outgoing)
+{
+  JointGraph graph;
+  graph.m_offsets.assign(numJoints + 1, 0);
+  for (auto const & e : edges)
+    ++graph.m_offsets[(outgoing ? e.m_source : e.m_target) + 1];
+  for (uint32_t i = 0; i < numJoints; ++i)
+    graph.m_offsets[i + 1] += graph.m_offsets[i];
+
+  auto positions = graph.m_offsets;
+  graph.m_edges.resize(edges.size());
+  for (auto const & e : edges)
+  {
+    if (outgoing)
+      graph.m_edges[positions[e.m_source]++] = {e.m_target, e.m_weight};
+    else
+      graph.m_edges[positions[e.m_target]++] = {e.m_source, e.m_weight};
+  }
+  return graph;
+}
+
+// Collects edges between the neighbouring joints of the roads. Restrictions, road access and traffic
+// are not taken into account, so the weights of the joint graph routes are not greater than the routing ones.
+std::vector<RawEdge> CollectEdges(IndexGraph const & graph, EdgeEstimator const & estimator)
+{
+  std::vector<RawEdge> edges;
+  graph.ForEachRoad([&](uint32_t featureId, RoadJointIds const & roadJoints)
+  {
+    auto const & road = graph.GetRoadGeometry(featureId);
+    if (!road.IsValid())
+      return;
+
+    uint32_t prevPointId = 0;
+    Joint::Id prevJointId = Joint::kInvalidId;
+    roadJoints.ForEachJoint([&](uint32_t pointId, Joint::Id jointId)
+    {
+      if (prevJointId != Joint::kInvalidId && pointId < road.GetPointsCount())
+      {
+        double forward = 0.0;
+        double backward = 0.0;
+        for (uint32_t i = prevPointId; i < pointId; ++i)
+        {
+          forward += estimator.CalcSegmentWeight(Segment(kFakeNumMwmId, featureId, i, true /* forward */), road,
+                                                 EdgeEstimator::Purpose::Weight);
+          backward += estimator.CalcSegmentWeight(Segment(kFakeNumMwmId, featureId, i, false /* forward */), road,
+                                                  EdgeEstimator::Purpose::Weight);
+        }
+
+        edges.push_back({prevJointId, jointId, forward});
+        if (!road.IsOneWay())
+          edges.push_back({jointId, prevJointId, backward});
+      }
+
+      prevPointId = pointId;
+      prevJointId = jointId;
+    });
+  });
+  return edges;
+}
+
+std::vector<double> FindWeights(JointGraph const & graph, Joint::Id source)
+{
+  std::vector<double> weights(graph.m_offsets.size() - 1, kInf);
+
+  using State = std::pair<double, Joint::Id>;
+  std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
+  weights[source] = 0.0;
+  queue.emplace(0.0, source);
+  while (!queue.empty())
+  {
+    auto const [weight, jointId] = queue.top();
+    queue.pop();
+    if (weight > weights[jointId])
+      continue;
+
+    graph.ForEachEdge(jointId, [&](JointGraph::Edge const & edge)
+    {
+      double const newWeight = weight + edge.m_weight;
+      if (newWeight < weights[edge.m_target])
+      {
+        weights[edge.m_target] = newWeight;
+        queue.emplace(newWeight, edge.m_target);
+      }
+    });
+  }
+  return weights;
+}
+
+// Picks the reachable joint which is the farthest from the already selected landmarks.
+Joint::Id FindFarthestJoint(std::vector<double> const & scores)
+{
+  Joint::Id result = Joint::kInvalidId;
+  double maxScore = 0.0;
+  for (Joint::Id jointId = 0; jointId < scores.size(); ++jointId)
+  {
+    if (std::isfinite(scores[jointId]) && scores[jointId] > maxScore)
+    {
+      maxScore = scores[jointId];
+      result = jointId;
+    }
+  }
+  return result;
+}
+}  // namespace
+
+bool BuildLandmarks(std::string const & mwmPath, std::string const & country,
+                    CountryParentNameGetterFn const & countryParentNameGetterFn, size_t count)
+{
+  CHECK_LESS_OR_EQUAL(count, LandmarkWeights::kMaxCount, ());
+  try
+  {
+    base::Timer timer;
+
+    std::shared_ptr<VehicleModelInterface> vehicleModel =
+        CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+    auto estimator = EdgeEstimator::Create(VehicleType::Car, *vehicleModel, nullptr /* trafficStash */,
+                                           nullptr /* dataSource */, nullptr /* numMvmIds */);
+
+    MwmValue mwmValue(platform::LocalCountryFile::MakeTemporary(mwmPath));
+    // Keep all roads of the mwm in memory, every road is used while the joint graph is built.
+    IndexGraph graph(std::make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmPath, vehicleModel),
+                                                std::numeric_limits<size_t>::max() /* roadsCacheSizeBytes */),
+                     estimator);
+    DeserializeIndexGraph(mwmValue, VehicleType::Car, graph);
+
+    uint32_t const numJoints = graph.GetNumJoints();
+    if (numJoints == 0 || count == 0)
+    {
+      LOG(LINFO, ("No landmarks for", mwmPath));
+      return true;
+    }
+
+    auto const edges = CollectEdges(graph, *estimator);
+    JointGraph const outgoing = MakeJointGraph(edges, numJoints, true /* outgoing */);
+    JointGraph const ingoing = MakeJointGraph(edges, numJoints, false /* outgoing */);
+    LOG(LINFO, ("Joint graph of", mwmPath, "has", numJoints, "joints and", edges.size(), "edges"));
+
+    // Landmarks are selected one by one as the farthest joints from the previous ones.
+    // The first one is the farthest from an arbitrary joint.
+    std::vector<Joint::Id> landmarks;
+    std::vector<std::vector<double>> from;
+    std::vector<std::vector<double>> to;
+    std::vector<double> scores = FindWeights(outgoing, 0 /* source */);
+    bool isSeed = true;
+    while (landmarks.size() < count)
+    {
+      Joint::Id const landmark = FindFarthestJoint(scores);
+      if (landmark == Joint::kInvalidId)
+        break;
+
+      landmarks.push_back(landmark);
+      from.push_back(FindWeights(outgoing, landmark));
+      to.push_back(FindWeights(ingoing, landmark));
+
+      if (isSeed)
+      {
+        scores.assign(numJoints, kInf);
+        isSeed = false;
+      }
+      for (uint32_t jointId = 0; jointId < numJoints; ++jointId)
+        scores[jointId] = std::min({scores[jointId], from.back()[jointId], to.back()[jointId]});
+    }
+
+    double maxWeight = 0.0;
+    for (size_t i = 0; i < landmarks.size(); ++i)
+    {
+      for (uint32_t jointId = 0; jointId < numJoints; ++jointId)
+      {
+        if (std::isfinite(from[i][jointId]))
+          maxWeight = std::max(maxWeight, from[i][jointId]);
+        if (std::isfinite(to[i][jointId]))
+          maxWeight = std::max(maxWeight, to[i][jointId]);
+      }
+    }
+
+    // The weights are rounded down to keep the bounds admissible.
+    uint32_t const maxValue = Landmarks::kNoWeight - 1;
+    uint32_t const precisionDs = std::max(1U, static_cast<uint32_t>(std::ceil(maxWeight * 10.0 / maxValue)));
+    auto const quantize = [&](double weight) -> uint16_t
+    {
+      if (!std::isfinite(weight))
+        return Landmarks::kNoWeight;
+      return static_cast<uint16_t>(std::min(static_cast<uint32_t>(weight * 10.0 / precisionDs), maxValue));
+    };
+
+    std::vector<uint16_t> fromValues(landmarks.size() * numJoints);
+    std::vector<uint16_t> toValues(landmarks.size() * numJoints);
+    for (uint32_t jointId = 0; jointId < numJoints; ++jointId)
+    {
+      for (size_t i = 0; i < landmarks.size(); ++i)
+      {
+        size_t const index = static_cast<size_t>(jointId) * landmarks.size() + i;
+        fromValues[index] = quantize(from[i][jointId]);
+        toValues[index] = quantize(to[i][jointId]);
+      }
+    }
+
+    Landmarks const result(std::move(landmarks), numJoints, precisionDs, std::move(fromValues), std::move(toValues));
+
+    FilesContainerW cont(mwmPath, FileWriter::OP_WRITE_EXISTING);
+    auto writer = cont.GetWriter(LANDMARKS_FILE_TAG);
+    result.Serialize(*writer);
+
+    LOG(LINFO, (LANDMARKS_FILE_TAG, "section of", mwmPath, "is built with", result.GetCount(),
+                "landmarks, precision:", precisionDs, "ds, elapsed:", timer.ElapsedSeconds(), "seconds"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Error while building", LANDMARKS_FILE_TAG, "section in", mwmPath, ". Message:", e.Msg()));
+    return false;
+  }
+}
+}  // namespace routing_builder
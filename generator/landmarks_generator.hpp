@@ -0,0 +1,16 @@
+#pragma once
+
+#include "generator/routing_index_generator.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace routing_builder
+{
+/// \brief Selects |count| landmark joints of the car routing graph of the mwm and builds LANDMARKS_FILE_TAG
+/// section with car route weights between the landmarks and all the joints.
+/// \note Before a call of this method ROUTING_FILE_TAG, city_roads and maxspeeds sections should be built,
+/// because the weights should be the same as the ones of the routing.
+bool BuildLandmarks(std::string const & mwmPath, std::string const & country,
+                    CountryParentNameGetterFn const & countryParentNameGetterFn, size_t count);
+}  // namespace routing_builder
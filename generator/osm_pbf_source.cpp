@@ -0,0 +1,482 @@
+#include "generator/osm_pbf_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <iterator>
+
+namespace osm
+{
+namespace
+{
+// Limits from the format specification.
+uint32_t constexpr kMaxBlobHeaderSize = 64 * 1024;
+uint32_t constexpr kMaxBlobSize = 32 * 1024 * 1024;
+
+// Blob.
+uint32_t constexpr kBlobRaw = 1;
+uint32_t constexpr kBlobRawSize = 2;
+uint32_t constexpr kBlobZlibData = 3;
+
+// BlobHeader.
+uint32_t constexpr kBlobHeaderType = 1;
+uint32_t constexpr kBlobHeaderDataSize = 3;
+
+// HeaderBlock.
+uint32_t constexpr kHeaderRequiredFeatures = 4;
+
+// PrimitiveBlock.
+uint32_t constexpr kBlockStringTable = 1;
+uint32_t constexpr kBlockPrimitiveGroup = 2;
+uint32_t constexpr kBlockGranularity = 17;
+uint32_t constexpr kBlockLatOffset = 19;
+uint32_t constexpr kBlockLonOffset = 20;
+
+// StringTable.
+uint32_t constexpr kStringTableString = 1;
+
+// PrimitiveGroup.
+uint32_t constexpr kGroupNodes = 1;
+uint32_t constexpr kGroupDense = 2;
+uint32_t constexpr kGroupWays = 3;
+uint32_t constexpr kGroupRelations = 4;
+
+// Node, Way and Relation share id/keys/vals numbers.
+uint32_t constexpr kId = 1;
+uint32_t constexpr kKeys = 2;
+uint32_t constexpr kVals = 3;
+uint32_t constexpr kNodeLat = 8;
+uint32_t constexpr kNodeLon = 9;
+uint32_t constexpr kWayRefs = 8;
+uint32_t constexpr kRelationRolesSid = 8;
+uint32_t constexpr kRelationMemIds = 9;
+uint32_t constexpr kRelationTypes = 10;
+
+// DenseNodes.
+uint32_t constexpr kDenseId = 1;
+uint32_t constexpr kDenseLat = 8;
+uint32_t constexpr kDenseLon = 9;
+uint32_t constexpr kDenseKeysVals = 10;
+
+bool ReadExactly(TPbfReadFunc const & reader, uint8_t * buffer, size_t size)
+{
+  size_t total = 0;
+  while (total < size)
+  {
+    size_t const read = reader(buffer + total, size - total);
+    if (read == 0)
+      break;
+    total += read;
+  }
+  return total == size;
+}
+
+class PrimitiveBlockDecoder
+{
+public:
+  explicit PrimitiveBlockDecoder(std::vector<OsmElement> & elements) : m_elements(elements) {}
+
+  void Decode(ProtobufReader block)
+  {
+    // Block parameters may follow primitive groups, so the groups are decoded in the second pass.
+    std::vector<ProtobufReader> groups;
+    while (block.Next())
+    {
+      switch (block.Field())
+      {
+      case kBlockStringTable: ReadStringTable(block.Message()); break;
+      case kBlockPrimitiveGroup: groups.push_back(block.Message()); break;
+      case kBlockGranularity: m_granularity = static_cast<int64_t>(block.Varint()); break;
+      case kBlockLatOffset: m_latOffset = static_cast<int64_t>(block.Varint()); break;
+      case kBlockLonOffset: m_lonOffset = static_cast<int64_t>(block.Varint()); break;
+      default: block.Skip(); break;
+      }
+    }
+
+    for (auto & group : groups)
+      DecodeGroup(group);
+  }
+
+private:
+  void ReadStringTable(ProtobufReader table)
+  {
+    while (table.Next())
+    {
+      if (table.Field() == kStringTableString)
+        m_strings.push_back(table.Bytes());
+      else
+        table.Skip();
+    }
+  }
+
+  std::string_view const & String(uint64_t index) const
+  {
+    CHECK_LESS(index, m_strings.size(), ("Broken PBF string table reference."));
+    return m_strings[index];
+  }
+
+  double ToDegrees(int64_t offset, int64_t value) const
+  {
+    return 1e-9 * static_cast<double>(offset + m_granularity * value);
+  }
+
+  void DecodeGroup(ProtobufReader group)
+  {
+    while (group.Next())
+    {
+      switch (group.Field())
+      {
+      case kGroupNodes: DecodeNode(group.Message()); break;
+      case kGroupDense: DecodeDenseNodes(group.Message()); break;
+      case kGroupWays: DecodeWay(group.Message()); break;
+      case kGroupRelations: DecodeRelation(group.Message()); break;
+      default: group.Skip(); break;
+      }
+    }
+  }
+
+  OsmElement & AddElement(OsmElement::EntityType type)
+  {
+    auto & element = m_elements.emplace_back();
+    element.m_type = type;
+    return element;
+  }
+
+  void AddTags(OsmElement & element, std::vector<uint32_t> const & keys, std::vector<uint32_t> const & vals) const
+  {
+    CHECK_EQUAL(keys.size(), vals.size(), ("Broken PBF tags of", element.m_id));
+    for (size_t i = 0; i < keys.size(); ++i)
+      element.AddTag(String(keys[i]), String(vals[i]));
+  }
+
+  void DecodeNode(ProtobufReader node)
+  {
+    auto & element = AddElement(OsmElement::EntityType::Node);
+    std::vector<uint32_t> keys, vals;
+    int64_t lat = 0, lon = 0;
+    while (node.Next())
+    {
+      switch (node.Field())
+      {
+      case kId: element.m_id = static_cast<uint64_t>(node.SVarint()); break;
+      case kKeys: node.ForEachVarint([&keys](uint64_t v) { keys.push_back(static_cast<uint32_t>(v)); }); break;
+      case kVals: node.ForEachVarint([&vals](uint64_t v) { vals.push_back(static_cast<uint32_t>(v)); }); break;
+      case kNodeLat: lat = node.SVarint(); break;
+      case kNodeLon: lon = node.SVarint(); break;
+      default: node.Skip(); break;
+      }
+    }
+    element.m_lat = ToDegrees(m_latOffset, lat);
+    element.m_lon = ToDegrees(m_lonOffset, lon);
+    AddTags(element, keys, vals);
+    element.Validate();
+  }
+
+  void DecodeDenseNodes(ProtobufReader dense)
+  {
+    std::vector<int64_t> ids, lats, lons;
+    std::vector<uint32_t> keysVals;
+    while (dense.Next())
+    {
+      switch (dense.Field())
+      {
+      case kDenseId: dense.ForEachSVarint([&ids](int64_t v) { ids.push_back(v); }); break;
+      case kDenseLat: dense.ForEachSVarint([&lats](int64_t v) { lats.push_back(v); }); break;
+      case kDenseLon: dense.ForEachSVarint([&lons](int64_t v) { lons.push_back(v); }); break;
+      case kDenseKeysVals:
+        dense.ForEachVarint([&keysVals](uint64_t v) { keysVals.push_back(static_cast<uint32_t>(v)); });
+        break;
+      default: dense.Skip(); break;
+      }
+    }
+
+    CHECK_EQUAL(ids.size(), lats.size(), ("Broken PBF dense nodes."));
+    CHECK_EQUAL(ids.size(), lons.size(), ("Broken PBF dense nodes."));
+
+    int64_t id = 0, lat = 0, lon = 0;
+    size_t kv = 0;
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      id += ids[i];
+      lat += lats[i];
+      lon += lons[i];
+
+      auto & element = AddElement(OsmElement::EntityType::Node);
+      element.m_id = static_cast<uint64_t>(id);
+      element.m_lat = ToDegrees(m_latOffset, lat);
+      element.m_lon = ToDegrees(m_lonOffset, lon);
+
+      // Tags of all nodes are stored as a single list of (key, val)* 0 sequences.
+      // The list is empty when none of the nodes in the block has tags.
+      while (kv < keysVals.size() && keysVals[kv] != 0)
+      {
+        CHECK_LESS(kv + 1, keysVals.size(), ("Broken PBF dense nodes tags."));
+        element.AddTag(String(keysVals[kv]), String(keysVals[kv + 1]));
+        kv += 2;
+      }
+      ++kv;
+      element.Validate();
+    }
+  }
+
+  void DecodeWay(ProtobufReader way)
+  {
+    auto & element = AddElement(OsmElement::EntityType::Way);
+    std::vector<uint32_t> keys, vals;
+    while (way.Next())
+    {
+      switch (way.Field())
+      {
+      case kId: element.m_id = way.Varint(); break;
+      case kKeys: way.ForEachVarint([&keys](uint64_t v) { keys.push_back(static_cast<uint32_t>(v)); }); break;
+      case kVals: way.ForEachVarint([&vals](uint64_t v) { vals.push_back(static_cast<uint32_t>(v)); }); break;
+      case kWayRefs:
+      {
+        int64_t ref = 0;
+        way.ForEachSVarint([&](int64_t delta)
+        {
+          ref += delta;
+          element.AddNd(static_cast<uint64_t>(ref));
+        });
+        break;
+      }
+      default: way.Skip(); break;
+      }
+    }
+    AddTags(element, keys, vals);
+    element.Validate();
+  }
+
+  void DecodeRelation(ProtobufReader relation)
+  {
+    auto & element = AddElement(OsmElement::EntityType::Relation);
+    std::vector<uint32_t> keys, vals, roles;
+    std::vector<uint64_t> memIds;
+    std::vector<OsmElement::EntityType> types;
+    while (relation.Next())
+    {
+      switch (relation.Field())
+      {
+      case kId: element.m_id = relation.Varint(); break;
+      case kKeys: relation.ForEachVarint([&keys](uint64_t v) { keys.push_back(static_cast<uint32_t>(v)); }); break;
+      case kVals: relation.ForEachVarint([&vals](uint64_t v) { vals.push_back(static_cast<uint32_t>(v)); }); break;
+      case kRelationRolesSid:
+        relation.ForEachVarint([&roles](uint64_t v) { roles.push_back(static_cast<uint32_t>(v)); });
+        break;
+      case kRelationMemIds:
+      {
+        int64_t ref = 0;
+        relation.ForEachSVarint([&](int64_t delta)
+        {
+          ref += delta;
+          memIds.push_back(static_cast<uint64_t>(ref));
+        });
+        break;
+      }
+      case kRelationTypes:
+        relation.ForEachVarint([&types](uint64_t v)
+        {
+          switch (v)
+          {
+          case 0: types.push_back(OsmElement::EntityType::Node); break;
+          case 1: types.push_back(OsmElement::EntityType::Way); break;
+          case 2: types.push_back(OsmElement::EntityType::Relation); break;
+          default: types.push_back(OsmElement::EntityType::Unknown); break;
+          }
+        });
+        break;
+      default: relation.Skip(); break;
+      }
+    }
+
+    CHECK_EQUAL(memIds.size(), roles.size(), ("Broken PBF relation", element.m_id));
+    CHECK_EQUAL(memIds.size(), types.size(), ("Broken PBF relation", element.m_id));
+    for (size_t i = 0; i < memIds.size(); ++i)
+      element.AddMember(memIds[i], types[i], std::string(String(roles[i])));
+
+    AddTags(element, keys, vals);
+    element.Validate();
+  }
+
+  std::vector<OsmElement> & m_elements;
+  std::vector<std::string_view> m_strings;
+  int64_t m_granularity = 100;
+  int64_t m_latOffset = 0;
+  int64_t m_lonOffset = 0;
+};
+}  // namespace
+
+// ProtobufReader ----------------------------------------------------------------------------------
+bool ProtobufReader::Next()
+{
+  if (Empty())
+    return false;
+
+  uint64_t const key = ReadVarint();
+  m_field = static_cast<uint32_t>(key >> 3);
+  m_type = static_cast<WireType>(key & 0x7);
+  return true;
+}
+
+uint64_t ProtobufReader::Varint()
+{
+  CHECK(m_type == WireType::Varint, (m_field));
+  return ReadVarint();
+}
+
+std::string_view ProtobufReader::Bytes()
+{
+  CHECK(m_type == WireType::LengthDelimited, (m_field));
+  auto const size = static_cast<size_t>(ReadVarint());
+  auto const * begin = m_pos;
+  Advance(size);
+  return {reinterpret_cast<char const *>(begin), size};
+}
+
+void ProtobufReader::Skip()
+{
+  switch (m_type)
+  {
+  case WireType::Varint: ReadVarint(); break;
+  case WireType::Fixed64: Advance(8); break;
+  case WireType::LengthDelimited: Advance(static_cast<size_t>(ReadVarint())); break;
+  case WireType::Fixed32: Advance(4); break;
+  default: CHECK(false, ("Unsupported protobuf wire type", static_cast<int>(m_type)));
+  }
+}
+
+uint64_t ProtobufReader::ReadVarint()
+{
+  uint64_t result = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+  {
+    CHECK(m_pos != m_end, ("Unexpected end of protobuf message."));
+    uint8_t const byte = *m_pos++;
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return result;
+  }
+  CHECK(false, ("Too long protobuf varint."));
+  return result;
+}
+
+void ProtobufReader::Advance(size_t size)
+{
+  CHECK_LESS_OR_EQUAL(size, static_cast<size_t>(m_end - m_pos), ("Unexpected end of protobuf message."));
+  m_pos += size;
+}
+
+// Functions ---------------------------------------------------------------------------------------
+bool ReadPbfBlob(TPbfReadFunc const & reader, PbfBlob & blob)
+{
+  uint8_t sizeBuffer[4];
+  size_t const read = reader(sizeBuffer, sizeof(sizeBuffer));
+  if (read == 0)
+    return false;
+  CHECK(read == sizeof(sizeBuffer) || ReadExactly(reader, sizeBuffer + read, sizeof(sizeBuffer) - read),
+        ("Truncated PBF blob header size."));
+
+  // Network byte order.
+  uint32_t const headerSize = (static_cast<uint32_t>(sizeBuffer[0]) << 24) |
+                              (static_cast<uint32_t>(sizeBuffer[1]) << 16) |
+                              (static_cast<uint32_t>(sizeBuffer[2]) << 8) | static_cast<uint32_t>(sizeBuffer[3]);
+  CHECK_LESS_OR_EQUAL(headerSize, kMaxBlobHeaderSize, ("Too large PBF blob header."));
+
+  std::vector<uint8_t> header(headerSize);
+  CHECK(ReadExactly(reader, header.data(), header.size()), ("Truncated PBF blob header."));
+
+  std::string_view type;
+  uint64_t dataSize = 0;
+  ProtobufReader headerReader(header.data(), header.size());
+  while (headerReader.Next())
+  {
+    switch (headerReader.Field())
+    {
+    case kBlobHeaderType: type = headerReader.Bytes(); break;
+    case kBlobHeaderDataSize: dataSize = headerReader.Varint(); break;
+    default: headerReader.Skip(); break;
+    }
+  }
+  CHECK_LESS_OR_EQUAL(dataSize, kMaxBlobSize, ("Too large PBF blob."));
+
+  if (type == "OSMHeader")
+    blob.m_type = PbfBlob::Type::Header;
+  else if (type == "OSMData")
+    blob.m_type = PbfBlob::Type::Data;
+  else
+    blob.m_type = PbfBlob::Type::Unknown;
+
+  blob.m_data.resize(static_cast<size_t>(dataSize));
+  CHECK(ReadExactly(reader, blob.m_data.data(), blob.m_data.size()), ("Truncated PBF blob."));
+  return true;
+}
+
+void UnpackPbfBlob(std::vector<uint8_t> const & data, std::vector<uint8_t> & out)
+{
+  out.clear();
+  ProtobufReader blob(data.data(), data.size());
+  std::string_view raw;
+  std::string_view zlibData;
+  uint64_t rawSize = 0;
+  while (blob.Next())
+  {
+    switch (blob.Field())
+    {
+    case kBlobRaw: raw = blob.Bytes(); break;
+    case kBlobRawSize: rawSize = blob.Varint(); break;
+    case kBlobZlibData: zlibData = blob.Bytes(); break;
+    default: blob.Skip(); break;
+    }
+  }
+
+  if (!zlibData.empty())
+  {
+    CHECK_LESS_OR_EQUAL(rawSize, kMaxBlobSize, ("Too large PBF blob."));
+    out.reserve(static_cast<size_t>(rawSize));
+    coding::ZLib::Inflate const inflate(coding::ZLib::Inflate::Format::ZLib);
+    CHECK(inflate(zlibData.data(), zlibData.size(), std::back_inserter(out)), ("Can't inflate PBF blob."));
+    CHECK_EQUAL(out.size(), rawSize, ("Broken PBF blob raw_size."));
+    return;
+  }
+
+  // Empty raw data is a valid empty block. Other compressions (lzma, lz4, zstd) are not used by planet dumps.
+  CHECK(rawSize == 0 || !raw.empty(), ("Unsupported PBF blob compression."));
+  out.assign(raw.begin(), raw.end());
+}
+
+void CheckPbfHeader(PbfBlob const & blob)
+{
+  CHECK(blob.m_type == PbfBlob::Type::Header, ());
+
+  std::vector<uint8_t> data;
+  UnpackPbfBlob(blob.m_data, data);
+
+  ProtobufReader header(data.data(), data.size());
+  while (header.Next())
+  {
+    if (header.Field() != kHeaderRequiredFeatures)
+    {
+      header.Skip();
+      continue;
+    }
+
+    auto const feature = header.Bytes();
+    CHECK(feature == "OsmSchema-V0.6" || feature == "DenseNodes", ("Unsupported PBF feature:", feature));
+  }
+}
+
+void DecodePbfBlob(PbfBlob const & blob, std::vector<OsmElement> & elements)
+{
+  if (blob.m_type != PbfBlob::Type::Data)
+  {
+    LOG(LWARNING, ("Skipping unknown PBF blob."));
+    return;
+  }
+
+  std::vector<uint8_t> data;
+  UnpackPbfBlob(blob.m_data, data);
+  PrimitiveBlockDecoder(elements).Decode(ProtobufReader(data.data(), data.size()));
+}
+}  // namespace osm
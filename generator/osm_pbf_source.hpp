@@ -0,0 +1,110 @@
+// See PBF Format definition at https://wiki.openstreetmap.org/wiki/PBF_Format
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace osm
+{
+using TPbfReadFunc = std::function<size_t(uint8_t *, size_t)>;
+
+// Minimal reader of the protobuf wire format, enough to parse OSM PBF messages
+// without a dependency on libprotobuf. All views point into the source buffer.
+class ProtobufReader
+{
+public:
+  enum class WireType : uint8_t
+  {
+    Varint = 0,
+    Fixed64 = 1,
+    LengthDelimited = 2,
+    Fixed32 = 5
+  };
+
+  ProtobufReader() = default;
+  ProtobufReader(uint8_t const * data, size_t size) : m_pos(data), m_end(data + size) {}
+  explicit ProtobufReader(std::string_view data)
+    : ProtobufReader(reinterpret_cast<uint8_t const *>(data.data()), data.size())
+  {}
+
+  // Moves to the next field. Returns false when the message is over.
+  bool Next();
+
+  uint32_t Field() const { return m_field; }
+  WireType Type() const { return m_type; }
+
+  uint64_t Varint();
+  int64_t SVarint() { return ZigZagDecode(Varint()); }
+  std::string_view Bytes();
+  ProtobufReader Message() { return ProtobufReader(Bytes()); }
+  void Skip();
+
+  // Calls |fn| for every value of a repeated varint field. Handles both packed
+  // and non-packed encodings.
+  template <typename Fn>
+  void ForEachVarint(Fn && fn)
+  {
+    if (m_type != WireType::LengthDelimited)
+    {
+      fn(Varint());
+      return;
+    }
+
+    ProtobufReader packed(Bytes());
+    while (!packed.Empty())
+      fn(packed.ReadVarint());
+  }
+
+  template <typename Fn>
+  void ForEachSVarint(Fn && fn)
+  {
+    ForEachVarint([&fn](uint64_t v) { fn(ZigZagDecode(v)); });
+  }
+
+  bool Empty() const { return m_pos == m_end; }
+
+  static int64_t ZigZagDecode(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+private:
+  uint64_t ReadVarint();
+  void Advance(size_t size);
+
+  uint8_t const * m_pos = nullptr;
+  uint8_t const * m_end = nullptr;
+  uint32_t m_field = 0;
+  WireType m_type = WireType::Varint;
+};
+
+struct PbfBlob
+{
+  enum class Type
+  {
+    Header,
+    Data,
+    Unknown
+  };
+
+  Type m_type = Type::Unknown;
+  // Serialized Blob message, still compressed.
+  std::vector<uint8_t> m_data;
+};
+
+// Reads the next BlobHeader + Blob pair from |reader|. Returns false at the end of the stream.
+bool ReadPbfBlob(TPbfReadFunc const & reader, PbfBlob & blob);
+
+// Decompresses Blob message |data| into |out|.
+void UnpackPbfBlob(std::vector<uint8_t> const & data, std::vector<uint8_t> & out);
+
+// Checks that all required features of OSMHeader are supported.
+void CheckPbfHeader(PbfBlob const & blob);
+
+// Decodes OSMData blob into elements preserving their order in the blob.
+// Thread-safe: may be called concurrently for different blobs.
+void DecodePbfBlob(PbfBlob const & blob, std::vector<OsmElement> & elements);
+}  // namespace osm
@@ -10,6 +10,7 @@
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 
@@ -118,6 +119,19 @@ void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElem
   }
 }
 
+void ProcessOsmElementsFromPbf(SourceReader & stream, std::function<void(OsmElement &&)> const & processor,
+                               size_t threadsCount)
+{
+  ProcessorOsmElementsFromPbf processorOsmElementsFromPbf(stream, threadsCount);
+  OsmElement element;
+  while (processorOsmElementsFromPbf.TryRead(element))
+  {
+    processor(std::move(element));
+    // It is safe to use `element` here as `Clear` will restore the state after the move.
+    element.Clear();
+  }
+}
+
 ProcessorOsmElementsFromO5M::ProcessorOsmElementsFromO5M(SourceReader & stream)
   : m_stream(stream)
   , m_dataset([&](uint8_t * buffer, size_t size) { return m_stream.Read(reinterpret_cast<char *>(buffer), size); })
@@ -182,6 +196,60 @@ bool ProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
   return true;
 }
 
+ProcessorOsmElementsFromPbf::ProcessorOsmElementsFromPbf(SourceReader & stream, size_t threadsCount)
+  : m_stream(stream)
+  // Keep a few blobs per thread in flight, so that decoding threads do not starve
+  // while the consumer is busy, but the memory stays bounded.
+  , m_maxPendingBlobs(4 * std::max<size_t>(threadsCount, 1))
+  , m_threadPool(std::max<size_t>(threadsCount, 1))
+{}
+
+void ProcessorOsmElementsFromPbf::ScheduleBlobs()
+{
+  auto const reader = [this](uint8_t * buffer, size_t size)
+  { return static_cast<size_t>(m_stream.Read(reinterpret_cast<char *>(buffer), size)); };
+
+  while (!m_isEnd && m_pending.size() < m_maxPendingBlobs)
+  {
+    osm::PbfBlob blob;
+    if (!osm::ReadPbfBlob(reader, blob))
+    {
+      m_isEnd = true;
+      break;
+    }
+
+    if (blob.m_type == osm::PbfBlob::Type::Header)
+    {
+      osm::CheckPbfHeader(blob);
+      continue;
+    }
+
+    m_pending.emplace_back(m_threadPool.Submit([blob = std::move(blob)]()
+    {
+      std::vector<OsmElement> elements;
+      osm::DecodePbfBlob(blob, elements);
+      return elements;
+    }));
+  }
+}
+
+bool ProcessorOsmElementsFromPbf::TryRead(OsmElement & element)
+{
+  while (m_current == m_elements.size())
+  {
+    ScheduleBlobs();
+    if (m_pending.empty())
+      return false;
+
+    m_elements = m_pending.front().get();
+    m_pending.pop_front();
+    m_current = 0;
+  }
+
+  element = std::move(m_elements[m_current++]);
+  return true;
+}
+
 ProcessorOsmElementsFromXml::ProcessorOsmElementsFromXml(SourceReader & stream)
   : m_xmlSource([&, this](OsmElement && e) { m_queue.emplace(std::move(e)); })
   , m_parser(stream, m_xmlSource)
@@ -215,7 +283,7 @@ bool ProcessorOsmElementsFromXml::TryRead(OsmElement & element)
 // Generate functions implementations.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool GenerateIntermediateData(feature::GenerateInfo & info)
+bool GenerateIntermediateData(feature::GenerateInfo & info, size_t threadsCount)
 {
   auto nodes = cache::CreatePointStorageWriter(info.m_nodeStorageType, info.GetCacheFileName(NODES_FILE));
   cache::IntermediateDataWriter cache(*nodes, info);
@@ -234,6 +302,7 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
   {
   case feature::GenerateInfo::OsmSourceType::XML: ProcessOsmElementsFromXML(reader, processor); break;
   case feature::GenerateInfo::OsmSourceType::O5M: ProcessOsmElementsFromO5M(reader, processor); break;
+  case feature::GenerateInfo::OsmSourceType::PBF: ProcessOsmElementsFromPbf(reader, processor, threadsCount); break;
   }
 
   cache.SaveIndex();
@@ -3,17 +3,23 @@
 #include "generator/generate_info.hpp"
 #include "generator/intermediate_data.hpp"
 #include "generator/osm_o5m_source.hpp"
+#include "generator/osm_pbf_source.hpp"
 #include "generator/osm_xml_source.hpp"
 #include "generator/translator_interface.hpp"
 
 #include "coding/parse_xml.hpp"
 
+#include "base/thread_pool_computational.hpp"
+
+#include <deque>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <queue>
 #include <sstream>
 #include <string>
+#include <vector>
 
 struct OsmElement;
 class FeatureParams;
@@ -45,10 +51,12 @@ public:
   uint64_t Pos() const { return m_pos; }
 };
 
-bool GenerateIntermediateData(feature::GenerateInfo & info);
+bool GenerateIntermediateData(feature::GenerateInfo & info, size_t threadsCount = 1);
 
 void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElement &&)> const & processor);
 void ProcessOsmElementsFromXML(SourceReader & stream, std::function<void(OsmElement &&)> const & processor);
+void ProcessOsmElementsFromPbf(SourceReader & stream, std::function<void(OsmElement &&)> const & processor,
+                               size_t threadsCount = 1);
 
 class ProcessorOsmElementsInterface
 {
@@ -72,6 +80,29 @@ private:
   osm::O5MSource::Iterator m_pos;
 };
 
+// Reads blobs sequentially and decodes them on the thread pool. Elements are returned
+// in the same order as they are stored in the file.
+class ProcessorOsmElementsFromPbf : public ProcessorOsmElementsInterface
+{
+public:
+  ProcessorOsmElementsFromPbf(SourceReader & stream, size_t threadsCount);
+
+  // ProcessorOsmElementsInterface overrides:
+  bool TryRead(OsmElement & element) override;
+
+private:
+  void ScheduleBlobs();
+
+  SourceReader & m_stream;
+  size_t const m_maxPendingBlobs;
+  bool m_isEnd = false;
+  std::deque<std::future<std::vector<OsmElement>>> m_pending;
+  std::vector<OsmElement> m_elements;
+  size_t m_current = 0;
+  // Declared last, so decoding threads are joined before the other members are destroyed.
+  base::ComputationalThreadPool m_threadPool;
+};
+
 class ProcessorOsmElementsFromXml : public ProcessorOsmElementsInterface
 {
 public:
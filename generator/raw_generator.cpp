@@ -231,6 +231,9 @@ bool RawGenerator::GenerateFilteredFeatures()
   case feature::GenerateInfo::OsmSourceType::XML:
     sourceProcessor = std::make_unique<ProcessorOsmElementsFromXml>(reader);
     break;
+  case feature::GenerateInfo::OsmSourceType::PBF:
+    sourceProcessor = std::make_unique<ProcessorOsmElementsFromPbf>(reader, m_threadsCount);
+    break;
   }
   CHECK(sourceProcessor, ());
 
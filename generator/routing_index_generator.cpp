@@ -42,6 +42,7 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <map>
 #include <memory>
 #include <unordered_map>
@@ -165,7 +166,8 @@ public:
   Segment GetStartSegment() const { return m_start; }
   Segment GetFinishSegment() const { return {}; }
   bool ConvertToReal(Segment const & /* segment */) const { return false; }
-  RouteWeight HeuristicCostEstimate(Segment const & /* from */, ms::LatLon const & /* to */)
+  RouteWeight HeuristicCostEstimate(Segment const & /* from */, Segment const & /* to */,
+                                    ms::LatLon const & /* toPoint */, bool /* toFinish */)
   {
     CHECK(false, ("This method exists only for compatibility with IndexGraphStarterJoints"));
     return GetAStarWeightZero<RouteWeight>();
@@ -185,6 +187,8 @@ public:
 
   RouteWeight GetAStarWeightEpsilon() { return RouteWeight(0.0); }
 
+  bool UseDenseAStarState() const { return false; }
+
   RouteWeight GetCrossBorderPenalty(NumMwmId mwmId1, NumMwmId mwmId2) { return RouteWeight(0); }
   /// @}
 
@@ -470,8 +474,9 @@ void FillWeights(string const & path, string const & mwmFile, string const & cou
       CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
 
   MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
-  uint32_t mwmNumRoads = DeserializeIndexGraphNumRoads(mwmValue, vhType);
-  IndexGraph graph(std::make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmFile, vehicleModel), mwmNumRoads),
+  // Keep all roads of the mwm in memory, every road is used many times while weights are calculated.
+  IndexGraph graph(std::make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmFile, vehicleModel),
+                                              std::numeric_limits<size_t>::max() /* roadsCacheSizeBytes */),
                    EdgeEstimator::Create(vhType, *vehicleModel, nullptr /* trafficStash */, nullptr /* dataSource */,
                                          nullptr /* numMvmIds */));
   graph.SetCurrentTimeGetter([time = GetCurrentTimestamp()] { return time; });
@@ -1,4 +1,5 @@
 #include "generator/search_index_builder.hpp"
+#include "generator/search_index_runs.hpp"
 
 #include "search/common.hpp"
 #include "search/house_to_street_table.hpp"
@@ -124,15 +125,14 @@ class FeatureNameInserter
 {
   String2StringMap const & m_suffixes;
 
-  base::TopStatsCounter<std::string> m_stats;
+  base::TopStatsCounter<std::string> & m_stats;
 
 public:
-  explicit FeatureNameInserter(ContT & keyValuePairs) : m_suffixes(GetDACHStreets()), m_keyValuePairs(keyValuePairs) {}
-  ~FeatureNameInserter()
-  {
-    LOG(LINFO, ("Top street's name tokens:"));
-    m_stats.PrintTop(10);
-  }
+  FeatureNameInserter(ContT & keyValuePairs, base::TopStatsCounter<std::string> & stats)
+    : m_suffixes(GetDACHStreets())
+    , m_stats(stats)
+    , m_keyValuePairs(keyValuePairs)
+  {}
 
   void SetFeature(uint32_t index, SynonymsHolder const * synonyms, bool hasStreetType)
   {
@@ -276,12 +276,12 @@ template <class ContT>
 class FeatureInserter
 {
 public:
-  FeatureInserter(SynonymsHolder * synonyms, ContT & keyValuePairs, CategoriesHolder const & catHolder,
-                  std::pair<int, int> const & scales)
+  FeatureInserter(SynonymsHolder const * synonyms, ContT & keyValuePairs, CategoriesHolder const & catHolder,
+                  std::pair<int, int> const & scales, base::TopStatsCounter<std::string> & stats)
     : m_synonyms(synonyms)
     , m_categories(catHolder)
     , m_scales(scales)
-    , m_inserter(keyValuePairs)
+    , m_inserter(keyValuePairs, stats)
   {}
 
   void operator()(FeatureType & f, uint32_t index)
@@ -352,7 +352,7 @@ public:
   }
 
 private:
-  SynonymsHolder * m_synonyms;
+  SynonymsHolder const * m_synonyms;
 
   CategoriesHolder const & m_categories;
   std::pair<int, int> m_scales;
@@ -361,18 +361,58 @@ private:
   FeatureNameInserter<ContT> m_inserter;
 };
 
-template <class ContT>
-void AddFeatureNameIndexPairs(FeaturesVectorTest const & features, CategoriesHolder const & categoriesHolder,
-                              ContT & keyValuePairs)
+void AddFeatureNameIndexPairs(std::string const & filePath, CategoriesHolder const & categoriesHolder,
+                              std::vector<KeyValueRuns> & runs, uint32_t threadsCount, size_t maxKeyValuePairsBytes)
 {
-  feature::DataHeader const & header = features.GetHeader();
-
+  auto const tmpFilePrefix = filePath + "." + SEARCH_INDEX_FILE_TAG + ".run.";
+  uint32_t featuresCount = 0;
   std::unique_ptr<SynonymsHolder> synonyms;
-  if (header.GetType() == feature::DataHeader::MapType::World)
-    synonyms = std::make_unique<SynonymsHolder>();
+  {
+    FeaturesVectorTest features(filePath);
+    featuresCount = base::checked_cast<uint32_t>(features.GetVector().GetNumFeatures());
+    if (features.GetHeader().GetType() == feature::DataHeader::MapType::World)
+      synonyms = std::make_unique<SynonymsHolder>();
+  }
+
+  for (uint32_t i = 0; i < threadsCount; ++i)
+    runs.emplace_back(tmpFilePrefix + std::to_string(i) + ".", maxKeyValuePairsBytes / threadsCount);
+
+  std::vector<base::TopStatsCounter<std::string>> stats(threadsCount);
+
+  // Thread working function. FeaturesVector is not thread-safe, so every thread reads its own copy.
+  auto const fn = [&](uint32_t threadIdx)
+  {
+    auto const fc = static_cast<uint64_t>(featuresCount);
+    auto const beg = static_cast<uint32_t>(fc * threadIdx / threadsCount);
+    auto const end = static_cast<uint32_t>(fc * (threadIdx + 1) / threadsCount);
+
+    FeaturesVectorTest features(filePath);
+    FeatureInserter inserter(synonyms.get(), runs[threadIdx], categoriesHolder, features.GetHeader().GetScaleRange(),
+                             stats[threadIdx]);
 
-  features.GetVector().ForEach(
-      FeatureInserter(synonyms.get(), keyValuePairs, categoriesHolder, header.GetScaleRange()));
+    // One feature object is reused for all the records.
+    FeatureType ft;
+    for (uint32_t i = beg; i < end; ++i)
+    {
+      features.GetVector().GetByIndex(i, ft);
+      ft.SetID(FeatureID(MwmSet::MwmId(), i));
+      inserter(ft, i);
+    }
+
+    runs[threadIdx].Finish();
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < threadsCount; ++i)
+    threads.emplace_back(fn, i);
+
+  for (auto & t : threads)
+    t.join();
+
+  for (uint32_t i = 1; i < threadsCount; ++i)
+    stats[0].Add(stats[i]);
+  LOG(LINFO, ("Top street's name tokens:"));
+  stats[0].PrintTop(10);
 }
 
 void ReadAddressData(std::string const & filename, std::vector<feature::AddressData> & addrs)
@@ -563,10 +603,11 @@ void BuildAddressTable(FilesContainerR & container, std::string const & addressD
 }
 }  // namespace
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter);
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, uint32_t threadsCount,
+                      size_t maxKeyValuePairsBytes);
 
 bool BuildSearchIndexFromDataFile(std::string const & country, feature::GenerateInfo const & info, bool forceRebuild,
-                                  uint32_t threadsCount)
+                                  uint32_t threadsCount, size_t maxKeyValuePairsBytes)
 {
   Platform & platform = GetPlatform();
 
@@ -586,7 +627,7 @@ bool BuildSearchIndexFromDataFile(std::string const & country, feature::Generate
   {
     {
       FileWriter writer(indexFilePath);
-      BuildSearchIndex(readContainer, writer);
+      BuildSearchIndex(readContainer, writer, threadsCount, maxKeyValuePairsBytes);
       LOG(LINFO, ("Search index size =", writer.Size()));
     }
 
@@ -647,7 +688,8 @@ bool BuildSearchIndexFromDataFile(std::string const & country, feature::Generate
   return true;
 }
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, uint32_t threadsCount,
+                      size_t maxKeyValuePairsBytes)
 {
   using Key = strings::UniString;
   using Value = Uint64IndexValue;
@@ -656,18 +698,16 @@ void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
   base::Timer timer;
 
   auto const & categoriesHolder = GetDefaultCategories();
+  threadsCount = std::max(threadsCount, 1U);
 
-  FeaturesVectorTest features(container);
-  SingleValueSerializer<Value> serializer;
-
-  std::vector<std::pair<Key, Value>> searchIndexKeyValuePairs;
-  AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs);
-
-  std::sort(searchIndexKeyValuePairs.begin(), searchIndexKeyValuePairs.end());
+  std::vector<KeyValueRuns> runs;
+  AddFeatureNameIndexPairs(container.GetFileName(), categoriesHolder, runs, threadsCount, maxKeyValuePairsBytes);
   LOG(LINFO, ("End sorting strings:", timer.ElapsedSeconds()));
 
-  trie::Build<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>(indexWriter, serializer,
-                                                                           searchIndexKeyValuePairs);
+  SingleValueSerializer<Value> serializer;
+  trie::Builder<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>> builder(indexWriter, serializer);
+  MergeRuns(runs, [&builder](Key const & key, Value const & value) { builder.Add(key, value); });
+  builder.Finish();
 
   LOG(LINFO, ("End building search index, elapsed seconds:", timer.ElapsedSeconds()));
 }
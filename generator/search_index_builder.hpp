@@ -1,9 +1,11 @@
 #pragma once
 
 #include "generator/generate_info.hpp"
+#include "generator/search_index_runs.hpp"
 
 #include "indexer/ftypes_matcher.hpp"
 
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -41,6 +43,7 @@ private:
 // An attempt to rewrite the search index of an old mwm may result in a future crash
 // when using search because this function does not update mwm's version. This results
 // in version mismatch when trying to read the index.
+// The key-value pairs of the index above |maxKeyValuePairsBytes| are spilled into temporary files.
 bool BuildSearchIndexFromDataFile(std::string const & country, feature::GenerateInfo const & info, bool forceRebuild,
-                                  uint32_t threadsCount);
+                                  uint32_t threadsCount, size_t maxKeyValuePairsBytes = kMaxKeyValuePairsBytes);
 }  // namespace indexer
@@ -0,0 +1,85 @@
+#include "generator/search_index_runs.hpp"
+
+#include "coding/file_writer.hpp"
+#include "coding/varint.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+
+namespace indexer
+{
+KeyValueRuns::KeyValueRuns(std::string const & tmpFilePrefix, size_t maxBytes)
+  : m_tmpFilePrefix(tmpFilePrefix)
+  , m_maxBytes(maxBytes)
+{
+}
+
+KeyValueRuns::~KeyValueRuns()
+{
+  for (auto const & path : m_runFiles)
+    FileWriter::DeleteFileX(path);
+}
+
+void KeyValueRuns::emplace_back(Key const & key, uint64_t value)
+{
+  m_pairs.emplace_back(key, value);
+  // Upper estimate, short keys are stored inside UniString without an allocation.
+  m_bytes += sizeof(KeyValuePair) + key.size() * sizeof(strings::UniChar);
+  if (m_bytes > m_maxBytes)
+    Spill();
+}
+
+void KeyValueRuns::Finish()
+{
+  std::sort(m_pairs.begin(), m_pairs.end());
+}
+
+void KeyValueRuns::Spill()
+{
+  std::sort(m_pairs.begin(), m_pairs.end());
+
+  m_runFiles.push_back(m_tmpFilePrefix + std::to_string(m_runFiles.size()) + EXTENSION_TMP);
+  FileWriter writer(m_runFiles.back());
+  for (auto const & [key, value] : m_pairs)
+  {
+    WriteVarUint(writer, static_cast<uint32_t>(key.size()));
+    for (auto const c : key)
+      WriteVarUint(writer, c);
+    WriteVarUint(writer, value.m_featureId);
+  }
+
+  m_pairs.clear();
+  m_pairs.shrink_to_fit();
+  m_bytes = 0;
+}
+
+KeyValueRunReader::KeyValueRunReader(std::string const & path)
+  : m_reader(std::make_unique<FileReader>(path))
+  , m_src(std::make_unique<ReaderSource<FileReader>>(*m_reader))
+{
+}
+
+KeyValueRunReader::KeyValueRunReader(std::vector<KeyValuePair> const & pairs) : m_pairs(&pairs) {}
+
+bool KeyValueRunReader::Read(KeyValuePair & pair)
+{
+  if (m_pairs)
+  {
+    if (m_index == m_pairs->size())
+      return false;
+    pair = (*m_pairs)[m_index++];
+    return true;
+  }
+
+  if (m_src->Size() == 0)
+    return false;
+
+  auto const size = ReadVarUint<uint32_t>(*m_src);
+  pair.first.resize(size);
+  for (auto & c : pair.first)
+    c = ReadVarUint<uint32_t>(*m_src);
+  pair.second = Uint64IndexValue(ReadVarUint<uint64_t>(*m_src));
+  return true;
+}
+}  // namespace indexer
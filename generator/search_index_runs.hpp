@@ -0,0 +1,108 @@
+#pragma once
+
+#include "search/search_index_values.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/reader.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace indexer
+{
+// Memory budget for the search index key-value pairs of all the threads by default. The pairs above it
+// are sorted and spilled into the temporary files, which are merged into the trie.
+size_t constexpr kMaxKeyValuePairsBytes = size_t(1) << 30;
+
+// Sorted runs of the search index key-value pairs. The pairs are collected in memory until
+// the buffer exceeds |maxBytes|, then the buffer is sorted and spilled into a temporary file.
+class KeyValueRuns
+{
+public:
+  using Key = strings::UniString;
+  using Value = Uint64IndexValue;
+  using KeyValuePair = std::pair<Key, Value>;
+
+  KeyValueRuns(std::string const & tmpFilePrefix, size_t maxBytes);
+  ~KeyValueRuns();
+
+  KeyValueRuns(KeyValueRuns &&) = default;
+  KeyValueRuns & operator=(KeyValueRuns &&) = default;
+
+  void emplace_back(Key const & key, uint64_t value);
+
+  // Sorts the last run, which is kept in memory.
+  void Finish();
+
+  std::vector<std::string> const & GetRunFiles() const { return m_runFiles; }
+  std::vector<KeyValuePair> const & GetLastRun() const { return m_pairs; }
+
+private:
+  void Spill();
+
+  std::string m_tmpFilePrefix;
+  size_t m_maxBytes;
+  size_t m_bytes = 0;
+  std::vector<KeyValuePair> m_pairs;
+  std::vector<std::string> m_runFiles;
+};
+
+// Sequential reader of one sorted run, either spilled into a file or kept in memory.
+class KeyValueRunReader
+{
+public:
+  using KeyValuePair = KeyValueRuns::KeyValuePair;
+
+  explicit KeyValueRunReader(std::string const & path);
+  explicit KeyValueRunReader(std::vector<KeyValuePair> const & pairs);
+
+  bool Read(KeyValuePair & pair);
+
+private:
+  std::unique_ptr<FileReader> m_reader;
+  std::unique_ptr<ReaderSource<FileReader>> m_src;
+
+  std::vector<KeyValuePair> const * m_pairs = nullptr;
+  size_t m_index = 0;
+};
+
+// Calls |fn| for the key-value pairs of all the |runs| in the sorted order.
+template <class FnT>
+void MergeRuns(std::vector<KeyValueRuns> const & runs, FnT && fn)
+{
+  std::vector<KeyValueRunReader> readers;
+  for (auto const & run : runs)
+  {
+    for (auto const & path : run.GetRunFiles())
+      readers.emplace_back(path);
+    readers.emplace_back(run.GetLastRun());
+  }
+
+  using Item = std::pair<KeyValueRunReader::KeyValuePair, size_t>;
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+
+  Item item;
+  for (size_t i = 0; i < readers.size(); ++i)
+  {
+    if (readers[i].Read(item.first))
+      queue.emplace(std::move(item.first), i);
+  }
+
+  while (!queue.empty())
+  {
+    item = queue.top();
+    queue.pop();
+    fn(item.first.first, item.first.second);
+    if (readers[item.second].Read(item.first))
+      queue.push(std::move(item));
+  }
+}
+}  // namespace indexer
@@ -5,6 +5,7 @@
 #include "generator/translator_interface.hpp"
 
 #include "base/thread_pool_computational.hpp"
+#include "base/thread_pool_work_stealing.hpp"
 #include "base/thread_safe_queue.hpp"
 
 #include <memory>
@@ -21,7 +22,7 @@ public:
   bool Finish();
 
 private:
-  base::ComputationalThreadPool m_threadPool;
+  base::WorkStealingThreadPool m_threadPool;
   threads::ThreadSafeQueue<std::shared_ptr<TranslatorInterface>> m_translators;
 };
 }  // namespace generator
@@ -0,0 +1,118 @@
+#include "testing/testing.hpp"
+
+#include "base/thread.hpp"
+#include "base/thread_pool_work_stealing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace thread_pool_work_stealing_tests
+{
+size_t const kTimes = 100;
+
+UNIT_TEST(WorkStealingThreadPool_SomeThreads)
+{
+  for (size_t t = 0; t < kTimes; ++t)
+  {
+    size_t const threadCount = 4;
+    std::atomic<size_t> counter{0};
+    {
+      base::WorkStealingThreadPool threadPool(threadCount);
+      for (size_t i = 0; i < threadCount; ++i)
+      {
+        threadPool.Submit([&]()
+        {
+          threads::Sleep(1);
+          ++counter;
+        });
+      }
+    }
+
+    TEST_EQUAL(threadCount, counter, ());
+  }
+}
+
+UNIT_TEST(WorkStealingThreadPool_ReturnValue)
+{
+  size_t const taskCount = 1000;
+  base::WorkStealingThreadPool threadPool(4);
+  std::vector<std::future<size_t>> futures;
+  for (size_t i = 0; i < taskCount; ++i)
+    futures.push_back(threadPool.Submit([](size_t i) { return i * i; }, i));
+
+  for (size_t i = 0; i < taskCount; ++i)
+    TEST_EQUAL(futures[i].get(), i * i, ());
+}
+
+UNIT_TEST(WorkStealingThreadPool_ManyTasks)
+{
+  for (size_t t = 0; t < kTimes; ++t)
+  {
+    size_t const taskCount = 10000;
+    std::atomic<size_t> counter{0};
+    {
+      base::WorkStealingThreadPool threadPool(4);
+      for (size_t i = 0; i < taskCount; ++i)
+        threadPool.SubmitWork([&]() { ++counter; });
+    }
+
+    TEST_EQUAL(taskCount, counter, ());
+  }
+}
+
+UNIT_TEST(WorkStealingThreadPool_Stealing)
+{
+  // All tasks are submitted from one worker to its own queue, the others have to steal them.
+  size_t const threadCount = 4;
+  size_t const taskCount = 1000;
+  std::atomic<size_t> counter{0};
+  std::mutex mutex;
+  std::vector<std::thread::id> ids;
+  {
+    base::WorkStealingThreadPool threadPool(threadCount);
+    auto submission = threadPool.Submit([&]()
+    {
+      for (size_t i = 0; i < taskCount; ++i)
+      {
+        threadPool.SubmitWork([&]()
+        {
+          threads::Sleep(1);
+          {
+            std::lock_guard lock(mutex);
+            ids.push_back(std::this_thread::get_id());
+          }
+          ++counter;
+        });
+      }
+    });
+    // Tasks which are submitted after the destructor call are ignored.
+    submission.wait();
+  }
+
+  TEST_EQUAL(counter, taskCount, ());
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  TEST_GREATER(ids.size(), 1, ());
+}
+
+UNIT_TEST(WorkStealingThreadPool_WaitingStop)
+{
+  size_t const taskCount = 1000;
+  std::atomic<size_t> counter{0};
+  base::WorkStealingThreadPool threadPool(4, true /* pinThreads */);
+  for (size_t i = 0; i < taskCount; ++i)
+    threadPool.SubmitWork([&]() { ++counter; });
+
+  threadPool.WaitingStop();
+  TEST_EQUAL(counter, taskCount, ());
+
+  // Tasks are ignored after stop.
+  threadPool.SubmitWork([&]() { ++counter; });
+  TEST(!threadPool.Submit([]() { return 0; }).valid(), ());
+  TEST_EQUAL(counter, taskCount, ());
+}
+}  // namespace thread_pool_work_stealing_tests
@@ -2,6 +2,7 @@
 
 #include "base/thread.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -114,3 +115,11 @@ UNIT_TEST(SimpleThreadTest4)
 
   TEST_EQUAL(a, 1, ("test a"));
 }
+
+UNIT_TEST(GetAvailableCpus)
+{
+  auto const cpus = threads::GetAvailableCpus();
+  TEST(!cpus.empty(), ());
+  TEST(std::is_sorted(cpus.begin(), cpus.end()), (cpus));
+  TEST(std::adjacent_find(cpus.begin(), cpus.end()) == cpus.end(), (cpus));
+}
@@ -84,6 +84,12 @@ class TopStatsCounter
 public:
   void Add(Key const & key) { ++m_data[key]; }
 
+  void Add(TopStatsCounter const & rhs)
+  {
+    for (auto const & p : rhs.m_data)
+      m_data[p.first] += p.second;
+  }
+
   void PrintTop(size_t count) const
   {
     ASSERT(count > 0, ());
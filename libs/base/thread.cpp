@@ -4,9 +4,16 @@
 
 #include "std/target_os.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
 
+#if defined(OMIM_OS_LINUX)
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#endif  // defined(OMIM_OS_LINUX)
+
 #if defined(OMIM_OS_ANDROID)
 void AndroidThreadAttachToJVM();
 void AndroidThreadDetachFromJVM();
@@ -96,6 +103,54 @@ ThreadID GetCurrentThreadID()
   return std::this_thread::get_id();
 }
 
+std::vector<size_t> GetAvailableCpus()
+{
+  std::vector<size_t> cpus;
+#if defined(OMIM_OS_LINUX)
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (sched_getaffinity(0 /* current thread */, sizeof(cpuSet), &cpuSet) == 0)
+  {
+    for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (CPU_ISSET(cpu, &cpuSet))
+        cpus.push_back(cpu);
+    }
+  }
+  else
+  {
+    LOG(LWARNING, ("Can't get the affinity of the current thread, errno:", errno));
+  }
+#endif  // defined(OMIM_OS_LINUX)
+
+  if (cpus.empty())
+  {
+    size_t const cpuCount = std::max(std::thread::hardware_concurrency(), 1U);
+    for (size_t cpu = 0; cpu < cpuCount; ++cpu)
+      cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+bool SetCurrentThreadAffinity(size_t cpu)
+{
+#if defined(OMIM_OS_LINUX)
+  if (cpu >= CPU_SETSIZE)
+    return false;
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(cpu, &cpuSet);
+  int const res = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+  if (res != 0)
+    LOG(LWARNING, ("Can't bind thread to cpu", cpu, "error:", res));
+  return res == 0;
+#else
+  UNUSED_VALUE(cpu);
+  return false;
+#endif  // defined(OMIM_OS_LINUX)
+}
+
 /////////////////////////////////////////////////////////////////////
 // SimpleThread implementation
 
@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace threads
 {
@@ -74,6 +75,14 @@ using ThreadID = std::thread::id;
 
 ThreadID GetCurrentThreadID();
 
+/// \returns cpus the current thread is allowed to run on, e.g. limited by taskset or a cgroup cpuset.
+/// All the cpus up to the hardware concurrency are returned when it's not supported by the platform.
+std::vector<size_t> GetAvailableCpus();
+
+/// Binds the current thread to the |cpu| core.
+/// \returns false if it's not supported by the platform or failed.
+bool SetCurrentThreadAffinity(size_t cpu);
+
 /// A wrapper around a std thread which executes callable object in thread which is attached to JVM
 /// Class has the same interface as std::thread
 class SimpleThread
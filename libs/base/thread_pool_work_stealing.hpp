@@ -0,0 +1,296 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/thread.hpp"
+#include "base/thread_utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace base
+{
+
+// WorkStealingThreadPool has the same interface as ComputationalThreadPool, but it's intended for
+// a lot of small tasks. Every worker has its own queue. Tasks are spread between queues round-robin,
+// a task which is submitted by a worker goes to the queue of this worker. A worker with an empty
+// queue steals a half of tasks of another worker at once. So workers don't fight for one mutex
+// and the mutex of the sleeping workers is touched only when some of them are sleeping.
+// Warning: Tasks are not executed in the order of submission, so a task must not wait for
+// a result of another task of the same pool.
+// Warning: WorkStealingThreadPool works with std::thread instead of SimpleThread and therefore
+// should not be used when the JVM is needed.
+class WorkStealingThreadPool
+{
+public:
+  using FunctionType = threads::FunctionWrapper;
+  using Threads = std::vector<std::thread>;
+
+  // Constructs a ThreadPool.
+  // threadCount - number of threads used by the thread pool.
+  // pinThreads - bind the i-th thread to the i-th of the cpu cores the calling thread may run on (modulo number
+  // of these cores), where it's supported.
+  // Warning: The constructor may throw exceptions.
+  explicit WorkStealingThreadPool(size_t threadCount, bool pinThreads = false) : m_joiner(m_threads)
+  {
+    CHECK_GREATER(threadCount, 0, ());
+
+    m_queues.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i)
+      m_queues.emplace_back(std::make_unique<Queue>());
+
+    std::vector<size_t> cpus;
+    if (pinThreads)
+      cpus = threads::GetAvailableCpus();
+
+    m_threads.reserve(threadCount);
+    try
+    {
+      for (size_t i = 0; i < threadCount; ++i)
+      {
+        size_t const cpu = cpus.empty() ? 0 : cpus[i % cpus.size()];
+        m_threads.emplace_back([this, i, pinThreads, cpu]()
+        {
+          if (pinThreads)
+            threads::SetCurrentThreadAffinity(cpu);
+          Worker(i);
+        });
+      }
+    }
+    catch (...)  // std::system_error etc.
+    {
+      Stop();
+      throw;
+    }
+  }
+
+  // Destroys the ThreadPool.
+  // This function will block until all runnables have been completed.
+  ~WorkStealingThreadPool() { Finish(); }
+
+  // Submit task for execution.
+  // func - task to be performed.
+  // args - arguments for func.
+  // The function will return the object future.
+  // Warning: If the thread pool is stopped then the call will be ignored.
+  template <typename F, typename... Args>
+  auto Submit(F && func, Args &&... args) -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+  {
+    using ResultType = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+    std::packaged_task<ResultType()> task([f = std::forward<F>(func), ... a = std::forward<Args>(args)]() mutable
+    { return std::invoke(std::move(f), std::move(a)...); });
+    std::future<ResultType> result(task.get_future());
+    if (!Push(std::move(task)))
+      return {};
+    return result;
+  }
+
+  // Submit work for execution.
+  // func - task to be performed.
+  // args - arguments for func
+  // Warning: If the thread pool is stopped then the call will be ignored.
+  template <typename F, typename... Args>
+  void SubmitWork(F && func, Args &&... args)
+  {
+    Push([f = std::forward<F>(func), ... a = std::forward<Args>(args)]() mutable
+    { std::invoke(std::move(f), std::move(a)...); });
+  }
+
+  // Stop a ThreadPool.
+  // Removes the tasks that are not yet started from the queues.
+  // Unlike the destructor, this function does not wait for all runnables to complete:
+  // the tasks will stop as soon as possible.
+  void Stop()
+  {
+    m_done = true;
+    for (auto & queue : m_queues)
+    {
+      std::deque<FunctionType> tasks;
+      {
+        std::lock_guard lock(queue->m_mutex);
+        tasks.swap(queue->m_tasks);
+      }
+      m_pending -= static_cast<int64_t>(tasks.size());
+    }
+    WakeUp(true /* all */);
+  }
+
+  void WaitingStop()
+  {
+    Finish();
+    m_joiner.Join();
+  }
+
+private:
+  struct Queue
+  {
+    std::mutex m_mutex;
+    std::deque<FunctionType> m_tasks;
+  };
+
+  struct CurrentWorker
+  {
+    WorkStealingThreadPool const * m_pool = nullptr;
+    size_t m_index = 0;
+  };
+
+  static CurrentWorker & GetCurrentWorker()
+  {
+    thread_local CurrentWorker worker;
+    return worker;
+  }
+
+  bool Push(FunctionType && task)
+  {
+    if (m_done)
+      return false;
+
+    auto const & worker = GetCurrentWorker();
+    size_t const index = worker.m_pool == this
+                           ? worker.m_index
+                           : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+    // The counter is increased before the task is queued, so workers don't finish while the task
+    // is on the way to its queue.
+    ++m_pending;
+    {
+      auto & queue = *m_queues[index];
+      std::lock_guard lock(queue.m_mutex);
+      queue.m_tasks.emplace_back(std::move(task));
+    }
+    WakeUp(false /* all */);
+    return true;
+  }
+
+  void Finish()
+  {
+    m_done = true;
+    WakeUp(true /* all */);
+  }
+
+  void WakeUp(bool all)
+  {
+    if (m_sleeping == 0 && !all)
+      return;
+
+    // Taking of the mutex guarantees that a worker which is going to sleep either sees the new
+    // state or is already waiting for the notification.
+    {
+      std::lock_guard lock(m_mutex);
+    }
+    if (all)
+      m_condition.notify_all();
+    else
+      m_condition.notify_one();
+  }
+
+  bool Pop(size_t index, FunctionType & task)
+  {
+    auto & queue = *m_queues[index];
+    std::lock_guard lock(queue.m_mutex);
+    if (queue.m_tasks.empty())
+      return false;
+
+    task = std::move(queue.m_tasks.front());
+    queue.m_tasks.pop_front();
+    --m_pending;
+    return true;
+  }
+
+  // Takes a half of tasks from the back of another queue. The first of them is returned
+  // and the rest go to the queue of the worker.
+  bool Steal(size_t index, FunctionType & task)
+  {
+    std::vector<FunctionType> stolen;
+    for (size_t i = 1; i < m_queues.size() && stolen.empty(); ++i)
+    {
+      auto & victim = *m_queues[(index + i) % m_queues.size()];
+      std::lock_guard lock(victim.m_mutex);
+      size_t const count = (victim.m_tasks.size() + 1) / 2;
+      for (size_t j = 0; j < count; ++j)
+      {
+        stolen.emplace_back(std::move(victim.m_tasks.back()));
+        victim.m_tasks.pop_back();
+      }
+    }
+
+    if (stolen.empty())
+      return false;
+
+    task = std::move(stolen.back());
+    stolen.pop_back();
+    --m_pending;
+
+    if (!stolen.empty())
+    {
+      auto & queue = *m_queues[index];
+      std::lock_guard lock(queue.m_mutex);
+      // Stolen tasks were taken from the back, restore their order.
+      for (auto it = stolen.rbegin(); it != stolen.rend(); ++it)
+        queue.m_tasks.emplace_back(std::move(*it));
+    }
+    return true;
+  }
+
+  void Worker(size_t index)
+  {
+    GetCurrentWorker() = {this, index};
+
+    size_t idleRounds = 0;
+    while (true)
+    {
+      FunctionType task;
+      if (Pop(index, task) || Steal(index, task))
+      {
+        idleRounds = 0;
+        task();
+        continue;
+      }
+
+      // Tiny tasks are submitted faster than a worker falls asleep and wakes up, so look for
+      // a task a little bit more before sleeping.
+      if (idleRounds++ < kIdleRoundsBeforeSleep)
+      {
+        std::this_thread::yield();
+        continue;
+      }
+      idleRounds = 0;
+
+      std::unique_lock lock(m_mutex);
+      ++m_sleeping;
+      m_condition.wait(lock, [&] { return m_done || m_pending > 0; });
+      --m_sleeping;
+
+      if (m_done && m_pending <= 0)
+        return;
+    }
+  }
+
+  static size_t constexpr kIdleRoundsBeforeSleep = 16;
+
+  std::atomic<bool> m_done = false;
+  // Number of tasks which are submitted and not taken by workers yet.
+  std::atomic<int64_t> m_pending = 0;
+  std::atomic<size_t> m_sleeping = 0;
+  std::atomic<size_t> m_nextQueue = 0;
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+
+  Threads m_threads;
+  threads::ThreadsJoiner<> m_joiner;
+};
+
+}  // namespace base
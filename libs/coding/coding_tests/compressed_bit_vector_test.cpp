@@ -1,12 +1,15 @@
 #include "testing/testing.hpp"
 
 #include "coding/compressed_bit_vector.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/write_to_sink.hpp"
 #include "coding/writer.hpp"
 
 #include <algorithm>
 #include <cstdint>
 #include <iterator>
 #include <memory>
+#include <random>
 #include <set>
 #include <vector>
 
@@ -81,6 +84,48 @@ void CheckUnion(vector<uint64_t> & setBits1, coding::CompressedBitVector::Storag
   TEST_EQUAL(resultStrategy, cbv3->GetStorageStrategy(), ());
   CheckUnion(setBits1, setBits2, *cbv3);
 }
+using Strategy = coding::CompressedBitVector::StorageStrategy;
+
+unique_ptr<coding::CompressedBitVector> Build(vector<uint64_t> const & setBits, Strategy strategy)
+{
+  switch (strategy)
+  {
+  case Strategy::Dense: return make_unique<coding::DenseCBV>(setBits);
+  case Strategy::Sparse: return make_unique<coding::SparseCBV>(setBits);
+  case Strategy::Roaring: return make_unique<coding::RoaringCBV>(setBits);
+  }
+  UNREACHABLE();
+}
+
+// Sorted set bits with chunks of all the roaring container types: chunk 0 is dense,
+// chunk 1 is sparse, chunk 2 consists of runs, chunks 3 and 4 are empty and chunk 5 has a few bits.
+vector<uint64_t> GenerateSetBits(uint32_t seed)
+{
+  mt19937 rng(seed);
+  uint64_t constexpr kChunkSize = coding::RoaringCBV::kChunkSize;
+  uniform_int_distribution<uint32_t> percent(0, 99);
+  vector<uint64_t> setBits;
+  for (uint64_t i = 0; i < kChunkSize; ++i)
+    if (percent(rng) < 50)
+      setBits.push_back(i);
+  for (uint64_t i = kChunkSize; i < 2 * kChunkSize; ++i)
+    if (percent(rng) == 0)
+      setBits.push_back(i);
+  for (uint64_t i = 2 * kChunkSize; i < 3 * kChunkSize; ++i)
+    if ((i / 1000) % 2 == seed % 2)
+      setBits.push_back(i);
+  for (uint64_t i = 5 * kChunkSize; i < 6 * kChunkSize; i += 1000 + seed)
+    setBits.push_back(i);
+  return setBits;
+}
+
+void CheckSetBits(coding::CompressedBitVector const & cbv, vector<uint64_t> const & expected)
+{
+  vector<uint64_t> actual;
+  coding::CompressedBitVectorEnumerator::ForEach(cbv, [&actual](uint64_t pos) { actual.push_back(pos); });
+  TEST_EQUAL(cbv.PopCount(), expected.size(), ());
+  TEST(actual == expected, (DebugPrint(cbv.GetStorageStrategy())));
+}
 }  // namespace
 
 UNIT_TEST(CompressedBitVector_Intersect1)
@@ -455,4 +500,154 @@ UNIT_TEST(CompressedBitVector_SparseLeaveFirstNBits)
   for (uint64_t bit = 0; bit < (1 << 10); ++bit)
     TEST(!cbv->GetBit(bit), (bit));
 }
+
+UNIT_TEST(RoaringCBV_Containers)
+{
+  using ContainerType = coding::RoaringCBV::ContainerType;
+
+  auto const setBits = GenerateSetBits(0 /* seed */);
+  coding::RoaringCBV const cbv(setBits);
+  TEST_EQUAL(cbv.NumContainers(), 4, ());
+  TEST_EQUAL(cbv.GetContainer(0).m_type, ContainerType::Bitmap, ());
+  TEST_EQUAL(cbv.GetContainer(1).m_type, ContainerType::Array, ());
+  TEST_EQUAL(cbv.GetContainer(2).m_type, ContainerType::Run, ());
+  TEST_EQUAL(cbv.GetContainer(3).m_key, 5, ());
+  CheckSetBits(cbv, setBits);
+
+  set<uint64_t> const bits(setBits.begin(), setBits.end());
+  for (uint64_t i = 0; i < 7 * coding::RoaringCBV::kChunkSize; ++i)
+    TEST_EQUAL(cbv.GetBit(i), bits.count(i) != 0, (i));
+}
+
+UNIT_TEST(RoaringCBV_BinaryOps)
+{
+  auto setBits1 = GenerateSetBits(1 /* seed */);
+  auto setBits2 = GenerateSetBits(2 /* seed */);
+
+  vector<uint64_t> intersection;
+  Intersect(setBits1, setBits2, intersection);
+  vector<uint64_t> subtraction;
+  Subtract(setBits1, setBits2, subtraction);
+  vector<uint64_t> unification;
+  Union(setBits1, setBits2, unification);
+
+  for (auto const strategy1 : {Strategy::Dense, Strategy::Sparse, Strategy::Roaring})
+  {
+    for (auto const strategy2 : {Strategy::Dense, Strategy::Sparse, Strategy::Roaring})
+    {
+      auto const cbv1 = Build(setBits1, strategy1);
+      auto const cbv2 = Build(setBits2, strategy2);
+
+      TEST_EQUAL(coding::CompressedBitVector::IntersectionPopCount(*cbv1, *cbv2), intersection.size(),
+                 (strategy1, strategy2));
+
+      if (strategy1 != Strategy::Roaring && strategy2 != Strategy::Roaring)
+        continue;
+
+      auto const intersectionCBV = coding::CompressedBitVector::Intersect(*cbv1, *cbv2);
+      TEST_EQUAL(intersectionCBV->GetStorageStrategy(), Strategy::Roaring, ());
+      CheckSetBits(*intersectionCBV, intersection);
+      CheckSetBits(*coding::CompressedBitVector::Subtract(*cbv1, *cbv2), subtraction);
+      CheckSetBits(*coding::CompressedBitVector::Union(*cbv1, *cbv2), unification);
+    }
+  }
+
+  coding::RoaringCBV const cbv2(setBits2);
+  coding::RoaringCBV intersectionCBV(setBits1);
+  intersectionCBV.IntersectWith(cbv2);
+  CheckSetBits(intersectionCBV, intersection);
+
+  coding::RoaringCBV subtractionCBV(setBits1);
+  subtractionCBV.SubtractWith(cbv2);
+  CheckSetBits(subtractionCBV, subtraction);
+
+  coding::RoaringCBV unionCBV(setBits1);
+  unionCBV.UnionWith(cbv2);
+  CheckSetBits(unionCBV, unification);
+
+  unionCBV.RunOptimize();
+  CheckSetBits(unionCBV, unification);
+}
+
+UNIT_TEST(RoaringCBV_Serialization)
+{
+  auto const setBits = GenerateSetBits(3 /* seed */);
+  vector<uint8_t> buf;
+  {
+    MemWriter<vector<uint8_t>> writer(buf);
+    coding::RoaringCBV(setBits).Serialize(writer);
+  }
+  MemReader reader(buf.data(), buf.size());
+  auto cbv = coding::CompressedBitVectorBuilder::DeserializeFromReader(reader);
+  TEST(cbv.get(), ());
+  TEST_EQUAL(cbv->GetStorageStrategy(), Strategy::Roaring, ());
+  CheckSetBits(*cbv, setBits);
+}
+
+UNIT_TEST(RoaringCBV_CorruptedContainers)
+{
+  using ContainerType = coding::RoaringCBV::ContainerType;
+  auto const deserialize = [](uint64_t key, ContainerType type, auto const & data)
+  {
+    vector<uint8_t> buf;
+    {
+      MemWriter<vector<uint8_t>> writer(buf);
+      WriteToSink(writer, static_cast<uint8_t>(Strategy::Roaring));
+      WriteToSink(writer, uint32_t{1});
+      WriteToSink(writer, key);
+      WriteToSink(writer, static_cast<uint8_t>(type));
+      rw::WriteVectorOfPOD(writer, data);
+    }
+    MemReader reader(buf.data(), buf.size());
+    return coding::CompressedBitVectorBuilder::DeserializeFromReader(reader);
+  };
+
+  TEST(deserialize(1, ContainerType::Bitmap, vector<uint64_t>(coding::RoaringCBV::kBitmapWords, 1)), ());
+  TEST_ANY_THROW(deserialize(1, ContainerType::Bitmap, vector<uint64_t>(3, 1)), ());
+  TEST_ANY_THROW(deserialize(1, ContainerType::Run, vector<uint16_t>{1, 2, 3}), ());
+  TEST_ANY_THROW(deserialize(1, ContainerType::Run, vector<uint16_t>{65000, 1000}), ());
+  TEST_ANY_THROW(deserialize(1, static_cast<ContainerType>(7), vector<uint16_t>{1}), ());
+}
+
+UNIT_TEST(RoaringCBV_LeaveFirstNBits)
+{
+  auto const setBits = GenerateSetBits(4 /* seed */);
+  coding::RoaringCBV const cbv(setBits);
+  for (size_t n : {size_t(0), size_t(1), size_t(100), setBits.size() / 2, setBits.size() - 1, setBits.size()})
+  {
+    auto const first = cbv.LeaveFirstSetNBits(n);
+    TEST_EQUAL(first->GetStorageStrategy(), Strategy::Roaring, ());
+    CheckSetBits(*first, vector<uint64_t>(setBits.begin(), setBits.begin() + n));
+  }
+}
+
+UNIT_TEST(CompressedBitVector_IntersectStrategies)
+{
+  // Typical search case: a large set of features is intersected with the features of the tokens.
+  uint64_t constexpr kNumBits = 4 * coding::RoaringCBV::kChunkSize;
+
+  mt19937 rng(0);
+  uniform_int_distribution<uint32_t> percent(0, 99);
+  vector<uint64_t> setBits1;
+  vector<uint64_t> setBits2;
+  for (uint64_t i = 0; i < kNumBits; ++i)
+  {
+    if (percent(rng) < 40)
+      setBits1.push_back(i);
+    if (percent(rng) < 5)
+      setBits2.push_back(i);
+  }
+
+  vector<uint64_t> expected;
+  Intersect(setBits1, setBits2, expected);
+  for (auto const strategy : {Strategy::Dense, Strategy::Sparse, Strategy::Roaring})
+  {
+    auto const cbv1 = Build(setBits1, strategy);
+    auto const cbv2 = Build(setBits2, strategy);
+
+    auto const intersection = coding::CompressedBitVector::Intersect(*cbv1, *cbv2);
+    CheckSetBits(*intersection, expected);
+    TEST_EQUAL(coding::CompressedBitVector::IntersectionPopCount(*cbv1, *cbv2), expected.size(), (strategy));
+  }
+}
 }  // namespace compressed_bit_vector_test
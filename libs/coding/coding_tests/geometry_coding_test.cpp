@@ -14,8 +14,11 @@
 
 #include "base/logging.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <random>
+#include <utility>
 #include <vector>
 
 namespace geometry_coding_test
@@ -196,4 +199,74 @@ UNIT_TEST(DecodeEncodePolyline_DataSet1)
 
   TestPolylineEncode("DataSet1", points, GetMaxPoint(), &EncodePolyline, &DecodePolyline);
 }
+
+UNIT_TEST(DecodeBatch_SameAsDecode)
+{
+  mt19937 rng(0);
+  // Walks of 100 steps from the random points stay within the bounds.
+  uint32_t constexpr kMargin = 1 << 20;
+  uniform_int_distribution<uint32_t> coord(kMargin, GetMaxPoint().x - kMargin);
+  uniform_int_distribution<int32_t> step(-1000, 1000);
+
+  vector<m2::PointU> points;
+  points.push_back(m2::PointU(coord(rng), coord(rng)));
+  for (size_t i = 1; i < 10000; ++i)
+  {
+    // Mostly short steps as in the real geometry with a rare jump.
+    if (i % 100 == 0)
+      points.push_back(m2::PointU(coord(rng), coord(rng)));
+    else
+      points.push_back(points.back() + m2::PointU(step(rng), step(rng)));
+  }
+
+  m2::PointU const basePoint = points[points.size() / 2];
+  m2::PointU const maxPoint = GetMaxPoint();
+
+  using EncodeFnT = void (*)(InPointsT const &, m2::PointU const &, m2::PointU const &, OutDeltasT &);
+  using DecodeFnT = void (*)(InDeltasT const &, m2::PointU const &, m2::PointU const &, OutPointsT &);
+  using BatchFnT = uint8_t const * (*)(uint8_t const *, size_t, DeltasEncoding, m2::PointU const &,
+                                       m2::PointU const &, uint8_t, m2::PointD *);
+  auto const test = [&](string const & name, EncodeFnT encode, DecodeFnT decode, BatchFnT batch)
+  {
+    vector<uint64_t> deltas(points.size());
+    OutDeltasT deltasA(deltas);
+    encode(make_read_adapter(points), basePoint, maxPoint, deltasA);
+
+    vector<m2::PointU> decoded(deltas.size());
+    OutPointsT decodedA(decoded);
+    decode(make_read_adapter(deltas), basePoint, maxPoint, decodedA);
+    vector<m2::PointD> expected;
+    for (auto const & pt : decoded)
+      expected.push_back(PointUToPointD(pt, kPointCoordBits));
+
+    // Odd and even counts to check the last incomplete group of GroupVarInt.
+    for (size_t const count : {points.size(), points.size() - 1})
+    {
+      vector<uint8_t> varInts;
+      vector<uint8_t> groupVarInts;
+      {
+        MemWriter<vector<uint8_t>> writer(varInts);
+        for (size_t i = 0; i < count; ++i)
+          WriteVarUint(writer, deltas[i]);
+      }
+      {
+        MemWriter<vector<uint8_t>> writer(groupVarInts);
+        WriteGroupVarIntDeltas(vector<uint64_t>(deltas.begin(), deltas.begin() + count), writer);
+      }
+      TEST_EQUAL(CountVarInts(varInts.data(), varInts.data() + varInts.size()), count, ());
+
+      for (auto const & [encoding, data] :
+           {make_pair(DeltasEncoding::VarInt, &varInts), make_pair(DeltasEncoding::GroupVarInt, &groupVarInts)})
+      {
+        vector<m2::PointD> actual(count);
+        TEST_EQUAL(batch(data->data(), count, encoding, basePoint, maxPoint, kPointCoordBits, actual.data()),
+                   data->data() + data->size(), (name, encoding, count));
+        TEST(equal(actual.begin(), actual.end(), expected.begin()), (name, encoding, count));
+      }
+    }
+  };
+
+  test("Polyline", &EncodePolyline, &DecodePolyline, &DecodePolylineBatch);
+  test("TriangleStrip", &EncodeTriangleStrip, &DecodeTriangleStrip, &DecodeTriangleStripBatch);
+}
 }  // namespace geometry_coding_test
@@ -42,27 +42,71 @@ UNIT_TEST(SaveLoadPolyline_DataSet1)
 
   vector<m2::PointD> data1(arr1, arr1 + ARRAY_SIZE(arr1));
 
-  vector<char> buffer;
-  PushBackByteSink<vector<char>> w(buffer);
+  for (auto const encoding : {coding::DeltasEncoding::VarInt, coding::DeltasEncoding::GroupVarInt})
+  {
+    vector<char> buffer;
+    PushBackByteSink<vector<char>> w(buffer);
 
-  serial::GeometryCodingParams cp;
-  serial::SaveOuterPath(data1, cp, w);
+    serial::GeometryCodingParams cp;
+    cp.SetDeltasEncoding(encoding);
+    serial::SaveOuterPath(data1, cp, w);
 
-  vector<m2::PointD> data2;
-  ArrayByteSource r(&buffer[0]);
-  serial::LoadOuterPath(r, cp, data2);
+    vector<m2::PointD> data2;
+    ArrayByteSource r(&buffer[0]);
+    serial::LoadOuterPath(r, cp, data2);
+    TEST_EQUAL(r.PtrUint8(), reinterpret_cast<uint8_t const *>(buffer.data() + buffer.size()), (encoding));
 
-  TEST_EQUAL(data1.size(), data2.size(), ());
+    TEST_EQUAL(data1.size(), data2.size(), (encoding));
 
-  m2::RectD r1, r2;
-  for (size_t i = 0; i < data1.size(); ++i)
-  {
-    r1.Add(data1[i]);
-    r2.Add(data2[i]);
+    m2::RectD r1, r2;
+    for (size_t i = 0; i < data1.size(); ++i)
+    {
+      r1.Add(data1[i]);
+      r2.Add(data2[i]);
+
+      TEST(IsEqual(data1[i], data2[i]), (encoding, data1[i], data2[i]));
+    }
 
-    TEST(IsEqual(data1[i], data2[i]), (data1[i], data2[i]));
+    TEST(IsEqual(r1, r2), (encoding, r1, r2));
   }
+}
 
-  TEST(IsEqual(r1, r2), (r1, r2));
+UNIT_TEST(SaveLoadInner_DeltasEncodings)
+{
+  using namespace geometry_coding_tests;
+
+  // Odd and even counts to check the last incomplete group of GroupVarInt.
+  for (size_t const count : {size_t(3), size_t(4), size_t(5), ARRAY_SIZE(arr1)})
+  {
+    vector<m2::PointD> const points(arr1, arr1 + count);
+    vector<serial::OutPointsT> paths;
+    vector<serial::OutPointsT> strips;
+    for (auto const encoding : {coding::DeltasEncoding::VarInt, coding::DeltasEncoding::GroupVarInt})
+    {
+      serial::GeometryCodingParams cp(kPointCoordBits, points[count / 2]);
+      cp.SetDeltasEncoding(encoding);
+
+      vector<uint8_t> buffer;
+      PushBackByteSink<vector<uint8_t>> w(buffer);
+      serial::SaveInnerPath(points, cp, w);
+      size_t const pathSize = buffer.size();
+      serial::SaveInnerTriangles(points, cp, w);
+
+      paths.emplace_back();
+      auto const * pathEnd = serial::LoadInnerPath(buffer.data(), count, cp, paths.back());
+      TEST_EQUAL(pathEnd, static_cast<void const *>(buffer.data() + pathSize), (encoding, count));
+
+      strips.emplace_back();
+      auto const * stripEnd = serial::LoadInnerTriangles(pathEnd, count, cp, strips.back());
+      TEST_EQUAL(stripEnd, static_cast<void const *>(buffer.data() + buffer.size()), (encoding, count));
+
+      TEST_EQUAL(paths.back().size(), count, (encoding));
+      for (size_t i = 0; i < count; ++i)
+        TEST(IsEqual(points[i], paths.back()[i]), (encoding, points[i], paths.back()[i]));
+    }
+
+    TEST_EQUAL(paths[0], paths[1], (count));
+    TEST_EQUAL(strips[0], strips[1], (count));
+  }
 }
 }  // namespace geometry_serialization_test
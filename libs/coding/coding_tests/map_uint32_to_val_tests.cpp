@@ -105,4 +105,51 @@ UNIT_TEST(MapUint32Val_Smoke)
     }
   }
 }
+
+UNIT_TEST(MapUint32Val_Batch)
+{
+  BufferT buffer;
+  {
+    BuilderT builder;
+    // Every third id has a value.
+    for (uint32_t id = 0; id < 1000; id += 3)
+      builder.Put(id, id * 2);
+
+    MemWriter writer(buffer);
+    builder.Freeze(writer, [](Writer & w, BuilderT::Iter begin, BuilderT::Iter end)
+    {
+      for (auto it = begin; it != end; ++it)
+        WriteVarUint(w, *it);
+    }, 16 /* blockSize */);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  size_t blocksRead = 0;
+  auto table = MapT::Load(reader, [&blocksRead](NonOwningReaderSource & source, uint32_t blockSize, ValuesT & values)
+  {
+    ++blocksRead;
+    while (source.Size() > 0 && values.size() < blockSize)
+      values.push_back(ReadVarUint<uint32_t>(source));
+  });
+  TEST(table.get(), ());
+
+  // Unsorted ids with duplicates, ids without values and ids out of the table.
+  ValuesT const ids = {999, 3, 4, 0, 3, 501, 5000, 48, 45, 2};
+  vector<bool> found(ids.size(), false);
+  table->GetThreadsafe(ids, [&](size_t i, uint32_t value)
+  {
+    TEST(!found[i], (i));
+    found[i] = true;
+    TEST_EQUAL(value, ids[i] * 2, (i));
+  });
+
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    uint32_t value;
+    TEST_EQUAL(found[i], table->GetThreadsafe(ids[i], value), (i));
+  }
+
+  // Blocks of 999, {3, 0, 3, 45}, 501 and 48 are read by the batch call, seven ids one by one.
+  TEST_EQUAL(blocksRead, 4 + 7, ());
+}
 }  // namespace map_uint32_tests
@@ -1,11 +1,17 @@
 #include "testing/testing.hpp"
 
+#include "coding/file_writer.hpp"
+#include "coding/files_container.hpp"
 #include "coding/reader.hpp"
 #include "coding/reader_cache.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/scope_guard.hpp"
 
 #include <algorithm>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace reader_cache_test
@@ -49,4 +55,117 @@ UNIT_TEST(CacheReaderRandomTest)
     TEST_EQUAL(readMem, readCache, (pos, len, i));
   }
 }
+
+UNIT_TEST(CacheReaderBudgetTest)
+{
+  vector<char> data(100000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+  MemReader memReader(&data[0], data.size());
+
+  auto & registry = reader_cache::Registry::Instance();
+  uint64_t const usedBefore = registry.GetUsedBytes();
+  uint64_t const budgetBefore = registry.GetBudget();
+  registry.SetBudget(usedBefore + 4 * 1024);
+  SCOPE_GUARD(restoreBudget, [&]() { registry.SetBudget(budgetBefore); });
+
+  reader_cache::Counters counters;
+  {
+    // 32 pages of 1 KB are requested, only 4 of them get memory.
+    ReaderCache<MemReader const> cache(10 /* logPageSize */, 5 /* logPageCount */, true /* useBudget */);
+    mt19937 rng(0);
+    for (size_t i = 0; i < 10000; ++i)
+    {
+      size_t const pos = rng() % data.size();
+      size_t const len = min(static_cast<size_t>(1 + (rng() % 2000)), data.size() - pos);
+      string expected(len, '0'), actual(len, '0');
+      memReader.Read(pos, &expected[0], len);
+      cache.Read(memReader, pos, &actual[0], len, &counters);
+      TEST_EQUAL(expected, actual, (pos, len, i));
+    }
+
+    TEST_EQUAL(cache.GetAllocatedBytes(), 4 * 1024, ());
+    TEST_EQUAL(registry.GetUsedBytes(), usedBefore + 4 * 1024, ());
+  }
+  TEST_EQUAL(registry.GetUsedBytes(), usedBefore, ());
+
+  auto const stats = counters.Get();
+  TEST_EQUAL(stats.m_reads, 10000, ());
+  TEST_GREATER(stats.m_hits, 0, ());
+  TEST_GREATER(stats.m_uncached, 0, ());
+}
+
+UNIT_TEST(FileReaderSectionStatsTest)
+{
+  string const fileName = "reader_cache_sections.tmp";
+  SCOPE_GUARD(deleteFile, [&]() { FileWriter::DeleteFileX(fileName); });
+  {
+    FilesContainerW writer(fileName);
+    for (string const tag : {"geom", "offs"})
+    {
+      auto w = writer.GetWriter(tag);
+      for (uint32_t i = 0; i < 10000; ++i)
+        WriteToSink(*w, i);
+    }
+  }
+
+  auto & registry = reader_cache::Registry::Instance();
+  registry.SetPolicy("geom", {12 /* logPageSize */, 2 /* logPageCount */});
+  SCOPE_GUARD(clearPolicies, [&]() { registry.ClearPolicies(); });
+  registry.ResetStats();
+
+  {
+    FilesContainerR cont(fileName);
+    for (string const tag : {"geom", "offs"})
+    {
+      auto const reader = cont.GetReader(tag);
+      for (uint32_t i = 0; i < 10000; ++i)
+        TEST_EQUAL(ReadPrimitiveFromPos<uint32_t>(reader, i * sizeof(uint32_t)), i, ());
+    }
+  }
+
+  auto const stats = registry.GetStats();
+  auto const geom = stats.find({fileName, "geom"});
+  auto const offs = stats.find({fileName, "offs"});
+  TEST(geom != stats.cend(), ());
+  TEST(offs != stats.cend(), ());
+  TEST_EQUAL(geom->second.m_reads, 10000, ());
+  TEST_EQUAL(offs->second.m_reads, 10000, ());
+  // 4 KB pages of the geometry section are read 4 times less often than 1 KB pages.
+  TEST_LESS(geom->second.m_misses * 3, offs->second.m_misses, ());
+}
+UNIT_TEST(RegistryCountersTest)
+{
+  string const fileName = "reader_cache_registry.tmp";
+  auto & registry = reader_cache::Registry::Instance();
+  registry.ResetStats();
+
+  // Statistics of destroyed readers are kept after their counters are collected.
+  for (size_t i = 0; i < 1000; ++i)
+    registry.CreateCounters(fileName, "finished")->OnRead(10);
+
+  // Copies of a reader share the counters and may be used by different threads.
+  auto const shared = registry.CreateCounters(fileName, "shared");
+  vector<thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&shared]()
+    {
+      for (size_t j = 0; j < 10000; ++j)
+        shared->OnRead(1);
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  auto const stats = registry.GetStats();
+  auto const finished = stats.find({fileName, "finished"});
+  auto const sharedStats = stats.find({fileName, "shared"});
+  TEST(finished != stats.cend(), ());
+  TEST(sharedStats != stats.cend(), ());
+  TEST_EQUAL(finished->second.m_reads, 1000, ());
+  TEST_EQUAL(finished->second.m_bytesRequested, 10000, ());
+  TEST_EQUAL(sharedStats->second.m_reads, 40000, ());
+  TEST_EQUAL(sharedStats->second.m_bytesRequested, 40000, ());
+}
 }  // namespace reader_cache_test
@@ -3,16 +3,454 @@
 #include "coding/write_to_sink.hpp"
 
 #include "base/assert.hpp"
+#include "base/checked_cast.hpp"
 
 #include <algorithm>
 #include <bit>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace coding
 {
 using std::make_unique, std::max, std::min, std::unique_ptr, std::vector;
 
 namespace
 {
+using Container = RoaringCBV::Container;
+using ContainerType = RoaringCBV::ContainerType;
+
+enum class BitmapOp
+{
+  And,
+  Or,
+  AndNot
+};
+
+// Applies |op| to the bitmaps of the roaring containers word by word and stores the result in |lhs|.
+// SSE2 and NEON are always available on x86-64 and arm64, so there is no runtime dispatch.
+template <BitmapOp op>
+void ApplyBitmapOp(uint64_t * lhs, uint64_t const * rhs)
+{
+  static_assert(RoaringCBV::kBitmapWords % 2 == 0);
+#if defined(__SSE2__)
+  for (size_t i = 0; i < RoaringCBV::kBitmapWords; i += 2)
+  {
+    __m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const *>(lhs + i));
+    __m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(rhs + i));
+    __m128i res;
+    if constexpr (op == BitmapOp::And)
+      res = _mm_and_si128(a, b);
+    else if constexpr (op == BitmapOp::Or)
+      res = _mm_or_si128(a, b);
+    else
+      res = _mm_andnot_si128(b, a);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lhs + i), res);
+  }
+#elif defined(__ARM_NEON)
+  for (size_t i = 0; i < RoaringCBV::kBitmapWords; i += 2)
+  {
+    uint64x2_t const a = vld1q_u64(lhs + i);
+    uint64x2_t const b = vld1q_u64(rhs + i);
+    uint64x2_t res;
+    if constexpr (op == BitmapOp::And)
+      res = vandq_u64(a, b);
+    else if constexpr (op == BitmapOp::Or)
+      res = vorrq_u64(a, b);
+    else
+      res = vbicq_u64(a, b);
+    vst1q_u64(lhs + i, res);
+  }
+#else
+  for (size_t i = 0; i < RoaringCBV::kBitmapWords; ++i)
+  {
+    if constexpr (op == BitmapOp::And)
+      lhs[i] &= rhs[i];
+    else if constexpr (op == BitmapOp::Or)
+      lhs[i] |= rhs[i];
+    else
+      lhs[i] &= ~rhs[i];
+  }
+#endif
+}
+
+uint32_t BitmapPopCount(uint64_t const * bitmap)
+{
+  uint32_t res = 0;
+  for (size_t i = 0; i < RoaringCBV::kBitmapWords; ++i)
+    res += std::popcount(bitmap[i]);
+  return res;
+}
+
+uint32_t AndPopCount(uint64_t const * lhs, uint64_t const * rhs)
+{
+  uint32_t res = 0;
+  for (size_t i = 0; i < RoaringCBV::kBitmapWords; ++i)
+    res += std::popcount(lhs[i] & rhs[i]);
+  return res;
+}
+
+void SetBit(std::vector<uint64_t> & bitmap, uint16_t v)
+{
+  bitmap[v / 64] |= static_cast<uint64_t>(1) << (v % 64);
+}
+
+void ResetBit(std::vector<uint64_t> & bitmap, uint16_t v)
+{
+  bitmap[v / 64] &= ~(static_cast<uint64_t>(1) << (v % 64));
+}
+
+// Calls |fn| for the low bits of the set bits of |c| while |fn| returns true.
+template <typename Fn>
+void ForEachValue(Container const & c, Fn && fn)
+{
+  switch (c.m_type)
+  {
+  case ContainerType::Array:
+    for (auto const v : c.m_values)
+      if (!fn(v))
+        return;
+    return;
+  case ContainerType::Bitmap:
+    for (size_t i = 0; i < c.m_bitmap.size(); ++i)
+    {
+      for (uint64_t word = c.m_bitmap[i]; word != 0; word &= word - 1)
+        if (!fn(static_cast<uint16_t>(i * 64 + std::countr_zero(word))))
+          return;
+    }
+    return;
+  case ContainerType::Run:
+    for (size_t i = 0; i < c.m_values.size(); i += 2)
+    {
+      for (uint32_t v = c.m_values[i]; v <= uint32_t{c.m_values[i]} + c.m_values[i + 1]; ++v)
+        if (!fn(static_cast<uint16_t>(v)))
+          return;
+    }
+    return;
+  }
+}
+
+bool Contains(Container const & c, uint16_t v)
+{
+  switch (c.m_type)
+  {
+  case ContainerType::Array: return std::binary_search(c.m_values.begin(), c.m_values.end(), v);
+  case ContainerType::Bitmap: return ((c.m_bitmap[v / 64] >> (v % 64)) & 1) > 0;
+  case ContainerType::Run:
+  {
+    // Finds the last run which starts not after |v|.
+    size_t lo = 0;
+    size_t hi = c.m_values.size() / 2;
+    while (lo < hi)
+    {
+      size_t const mid = (lo + hi) / 2;
+      if (c.m_values[2 * mid] <= v)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return lo != 0 && v <= uint32_t{c.m_values[2 * (lo - 1)]} + c.m_values[2 * (lo - 1) + 1];
+  }
+  }
+  UNREACHABLE();
+}
+
+void UpdatePopCount(Container & c)
+{
+  switch (c.m_type)
+  {
+  case ContainerType::Array: c.m_popCount = static_cast<uint32_t>(c.m_values.size()); return;
+  case ContainerType::Bitmap: c.m_popCount = BitmapPopCount(c.m_bitmap.data()); return;
+  case ContainerType::Run:
+    c.m_popCount = 0;
+    for (size_t i = 0; i < c.m_values.size(); i += 2)
+      c.m_popCount += uint32_t{c.m_values[i + 1]} + 1;
+    return;
+  }
+}
+
+void ToBitmap(Container & c)
+{
+  if (c.m_type == ContainerType::Bitmap)
+    return;
+
+  std::vector<uint64_t> bitmap(RoaringCBV::kBitmapWords, 0);
+  ForEachValue(c, [&bitmap](uint16_t v)
+  {
+    SetBit(bitmap, v);
+    return true;
+  });
+  c.m_type = ContainerType::Bitmap;
+  c.m_bitmap = std::move(bitmap);
+  c.m_values = {};
+}
+
+void ToArray(Container & c)
+{
+  if (c.m_type == ContainerType::Array)
+    return;
+
+  std::vector<uint16_t> values;
+  values.reserve(c.m_popCount);
+  ForEachValue(c, [&values](uint16_t v)
+  {
+    values.push_back(v);
+    return true;
+  });
+  c.m_type = ContainerType::Array;
+  c.m_values = std::move(values);
+  c.m_bitmap = {};
+}
+
+void ToRuns(Container & c)
+{
+  std::vector<uint16_t> runs;
+  ForEachValue(c, [&runs](uint16_t v)
+  {
+    if (!runs.empty() && uint32_t{runs[runs.size() - 2]} + runs.back() + 1 == v)
+    {
+      ++runs.back();
+    }
+    else
+    {
+      runs.push_back(v);
+      runs.push_back(0);
+    }
+    return true;
+  });
+  c.m_type = ContainerType::Run;
+  c.m_values = std::move(runs);
+  c.m_bitmap = {};
+}
+
+// Chooses an array or a bitmap by the number of the set bits. Runs are unpacked too.
+void Normalize(Container & c)
+{
+  if (c.m_popCount > RoaringCBV::kMaxArraySize)
+    ToBitmap(c);
+  else
+    ToArray(c);
+}
+
+// Chooses the most compact container type.
+void Optimize(Container & c)
+{
+  Normalize(c);
+
+  size_t runs = 0;
+  if (c.m_type == ContainerType::Array)
+  {
+    for (size_t i = 0; i < c.m_values.size(); ++i)
+      runs += (i == 0 || c.m_values[i] != c.m_values[i - 1] + 1) ? 1 : 0;
+  }
+  else
+  {
+    // A run starts at a set bit whose previous bit is not set.
+    uint64_t carry = 0;
+    for (auto const word : c.m_bitmap)
+    {
+      runs += std::popcount(word & ~((word << 1) | carry));
+      carry = word >> 63;
+    }
+  }
+
+  // Sizes in 16-bit words.
+  size_t const size = c.m_type == ContainerType::Array ? c.m_values.size() : RoaringCBV::kBitmapWords * 4;
+  if (2 * runs < size)
+    ToRuns(c);
+}
+
+// Returns |c| or its copy unpacked to an array or a bitmap.
+Container const & Unpacked(Container const & c, Container & buffer)
+{
+  if (c.m_type != ContainerType::Run)
+    return c;
+  buffer = c;
+  Normalize(buffer);
+  return buffer;
+}
+
+void IntersectContainers(Container & a, Container const & rhs)
+{
+  Container buffer;
+  auto const & b = Unpacked(rhs, buffer);
+  if (a.m_type == ContainerType::Run)
+    Normalize(a);
+
+  if (a.m_type == ContainerType::Array && b.m_type == ContainerType::Array)
+  {
+    size_t k = 0;
+    for (size_t i = 0, j = 0; i < a.m_values.size() && j < b.m_values.size();)
+    {
+      if (a.m_values[i] < b.m_values[j])
+      {
+        ++i;
+      }
+      else if (b.m_values[j] < a.m_values[i])
+      {
+        ++j;
+      }
+      else
+      {
+        a.m_values[k++] = a.m_values[i];
+        ++i;
+        ++j;
+      }
+    }
+    a.m_values.resize(k);
+  }
+  else if (a.m_type == ContainerType::Array)
+  {
+    std::erase_if(a.m_values, [&b](uint16_t v) { return !Contains(b, v); });
+  }
+  else if (b.m_type == ContainerType::Array)
+  {
+    std::vector<uint16_t> values;
+    std::copy_if(b.m_values.begin(), b.m_values.end(), std::back_inserter(values),
+                 [&a](uint16_t v) { return Contains(a, v); });
+    a.m_type = ContainerType::Array;
+    a.m_values = std::move(values);
+    a.m_bitmap = {};
+  }
+  else
+  {
+    ApplyBitmapOp<BitmapOp::And>(a.m_bitmap.data(), b.m_bitmap.data());
+  }
+
+  UpdatePopCount(a);
+  Normalize(a);
+}
+
+void UniteContainers(Container & a, Container const & rhs)
+{
+  Container buffer;
+  auto const & b = Unpacked(rhs, buffer);
+  if (a.m_type == ContainerType::Run)
+    Normalize(a);
+
+  if (a.m_type == ContainerType::Array && b.m_type == ContainerType::Array)
+  {
+    std::vector<uint16_t> values;
+    values.reserve(a.m_values.size() + b.m_values.size());
+    std::set_union(a.m_values.begin(), a.m_values.end(), b.m_values.begin(), b.m_values.end(),
+                   std::back_inserter(values));
+    a.m_values = std::move(values);
+  }
+  else if (a.m_type == ContainerType::Array)
+  {
+    std::vector<uint64_t> bitmap = b.m_bitmap;
+    for (auto const v : a.m_values)
+      SetBit(bitmap, v);
+    a.m_type = ContainerType::Bitmap;
+    a.m_bitmap = std::move(bitmap);
+    a.m_values = {};
+  }
+  else if (b.m_type == ContainerType::Array)
+  {
+    for (auto const v : b.m_values)
+      SetBit(a.m_bitmap, v);
+  }
+  else
+  {
+    ApplyBitmapOp<BitmapOp::Or>(a.m_bitmap.data(), b.m_bitmap.data());
+  }
+
+  UpdatePopCount(a);
+  Normalize(a);
+}
+
+void SubtractContainers(Container & a, Container const & rhs)
+{
+  Container buffer;
+  auto const & b = Unpacked(rhs, buffer);
+  if (a.m_type == ContainerType::Run)
+    Normalize(a);
+
+  if (a.m_type == ContainerType::Array)
+  {
+    std::erase_if(a.m_values, [&b](uint16_t v) { return Contains(b, v); });
+  }
+  else if (b.m_type == ContainerType::Array)
+  {
+    for (auto const v : b.m_values)
+      ResetBit(a.m_bitmap, v);
+  }
+  else
+  {
+    ApplyBitmapOp<BitmapOp::AndNot>(a.m_bitmap.data(), b.m_bitmap.data());
+  }
+
+  UpdatePopCount(a);
+  Normalize(a);
+}
+
+uint32_t IntersectionPopCount(Container const & a, Container const & b)
+{
+  uint32_t res = 0;
+  if (a.m_type == ContainerType::Array && b.m_type == ContainerType::Array)
+  {
+    for (size_t i = 0, j = 0; i < a.m_values.size() && j < b.m_values.size();)
+    {
+      if (a.m_values[i] < b.m_values[j])
+      {
+        ++i;
+      }
+      else if (b.m_values[j] < a.m_values[i])
+      {
+        ++j;
+      }
+      else
+      {
+        ++res;
+        ++i;
+        ++j;
+      }
+    }
+    return res;
+  }
+
+  if (a.m_type == ContainerType::Bitmap && b.m_type == ContainerType::Bitmap)
+    return AndPopCount(a.m_bitmap.data(), b.m_bitmap.data());
+
+  // Looks up the values of the container with fewer set bits in the other one.
+  auto const & smaller = a.m_popCount <= b.m_popCount ? a : b;
+  auto const & other = a.m_popCount <= b.m_popCount ? b : a;
+  ForEachValue(smaller, [&](uint16_t v)
+  {
+    res += Contains(other, v) ? 1 : 0;
+    return true;
+  });
+  return res;
+}
+
+template <typename It>
+std::vector<Container> BuildContainers(It begin, It end)
+{
+  std::vector<Container> containers;
+  for (auto it = begin; it != end;)
+  {
+    Container c;
+    c.m_key = *it >> RoaringCBV::kChunkBits;
+    for (; it != end && (*it >> RoaringCBV::kChunkBits) == c.m_key; ++it)
+      c.m_values.push_back(static_cast<uint16_t>(*it & (RoaringCBV::kChunkSize - 1)));
+    UpdatePopCount(c);
+    Optimize(c);
+    containers.push_back(std::move(c));
+  }
+  return containers;
+}
+
+RoaringCBV const & ToRoaring(CompressedBitVector const & cbv, unique_ptr<RoaringCBV> & buffer)
+{
+  if (cbv.GetStorageStrategy() == CompressedBitVector::StorageStrategy::Roaring)
+    return static_cast<RoaringCBV const &>(cbv);
+  buffer = RoaringCBV::BuildFromCBV(cbv);
+  return *buffer;
+}
+
 struct IntersectOp
 {
   IntersectOp() {}
@@ -51,6 +489,64 @@ struct IntersectOp
     set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
     return make_unique<coding::SparseCBV>(std::move(resPos));
   }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::RoaringCBV const & a, coding::RoaringCBV const & b) const
+  {
+    // Only the containers of the smaller bit vector may remain.
+    bool const aIsSmaller = a.NumContainers() <= b.NumContainers();
+    auto res = make_unique<coding::RoaringCBV>(aIsSmaller ? a : b);
+    res->IntersectWith(aIsSmaller ? b : a);
+    return res;
+  }
+};
+
+struct IntersectionPopCountOp
+{
+  IntersectionPopCountOp() {}
+
+  uint64_t operator()(coding::DenseCBV const & a, coding::DenseCBV const & b) const
+  {
+    uint64_t res = 0;
+    size_t const size = min(a.NumBitGroups(), b.NumBitGroups());
+    for (size_t i = 0; i < size; ++i)
+      res += std::popcount(a.GetBitGroup(i) & b.GetBitGroup(i));
+    return res;
+  }
+
+  uint64_t operator()(coding::DenseCBV const & a, coding::SparseCBV const & b) const
+  {
+    return static_cast<uint64_t>(count_if(b.Begin(), b.End(), [&a](uint64_t bit) { return a.GetBit(bit); }));
+  }
+
+  uint64_t operator()(coding::SparseCBV const & a, coding::DenseCBV const & b) const { return operator()(b, a); }
+
+  uint64_t operator()(coding::SparseCBV const & a, coding::SparseCBV const & b) const
+  {
+    uint64_t res = 0;
+    for (auto i = a.Begin(), j = b.Begin(); i != a.End() && j != b.End();)
+    {
+      if (*i < *j)
+      {
+        ++i;
+      }
+      else if (*j < *i)
+      {
+        ++j;
+      }
+      else
+      {
+        ++res;
+        ++i;
+        ++j;
+      }
+    }
+    return res;
+  }
+
+  uint64_t operator()(coding::RoaringCBV const & a, coding::RoaringCBV const & b) const
+  {
+    return a.IntersectionPopCount(b);
+  }
 };
 
 struct SubtractOp
@@ -107,6 +603,13 @@ struct SubtractOp
     set_difference(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
     return CompressedBitVectorBuilder::FromBitPositions(std::move(resPos));
   }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::RoaringCBV const & a, coding::RoaringCBV const & b) const
+  {
+    auto res = make_unique<coding::RoaringCBV>(a);
+    res->SubtractWith(b);
+    return res;
+  }
 };
 
 struct UnionOp
@@ -192,15 +695,31 @@ struct UnionOp
     set_union(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
     return CompressedBitVectorBuilder::FromBitPositions(std::move(resPos));
   }
+
+  unique_ptr<coding::CompressedBitVector> operator()(coding::RoaringCBV const & a, coding::RoaringCBV const & b) const
+  {
+    // The containers of the larger bit vector are reused.
+    bool const aIsLarger = a.NumContainers() >= b.NumContainers();
+    auto res = make_unique<coding::RoaringCBV>(aIsLarger ? a : b);
+    res->UnionWith(aIsLarger ? b : a);
+    return res;
+  }
 };
 
 template <typename TBinaryOp>
-unique_ptr<coding::CompressedBitVector> Apply(TBinaryOp const & op, CompressedBitVector const & lhs,
-                                              CompressedBitVector const & rhs)
+auto Apply(TBinaryOp const & op, CompressedBitVector const & lhs, CompressedBitVector const & rhs)
+    -> decltype(op(std::declval<DenseCBV const &>(), std::declval<DenseCBV const &>()))
 {
   using strat = CompressedBitVector::StorageStrategy;
   auto const stratA = lhs.GetStorageStrategy();
   auto const stratB = rhs.GetStorageStrategy();
+  if (stratA == strat::Roaring || stratB == strat::Roaring)
+  {
+    // Operations with a roaring bit vector are done in the roaring representation.
+    unique_ptr<RoaringCBV> bufferA;
+    unique_ptr<RoaringCBV> bufferB;
+    return op(ToRoaring(lhs, bufferA), ToRoaring(rhs, bufferB));
+  }
   if (stratA == strat::Dense && stratB == strat::Dense)
   {
     DenseCBV const & a = static_cast<DenseCBV const &>(lhs);
@@ -226,7 +745,7 @@ unique_ptr<coding::CompressedBitVector> Apply(TBinaryOp const & op, CompressedBi
     return op(a, b);
   }
 
-  return nullptr;
+  return {};
 }
 
 // Returns true if a bit vector with popCount bits set out of totalBits
@@ -397,6 +916,304 @@ unique_ptr<CompressedBitVector> SparseCBV::Clone() const
   return make_unique<SparseCBV>(m_positions);
 }
 
+RoaringCBV::RoaringCBV(vector<uint64_t> const & setBits) : m_containers(BuildContainers(setBits.begin(), setBits.end()))
+{
+  ASSERT(is_sorted(setBits.begin(), setBits.end()), ());
+  UpdatePopCount(false /* updateContainers */);
+}
+
+// static
+unique_ptr<RoaringCBV> RoaringCBV::BuildFromBitGroups(vector<uint64_t> const & bitGroups)
+{
+  auto cbv = make_unique<RoaringCBV>();
+  for (size_t begin = 0; begin < bitGroups.size(); begin += kBitmapWords)
+  {
+    Container c;
+    c.m_key = begin / kBitmapWords;
+    c.m_type = ContainerType::Bitmap;
+    c.m_bitmap.assign(kBitmapWords, 0);
+    std::copy(bitGroups.begin() + begin, bitGroups.begin() + min(bitGroups.size(), begin + kBitmapWords),
+              c.m_bitmap.begin());
+    coding::UpdatePopCount(c);
+    if (c.m_popCount == 0)
+      continue;
+    Optimize(c);
+    cbv->m_containers.push_back(std::move(c));
+  }
+  cbv->UpdatePopCount(false /* updateContainers */);
+  return cbv;
+}
+
+// static
+unique_ptr<RoaringCBV> RoaringCBV::BuildFromCBV(CompressedBitVector const & cbv)
+{
+  switch (cbv.GetStorageStrategy())
+  {
+  case StorageStrategy::Dense: return BuildFromBitGroups(static_cast<DenseCBV const &>(cbv).m_bitGroups);
+  case StorageStrategy::Sparse:
+  {
+    auto const & sparse = static_cast<SparseCBV const &>(cbv);
+    auto res = make_unique<RoaringCBV>();
+    res->m_containers = BuildContainers(sparse.Begin(), sparse.End());
+    res->UpdatePopCount(false /* updateContainers */);
+    return res;
+  }
+  case StorageStrategy::Roaring: return make_unique<RoaringCBV>(static_cast<RoaringCBV const &>(cbv));
+  }
+  UNREACHABLE();
+}
+
+void RoaringCBV::IntersectWith(RoaringCBV const & rhs)
+{
+  size_t k = 0;
+  size_t j = 0;
+  for (size_t i = 0; i < m_containers.size() && j < rhs.m_containers.size(); ++i)
+  {
+    auto & c = m_containers[i];
+    while (j < rhs.m_containers.size() && rhs.m_containers[j].m_key < c.m_key)
+      ++j;
+    if (j == rhs.m_containers.size() || rhs.m_containers[j].m_key != c.m_key)
+      continue;
+
+    IntersectContainers(c, rhs.m_containers[j]);
+    if (c.m_popCount == 0)
+      continue;
+    if (k != i)
+      m_containers[k] = std::move(c);
+    ++k;
+  }
+  m_containers.resize(k);
+  UpdatePopCount(false /* updateContainers */);
+}
+
+void RoaringCBV::UnionWith(RoaringCBV const & rhs)
+{
+  vector<Container> res;
+  res.reserve(m_containers.size() + rhs.m_containers.size());
+  size_t i = 0;
+  size_t j = 0;
+  while (i < m_containers.size() || j < rhs.m_containers.size())
+  {
+    if (j == rhs.m_containers.size() ||
+        (i < m_containers.size() && m_containers[i].m_key < rhs.m_containers[j].m_key))
+    {
+      res.push_back(std::move(m_containers[i++]));
+    }
+    else if (i == m_containers.size() || rhs.m_containers[j].m_key < m_containers[i].m_key)
+    {
+      res.push_back(rhs.m_containers[j++]);
+    }
+    else
+    {
+      UniteContainers(m_containers[i], rhs.m_containers[j++]);
+      res.push_back(std::move(m_containers[i++]));
+    }
+  }
+  m_containers = std::move(res);
+  UpdatePopCount(false /* updateContainers */);
+}
+
+void RoaringCBV::SubtractWith(RoaringCBV const & rhs)
+{
+  size_t k = 0;
+  size_t j = 0;
+  for (size_t i = 0; i < m_containers.size(); ++i)
+  {
+    auto & c = m_containers[i];
+    while (j < rhs.m_containers.size() && rhs.m_containers[j].m_key < c.m_key)
+      ++j;
+    if (j < rhs.m_containers.size() && rhs.m_containers[j].m_key == c.m_key)
+    {
+      SubtractContainers(c, rhs.m_containers[j]);
+      if (c.m_popCount == 0)
+        continue;
+    }
+    if (k != i)
+      m_containers[k] = std::move(c);
+    ++k;
+  }
+  m_containers.resize(k);
+  UpdatePopCount(false /* updateContainers */);
+}
+
+uint64_t RoaringCBV::IntersectionPopCount(RoaringCBV const & rhs) const
+{
+  uint64_t res = 0;
+  for (size_t i = 0, j = 0; i < m_containers.size() && j < rhs.m_containers.size();)
+  {
+    if (m_containers[i].m_key < rhs.m_containers[j].m_key)
+    {
+      ++i;
+    }
+    else if (rhs.m_containers[j].m_key < m_containers[i].m_key)
+    {
+      ++j;
+    }
+    else
+    {
+      res += coding::IntersectionPopCount(m_containers[i], rhs.m_containers[j]);
+      ++i;
+      ++j;
+    }
+  }
+  return res;
+}
+
+uint64_t RoaringCBV::IntersectionPopCount(DenseCBV const & rhs) const
+{
+  uint64_t res = 0;
+  for (auto const & c : m_containers)
+  {
+    size_t const firstGroup = static_cast<size_t>(c.m_key * kBitmapWords);
+    if (firstGroup >= rhs.NumBitGroups())
+      break;
+
+    if (c.m_type == ContainerType::Bitmap)
+    {
+      for (size_t i = 0; i < kBitmapWords; ++i)
+        res += std::popcount(c.m_bitmap[i] & rhs.GetBitGroup(firstGroup + i));
+      continue;
+    }
+
+    ForEachValue(c, [&](uint16_t v)
+    {
+      res += (rhs.GetBitGroup(firstGroup + v / 64) >> (v % 64)) & 1;
+      return true;
+    });
+  }
+  return res;
+}
+
+uint64_t RoaringCBV::IntersectionPopCount(SparseCBV const & rhs) const
+{
+  uint64_t res = 0;
+  size_t i = 0;
+  for (auto it = rhs.Begin(); it != rhs.End() && i < m_containers.size(); ++it)
+  {
+    uint64_t const key = *it >> kChunkBits;
+    while (i < m_containers.size() && m_containers[i].m_key < key)
+      ++i;
+    if (i < m_containers.size() && m_containers[i].m_key == key &&
+        Contains(m_containers[i], static_cast<uint16_t>(*it & (kChunkSize - 1))))
+    {
+      ++res;
+    }
+  }
+  return res;
+}
+
+void RoaringCBV::RunOptimize()
+{
+  for (auto & c : m_containers)
+    Optimize(c);
+}
+
+uint64_t RoaringCBV::PopCount() const
+{
+  return m_popCount;
+}
+
+bool RoaringCBV::GetBit(uint64_t pos) const
+{
+  uint64_t const key = pos >> kChunkBits;
+  auto const it = std::lower_bound(m_containers.begin(), m_containers.end(), key,
+                                   [](Container const & c, uint64_t key) { return c.m_key < key; });
+  return it != m_containers.end() && it->m_key == key && Contains(*it, static_cast<uint16_t>(pos & (kChunkSize - 1)));
+}
+
+unique_ptr<CompressedBitVector> RoaringCBV::LeaveFirstSetNBits(uint64_t n) const
+{
+  if (PopCount() <= n)
+    return Clone();
+
+  auto cbv = make_unique<RoaringCBV>();
+  for (size_t i = 0; i < m_containers.size() && n != 0; ++i)
+  {
+    auto const & c = m_containers[i];
+    if (c.m_popCount <= n)
+    {
+      cbv->m_containers.push_back(c);
+      n -= c.m_popCount;
+      continue;
+    }
+
+    Container part;
+    part.m_key = c.m_key;
+    ForEachValue(c, [&part, n](uint16_t v)
+    {
+      part.m_values.push_back(v);
+      return part.m_values.size() < n;
+    });
+    coding::UpdatePopCount(part);
+    Optimize(part);
+    cbv->m_containers.push_back(std::move(part));
+    n = 0;
+  }
+  cbv->UpdatePopCount(false /* updateContainers */);
+  return cbv;
+}
+
+CompressedBitVector::StorageStrategy RoaringCBV::GetStorageStrategy() const
+{
+  return CompressedBitVector::StorageStrategy::Roaring;
+}
+
+void RoaringCBV::Serialize(Writer & writer) const
+{
+  uint8_t header = static_cast<uint8_t>(GetStorageStrategy());
+  WriteToSink(writer, header);
+  WriteToSink(writer, base::checked_cast<uint32_t>(m_containers.size()));
+  for (auto const & c : m_containers)
+  {
+    WriteToSink(writer, c.m_key);
+    WriteToSink(writer, static_cast<uint8_t>(c.m_type));
+    if (c.m_type == ContainerType::Bitmap)
+      rw::WriteVectorOfPOD(writer, c.m_bitmap);
+    else
+      rw::WriteVectorOfPOD(writer, c.m_values);
+  }
+}
+
+unique_ptr<CompressedBitVector> RoaringCBV::Clone() const
+{
+  return make_unique<RoaringCBV>(*this);
+}
+
+void RoaringCBV::CheckContainers() const
+{
+  for (size_t i = 0; i < m_containers.size(); ++i)
+  {
+    auto const & c = m_containers[i];
+    if (i != 0 && c.m_key <= m_containers[i - 1].m_key)
+      MYTHROW(Reader::ReadException, ("Unsorted roaring containers", c.m_key));
+
+    bool isValid = false;
+    switch (c.m_type)
+    {
+    case ContainerType::Array: isValid = c.m_values.size() <= kChunkSize; break;
+    case ContainerType::Bitmap: isValid = c.m_bitmap.size() == kBitmapWords; break;
+    case ContainerType::Run:
+      isValid = c.m_values.size() % 2 == 0;
+      for (size_t j = 0; isValid && j < c.m_values.size(); j += 2)
+        isValid = uint32_t{c.m_values[j]} + c.m_values[j + 1] < kChunkSize;
+      break;
+    }
+    if (!isValid)
+      MYTHROW(Reader::ReadException, ("Corrupted roaring container", c.m_key, static_cast<uint32_t>(c.m_type)));
+  }
+}
+
+void RoaringCBV::UpdatePopCount(bool updateContainers)
+{
+  m_popCount = 0;
+  for (auto & c : m_containers)
+  {
+    if (updateContainers)
+      coding::UpdatePopCount(c);
+    m_popCount += c.m_popCount;
+  }
+}
+
 // static
 unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitPositions(vector<uint64_t> const & setBits)
 {
@@ -443,6 +1260,18 @@ std::string DebugPrint(CompressedBitVector::StorageStrategy strat)
   {
   case CompressedBitVector::StorageStrategy::Dense: return "Dense";
   case CompressedBitVector::StorageStrategy::Sparse: return "Sparse";
+  case CompressedBitVector::StorageStrategy::Roaring: return "Roaring";
+  }
+  UNREACHABLE();
+}
+
+std::string DebugPrint(RoaringCBV::ContainerType type)
+{
+  switch (type)
+  {
+  case RoaringCBV::ContainerType::Array: return "Array";
+  case RoaringCBV::ContainerType::Bitmap: return "Bitmap";
+  case RoaringCBV::ContainerType::Run: return "Run";
   }
   UNREACHABLE();
 }
@@ -471,6 +1300,29 @@ unique_ptr<CompressedBitVector> CompressedBitVector::Union(CompressedBitVector c
   return Apply(op, lhs, rhs);
 }
 
+// static
+uint64_t CompressedBitVector::IntersectionPopCount(CompressedBitVector const & lhs, CompressedBitVector const & rhs)
+{
+  // The other operand of a roaring bit vector is not converted to the roaring representation.
+  using strat = StorageStrategy;
+  bool const lhsIsRoaring = lhs.GetStorageStrategy() == strat::Roaring;
+  if (lhsIsRoaring || rhs.GetStorageStrategy() == strat::Roaring)
+  {
+    auto const & roaring = static_cast<RoaringCBV const &>(lhsIsRoaring ? lhs : rhs);
+    auto const & other = lhsIsRoaring ? rhs : lhs;
+    switch (other.GetStorageStrategy())
+    {
+    case strat::Dense: return roaring.IntersectionPopCount(static_cast<DenseCBV const &>(other));
+    case strat::Sparse: return roaring.IntersectionPopCount(static_cast<SparseCBV const &>(other));
+    case strat::Roaring: return roaring.IntersectionPopCount(static_cast<RoaringCBV const &>(other));
+    }
+    UNREACHABLE();
+  }
+
+  static IntersectionPopCountOp const op;
+  return Apply(op, lhs, rhs);
+}
+
 // static
 bool CompressedBitVector::IsEmpty(unique_ptr<CompressedBitVector> const & cbv)
 {
@@ -7,6 +7,8 @@
 #include "base/control_flow.hpp"
 #include "base/ref_counted.hpp"
 
+#include <bit>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -19,7 +21,8 @@ public:
   enum class StorageStrategy
   {
     Dense,
-    Sparse
+    Sparse,
+    Roaring
   };
 
   virtual ~CompressedBitVector() = default;
@@ -46,6 +49,10 @@ public:
   // Unites two bit vectors.
   static std::unique_ptr<CompressedBitVector> Union(CompressedBitVector const & lhs, CompressedBitVector const & rhs);
 
+  // Returns the number of set bits in the intersection of two bit vectors
+  // without building the intersection itself.
+  static uint64_t IntersectionPopCount(CompressedBitVector const & lhs, CompressedBitVector const & rhs);
+
   static bool IsEmpty(std::unique_ptr<CompressedBitVector> const & cbv);
 
   static bool IsEmpty(CompressedBitVector const * cbv);
@@ -66,7 +73,7 @@ public:
 
   // Writes the contents of a bit vector to writer.
   // The first byte is always the header that defines the format.
-  // Currently the header is 0 or 1 for Dense and Sparse strategies respectively.
+  // Currently the header is 0, 1 or 2 for Dense, Sparse and Roaring strategies respectively.
   // It is easier to dispatch via virtual method calls and not bother
   // with template TWriters here as we do in similar places in our code.
   // This should not pose too much a problem because commonly
@@ -85,6 +92,7 @@ class DenseCBV : public CompressedBitVector
 {
 public:
   friend class CompressedBitVectorBuilder;
+  friend class RoaringCBV;
   static uint64_t const kBlockSize = 64;
 
   DenseCBV() = default;
@@ -171,6 +179,136 @@ private:
   std::vector<uint64_t> m_positions;
 };
 
+// A bit vector split into chunks of 2^16 bits, every non-empty chunk is stored in the most compact
+// of three containers: a sorted array of the set bits, a bitmap or a list of runs of the set bits
+// (see Chambi et al, "Better bitmap performance with Roaring bitmaps").
+// Operations are done chunk by chunk, bitmaps are processed by SIMD instructions.
+class RoaringCBV : public CompressedBitVector
+{
+public:
+  static uint32_t constexpr kChunkBits = 16;
+  static uint32_t constexpr kChunkSize = 1 << kChunkBits;
+  static uint32_t constexpr kBitmapWords = kChunkSize / 64;
+  // Chunks with more set bits are stored as bitmaps, because they are smaller than arrays.
+  static uint32_t constexpr kMaxArraySize = kChunkSize / 16;
+
+  enum class ContainerType : uint8_t
+  {
+    Array,
+    Bitmap,
+    Run
+  };
+
+  struct Container
+  {
+    // Position of the first bit of the chunk divided by kChunkSize.
+    uint64_t m_key = 0;
+    ContainerType m_type = ContainerType::Array;
+    uint32_t m_popCount = 0;
+    // Sorted low bits of the set bits for Array, pairs of the first bit and the length minus one
+    // of the runs for Run.
+    std::vector<uint16_t> m_values;
+    // kBitmapWords words for Bitmap.
+    std::vector<uint64_t> m_bitmap;
+  };
+
+  RoaringCBV() = default;
+  RoaringCBV(RoaringCBV const & rhs) : m_containers(rhs.m_containers), m_popCount(rhs.m_popCount) {}
+
+  // Builds a roaring CBV from a sorted list of positions of set bits.
+  explicit RoaringCBV(std::vector<uint64_t> const & setBits);
+
+  static std::unique_ptr<RoaringCBV> BuildFromBitGroups(std::vector<uint64_t> const & bitGroups);
+  static std::unique_ptr<RoaringCBV> BuildFromCBV(CompressedBitVector const & cbv);
+
+  // In-place operations, which reuse the memory of the current bit vector.
+  void IntersectWith(RoaringCBV const & rhs);
+  void UnionWith(RoaringCBV const & rhs);
+  void SubtractWith(RoaringCBV const & rhs);
+
+  // Counting does not convert |rhs| and does not allocate.
+  uint64_t IntersectionPopCount(RoaringCBV const & rhs) const;
+  uint64_t IntersectionPopCount(DenseCBV const & rhs) const;
+  uint64_t IntersectionPopCount(SparseCBV const & rhs) const;
+
+  // Converts the containers to runs where runs are more compact.
+  void RunOptimize();
+
+  size_t NumContainers() const { return m_containers.size(); }
+  Container const & GetContainer(size_t i) const { return m_containers[i]; }
+
+  template <typename Fn>
+  void ForEach(Fn && f) const
+  {
+    base::ControlFlowWrapper<Fn> wrapper(std::forward<Fn>(f));
+    for (auto const & c : m_containers)
+    {
+      uint64_t const offset = c.m_key << kChunkBits;
+      switch (c.m_type)
+      {
+      case ContainerType::Array:
+        for (auto const v : c.m_values)
+          if (wrapper(offset + v) == base::ControlFlow::Break)
+            return;
+        break;
+      case ContainerType::Bitmap:
+        for (size_t i = 0; i < c.m_bitmap.size(); ++i)
+        {
+          for (uint64_t word = c.m_bitmap[i]; word != 0; word &= word - 1)
+            if (wrapper(offset + i * 64 + std::countr_zero(word)) == base::ControlFlow::Break)
+              return;
+        }
+        break;
+      case ContainerType::Run:
+        for (size_t i = 0; i < c.m_values.size(); i += 2)
+        {
+          for (uint32_t v = c.m_values[i]; v <= uint32_t{c.m_values[i]} + c.m_values[i + 1]; ++v)
+            if (wrapper(offset + v) == base::ControlFlow::Break)
+              return;
+        }
+        break;
+      }
+    }
+  }
+
+  template <typename TSource>
+  static std::unique_ptr<RoaringCBV> DeserializeFromSource(TSource & src)
+  {
+    auto cbv = std::make_unique<RoaringCBV>();
+    cbv->m_containers.resize(ReadPrimitiveFromSource<uint32_t>(src));
+    for (auto & c : cbv->m_containers)
+    {
+      c.m_key = ReadPrimitiveFromSource<uint64_t>(src);
+      c.m_type = static_cast<ContainerType>(ReadPrimitiveFromSource<uint8_t>(src));
+      if (c.m_type == ContainerType::Bitmap)
+        rw::ReadVectorOfPOD(src, c.m_bitmap);
+      else
+        rw::ReadVectorOfPOD(src, c.m_values);
+    }
+    cbv->CheckContainers();
+    cbv->UpdatePopCount(true /* updateContainers */);
+    return cbv;
+  }
+
+  // CompressedBitVector overrides:
+  uint64_t PopCount() const override;
+  bool GetBit(uint64_t pos) const override;
+  std::unique_ptr<CompressedBitVector> LeaveFirstSetNBits(uint64_t n) const override;
+  StorageStrategy GetStorageStrategy() const override;
+  void Serialize(Writer & writer) const override;
+  std::unique_ptr<CompressedBitVector> Clone() const override;
+
+private:
+  // Throws Reader::ReadException if the deserialized containers are corrupted.
+  void CheckContainers() const;
+  void UpdatePopCount(bool updateContainers);
+
+  std::vector<Container> m_containers;
+  uint64_t m_popCount = 0;
+};
+
+std::string DebugPrint(RoaringCBV::ContainerType type);
+
 class CompressedBitVectorBuilder
 {
 public:
@@ -214,6 +352,7 @@ public:
       rw::ReadVectorOfPOD(src, setBits);
       return std::make_unique<SparseCBV>(std::move(setBits));
     }
+    case CompressedBitVector::StorageStrategy::Roaring: return RoaringCBV::DeserializeFromSource(src);
     }
     return std::unique_ptr<CompressedBitVector>();
   }
@@ -243,6 +382,12 @@ public:
       sparseCBV.ForEach(f);
       return;
     }
+    case CompressedBitVector::StorageStrategy::Roaring:
+    {
+      RoaringCBV const & roaringCBV = static_cast<RoaringCBV const &>(cbv);
+      roaringCBV.ForEach(f);
+      return;
+    }
     }
   }
 };
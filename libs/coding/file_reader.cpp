@@ -6,48 +6,53 @@
 
 #include "base/logging.hpp"
 
-#ifndef LOG_FILE_READER_STATS
-#define LOG_FILE_READER_STATS 0
-#endif  // LOG_FILE_READER_STATS
-
-#if LOG_FILE_READER_STATS && !defined(LOG_FILE_READER_EVERY_N_READS_MASK)
-#define LOG_FILE_READER_EVERY_N_READS_MASK 0xFFFFFFFF
-#endif
+#include <map>
+#include <vector>
 
 // static
 uint32_t const FileReader::kDefaultLogPageSize = 10;  // page size is 2^10 = 1024 = 1kb
 // static
 uint32_t const FileReader::kDefaultLogPageCount = 4;  // page count is 2^4 = 16, i.e. 16 pages are cached
 
+namespace
+{
+class FileDataWithCachedSize : public base::FileData
+{
+public:
+  explicit FileDataWithCachedSize(std::string const & fileName)
+    : base::FileData(fileName, Op::READ)
+    , m_Size(FileData::Size())
+  {}
+
+  uint64_t Size() const { return m_Size; }
+
+private:
+  uint64_t m_Size;
+};
+
+using Cache = ReaderCache<FileDataWithCachedSize>;
+}  // namespace
+
+// Readers of a section share a cache and statistics.
+struct FileReader::Section
+{
+  Cache * m_cache = nullptr;
+  std::shared_ptr<reader_cache::Counters> m_counters;
+};
+
 class FileReader::Impl
 {
 public:
   Impl(std::string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
     : m_fileData(fileName)
-    , m_readerCache(logPageSize, logPageCount)
-  {
-#if LOG_FILE_READER_STATS
-    m_readCallCount = 0;
-#endif
-  }
-
-  ~Impl()
-  {
-#if LOG_FILE_READER_STATS
-    LOG(LINFO, ("FileReader", m_fileData.GetName(), m_readerCache.GetStatsStr()));
-#endif
-  }
+    , m_readerCache(logPageSize, logPageCount, true /* useBudget */)
+  {}
 
   uint64_t Size() const { return m_fileData.Size(); }
 
-  void Read(uint64_t pos, void * p, size_t size)
+  void Read(Section const & section, uint64_t pos, void * p, size_t size)
   {
-#if LOG_FILE_READER_STATS
-    if (((++m_readCallCount) & LOG_FILE_READER_EVERY_N_READS_MASK) == 0)
-      LOG(LINFO, ("FileReader", m_fileData.GetName(), m_readerCache.GetStatsStr()));
-#endif
-
-    return m_readerCache.Read(m_fileData, pos, p, size);
+    return section.m_cache->Read(m_fileData, pos, p, size, section.m_counters.get());
   }
 
   std::unique_ptr<MemoryRegion> GetMemoryRegion(uint64_t pos, size_t size)
@@ -58,27 +63,33 @@ public:
     return std::make_unique<CopiedMemoryRegion>(std::move(buffer));
   }
 
-private:
-  class FileDataWithCachedSize : public base::FileData
+  // Returns the section of readers of |tag|. A section gets its own cache if there is
+  // a policy for it in reader_cache::Registry, otherwise it uses the cache of the file.
+  Section const * GetSection(std::string const & tag)
   {
-  public:
-    explicit FileDataWithCachedSize(std::string const & fileName)
-      : base::FileData(fileName, Op::READ)
-      , m_Size(FileData::Size())
-    {}
-
-    uint64_t Size() const { return m_Size; }
-
-  private:
-    uint64_t m_Size;
-  };
+    auto const it = m_sections.find(tag);
+    if (it != m_sections.end())
+      return &it->second;
+
+    auto & registry = reader_cache::Registry::Instance();
+    Section section;
+    section.m_cache = &m_readerCache;
+    if (auto const policy = registry.GetPolicy(tag))
+    {
+      m_sectionCaches.push_back(
+          std::make_unique<Cache>(policy->m_logPageSize, policy->m_logPageCount, true /* useBudget */));
+      section.m_cache = m_sectionCaches.back().get();
+    }
+    section.m_counters = registry.CreateCounters(m_fileData.GetName(), tag);
+    return &m_sections.emplace(tag, std::move(section)).first->second;
+  }
 
+private:
   FileDataWithCachedSize m_fileData;
-  ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS> m_readerCache;
-
-#if LOG_FILE_READER_STATS
-  uint32_t m_readCallCount;
-#endif
+  Cache m_readerCache;
+  std::vector<std::unique_ptr<Cache>> m_sectionCaches;
+  // Node-based container: readers keep pointers to sections.
+  std::map<std::string, Section> m_sections;
 };
 
 FileReader::FileReader(std::string const & fileName) : FileReader(fileName, kDefaultLogPageSize, kDefaultLogPageCount)
@@ -89,16 +100,18 @@ FileReader::FileReader(std::string const & fileName, uint32_t logPageSize, uint3
   , m_logPageSize(logPageSize)
   , m_logPageCount(logPageCount)
   , m_impl(std::make_shared<Impl>(fileName, logPageSize, logPageCount))
+  , m_section(m_impl->GetSection({} /* tag */))
   , m_offset(0)
   , m_size(m_impl->Size())
 {}
 
 FileReader::FileReader(FileReader const & reader, uint64_t offset, uint64_t size, uint32_t logPageSize,
-                       uint32_t logPageCount)
+                       uint32_t logPageCount, Section const * section)
   : ModelReader(reader.GetName())
   , m_logPageSize(logPageSize)
   , m_logPageCount(logPageCount)
   , m_impl(reader.m_impl)
+  , m_section(section)
   , m_offset(offset)
   , m_size(size)
 {}
@@ -106,7 +119,7 @@ FileReader::FileReader(FileReader const & reader, uint64_t offset, uint64_t size
 void FileReader::Read(uint64_t pos, void * p, size_t size) const
 {
   CheckPosAndSize(pos, size);
-  m_impl->Read(m_offset + pos, p, size);
+  m_impl->Read(*m_section, m_offset + pos, p, size);
 }
 
 std::unique_ptr<MemoryRegion> FileReader::GetMemoryRegion(uint64_t pos, size_t size) const
@@ -118,14 +131,21 @@ std::unique_ptr<MemoryRegion> FileReader::GetMemoryRegion(uint64_t pos, size_t s
 FileReader FileReader::SubReader(uint64_t pos, uint64_t size) const
 {
   CheckPosAndSize(pos, size);
-  return FileReader(*this, m_offset + pos, size, m_logPageSize, m_logPageCount);
+  return FileReader(*this, m_offset + pos, size, m_logPageSize, m_logPageCount, m_section);
+}
+
+FileReader FileReader::SectionReader(uint64_t pos, uint64_t size, std::string const & tag) const
+{
+  CheckPosAndSize(pos, size);
+  return FileReader(*this, m_offset + pos, size, m_logPageSize, m_logPageCount, m_impl->GetSection(tag));
 }
 
 std::unique_ptr<Reader> FileReader::CreateSubReader(uint64_t pos, uint64_t size) const
 {
   CheckPosAndSize(pos, size);
   // Can't use make_unique with private constructor.
-  return std::unique_ptr<Reader>(new FileReader(*this, m_offset + pos, size, m_logPageSize, m_logPageCount));
+  return std::unique_ptr<Reader>(
+      new FileReader(*this, m_offset + pos, size, m_logPageSize, m_logPageCount, m_section));
 }
 
 void FileReader::CheckPosAndSize(uint64_t pos, uint64_t size) const
@@ -8,6 +8,7 @@
 // FileReader, cheap to copy, not thread safe.
 // It is assumed that file is not modified during FireReader lifetime,
 // because of caching and assumption that Size() is constant.
+// Page caches are configured and their statistics are collected by reader_cache::Registry.
 class FileReader : public ModelReader
 {
 public:
@@ -25,14 +26,20 @@ public:
 
   FileReader SubReader(uint64_t pos, uint64_t size) const;
 
+  /// Sub reader of the file section |tag|. Reads of the section are counted separately in
+  /// reader_cache::Registry statistics and use the section's page cache if there is a policy for it.
+  FileReader SectionReader(uint64_t pos, uint64_t size, std::string const & tag) const;
+
 protected:
   // Used in special derived readers.
   void SetOffsetAndSize(uint64_t offset, uint64_t size);
 
 private:
   class Impl;
+  struct Section;
 
-  FileReader(FileReader const & reader, uint64_t offset, uint64_t size, uint32_t logPageSize, uint32_t logPageCount);
+  FileReader(FileReader const & reader, uint64_t offset, uint64_t size, uint32_t logPageSize, uint32_t logPageCount,
+             Section const * section);
 
   // Throws an exception if a (pos, size) read would result in an out-of-bounds access.
   void CheckPosAndSize(uint64_t pos, uint64_t size) const;
@@ -40,6 +47,7 @@ private:
   uint32_t m_logPageSize;
   uint32_t m_logPageCount;
   std::shared_ptr<Impl> m_impl;
+  Section const * m_section;
   uint64_t m_offset;
   uint64_t m_size;
 };
@@ -54,12 +54,12 @@ void FilesContainerBase::ReadInfo(Reader & reader)
 /////////////////////////////////////////////////////////////////////////////
 
 FilesContainerR::FilesContainerR(std::string const & filePath, uint32_t logPageSize, uint32_t logPageCount)
-  : m_source(std::make_unique<FileReader>(filePath, logPageSize, logPageCount))
-{
-  ReadInfo(m_source);
-}
+  : FilesContainerR(std::make_unique<FileReader>(filePath, logPageSize, logPageCount))
+{}
 
-FilesContainerR::FilesContainerR(TReader const & file) : m_source(file)
+FilesContainerR::FilesContainerR(TReader const & file)
+  : m_source(file)
+  , m_fileReader(dynamic_cast<FileReader const *>(m_source.GetPtr()))
 {
   ReadInfo(m_source);
 }
@@ -69,6 +69,8 @@ FilesContainerR::TReader FilesContainerR::GetReader(Tag const & tag) const
   TagInfo const * p = GetInfo(tag);
   if (!p)
     MYTHROW(Reader::OpenException, ("Can't find section:", GetFileName(), tag));
+  if (m_fileReader)
+    return std::make_unique<FileReader>(m_fileReader->SectionReader(p->m_offset, p->m_size, tag));
   return m_source.SubReader(p->m_offset, p->m_size);
 }
 
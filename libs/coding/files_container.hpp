@@ -8,6 +8,8 @@
 #include <string>
 #include <vector>
 
+class FileReader;
+
 class FilesContainerBase
 {
 public:
@@ -107,6 +109,8 @@ public:
 
 private:
   TReader m_source;
+  // Not null if |m_source| is a FileReader: its section readers collect statistics per section.
+  FileReader const * m_fileReader = nullptr;
 };
 
 class FilesContainerW : public FilesContainerBase
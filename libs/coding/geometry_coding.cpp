@@ -1,12 +1,17 @@
 #include "coding/geometry_coding.hpp"
 
+#include "coding/endianness.hpp"
 #include "coding/point_coding.hpp"
 
 #include "geometry/mercator.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 
+#include <algorithm>
 #include <complex>
+#include <cstring>
+#include <iterator>
 #include <stack>
 
 namespace
@@ -281,6 +286,162 @@ void DecodeTriangleStrip(InDeltasT const & deltas, m2::PointU const & basePoint,
     }
   }
 }
+
+std::string DebugPrint(DeltasEncoding encoding)
+{
+  switch (encoding)
+  {
+  case DeltasEncoding::VarInt: return "VarInt";
+  case DeltasEncoding::GroupVarInt: return "GroupVarInt";
+  }
+  UNREACHABLE();
+}
+
+namespace
+{
+class VarIntDeltaReader
+{
+public:
+  explicit VarIntDeltaReader(uint8_t const * p) : m_src(p) {}
+
+  m2::PointU Decode(m2::PointU const & prediction)
+  {
+    return DecodePointDeltaFromUint(ReadVarUint<uint64_t>(m_src), prediction);
+  }
+
+  uint8_t const * Ptr() const { return m_src.Ptr(); }
+
+private:
+  ::impl::VarIntPtrSource m_src;
+};
+
+class GroupVarIntDeltaReader
+{
+public:
+  GroupVarIntDeltaReader(uint8_t const * p, size_t count) : m_p(p), m_groupsLeft((count + 1) / 2) {}
+
+  m2::PointU Decode(m2::PointU const & prediction)
+  {
+    if (m_next == std::size(m_values))
+      ReadGroup();
+
+    uint32_t const x = m_values[m_next++];
+    uint32_t const y = m_values[m_next++];
+    return {prediction.x + bits::ZigZagDecode(x), prediction.y + bits::ZigZagDecode(y)};
+  }
+
+  uint8_t const * Ptr() const { return m_p; }
+
+private:
+  void ReadGroup()
+  {
+    static uint32_t constexpr kMasks[] = {0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+
+    ASSERT_GREATER(m_groupsLeft, 0, ());
+    --m_groupsLeft;
+    uint8_t const control = *m_p++;
+    for (size_t i = 0; i < std::size(m_values); ++i)
+    {
+      size_t const size = ((control >> (2 * i)) & 3) + 1;
+      if (m_groupsLeft > 0)
+      {
+        // Reading of 4 bytes for every value is safe until the last group, the next group takes at least 5 bytes.
+        uint32_t value;
+        std::memcpy(&value, m_p, sizeof(value));
+        m_values[i] = SwapIfBigEndianMacroBased(value) & kMasks[size - 1];
+      }
+      else
+      {
+        uint32_t value = 0;
+        for (size_t j = 0; j < size; ++j)
+          value |= static_cast<uint32_t>(m_p[j]) << (8 * j);
+        m_values[i] = value;
+      }
+      m_p += size;
+    }
+    m_next = 0;
+  }
+
+  uint8_t const * m_p;
+  size_t m_groupsLeft;
+  uint32_t m_values[4] = {};
+  size_t m_next = std::size(m_values);
+};
+
+template <class Reader>
+void DecodePolylineBatch(Reader & reader, size_t count, m2::PointU const & basePoint, m2::PointU const & maxPoint,
+                         uint8_t coordBits, m2::PointD * points)
+{
+  m2::PointD const maxPointD(maxPoint);
+  m2::PointU prev1 = basePoint;
+  m2::PointU prev2;
+  for (size_t i = 0; i < count; ++i)
+  {
+    m2::PointU const pt = reader.Decode(i < 2 ? prev1 : PredictPointInPolyline(maxPointD, prev1, prev2));
+    points[i] = PointUToPointD(pt, coordBits);
+    prev2 = prev1;
+    prev1 = pt;
+  }
+}
+
+template <class Reader>
+void DecodeTriangleStripBatch(Reader & reader, size_t count, m2::PointU const & basePoint,
+                              m2::PointU const & maxPoint, uint8_t coordBits, m2::PointD * points)
+{
+  ASSERT(count == 0 || count > 2, (count));
+
+  m2::PointD const maxPointD(maxPoint);
+  m2::PointU prev1 = basePoint;
+  m2::PointU prev2;
+  m2::PointU prev3;
+  for (size_t i = 0; i < count; ++i)
+  {
+    m2::PointU const pt = reader.Decode(i < 3 ? prev1 : PredictPointInTriangle(maxPointD, prev1, prev2, prev3));
+    points[i] = PointUToPointD(pt, coordBits);
+    prev3 = prev2;
+    prev2 = prev1;
+    prev1 = pt;
+  }
+}
+}  // namespace
+
+uint8_t const * DecodePolylineBatch(uint8_t const * p, size_t count, DeltasEncoding encoding,
+                                    m2::PointU const & basePoint, m2::PointU const & maxPoint, uint8_t coordBits,
+                                    m2::PointD * points)
+{
+  if (encoding == DeltasEncoding::GroupVarInt)
+  {
+    GroupVarIntDeltaReader reader(p, count);
+    DecodePolylineBatch(reader, count, basePoint, maxPoint, coordBits, points);
+    return reader.Ptr();
+  }
+
+  VarIntDeltaReader reader(p);
+  DecodePolylineBatch(reader, count, basePoint, maxPoint, coordBits, points);
+  return reader.Ptr();
+}
+
+uint8_t const * DecodeTriangleStripBatch(uint8_t const * p, size_t count, DeltasEncoding encoding,
+                                         m2::PointU const & basePoint, m2::PointU const & maxPoint, uint8_t coordBits,
+                                         m2::PointD * points)
+{
+  if (encoding == DeltasEncoding::GroupVarInt)
+  {
+    GroupVarIntDeltaReader reader(p, count);
+    DecodeTriangleStripBatch(reader, count, basePoint, maxPoint, coordBits, points);
+    return reader.Ptr();
+  }
+
+  VarIntDeltaReader reader(p);
+  DecodeTriangleStripBatch(reader, count, basePoint, maxPoint, coordBits, points);
+  return reader.Ptr();
+}
+
+size_t CountVarInts(uint8_t const * beg, uint8_t const * end)
+{
+  // Every varint ends with a byte without the continuation bit.
+  return static_cast<size_t>(std::count_if(beg, end, [](uint8_t b) { return b < 128; }));
+}
 }  // namespace coding
 
 namespace serial
@@ -9,12 +9,14 @@
 
 #include "base/array_adapters.hpp"
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/buffer_vector.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
 #include <functional>
 #include <list>
+#include <string>
 #include <vector>
 
 namespace coding
@@ -92,6 +94,63 @@ void EncodeTriangleStrip(InPointsT const & points, m2::PointU const & basePoint,
 
 void DecodeTriangleStrip(InDeltasT const & deltas, m2::PointU const & basePoint, m2::PointU const & maxPoint,
                          OutPointsT & points);
+
+/// Encoding of the point deltas in the features geometry.
+enum class DeltasEncoding : uint8_t
+{
+  // A varint for every delta with the interleaved bits of x and y.
+  VarInt,
+  // Groups of 2 deltas, i.e. 4 values of zigzagged x and y: a control byte with (size - 1) of the values in
+  // 2 bits each (from the lowest bits) followed by the values of 1-4 little-endian bytes. The values of the
+  // missing second delta of the last group are zeroes.
+  GroupVarInt
+};
+
+std::string DebugPrint(DeltasEncoding encoding);
+
+template <class TDeltas, class TSink>
+void WriteGroupVarIntDeltas(TDeltas const & deltas, TSink & sink)
+{
+  size_t const count = deltas.size();
+  for (size_t i = 0; i < count; i += 2)
+  {
+    uint32_t values[4] = {};
+    bits::BitwiseSplit(deltas[i], values[0], values[1]);
+    if (i + 1 < count)
+      bits::BitwiseSplit(deltas[i + 1], values[2], values[3]);
+
+    uint8_t group[1 + sizeof(values)] = {};
+    size_t size = 1;
+    for (size_t j = 0; j < 4; ++j)
+    {
+      uint8_t valueSize = 1;
+      while (valueSize < 4 && (values[j] >> (8 * valueSize)) != 0)
+        ++valueSize;
+
+      group[0] |= static_cast<uint8_t>((valueSize - 1) << (2 * j));
+      for (uint8_t k = 0; k < valueSize; ++k)
+        group[size++] = static_cast<uint8_t>(values[j] >> (8 * k));
+    }
+    sink.Write(group, size);
+  }
+}
+
+/// @name Batch decoders of |count| points from the |encoding| deltas at |p| straight into the preallocated
+/// |points|, the points are converted to doubles with |coordBits|. Return the end of the read deltas.
+/// The results are the same as of reading deltas + DecodePolyline/DecodeTriangleStrip + PointUToPointD
+/// without the intermediate delta and point buffers.
+/// @{
+uint8_t const * DecodePolylineBatch(uint8_t const * p, size_t count, DeltasEncoding encoding,
+                                    m2::PointU const & basePoint, m2::PointU const & maxPoint, uint8_t coordBits,
+                                    m2::PointD * points);
+
+uint8_t const * DecodeTriangleStripBatch(uint8_t const * p, size_t count, DeltasEncoding encoding,
+                                         m2::PointU const & basePoint, m2::PointU const & maxPoint, uint8_t coordBits,
+                                         m2::PointD * points);
+/// @}
+
+// Returns the number of the varints which end in [beg, end).
+size_t CountVarInts(uint8_t const * beg, uint8_t const * end);
 }  // namespace coding
 
 namespace serial
@@ -111,6 +170,9 @@ public:
 
   uint8_t GetCoordBits() const { return m_CoordBits; }
 
+  coding::DeltasEncoding GetDeltasEncoding() const { return m_deltasEncoding; }
+  void SetDeltasEncoding(coding::DeltasEncoding encoding) { m_deltasEncoding = encoding; }
+
   template <typename WriterT>
   void Save(WriterT & writer) const
   {
@@ -130,6 +192,8 @@ private:
   uint64_t m_BasePointUint64;
   m2::PointU m_BasePoint;
   uint8_t m_CoordBits;
+  // Is not saved, it is defined by the version of the features section.
+  coding::DeltasEncoding m_deltasEncoding = coding::DeltasEncoding::VarInt;
 };
 
 namespace pts
@@ -202,7 +266,10 @@ void SaveInner(EncodeFunT fn, std::vector<m2::PointD> const & points, GeometryCo
 {
   DeltasT deltas;
   Encode(fn, points, params, deltas);
-  WriteVarUintArray(deltas, sink);
+  if (params.GetDeltasEncoding() == coding::DeltasEncoding::GroupVarInt)
+    coding::WriteGroupVarIntDeltas(deltas, sink);
+  else
+    WriteVarUintArray(deltas, sink);
 }
 
 template <class TSink>
@@ -221,7 +288,16 @@ void SaveOuter(EncodeFunT fn, std::vector<m2::PointD> const & points, GeometryCo
 
   std::vector<char> buffer;
   MemWriter<std::vector<char>> writer(buffer);
-  WriteVarUintArray(deltas, writer);
+  if (params.GetDeltasEncoding() == coding::DeltasEncoding::GroupVarInt)
+  {
+    // The count of the deltas can't be restored from the groups.
+    WriteVarUint(writer, static_cast<uint32_t>(deltas.size()));
+    coding::WriteGroupVarIntDeltas(deltas, writer);
+  }
+  else
+  {
+    WriteVarUintArray(deltas, writer);
+  }
 
   WriteBufferToSink(buffer, sink);
 }
@@ -260,13 +336,47 @@ void SaveOuterPath(std::vector<m2::PointD> const & points, GeometryCodingParams
 inline void const * LoadInnerPath(void const * pBeg, size_t count, GeometryCodingParams const & params,
                                   OutPointsT & points)
 {
-  return LoadInner(&coding::DecodePolyline, pBeg, count, params, points);
+  size_t const offset = points.size();
+  points.resize(offset + count);
+  return coding::DecodePolylineBatch(static_cast<uint8_t const *>(pBeg), count, params.GetDeltasEncoding(),
+                                     pts::GetBasePoint(params), pts::GetMaxPoint(params), params.GetCoordBits(),
+                                     points.data() + offset);
 }
 
 template <class TSource, class TPoints>
 void LoadOuterPath(TSource & src, GeometryCodingParams const & params, TPoints & points)
 {
-  LoadOuter(&coding::DecodePolyline, src, params, points);
+  uint32_t const size = ReadVarUint<uint32_t>(src);
+  buffer_vector<uint8_t, 256> buffer(size);
+  src.Read(buffer.data(), size);
+
+  uint8_t const * beg = buffer.data();
+  uint8_t const * end = buffer.data() + buffer.size();
+  size_t count;
+  if (params.GetDeltasEncoding() == coding::DeltasEncoding::GroupVarInt)
+  {
+    // The buffer starts with the count of the deltas.
+    if (std::find_if(beg, end, [](uint8_t b) { return b < 128; }) == end)
+      MYTHROW(ReadVarIntException, ());
+    ::impl::VarIntPtrSource countSrc(beg);
+    count = ReadVarUint<uint32_t>(countSrc);
+    beg = countSrc.Ptr();
+    // Every group of 2 deltas takes at least 5 bytes.
+    if ((count + 1) / 2 * 5 > static_cast<size_t>(end - beg))
+      MYTHROW(ReadVarIntException, ());
+  }
+  else
+  {
+    count = coding::CountVarInts(beg, end);
+  }
+
+  size_t const offset = points.size();
+  points.resize(offset + count);
+  if (coding::DecodePolylineBatch(beg, count, params.GetDeltasEncoding(), pts::GetBasePoint(params),
+                                  pts::GetMaxPoint(params), params.GetCoordBits(), points.data() + offset) != end)
+  {
+    MYTHROW(ReadVarIntException, ());
+  }
 }
 
 /// @name Triangles.
@@ -294,7 +404,11 @@ inline void const * LoadInnerTriangles(void const * pBeg, size_t count, Geometry
 {
   CHECK_GREATER_OR_EQUAL(count, 2, ());
   OutPointsT points;
-  void const * res = LoadInner(&coding::DecodeTriangleStrip, pBeg, count, params, points);
+  points.resize(count);
+  void const * res =
+      coding::DecodeTriangleStripBatch(static_cast<uint8_t const *>(pBeg), count, params.GetDeltasEncoding(),
+                                       pts::GetBasePoint(params), pts::GetMaxPoint(params), params.GetCoordBits(),
+                                       points.data());
 
   StripToTriangles(count, points, triangles);
   return res;
@@ -29,6 +29,7 @@
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 // A data structure that allows storing a map from small 32-bit integers (the main use
@@ -57,7 +58,8 @@
 // exception of the last one) is a sequence of kBlockSize variables
 // encoded by block encoding callback.
 //
-// On Get call m_blockSize consecutive variables are decoded and cached in RAM.
+// On Get call m_blockSize consecutive variables are decoded and cached in RAM. At most
+// kMaxCachedBlocks blocks are kept, so long living tables don't end up with all values decoded.
 
 template <typename Value>
 class MapUint32ToValue
@@ -67,6 +69,8 @@ class MapUint32ToValue
   static uint16_t constexpr kLastVersion = 1;
 
 public:
+  static size_t constexpr kMaxCachedBlocks = 1024;
+
   using ReadBlockCallback = std::function<void(NonOwningReaderSource &, uint32_t, std::vector<Value> &)>;
 
   struct Header
@@ -117,9 +121,14 @@ public:
     uint32_t const base = rank / m_header.m_blockSize;
     uint32_t const offset = rank % m_header.m_blockSize;
 
-    auto & entry = m_cache[base];
-    if (entry.empty())
-      entry = GetImpl(rank, m_header.m_blockSize);
+    auto it = m_cache.find(base);
+    if (it == m_cache.end())
+    {
+      if (m_cache.size() >= kMaxCachedBlocks)
+        m_cache.clear();
+      it = m_cache.emplace(base, GetImpl(rank, m_header.m_blockSize)).first;
+    }
+    auto const & entry = it->second;
 
     value = entry[offset];
     return true;
@@ -140,6 +149,37 @@ public:
   }
   /// @}
 
+  /// Gets values for all |ids| at once, decoding every block only once and not further than the
+  /// last requested value in it. Calls fn(i, value) for every i such that ids[i] has a value, in
+  /// the order of the table. Does not use the cache, so it is thread-safe like GetThreadsafe.
+  template <typename Fn>
+  void GetThreadsafe(std::vector<uint32_t> const & ids, Fn && fn) const
+  {
+    // Pairs of (rank, index in |ids|).
+    std::vector<std::pair<uint32_t, size_t>> ranks;
+    ranks.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      auto const id = ids[i];
+      if (id < m_ids.size() && m_ids[id])
+        ranks.emplace_back(static_cast<uint32_t>(m_ids.rank(id)), i);
+    }
+    std::sort(ranks.begin(), ranks.end());
+
+    std::vector<Value> entry;
+    for (size_t i = 0; i < ranks.size();)
+    {
+      uint32_t const base = ranks[i].first / m_header.m_blockSize;
+      size_t j = i;
+      while (j < ranks.size() && ranks[j].first / m_header.m_blockSize == base)
+        ++j;
+
+      entry = GetImpl(ranks[i].first, ranks[j - 1].first % m_header.m_blockSize + 1);
+      for (; i < j; ++i)
+        fn(ranks[i].second, entry[ranks[i].first % m_header.m_blockSize]);
+    }
+  }
+
   // Loads MapUint32ToValue instance. Note that |reader| must be alive
   // until the destruction of loaded table. Returns nullptr if
   // MapUint32ToValue can't be loaded.
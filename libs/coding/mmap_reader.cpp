@@ -1,6 +1,8 @@
 #include "coding/mmap_reader.hpp"
 #include "coding/memory_region.hpp"
 
+#include "base/logging.hpp"
+#include "base/macros.hpp"
 #include "base/scope_guard.hpp"
 
 #include "std/target_os.hpp"
@@ -64,15 +66,33 @@ public:
       MYTHROW(OpenException, ("mmap failed for file", fileName));
     }
 
+    Advise(0 /* offset */, m_size, advice);
+#endif
+  }
+
+  void Advise(uint64_t offset, uint64_t size, Advice advice)
+  {
+#ifdef OMIM_OS_WINDOWS
+    UNUSED_VALUE(offset);
+    UNUSED_VALUE(size);
+    UNUSED_VALUE(advice);
+#else
+    if (size == 0)
+      return;
+
     int adv = MADV_NORMAL;
     switch (advice)
     {
     case Advice::Random: adv = MADV_RANDOM; break;
     case Advice::Sequential: adv = MADV_SEQUENTIAL; break;
+    case Advice::WillNeed: adv = MADV_WILLNEED; break;
     case Advice::Normal: adv = MADV_NORMAL; break;
     }
 
-    if (madvise(m_memory, static_cast<size_t>(s.st_size), adv) != 0)
+    // madvise() requires a page-aligned address.
+    static uint64_t const pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    uint64_t const begin = offset / pageSize * pageSize;
+    if (madvise(m_memory + begin, static_cast<size_t>(offset + size - begin), adv) != 0)
       LOG(LWARNING, ("madvise error:", strerror(errno)));
 #endif
   }
@@ -144,6 +164,12 @@ std::unique_ptr<Reader> MmapReader::CreateSubReader(uint64_t pos, uint64_t size)
   return std::unique_ptr<Reader>(new MmapReader(*this, m_offset + pos, size));
 }
 
+void MmapReader::Advise(uint64_t pos, uint64_t size, Advice advice) const
+{
+  CheckPosAndSize(pos, size);
+  m_data->Advise(m_offset + pos, size, advice);
+}
+
 void MmapReader::CheckPosAndSize(uint64_t pos, uint64_t size) const
 {
   /// @todo FileReader makes honest checks and MYTHROW.
@@ -13,7 +13,8 @@ public:
   {
     Normal,
     Random,
-    Sequential
+    Sequential,
+    WillNeed
   };
 
   explicit MmapReader(std::string const & fileName, Advice advice = Advice::Normal);
@@ -29,6 +30,10 @@ public:
   std::unique_ptr<MemoryRegion> GetMemoryRegion(uint64_t pos, size_t size) const override;
   std::unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const override;
 
+  /// Gives the OS a hint how [pos, pos + size) of this reader is going to be accessed.
+  /// The hint is applied to the whole shared mapping, so it affects other readers of the same range too.
+  void Advise(uint64_t pos, uint64_t size, Advice advice) const;
+
 protected:
   void CheckPosAndSize(uint64_t pos, uint64_t size) const;
   // Used in special derived readers.
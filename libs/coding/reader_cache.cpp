@@ -0,0 +1,154 @@
+#include "coding/reader_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace reader_cache
+{
+Stats & Stats::operator-=(Stats const & rhs)
+{
+  m_reads -= rhs.m_reads;
+  m_bytesRequested -= rhs.m_bytesRequested;
+  m_hits -= rhs.m_hits;
+  m_misses -= rhs.m_misses;
+  m_uncached -= rhs.m_uncached;
+  return *this;
+}
+
+Stats & Stats::operator+=(Stats const & rhs)
+{
+  m_reads += rhs.m_reads;
+  m_bytesRequested += rhs.m_bytesRequested;
+  m_hits += rhs.m_hits;
+  m_misses += rhs.m_misses;
+  m_uncached += rhs.m_uncached;
+  return *this;
+}
+
+double Stats::GetHitRatio() const
+{
+  uint64_t const pages = m_hits + m_misses;
+  return pages == 0 ? 0.0 : static_cast<double>(m_hits) / pages;
+}
+
+std::string DebugPrint(Stats const & stats)
+{
+  std::ostringstream out;
+  out << "Stats [ reads: " << stats.m_reads << ", bytes: " << stats.m_bytesRequested << ", hits: " << stats.m_hits
+      << ", misses: " << stats.m_misses << ", uncached: " << stats.m_uncached << ", hit ratio: " << stats.GetHitRatio()
+      << " ]";
+  return out.str();
+}
+
+Stats Counters::Get() const
+{
+  Stats stats;
+  stats.m_reads = m_reads.load(std::memory_order_relaxed);
+  stats.m_bytesRequested = m_bytesRequested.load(std::memory_order_relaxed);
+  stats.m_hits = m_hits.load(std::memory_order_relaxed);
+  stats.m_misses = m_misses.load(std::memory_order_relaxed);
+  stats.m_uncached = m_uncached.load(std::memory_order_relaxed);
+  return stats;
+}
+
+Stats Registry::Entry::Get() const
+{
+  auto stats = m_counters->Get();
+  stats -= m_base;
+  return stats;
+}
+
+// static
+Registry & Registry::Instance()
+{
+  static Registry instance;
+  return instance;
+}
+
+void Registry::SetPolicy(std::string const & tag, Policy const & policy)
+{
+  CHECK(policy.m_logPageCount > 0 && policy.m_logPageCount < 32, (tag, policy.m_logPageCount));
+  CHECK_LESS(policy.m_logPageSize, 32, (tag));
+
+  std::lock_guard lock(m_mutex);
+  m_policies[tag] = policy;
+}
+
+std::optional<Policy> Registry::GetPolicy(std::string const & tag) const
+{
+  std::lock_guard lock(m_mutex);
+  auto const it = m_policies.find(tag);
+  if (it == m_policies.cend())
+    return {};
+  return it->second;
+}
+
+void Registry::ClearPolicies()
+{
+  std::lock_guard lock(m_mutex);
+  m_policies.clear();
+}
+
+bool Registry::TryAcquire(uint64_t bytes)
+{
+  uint64_t const budget = m_budget;
+  uint64_t used = m_usedBytes.load();
+  do
+  {
+    if (budget != 0 && used + bytes > budget)
+      return false;
+  }
+  while (!m_usedBytes.compare_exchange_weak(used, used + bytes));
+  return true;
+}
+
+void Registry::Release(uint64_t bytes)
+{
+  ASSERT_GREATER_OR_EQUAL(m_usedBytes.load(), bytes, ());
+  m_usedBytes -= bytes;
+}
+
+std::shared_ptr<Counters> Registry::CreateCounters(std::string const & fileName, std::string const & tag)
+{
+  auto counters = std::make_shared<Counters>();
+
+  std::lock_guard lock(m_mutex);
+  if (m_counters.size() >= m_collectCount)
+    CollectFinished();
+  m_counters.push_back({Key(fileName, tag), counters, {} /* base */});
+  return counters;
+}
+
+Registry::StatsMap Registry::GetStats() const
+{
+  std::lock_guard lock(m_mutex);
+  CollectFinished();
+
+  StatsMap stats = m_finished;
+  for (auto const & entry : m_counters)
+    stats[entry.m_key] += entry.Get();
+  return stats;
+}
+
+void Registry::ResetStats()
+{
+  std::lock_guard lock(m_mutex);
+  CollectFinished();
+  m_finished.clear();
+  for (auto & entry : m_counters)
+    entry.m_base = entry.m_counters->Get();
+}
+
+void Registry::CollectFinished() const
+{
+  // Only the registry refers to counters of destroyed readers, so they can't change anymore.
+  auto const it = std::partition(m_counters.begin(), m_counters.end(),
+                                 [](Entry const & entry) { return entry.m_counters.use_count() > 1; });
+  for (auto i = it; i != m_counters.end(); ++i)
+    m_finished[i->m_key] += i->Get();
+  m_counters.erase(it, m_counters.end());
+  m_collectCount = std::max(kMinCollectedCount, 2 * m_counters.size());
+}
+}  // namespace reader_cache
@@ -2,94 +2,217 @@
 
 #include "base/base.hpp"
 #include "base/cache.hpp"
-#include "base/stats.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
-#include <sstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
-namespace impl
+namespace reader_cache
 {
-template <bool Enable>
-struct ReaderCacheStats
+// Parameters of a page cache: page size is 2^m_logPageSize and number of pages is 2^m_logPageCount.
+struct Policy
 {
-  std::string GetStatsStr(uint32_t, uint32_t) const { return ""; }
-  base::NoopStats<uint32_t> m_ReadSize;
-  base::NoopStats<uint32_t> m_CacheHit;
+  uint32_t m_logPageSize = 10;
+  uint32_t m_logPageCount = 4;
 };
 
-template <>
-struct ReaderCacheStats<true>
+struct Stats
 {
-  std::string GetStatsStr(uint32_t logPageSize, uint32_t pageCount) const
+  Stats & operator+=(Stats const & rhs);
+  Stats & operator-=(Stats const & rhs);
+
+  // Share of pages found in the cache.
+  double GetHitRatio() const;
+
+  uint64_t m_reads = 0;
+  uint64_t m_bytesRequested = 0;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  // Pages read past the cache because of the memory budget.
+  uint64_t m_uncached = 0;
+};
+
+std::string DebugPrint(Stats const & stats);
+
+// Statistics of reads of one section of one file. Written by the threads which use the reader
+// and its copies and may be read by any thread.
+class Counters
+{
+public:
+  void OnRead(size_t bytes)
+  {
+    Add(m_reads, 1);
+    Add(m_bytesRequested, bytes);
+  }
+
+  void OnPage(bool hit) { Add(hit ? m_hits : m_misses, 1); }
+  void OnUncachedPage() { Add(m_uncached, 1); }
+
+  Stats Get() const;
+
+private:
+  // Copies of a reader share its counters and may be used by different threads.
+  static void Add(std::atomic<uint64_t> & counter, uint64_t value)
   {
-    std::ostringstream out;
-    out << "LogPageSize: " << logPageSize << " PageCount: " << pageCount;
-    out << " ReadSize(" << m_ReadSize.ToString() << ")";
-    out << " CacheHit(" << m_CacheHit.ToString() << ")";
-    double const bytesAsked = m_ReadSize.GetAverage() * m_ReadSize.GetCount();
-    double const callsMade = (1.0 - m_CacheHit.GetAverage()) * m_CacheHit.GetCount();
-    double const bytesRead = callsMade * (1 << logPageSize);
-    out << " RatioBytesRead: " << (bytesRead + 1) / (bytesAsked + 1);
-    out << " RatioCallsMade: " << (callsMade + 1) / (m_ReadSize.GetCount() + 1);
-    return out.str();
+    counter.fetch_add(value, std::memory_order_relaxed);
   }
 
-  base::AverageStats<uint32_t> m_ReadSize;
-  base::AverageStats<uint32_t> m_CacheHit;
+  std::atomic<uint64_t> m_reads = 0;
+  std::atomic<uint64_t> m_bytesRequested = 0;
+  std::atomic<uint64_t> m_hits = 0;
+  std::atomic<uint64_t> m_misses = 0;
+  std::atomic<uint64_t> m_uncached = 0;
+};
+
+// Process-wide settings of FileReader page caches and their statistics. Thread-safe.
+class Registry
+{
+public:
+  // File name and section tag.
+  using Key = std::pair<std::string, std::string>;
+  using StatsMap = std::map<Key, Stats>;
+
+  static Registry & Instance();
+
+  /// Sets the page cache policy for sections with |tag|, e.g. bigger pages for geometry and
+  /// smaller ones for offsets tables. Sections without a policy share the cache of the file.
+  /// Affects files opened after the call.
+  void SetPolicy(std::string const & tag, Policy const & policy);
+  std::optional<Policy> GetPolicy(std::string const & tag) const;
+  void ClearPolicies();
+
+  /// Sets the limit of memory for pages of all caches, 0 means no limit. When it's reached,
+  /// caches don't allocate new pages and read the data past them.
+  void SetBudget(uint64_t bytes) { m_budget = bytes; }
+  uint64_t GetBudget() const { return m_budget; }
+  uint64_t GetUsedBytes() const { return m_usedBytes; }
+
+  bool TryAcquire(uint64_t bytes);
+  void Release(uint64_t bytes);
+
+  std::shared_ptr<Counters> CreateCounters(std::string const & fileName, std::string const & tag);
+
+  /// \returns statistics of all readers, alive and destroyed, by file name and section tag.
+  /// The tag is empty for reads which are not bound to a section.
+  StatsMap GetStats() const;
+  void ResetStats();
+
+private:
+  struct Entry
+  {
+    // Statistics since the last ResetStats().
+    Stats Get() const;
+
+    Key m_key;
+    std::shared_ptr<Counters> m_counters;
+    Stats m_base;
+  };
+
+  Registry() = default;
+
+  // Moves statistics of counters which are not used by readers anymore to |m_finished|.
+  // Must be called with |m_mutex| locked.
+  void CollectFinished() const;
+
+  // CreateCounters() collects the finished counters only when the number of counters doubles since
+  // the last collection, so the cost of the collections per created reader is constant.
+  static size_t constexpr kMinCollectedCount = 64;
+
+  std::atomic<uint64_t> m_budget = 0;
+  std::atomic<uint64_t> m_usedBytes = 0;
+
+  mutable std::mutex m_mutex;
+  std::map<std::string, Policy> m_policies;
+  mutable std::vector<Entry> m_counters;
+  mutable size_t m_collectCount = kMinCollectedCount;
+  mutable StatsMap m_finished;
 };
-}  // namespace impl
+}  // namespace reader_cache
 
-template <class ReaderT, bool bStats = false>
+template <class ReaderT>
 class ReaderCache
 {
 public:
-  ReaderCache(uint32_t logPageSize, uint32_t logPageCount) : m_Cache(logPageCount), m_LogPageSize(logPageSize) {}
+  /// \param useBudget the cache accounts its pages in reader_cache::Registry's memory budget.
+  ReaderCache(uint32_t logPageSize, uint32_t logPageCount, bool useBudget = false)
+    : m_Cache(logPageCount)
+    , m_LogPageSize(logPageSize)
+    , m_useBudget(useBudget)
+  {}
 
-  void Read(ReaderT & reader, uint64_t pos, void * p, size_t size)
+  ~ReaderCache()
+  {
+    if (m_useBudget && m_allocatedBytes != 0)
+      reader_cache::Registry::Instance().Release(m_allocatedBytes);
+  }
+
+  void Read(ReaderT & reader, uint64_t pos, void * p, size_t size, reader_cache::Counters * counters = nullptr)
   {
     if (size == 0)
       return;
     ASSERT_LESS_OR_EQUAL(pos + size, reader.Size(), (pos, size, reader.Size()));
-    m_Stats.m_ReadSize(static_cast<uint32_t>(size));
+    if (counters)
+      counters->OnRead(size);
+
     char * pDst = static_cast<char *>(p);
     uint64_t pageNum = pos >> m_LogPageSize;
-    size_t const firstPageOffset = static_cast<size_t>(pos - (pageNum << m_LogPageSize));
-    size_t const firstCopySize = std::min(size, PageSize() - firstPageOffset);
-    ASSERT_GREATER(firstCopySize, 0, ());
-    memcpy(pDst, ReadPage(reader, pageNum) + firstPageOffset, firstCopySize);
-    size -= firstCopySize;
-    pos += firstCopySize;
-    pDst += firstCopySize;
-    ++pageNum;
+    size_t pageOffset = static_cast<size_t>(pos - (pageNum << m_LogPageSize));
     while (size > 0)
     {
-      size_t const copySize = std::min(size, PageSize());
-      memcpy(pDst, ReadPage(reader, pageNum), copySize);
+      size_t const copySize = std::min(size, PageSize() - pageOffset);
+      ASSERT_GREATER(copySize, 0, ());
+      if (char const * page = ReadPage(reader, pageNum, counters))
+      {
+        memcpy(pDst, page + pageOffset, copySize);
+      }
+      else
+      {
+        // No memory for the page, read the requested part only.
+        reader.Read(pos, pDst, copySize);
+      }
       size -= copySize;
       pos += copySize;
       pDst += copySize;
+      pageOffset = 0;
       ++pageNum;
     }
   }
 
-  std::string GetStatsStr() const { return m_Stats.GetStatsStr(m_LogPageSize, m_Cache.GetCacheSize()); }
+  size_t GetAllocatedBytes() const { return m_allocatedBytes; }
 
 private:
-  inline size_t PageSize() const { return 1 << m_LogPageSize; }
+  inline size_t PageSize() const { return size_t{1} << m_LogPageSize; }
 
-  inline char const * ReadPage(ReaderT & reader, uint64_t pageNum)
+  // Returns nullptr if the page can't be cached because of the memory budget.
+  inline char const * ReadPage(ReaderT & reader, uint64_t pageNum, reader_cache::Counters * counters)
   {
     bool cached;
     std::vector<char> & v = m_Cache.Find(pageNum, cached);
-    m_Stats.m_CacheHit(cached ? 1 : 0);
+    // A slot which has not got memory keeps the key of the last page which was read past it.
+    cached = cached && !v.empty();
+    if (counters)
+      counters->OnPage(cached);
     if (!cached)
     {
       if (v.empty())
+      {
+        if (m_useBudget && !reader_cache::Registry::Instance().TryAcquire(PageSize()))
+        {
+          if (counters)
+            counters->OnUncachedPage();
+          return nullptr;
+        }
         v.resize(PageSize());
+        m_allocatedBytes += PageSize();
+      }
       uint64_t const pos = pageNum << m_LogPageSize;
       reader.Read(pos, &v[0], std::min(PageSize(), static_cast<size_t>(reader.Size() - pos)));
     }
@@ -98,5 +221,6 @@ private:
 
   base::Cache<uint64_t, std::vector<char>> m_Cache;
   uint32_t const m_LogPageSize;
-  impl::ReaderCacheStats<bStats> m_Stats;
+  bool const m_useBudget;
+  size_t m_allocatedBytes = 0;
 };
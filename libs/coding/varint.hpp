@@ -7,6 +7,7 @@
 #include "base/exception.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <cstdint>
 #include <type_traits>
 
 // Writes any unsigned integer type using optimal bytes count, platform-independent.
@@ -208,6 +209,8 @@ public:
     ASSERT_LESS_OR_EQUAL(reinterpret_cast<uintptr_t>(p), reinterpret_cast<uintptr_t>(m_pEnd), ());
     return p < m_pEnd;
   }
+  // The longest 64-bit varint has 10 bytes.
+  bool HasWholeVarInt(uint8_t const * p) const { return static_cast<uint8_t const *>(m_pEnd) - p >= 10; }
   void NextVarInt() {}
 
 private:
@@ -219,12 +222,29 @@ class ReadVarInt64ArrayGivenSize
 public:
   explicit ReadVarInt64ArrayGivenSize(size_t const count) : m_Remaining(count) {}
   bool Continue(void const *) const { return m_Remaining > 0; }
+  bool HasWholeVarInt(uint8_t const *) const { return true; }
   void NextVarInt() { --m_Remaining; }
 
 private:
   size_t m_Remaining;
 };
 
+// Source over a contiguous buffer for the unrolled ReadVarUint.
+class VarIntPtrSource
+{
+public:
+  explicit VarIntPtrSource(uint8_t const * p) : m_p(p) {}
+  void Read(void * p, size_t size)
+  {
+    ASSERT_EQUAL(size, 1, ());
+    *static_cast<uint8_t *>(p) = *m_p++;
+  }
+  uint8_t const * Ptr() const { return m_p; }
+
+private:
+  uint8_t const * m_p;
+};
+
 template <typename ConverterT, typename F, class WhileConditionT>
 void const * ReadVarInt64Array(void const * pBeg, WhileConditionT whileCondition, F f, ConverterT converter)
 {
@@ -236,6 +256,16 @@ void const * ReadVarInt64Array(void const * pBeg, WhileConditionT whileCondition
   uint8_t const * p = pBegChar;
   while (whileCondition.Continue(p))
   {
+    // Fast path: the whole varint is in the buffer, so it is read by the unrolled ReadVarUint.
+    if (count32 == 0 && count64 == 0 && whileCondition.HasWholeVarInt(p))
+    {
+      VarIntPtrSource src(p);
+      f(converter(ReadVarUint(src, static_cast<uint64_t const *>(nullptr))));
+      p = src.Ptr();
+      whileCondition.NextVarInt();
+      continue;
+    }
+
     uint8_t const t = *p++;
     res32 += (static_cast<uint32_t>(t & 127) << count32);
     count32 += 7;
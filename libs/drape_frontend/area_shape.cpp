@@ -78,6 +78,12 @@ void AreaShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher>
     DrawArea(context, batcher, colorUv, outlineUv, region.GetTexture());
 }
 
+size_t AreaShape::GetSizeBytes() const
+{
+  return sizeof(AreaShape) + (m_vertexes.size() + m_buildingOutline.m_vertices.size()) * sizeof(m2::PointD) +
+         m_buildingOutline.m_normals.size() * sizeof(m2::PointD) + m_buildingOutline.m_indices.size() * sizeof(int);
+}
+
 void AreaShape::DrawArea(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher, m2::PointD const & colorUv,
                          m2::PointD const & outlineUv, ref_ptr<dp::Texture> texture) const
 {
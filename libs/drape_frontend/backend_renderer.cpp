@@ -41,7 +41,8 @@ BackendRenderer::BackendRenderer(Params && params)
   , m_model(params.m_model)
   , m_readManager(make_unique_dp<ReadManager>(params.m_commutator, m_model, params.m_allow3dBuildings,
                                               params.m_trafficEnabled, params.m_isolinesEnabled,
-                                              params.m_backgroundMode, params.m_satelliteAreaOpacity))
+                                              params.m_backgroundMode, params.m_satelliteAreaOpacity,
+                                              params.m_tileShapesCacheSizeBytes, params.m_readTilesInGroups))
   , m_transitBuilder(
         make_unique_dp<TransitSchemeBuilder>(std::bind(&BackendRenderer::FlushTransitRenderData, this, _1)))
   , m_trafficGenerator(make_unique_dp<TrafficGenerator>(std::bind(&BackendRenderer::FlushTrafficRenderData, this, _1)))
@@ -158,7 +159,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
     if (msg->NeedRestartReading())
       m_readManager->Restart();
     else
-      m_readManager->Invalidate(msg->GetTilesForInvalidate());
+      m_readManager->Invalidate(msg->GetTilesForInvalidate(), msg->GetRect());
     break;
   }
 
@@ -69,6 +69,10 @@ public:
     dp::BackgroundMode m_backgroundMode;
     float m_satelliteAreaOpacity;
     std::optional<Arrow3dCustomDecl> m_arrow3dCustomDecl;
+    // Size limit of the cache of the shapes of recently read tiles, 0 disables the cache.
+    uint64_t m_tileShapesCacheSizeBytes = 0;
+    // Read neighbouring tiles together after zoom changes.
+    bool m_readTilesInGroups = false;
   };
 
   explicit BackendRenderer(Params && params);
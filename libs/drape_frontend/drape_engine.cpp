@@ -106,6 +106,8 @@ DrapeEngine::DrapeEngine(Params && params)
       params.m_model.UpdateCurrentCountryFn(), make_ref(m_requestedTiles), params.m_allow3dBuildings,
       params.m_trafficEnabled, params.m_isolinesEnabled, params.m_simplifiedTrafficColors, params.m_backgroundMode,
       params.m_satelliteAreaOpacity, std::move(params.m_arrow3dCustomDecl), params.m_onGraphicsContextInitialized);
+  brParams.m_tileShapesCacheSizeBytes = params.m_tileShapesCacheSizeBytes;
+  brParams.m_readTilesInGroups = params.m_readTilesInGroups;
 
   m_backend = make_unique_dp<BackendRenderer>(std::move(brParams));
   m_frontend = make_unique_dp<FrontendRenderer>(std::move(frParams));
@@ -113,6 +113,10 @@ public:
     OverlaysShowStatsCallback m_overlaysShowStatsCallback;
     OnGraphicsContextInitialized m_onGraphicsContextInitialized;
     dp::RenderInjectionHandler m_renderInjectionHandler;
+    // Size limit of the cache of the shapes of recently read tiles, 0 disables the cache.
+    uint64_t m_tileShapesCacheSizeBytes = 0;
+    // Read neighbouring tiles together after zoom changes.
+    bool m_readTilesInGroups = false;
   };
 
   DrapeEngine(Params && params);
@@ -4,6 +4,7 @@
 
 #include "indexer/classificator.hpp"
 #include "indexer/classificator_loader.hpp"
+#include "indexer/map_style_reader.hpp"
 
 #include "drape/hatching_decl.hpp"
 
@@ -50,3 +51,41 @@ UNIT_TEST(Stylist_IsAreaPattern)
   // Unrelated area types get no pattern.
   TEST(checker.GetPattern(cl.GetTypeByPath({"natural", "water"})).empty(), ());
 }
+
+UNIT_TEST(Stylist_RulesTable)
+{
+  classificator::Load();
+  auto const & cl = classif();
+  auto const style = GetStyleReader().GetCurrentStyle();
+  auto & table = df::StyleRulesTable::Instance();
+
+  uint32_t const parkType = cl.GetTypeByPath({"leisure", "park"});
+  uint32_t const reserveType = cl.GetTypeByPath({"leisure", "nature_reserve"});
+
+  feature::TypesHolder types(feature::GeomType::Area);
+  types.Add(parkType);
+  types.Add(reserveType);
+
+  size_t const count = table.GetCombinationsCount(style);
+  auto const rules = table.GetRules(style, types, 17 /* zoomLevel */);
+  TEST_EQUAL(table.GetCombinationsCount(style), count + 1, ());
+
+  // Other zoom levels of the same combination share its id.
+  auto const cached = table.GetRules(style, types, 17 /* zoomLevel */);
+  table.GetRules(style, types, 12 /* zoomLevel */);
+  TEST_EQUAL(table.GetCombinationsCount(style), count + 1, ());
+  TEST_EQUAL(cached.m_mainOverlayType, rules.m_mainOverlayType, ());
+  TEST_EQUAL(cached.m_keys.size(), rules.m_keys.size(), ());
+
+  // The rules of a single type are the type's suitable keys.
+  types.Assign(parkType);
+  auto const parkRules = table.GetRules(style, types, 17 /* zoomLevel */);
+  TEST_EQUAL(table.GetCombinationsCount(style), count + 2, ());
+  TEST_EQUAL(parkRules.m_mainOverlayType, parkType, ());
+
+  drule::KeysT keys;
+  cl.GetObject(parkType)->GetSuitable(17 /* scale */, feature::GeomType::Area, keys);
+  TEST_EQUAL(parkRules.m_keys.size(), keys.size(), ());
+  for (size_t i = 0; i < keys.size(); ++i)
+    TEST_EQUAL(parkRules.m_keys[i].m_index, keys[i].m_index, ());
+}
@@ -0,0 +1,121 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/tile_shapes_cache.hpp"
+
+#include <memory>
+#include <utility>
+
+namespace tile_shapes_cache_tests
+{
+using df::TileKey;
+using df::TileShapesCache;
+
+class TestShape : public df::MapShape
+{
+public:
+  explicit TestShape(size_t sizeBytes) : m_sizeBytes(sizeBytes) {}
+
+  void Draw(ref_ptr<dp::GraphicsContext>, ref_ptr<dp::Batcher>, ref_ptr<dp::TextureManager>) const override {}
+  size_t GetSizeBytes() const override { return m_sizeBytes; }
+
+private:
+  size_t const m_sizeBytes;
+};
+
+TileShapesCache::TileShapes MakeShapes(size_t sizeBytes)
+{
+  df::TMapShapes shapes;
+  shapes.push_back(make_unique_dp<TestShape>(sizeBytes));
+
+  TileShapesCache::TileShapes tileShapes;
+  tileShapes.m_geometry.push_back(std::make_shared<df::TMapShapes const>(std::move(shapes)));
+  return tileShapes;
+}
+
+bool NotCancelled()
+{
+  return false;
+}
+
+UNIT_TEST(TileShapesCache_FindAdd)
+{
+  TileShapesCache cache(1024 * 1024 /* maxSizeBytes */);
+  TileKey const key(1, 2, 10);
+  TEST(!cache.Find(key), ());
+
+  cache.Add(TileKey(key, 1 /* generation */, 1 /* userMarksGeneration */), MakeShapes(100), NotCancelled);
+
+  // Tiles of later generations get the cached shapes.
+  auto const shapes = cache.Find(TileKey(key, 5 /* generation */, 7 /* userMarksGeneration */));
+  TEST(shapes, ());
+  TEST_EQUAL(shapes->m_geometry.size(), 1, ());
+  TEST_EQUAL(shapes->m_geometry[0]->front()->GetSizeBytes(), 100, ());
+  TEST(!cache.Find(TileKey(1, 2, 11)), ());
+
+  cache.Add(TileKey(2, 2, 10), MakeShapes(100), [] { return true; });
+  TEST(!cache.Find(TileKey(2, 2, 10)), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 1, ());
+  TEST_EQUAL(stats.m_misses, 3, ());
+  TEST_EQUAL(stats.m_entries, 1, ());
+
+  cache.Erase(key.GetGlobalRect());
+  TEST(!cache.Find(key), ());
+  TEST_EQUAL(cache.GetStats().m_sizeBytes, 0, ());
+}
+
+UNIT_TEST(TileShapesCache_EraseRect)
+{
+  TileShapesCache cache(1024 * 1024 /* maxSizeBytes */);
+
+  // A feature is edited inside the tile (5, 5) of zoom 12 while the map is zoomed out to zoom 10,
+  // both tiles cached before must be read again when the map is zoomed in back.
+  TileKey const tile12(5, 5, 12);
+  TileKey const tile10(1, 1, 10);
+  TileKey const farTile12(100, 5, 12);
+  m2::PointD const featureCenter = tile12.GetGlobalRect().Center();
+  TEST(tile10.GetGlobalRect().IsPointInside(featureCenter), ());
+  TEST(!farTile12.GetGlobalRect().IsPointInside(featureCenter), ());
+
+  for (auto const & key : {tile12, tile10, farTile12})
+    cache.Add(key, MakeShapes(100), NotCancelled);
+
+  cache.Erase(m2::RectD(featureCenter, featureCenter));
+  TEST(!cache.Find(tile12), ());
+  TEST(!cache.Find(tile10), ());
+  TEST(cache.Find(farTile12), ());
+  TEST_EQUAL(cache.GetStats().m_entries, 1, ());
+}
+
+UNIT_TEST(TileShapesCache_Eviction)
+{
+  size_t constexpr kShapeSize = 10000;
+  auto const entrySize = TileShapesCache::GetSizeBytes(MakeShapes(kShapeSize)) + 1024;
+
+  // Room for two tiles only.
+  TileShapesCache cache(2 * entrySize /* maxSizeBytes */);
+  cache.Add(TileKey(0, 0, 10), MakeShapes(kShapeSize), NotCancelled);
+  cache.Add(TileKey(1, 0, 10), MakeShapes(kShapeSize), NotCancelled);
+  // (0, 0) becomes the most recently used tile.
+  TEST(cache.Find(TileKey(0, 0, 10)), ());
+  cache.Add(TileKey(2, 0, 10), MakeShapes(kShapeSize), NotCancelled);
+
+  TEST(cache.Find(TileKey(0, 0, 10)), ());
+  TEST(!cache.Find(TileKey(1, 0, 10)), ());
+  TEST(cache.Find(TileKey(2, 0, 10)), ());
+
+  // Too large tiles are not cached.
+  cache.Add(TileKey(3, 0, 10), MakeShapes(3 * entrySize), NotCancelled);
+  TEST(!cache.Find(TileKey(3, 0, 10)), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_evictions, 1, ());
+  TEST_EQUAL(stats.m_entries, 2, ());
+  TEST_LESS_OR_EQUAL(stats.m_sizeBytes, 2 * entrySize, ());
+
+  cache.Clear();
+  TEST(!cache.Find(TileKey(0, 0, 10)), ());
+  TEST_EQUAL(cache.GetStats().m_entries, 0, ());
+}
+}  // namespace tile_shapes_cache_tests
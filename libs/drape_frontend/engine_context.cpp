@@ -3,6 +3,7 @@
 #include "drape/texture_manager.hpp"
 #include "drape_frontend/message_subclasses.hpp"
 
+#include <memory>
 #include <utility>
 
 namespace df
@@ -10,7 +11,8 @@ namespace df
 EngineContext::EngineContext(TileKey tileKey, ref_ptr<ThreadsCommutator> commutator, ref_ptr<dp::TextureManager> texMng,
                              ref_ptr<MetalineManager> metalineMng, CustomFeaturesContextWeakPtr customFeaturesContext,
                              bool is3dBuildingsEnabled, bool isTrafficEnabled, bool isolinesEnabled,
-                             int8_t mapLangIndex, dp::BackgroundMode backgroundMode, float areaOpacity)
+                             int8_t mapLangIndex, dp::BackgroundMode backgroundMode, float areaOpacity,
+                             ref_ptr<TileShapesCache> shapesCache)
   : m_tileKey(tileKey)
   , m_commutator(commutator)
   , m_texMng(texMng)
@@ -22,6 +24,7 @@ EngineContext::EngineContext(TileKey tileKey, ref_ptr<ThreadsCommutator> commuta
   , m_mapLangIndex(mapLangIndex)
   , m_backgroundMode(backgroundMode)
   , m_areaOpacity(areaOpacity)
+  , m_shapesCache(shapesCache)
 {}
 
 ref_ptr<dp::TextureManager> EngineContext::GetTextureManager() const
@@ -36,33 +39,64 @@ ref_ptr<MetalineManager> EngineContext::GetMetalineManager() const
 
 void EngineContext::BeginReadTile()
 {
-  PostMessage(make_unique_dp<TileReadStartMessage>(m_tileKey));
+  PostMessage(make_unique_dp<TileReadStartMessage>(m_tileKey), MessagePriority::Normal);
 }
 
 void EngineContext::Flush(TMapShapes && shapes)
 {
-  PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, std::move(shapes)));
+  auto shapesPtr = std::make_shared<TMapShapes const>(std::move(shapes));
+  if (m_shapesCache)
+    m_shapes.m_geometry.push_back(shapesPtr);
+  PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, std::move(shapesPtr)), MessagePriority::Normal);
 }
 
 void EngineContext::FlushOverlays(TMapShapes && shapes)
 {
-  PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, std::move(shapes)));
+  auto shapesPtr = std::make_shared<TMapShapes const>(std::move(shapes));
+  if (m_shapesCache)
+    m_shapes.m_overlays.push_back(shapesPtr);
+  PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, std::move(shapesPtr)), MessagePriority::Normal);
 }
 
 void EngineContext::FlushTrafficGeometry(TrafficSegmentsGeometry && geometry)
 {
-  m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
-                            make_unique_dp<FlushTrafficGeometryMessage>(m_tileKey, std::move(geometry)),
-                            MessagePriority::Low);
+  if (m_shapesCache)
+    m_shapes.m_trafficGeometry = geometry;
+  PostMessage(make_unique_dp<FlushTrafficGeometryMessage>(m_tileKey, std::move(geometry)), MessagePriority::Low);
 }
 
 void EngineContext::EndReadTile()
 {
-  PostMessage(make_unique_dp<TileReadEndMessage>(m_tileKey));
+  PostMessage(make_unique_dp<TileReadEndMessage>(m_tileKey), MessagePriority::Normal);
 }
 
-void EngineContext::PostMessage(drape_ptr<Message> && message)
+bool EngineContext::FlushCachedShapes()
 {
-  m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread, std::move(message), MessagePriority::Normal);
+  if (!m_shapesCache)
+    return false;
+
+  auto const shapes = m_shapesCache->Find(m_tileKey);
+  if (!shapes)
+    return false;
+
+  for (auto const & geometry : shapes->m_geometry)
+    PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, geometry), MessagePriority::Normal);
+  for (auto const & overlays : shapes->m_overlays)
+    PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, overlays), MessagePriority::Normal);
+  TrafficSegmentsGeometry trafficGeometry(shapes->m_trafficGeometry);
+  PostMessage(make_unique_dp<FlushTrafficGeometryMessage>(m_tileKey, std::move(trafficGeometry)), MessagePriority::Low);
+  return true;
+}
+
+void EngineContext::CacheShapes(TileShapesCache::TCheckCancelledCallback const & isCancelled)
+{
+  if (m_shapesCache)
+    m_shapesCache->Add(m_tileKey, std::move(m_shapes), isCancelled);
+  m_shapes = {};
+}
+
+void EngineContext::PostMessage(drape_ptr<Message> && message, MessagePriority priority)
+{
+  m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread, std::move(message), priority);
 }
 }  // namespace df
@@ -3,6 +3,7 @@
 #include "drape_frontend/custom_features_context.hpp"
 #include "drape_frontend/map_shape.hpp"
 #include "drape_frontend/threads_commutator.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/traffic_generator.hpp"
 
 #include "drape/pointers.hpp"
@@ -23,7 +24,8 @@ public:
   EngineContext(TileKey tileKey, ref_ptr<ThreadsCommutator> commutator, ref_ptr<dp::TextureManager> texMng,
                 ref_ptr<MetalineManager> metalineMng, CustomFeaturesContextWeakPtr customFeaturesContext,
                 bool is3dBuildingsEnabled, bool isTrafficEnabled, bool isolinesEnabled, int8_t mapLangIndex,
-                dp::BackgroundMode backgroundMode, float areaOpacity);
+                dp::BackgroundMode backgroundMode, float areaOpacity, ref_ptr<TileShapesCache> shapesCache);
+  virtual ~EngineContext() = default;
 
   TileKey const & GetTileKey() const { return m_tileKey; }
   bool Is3dBuildingsEnabled() const { return m_3dBuildingsEnabled; }
@@ -43,9 +45,16 @@ public:
   void FlushTrafficGeometry(TrafficSegmentsGeometry && geometry);
   void EndReadTile();
 
-private:
-  void PostMessage(drape_ptr<Message> && message);
+  // Sends the cached shapes of the tile, returns false if there are none.
+  bool FlushCachedShapes();
+  // Puts the shapes flushed since the beginning of reading to the cache, if the cache is set.
+  void CacheShapes(TileShapesCache::TCheckCancelledCallback const & isCancelled);
+
+protected:
+  // Sends |message| to the backend renderer. Tools building tiles without renderers intercept it.
+  virtual void PostMessage(drape_ptr<Message> && message, MessagePriority priority);
 
+private:
   TileKey m_tileKey;
   ref_ptr<ThreadsCommutator> m_commutator;
   ref_ptr<dp::TextureManager> m_texMng;
@@ -57,5 +66,7 @@ private:
   int8_t m_mapLangIndex;
   dp::BackgroundMode m_backgroundMode;
   float m_areaOpacity;
+  ref_ptr<TileShapesCache> m_shapesCache;
+  TileShapesCache::TileShapes m_shapes;
 };
 }  // namespace df
@@ -1191,7 +1191,8 @@ void FrontendRenderer::InvalidateRect(m2::RectD const & gRect)
     // Remove tiles to invalidate from backend renderer.
     BaseBlockingMessage::Blocker blocker;
     m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
-                              make_unique_dp<InvalidateReadManagerRectMessage>(blocker, tiles), MessagePriority::High);
+                              make_unique_dp<InvalidateReadManagerRectMessage>(blocker, tiles, gRect),
+                              MessagePriority::High);
     blocker.Wait();
 
     // Request new tiles.
@@ -1201,6 +1202,15 @@ void FrontendRenderer::InvalidateRect(m2::RectD const & gRect)
     m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread, make_unique_dp<UpdateReadManagerMessage>(),
                               MessagePriority::UberHighSingleton);
   }
+  else
+  {
+    // Invisible tiles may be cached by the read manager.
+    BaseBlockingMessage::Blocker blocker;
+    m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                              make_unique_dp<InvalidateReadManagerRectMessage>(blocker, TTilesCollection(), gRect),
+                              MessagePriority::High);
+    blocker.Wait();
+  }
 }
 
 void FrontendRenderer::OnResize(ScreenBase const & screen)
@@ -566,4 +566,13 @@ void LineShape::Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher>
     batcher->InsertLineStrip(context, state, make_ref(&provider));
   }
 }
+
+size_t LineShape::GetSizeBytes() const
+{
+  // The spline may be shared with other shapes of the feature, only the prepared vertices are counted.
+  if (!m_lineShapeInfo)
+    return sizeof(LineShape);
+  return sizeof(LineShape) + (m_lineShapeInfo->GetLineSize() + m_lineShapeInfo->GetCapSize()) *
+                                 m_lineShapeInfo->GetBindingInfo().GetElementSize();
+}
 }  // namespace df
@@ -40,6 +40,7 @@ public:
   void Prepare(ref_ptr<dp::TextureManager> textures) const override;
   void Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
             ref_ptr<dp::TextureManager> textures) const override;
+  size_t GetSizeBytes() const override;
 
 private:
   glsl::vec2 ToShapeVertex2(m2::PointD const & vertex) const
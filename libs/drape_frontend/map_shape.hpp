@@ -8,6 +8,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <memory>
 #include <vector>
 
 namespace dp
@@ -34,6 +35,8 @@ public:
   virtual void Draw(ref_ptr<dp::GraphicsContext> context, ref_ptr<dp::Batcher> batcher,
                     ref_ptr<dp::TextureManager> textures) const = 0;
   virtual MapShapeType GetType() const { return MapShapeType::GeometryType; }
+  // Approximate size of the shape with its prepared geometry, used to limit TileShapesCache.
+  virtual size_t GetSizeBytes() const { return kDefaultSizeBytes; }
 
   void SetFeatureMinZoom(int minZoom) { m_minZoom = minZoom; }
   int GetFeatureMinZoom() const { return m_minZoom; }
@@ -43,11 +46,16 @@ public:
     return (basePt - tileCenter) * scalar;
   }
 
+protected:
+  static size_t constexpr kDefaultSizeBytes = 256;
+
 private:
   int m_minZoom = 0;
 };
 
 using TMapShapes = std::vector<drape_ptr<MapShape>>;
+// Shapes are shared by the messages and TileShapesCache, they are never changed after flushing.
+using TMapShapesPtr = std::shared_ptr<TMapShapes const>;
 
 class MapShapeMessage : public Message
 {
@@ -79,21 +87,21 @@ public:
 class MapShapeReadedMessage : public MapShapeMessage
 {
 public:
-  MapShapeReadedMessage(TileKey const & key, TMapShapes && shapes) : MapShapeMessage(key), m_shapes(std::move(shapes))
+  MapShapeReadedMessage(TileKey const & key, TMapShapesPtr shapes) : MapShapeMessage(key), m_shapes(std::move(shapes))
   {}
 
   Type GetType() const override { return Type::MapShapeReaded; }
   bool IsGraphicsContextDependent() const override { return true; }
-  TMapShapes const & GetShapes() { return m_shapes; }
+  TMapShapes const & GetShapes() { return *m_shapes; }
 
 private:
-  TMapShapes m_shapes;
+  TMapShapesPtr m_shapes;
 };
 
 class OverlayMapShapeReadedMessage : public MapShapeReadedMessage
 {
 public:
-  OverlayMapShapeReadedMessage(TileKey const & key, TMapShapes && shapes)
+  OverlayMapShapeReadedMessage(TileKey const & key, TMapShapesPtr shapes)
     : MapShapeReadedMessage(key, std::move(shapes))
   {}
 
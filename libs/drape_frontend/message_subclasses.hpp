@@ -176,9 +176,10 @@ public:
 class InvalidateReadManagerRectMessage : public BaseBlockingMessage
 {
 public:
-  InvalidateReadManagerRectMessage(Blocker & blocker, TTilesCollection const & tiles)
+  InvalidateReadManagerRectMessage(Blocker & blocker, TTilesCollection const & tiles, m2::RectD const & rect)
     : BaseBlockingMessage(blocker)
     , m_tiles(tiles)
+    , m_rect(rect)
     , m_needRestartReading(false)
   {}
 
@@ -190,10 +191,12 @@ public:
   Type GetType() const override { return Type::InvalidateReadManagerRect; }
 
   TTilesCollection const & GetTilesForInvalidate() const { return m_tiles; }
+  m2::RectD const & GetRect() const { return m_rect; }
   bool NeedRestartReading() const { return m_needRestartReading; }
 
 private:
   TTilesCollection m_tiles;
+  m2::RectD m_rect;
   bool m_needRestartReading;
 };
 
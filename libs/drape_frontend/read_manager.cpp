@@ -6,9 +6,12 @@
 #include "platform/platform.hpp"
 
 #include "base/buffer_vector.hpp"
+#include "base/logging.hpp"
 
 #include <algorithm>
 #include <functional>
+#include <map>
+#include <utility>
 
 namespace df
 {
@@ -40,7 +43,7 @@ bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l
 
 ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model, bool allow3dBuildings,
                          bool trafficEnabled, bool isolinesEnabled, dp::BackgroundMode backgroundMode,
-                         float areaOpacity)
+                         float areaOpacity, uint64_t shapesCacheSizeBytes, bool readTilesInGroups)
   : m_commutator(commutator)
   , m_model(model)
   , m_have3dBuildings(false)
@@ -51,11 +54,14 @@ ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider
   , m_mapLangIndex(StringUtf8Multilang::kDefaultCode)
   , m_backgroundMode(backgroundMode)
   , m_areaOpacity(areaOpacity)
+  , m_readTilesInGroups(readTilesInGroups)
   , m_tasksPool(64, ReadMWMTaskFactory(m_model))
   , m_counter(0)
   , m_generationCounter(0)
   , m_userMarksGenerationCounter(0)
 {
+  if (shapesCacheSizeBytes != 0)
+    m_shapesCache = make_unique_dp<TileShapesCache>(shapesCacheSizeBytes);
   Start();
 }
 
@@ -80,7 +86,9 @@ void ReadManager::Stop()
 
 void ReadManager::Restart()
 {
+  // Reading is restarted when the map data changes, so the cached shapes are dropped for sure.
   Stop();
+  ClearShapesCache();
   Start();
 }
 
@@ -94,25 +102,38 @@ void ReadManager::OnTaskFinished(threads::IRoutine * task)
     std::lock_guard lock(m_finishedTilesMutex);
 
     // decrement counter
-    ASSERT_GREATER(m_counter, 0, ());
-    if (--m_counter == 0)
+    auto const tilesCount = static_cast<int>(t->GetTilesCount());
+    ASSERT_GREATER_OR_EQUAL(m_counter, tilesCount, ());
+    m_counter -= tilesCount;
+    if (m_counter == 0)
     {
+      if (m_isCoverageTimed)
+      {
+        LOG(LDEBUG, ("All tiles are read in", m_coverageTimer.ElapsedMilliseconds(), "ms after the coverage of",
+                     m_coverageTilesCount, "tiles"));
+        m_isCoverageTimed = false;
+      }
       m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread, make_unique_dp<FinishReadingMessage>(),
                                 MessagePriority::Normal);
     }
 
-    auto const & key = t->GetTileKey();
-    if (!task->IsCancelled())
+    TTilesCollection tiles;
+    for (size_t i = 0; i < t->GetTilesCount(); ++i)
     {
-      auto const it = m_activeTiles.find(key);
+      if (t->IsTileCancelled(i))
+        continue;
+
+      auto const it = m_activeTiles.find(t->GetTileKey(i));
       ASSERT(it != m_activeTiles.end(), ());
 
       // Use the tile key from active tiles with the actual user marks generation.
-      TTilesCollection tiles;
       tiles.emplace(*it);
 
       m_activeTiles.erase(it);
+    }
 
+    if (!tiles.empty())
+    {
       m_commutator->PostMessage(
           ThreadsCommutator::ResourceUploadThread,
           make_unique_dp<FinishTileReadMessage>(std::move(tiles), true /* forceUpdateUserMarks */),
@@ -133,18 +154,30 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
 
   if (m_modeChanged || forceUpdate || MustDropAllTiles(screen))
   {
+    // Cached shapes stay valid when only the viewport has changed.
+    bool const clearShapesCache = m_modeChanged || forceUpdate;
     m_modeChanged = false;
 
     for (auto const & info : m_tileInfos)
       CancelTileInfo(info);
     m_tileInfos.clear();
 
+    if (clearShapesCache)
+      ClearShapesCache();
+
     IncreaseCounter(tiles.size());
     ++m_generationCounter;
     ++m_userMarksGenerationCounter;
 
-    for (auto const & tileKey : tiles)
-      PushTaskBackForTileKey(tileKey, texMng, metalineMng);
+    {
+      // Time to read all the tiles after a zoom change or a jump.
+      std::lock_guard lock(m_finishedTilesMutex);
+      m_coverageTimer.Reset();
+      m_coverageTilesCount = tiles.size();
+      m_isCoverageTimed = true;
+    }
+
+    PushTasksBack(std::vector<TileKey>(tiles.begin(), tiles.end()), texMng, metalineMng);
   }
   else
   {
@@ -157,7 +190,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
       ClearTileInfo(info);
 
     // Find rects that go in into viewport.
-    buffer_vector<TileKey, 8> newTiles;
+    std::vector<TileKey> newTiles;
     std::set_difference(tiles.begin(), tiles.end(), m_tileInfos.begin(), m_tileInfos.end(),
                         std::back_inserter(newTiles), LessCoverageCell());
 
@@ -172,14 +205,13 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
       ++m_userMarksGenerationCounter;
     CheckFinishedTiles(readyTiles, forceUpdateUserMarks);
 
-    for (auto const & tileKey : newTiles)
-      PushTaskBackForTileKey(tileKey, texMng, metalineMng);
+    PushTasksBack(newTiles, texMng, metalineMng);
   }
 
   m_currentViewport = screen;
 }
 
-void ReadManager::Invalidate(TTilesCollection const & keyStorage)
+void ReadManager::Invalidate(TTilesCollection const & keyStorage, m2::RectD const & rect)
 {
   TTileSet tilesToErase;
   for (auto const & info : m_tileInfos)
@@ -191,6 +223,9 @@ void ReadManager::Invalidate(TTilesCollection const & keyStorage)
     CancelTileInfo(info);
     m_tileInfos.erase(info);
   }
+
+  if (m_shapesCache != nullptr)
+    m_shapesCache->Erase(rect);
 }
 
 void ReadManager::InvalidateAll()
@@ -199,9 +234,17 @@ void ReadManager::InvalidateAll()
     CancelTileInfo(info);
   m_tileInfos.clear();
 
+  ClearShapesCache();
+
   m_modeChanged = true;
 }
 
+void ReadManager::ClearShapesCache()
+{
+  if (m_shapesCache != nullptr)
+    m_shapesCache->Clear();
+}
+
 bool ReadManager::CheckTileKey(TileKey const & tileKey) const
 {
   for (auto const & tileInfo : m_tileInfos)
@@ -217,28 +260,54 @@ bool ReadManager::MustDropAllTiles(ScreenBase const & screen) const
   return (oldScale != newScale) || !m_currentViewport.GlobalRect().IsIntersect(screen.GlobalRect());
 }
 
-void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng,
-                                         ref_ptr<MetalineManager> metalineMng)
+void ReadManager::PushTasksBack(std::vector<TileKey> const & tileKeys, ref_ptr<dp::TextureManager> texMng,
+                                ref_ptr<MetalineManager> metalineMng)
 {
   ASSERT(m_pool != nullptr, ());
-  auto context = make_unique_dp<EngineContext>(TileKey(tileKey, m_generationCounter, m_userMarksGenerationCounter),
-                                               m_commutator, texMng, metalineMng, m_customFeaturesContext,
-                                               m_have3dBuildings && m_allow3dBuildings, m_trafficEnabled,
-                                               m_isolinesEnabled, m_mapLangIndex, m_backgroundMode, m_areaOpacity);
-  std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context));
-  m_tileInfos.insert(tileInfo);
-
-  /// @todo Do we really need ReadMWMTask pool? Avoid "new" with hand-written bicycle? ;)
-  ReadMWMTask * task = m_tasksPool.Get();
-
-  task->Init(tileInfo);
-  /// @todo Can we update m_activeTiles once like IncreaseCounter and lock mutex once?
-  /// Or order is important here?
+
+  // Neighbouring tiles are read together in 2x2 blocks if there are enough blocks for all the threads.
+  bool const groupTiles = m_readTilesInGroups && tileKeys.size() >= kMaxTilesInGroup * GetReadingThreadsCount();
+
+  std::vector<TTileInfoGroup> groups;
+  std::map<std::pair<int, int>, size_t> blocks;
+  for (auto const & tileKey : tileKeys)
   {
-    std::lock_guard lock(m_finishedTilesMutex);
-    m_activeTiles.insert(TileKey(tileKey, m_generationCounter, m_userMarksGenerationCounter));
+    auto context = make_unique_dp<EngineContext>(TileKey(tileKey, m_generationCounter, m_userMarksGenerationCounter),
+                                                 m_commutator, texMng, metalineMng, m_customFeaturesContext,
+                                                 m_have3dBuildings && m_allow3dBuildings, m_trafficEnabled,
+                                                 m_isolinesEnabled, m_mapLangIndex, m_backgroundMode, m_areaOpacity,
+                                                 make_ref(m_shapesCache));
+    std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context));
+    m_tileInfos.insert(tileInfo);
+
+    if (groupTiles)
+    {
+      auto const [it, inserted] = blocks.emplace(std::make_pair(tileKey.m_x >> 1, tileKey.m_y >> 1), groups.size());
+      if (inserted)
+        groups.emplace_back();
+      groups[it->second].push_back(std::move(tileInfo));
+    }
+    else
+    {
+      groups.emplace_back().push_back(std::move(tileInfo));
+    }
+  }
+
+  for (auto const & group : groups)
+  {
+    /// @todo Do we really need ReadMWMTask pool? Avoid "new" with hand-written bicycle? ;)
+    ReadMWMTask * task = m_tasksPool.Get();
+
+    task->Init(group);
+    /// @todo Can we update m_activeTiles once like IncreaseCounter and lock mutex once?
+    /// Or order is important here?
+    {
+      std::lock_guard lock(m_finishedTilesMutex);
+      for (auto const & tileInfo : group)
+        m_activeTiles.insert(tileInfo->GetTileKey());
+    }
+    m_pool->PushBack(task);
   }
-  m_pool->PushBack(task);
 }
 
 void ReadManager::CheckFinishedTiles(TTileInfoCollection const & requestedTiles, bool forceUpdateUserMarks)
@@ -349,6 +418,7 @@ void ReadManager::SetBackgroundMode(dp::BackgroundMode mode, float areaOpacity)
 void ReadManager::SetCustomFeatures(CustomFeatures && ids)
 {
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(ids));
+  ClearShapesCache();
 }
 
 std::vector<FeatureID> ReadManager::GetCustomFeaturesArray() const
@@ -375,6 +445,7 @@ bool ReadManager::RemoveCustomFeatures(MwmSet::MwmId const & mwmId)
     return false;
 
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(features));
+  ClearShapesCache();
   return true;
 }
 
@@ -384,6 +455,7 @@ bool ReadManager::RemoveAllCustomFeatures()
     return false;
 
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(CustomFeatures());
+  ClearShapesCache();
   return true;
 }
 
@@ -3,6 +3,7 @@
 #include "drape_frontend/engine_context.hpp"
 #include "drape_frontend/read_mwm_task.hpp"
 #include "drape_frontend/tile_info.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/tile_utils.hpp"
 
 #include "geometry/screenbase.hpp"
@@ -11,7 +12,9 @@
 #include "drape/pointers.hpp"
 
 #include "base/thread_pool.hpp"
+#include "base/timer.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -32,8 +35,11 @@ uint8_t GetReadingThreadsCount();
 class ReadManager
 {
 public:
+  // |shapesCacheSizeBytes| limits the cache of the shapes of recently read tiles, 0 disables the cache.
+  // With |readTilesInGroups| neighbouring tiles are read together, see TileInfo::ReadGroupFeatures.
   ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model, bool allow3dBuildings,
-              bool trafficEnabled, bool isolinesEnabled, dp::BackgroundMode backgroundMode, float areaOpacity);
+              bool trafficEnabled, bool isolinesEnabled, dp::BackgroundMode backgroundMode, float areaOpacity,
+              uint64_t shapesCacheSizeBytes, bool readTilesInGroups);
 
   void Start();
   void Stop();
@@ -42,7 +48,9 @@ public:
   void UpdateCoverage(ScreenBase const & screen, bool have3dBuildings, bool forceUpdate, bool forceUpdateUserMarks,
                       TTilesCollection const & tiles, ref_ptr<dp::TextureManager> texMng,
                       ref_ptr<MetalineManager> metalineMng);
-  void Invalidate(TTilesCollection const & keyStorage);
+  // Cancels reading of |keyStorage| tiles and drops cached shapes of all the tiles intersecting |rect|,
+  // which is the rect of the changed map data.
+  void Invalidate(TTilesCollection const & keyStorage, m2::RectD const & rect);
   void InvalidateAll();
 
   bool CheckTileKey(TileKey const & tileKey) const;
@@ -67,15 +75,19 @@ public:
 
 private:
   void OnTaskFinished(threads::IRoutine * task);
+  void ClearShapesCache();
   bool MustDropAllTiles(ScreenBase const & screen) const;
 
-  void PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng,
-                              ref_ptr<MetalineManager> metalineMng);
+  void PushTasksBack(std::vector<TileKey> const & tileKeys, ref_ptr<dp::TextureManager> texMng,
+                     ref_ptr<MetalineManager> metalineMng);
 
   ref_ptr<ThreadsCommutator> m_commutator;
 
   MapDataProvider & m_model;
 
+  // Declared before the tiles, which refer to it.
+  drape_ptr<TileShapesCache> m_shapesCache;
+
   drape_ptr<base::ThreadPool> m_pool;
 
   ScreenBase m_currentViewport;
@@ -87,6 +99,7 @@ private:
   int8_t m_mapLangIndex;
   dp::BackgroundMode m_backgroundMode = dp::BackgroundMode::Default;
   float m_areaOpacity = 0.5f;
+  bool const m_readTilesInGroups;
 
   struct LessByTileInfo
   {
@@ -102,6 +115,10 @@ private:
   std::mutex m_finishedTilesMutex;
   uint64_t m_generationCounter;
   uint64_t m_userMarksGenerationCounter;
+  base::Timer m_coverageTimer;
+  size_t m_coverageTilesCount = 0;
+  // The reading of all the tiles after dropping them is timed by |m_coverageTimer|.
+  bool m_isCoverageTimed = false;
 
   using TTileInfoCollection = buffer_vector<std::shared_ptr<TileInfo>, 8>;
   TTilesCollection m_activeTiles;
@@ -9,10 +9,14 @@ ReadMWMTask::ReadMWMTask(MapDataProvider & model) : m_model(model)
 #endif
 }
 
-void ReadMWMTask::Init(std::shared_ptr<TileInfo> const & tileInfo)
+void ReadMWMTask::Init(TTileInfoGroup const & tileInfos)
 {
-  m_tileInfo = tileInfo;
-  m_tileKey = tileInfo->GetTileKey();
+  ASSERT(!tileInfos.empty(), ());
+  for (auto const & tileInfo : tileInfos)
+  {
+    m_tileInfos.emplace_back(tileInfo);
+    m_tileKeys.push_back(tileInfo->GetTileKey());
+  }
 #ifdef DEBUG
   m_checker = true;
 #endif
@@ -23,17 +27,26 @@ void ReadMWMTask::Reset()
 #ifdef DEBUG
   m_checker = false;
 #endif
-  m_tileInfo.reset();
+  m_tileInfos.clear();
+  m_tileKeys.clear();
   IRoutine::Reset();
 }
 
 bool ReadMWMTask::IsCancelled() const
 {
-  std::shared_ptr<TileInfo> tile = m_tileInfo.lock();
-  if (tile == nullptr)
+  if (IRoutine::IsCancelled())
     return true;
 
-  return tile->IsCancelled() || IRoutine::IsCancelled();
+  for (size_t i = 0; i < m_tileInfos.size(); ++i)
+    if (!IsTileCancelled(i))
+      return false;
+  return true;
+}
+
+bool ReadMWMTask::IsTileCancelled(size_t i) const
+{
+  std::shared_ptr<TileInfo> tile = m_tileInfos[i].lock();
+  return tile == nullptr || tile->IsCancelled() || IRoutine::IsCancelled();
 }
 
 void ReadMWMTask::Do()
@@ -42,12 +55,22 @@ void ReadMWMTask::Do()
   ASSERT(m_checker, ());
 #endif
 
-  std::shared_ptr<TileInfo> tile = m_tileInfo.lock();
-  if (tile == nullptr)
+  TTileInfoGroup tiles;
+  for (auto const & tileInfo : m_tileInfos)
+    if (auto tile = tileInfo.lock())
+      tiles.push_back(std::move(tile));
+
+  if (tiles.size() > 1)
+  {
+    TileInfo::ReadGroupFeatures(m_model, tiles);
+    return;
+  }
+
+  if (tiles.empty())
     return;
   try
   {
-    tile->ReadFeatures(m_model);
+    tiles.front()->ReadFeatures(m_model);
   }
   catch (TileInfo::ReadCanceledException &)
   {
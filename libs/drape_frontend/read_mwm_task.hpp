@@ -2,6 +2,7 @@
 
 #include "drape_frontend/tile_info.hpp"
 
+#include "base/buffer_vector.hpp"
 #include "base/thread.hpp"
 
 #include <memory>
@@ -15,14 +16,19 @@ public:
 
   void Do() override;
 
-  void Init(std::shared_ptr<TileInfo> const & tileInfo);
+  // The task reads a group of neighbouring tiles, see TileInfo::ReadGroupFeatures.
+  void Init(TTileInfoGroup const & tileInfos);
   void Reset() override;
+  // The task is cancelled when all its tiles are cancelled.
   bool IsCancelled() const override;
-  TileKey const & GetTileKey() const { return m_tileKey; }
+
+  size_t GetTilesCount() const { return m_tileKeys.size(); }
+  TileKey const & GetTileKey(size_t i) const { return m_tileKeys[i]; }
+  bool IsTileCancelled(size_t i) const;
 
 private:
-  std::weak_ptr<TileInfo> m_tileInfo;
-  TileKey m_tileKey;
+  buffer_vector<std::weak_ptr<TileInfo>, kMaxTilesInGroup> m_tileInfos;
+  buffer_vector<TileKey, kMaxTilesInGroup> m_tileKeys;
   MapDataProvider & m_model;
 
 #ifdef DEBUG
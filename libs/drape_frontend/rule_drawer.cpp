@@ -383,6 +383,8 @@ void RuleDrawer::ProcessLineStyle(FeatureType & f, Stylist const & s)
 
         ExtractTrafficGeometry(f, checkers[i].m_roadClass, m2::PolylineD(std::move(points)), oneWay, m_zoomLevel,
                                m_applyParams.m_trafficScalePtoG, m_trafficGeometry);
+        // The feature may be drawn in other tiles of the group next, they need the simplified geometry.
+        f.ResetGeometry();
         break;
       }
     }
@@ -206,22 +206,93 @@ void Stylist::ProcessKey(FeatureType & f, drule::Key const & key)
   }
 }
 
-Stylist::Stylist(FeatureType & f, uint8_t zoomLevel, int8_t deviceLang, bool forceOutdoorStyle)
-  : m_rulesHolder(forceOutdoorStyle ? drule::GetOutdoorRules() : drule::GetCurrentRules())
+namespace
+{
+MapStyle GetStylistStyle(bool forceOutdoorStyle)
 {
-#ifdef DEBUG
   auto const style = GetStyleReader().GetCurrentStyle();
-  ASSERT(classificator::IsStyleLoaded(
-             forceOutdoorStyle ? (MapStyleIsDark(style) ? MapStyleOutdoorsDark : MapStyleOutdoorsLight) : style),
-         ("Drawing rules for the current style are not loaded", style, forceOutdoorStyle));
-#endif  // DEBUG
+  if (!forceOutdoorStyle)
+    return style;
+  return MapStyleIsDark(style) ? MapStyleOutdoorsDark : MapStyleOutdoorsLight;
+}
+}  // namespace
 
-  feature::TypesHolder const types(f);
-  Classificator const & cl = forceOutdoorStyle ? GetOutdoorClassif() : classif();
+// static
+StyleRulesTable & StyleRulesTable::Instance()
+{
+  static StyleRulesTable table;
+  return table;
+}
+
+StyleRulesTable::Rules StyleRulesTable::GetRules(MapStyle style, feature::TypesHolder const & types,
+                                                 uint8_t zoomLevel)
+{
+  ASSERT_LESS(style, MapStyleCount, ());
+  if (zoomLevel > scales::UPPER_STYLE_SCALE)
+    return BuildRules(style, types, zoomLevel);
+
+  Combination combination;
+  combination.m_geomType = types.GetGeomType();
+  combination.m_types.assign(types.begin(), types.end());
+
+  uint32_t const generation = drule::GetRules(style).GetGeneration();
+  {
+    std::shared_lock lock(m_mutex);
+    Table const & table = m_tables[style];
+    if (table.m_rulesGeneration == generation)
+    {
+      auto const it = table.m_ids.find(combination);
+      if (it != table.m_ids.end())
+      {
+        auto const & rules = table.m_rules[it->second][zoomLevel];
+        if (rules)
+          return *rules;
+      }
+    }
+  }
+
+  // The classificator is walked without the lock, so the other reading threads are not blocked.
+  // Several threads may build the same rules, the first inserted ones are kept.
+  auto built = std::make_unique<Rules const>(BuildRules(style, types, zoomLevel));
+
+  std::lock_guard lock(m_mutex);
+  Table & table = m_tables[style];
+  if (table.m_rulesGeneration != generation)
+  {
+    // The rules are built for a generation of the drawing rules that is not the current one anymore.
+    if (drule::GetRules(style).GetGeneration() != generation)
+      return *built;
 
-  uint32_t mainOverlayType = 0;
+    table.m_ids.clear();
+    table.m_rules.clear();
+    table.m_rulesGeneration = generation;
+  }
+
+  auto const res = table.m_ids.emplace(std::move(combination), static_cast<uint32_t>(table.m_rules.size()));
+  if (res.second)
+    table.m_rules.emplace_back();
+
+  auto & rules = table.m_rules[res.first->second][zoomLevel];
+  if (!rules)
+    rules = std::move(built);
+  return *rules;
+}
+
+size_t StyleRulesTable::GetCombinationsCount(MapStyle style) const
+{
+  std::shared_lock lock(m_mutex);
+  return m_tables[style].m_ids.size();
+}
+
+// static
+StyleRulesTable::Rules StyleRulesTable::BuildRules(MapStyle style, feature::TypesHolder const & types,
+                                                   uint8_t zoomLevel)
+{
+  Classificator const & cl = classif(style);
+
+  Rules rules;
   if (types.Size() == 1)
-    mainOverlayType = types.front();
+    rules.m_mainOverlayType = types.front();
   else
   {
     // Determine main overlays type by priority. Priorities might be different across zoom levels
@@ -233,7 +304,7 @@ Stylist::Stylist(FeatureType & f, uint8_t zoomLevel, int8_t deviceLang, bool for
       if (priority > overlaysMaxPriority)
       {
         overlaysMaxPriority = priority;
-        mainOverlayType = t;
+        rules.m_mainOverlayType = t;
       }
     }
   }
@@ -241,7 +312,6 @@ Stylist::Stylist(FeatureType & f, uint8_t zoomLevel, int8_t deviceLang, bool for
   auto const & hatchingChecker = IsHatchingTerritoryChecker::Instance();
   auto const geomType = types.GetGeomType();
 
-  drule::KeysT keys;
   for (uint32_t t : types)
   {
     drule::KeysT typeKeys;
@@ -251,15 +321,40 @@ Stylist::Stylist(FeatureType & f, uint8_t zoomLevel, int8_t deviceLang, bool for
     for (auto & k : typeKeys)
     {
       // Take overlay drules from the main type only.
-      if (t == mainOverlayType || (k.m_type != drule::caption && k.m_type != drule::symbol &&
-                                   k.m_type != drule::shield && k.m_type != drule::pathtext))
+      if (t == rules.m_mainOverlayType || (k.m_type != drule::caption && k.m_type != drule::symbol &&
+                                           k.m_type != drule::shield && k.m_type != drule::pathtext))
       {
         if (hasHatching && k.m_type == drule::area)
           k.m_hatching = true;
-        keys.push_back(k);
+        rules.m_keys.push_back(k);
       }
     }
   }
+  return rules;
+}
+
+size_t StyleRulesTable::CombinationHash::operator()(Combination const & c) const
+{
+  size_t hash = static_cast<size_t>(c.m_geomType);
+  for (uint32_t t : c.m_types)
+    hash = hash * 31 + t;
+  return hash;
+}
+
+Stylist::Stylist(FeatureType & f, uint8_t zoomLevel, int8_t deviceLang, bool forceOutdoorStyle)
+  : m_style(GetStylistStyle(forceOutdoorStyle))
+  , m_rulesHolder(drule::GetRules(m_style))
+{
+  ASSERT(classificator::IsStyleLoaded(m_style),
+         ("Drawing rules for the current style are not loaded", m_style, forceOutdoorStyle));
+
+  feature::TypesHolder const types(f);
+  Classificator const & cl = classif(m_style);
+  auto const geomType = types.GetGeomType();
+
+  auto rules = StyleRulesTable::Instance().GetRules(m_style, types, zoomLevel);
+  uint32_t const mainOverlayType = rules.m_mainOverlayType;
+  drule::KeysT & keys = rules.m_keys;
 
   feature::FilterRulesByRuntimeSelector(f, zoomLevel, m_rulesHolder, keys);
 
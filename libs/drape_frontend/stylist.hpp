@@ -1,12 +1,22 @@
 #pragma once
 
 #include "indexer/drawing_rules.hpp"
+#include "indexer/feature_data.hpp"
 #include "indexer/ftypes_matcher.hpp"
+#include "indexer/map_style.hpp"
 #include "indexer/road_shields_parser.hpp"
+#include "indexer/scales.hpp"
 
 #include "base/buffer_vector.hpp"
 
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class FeatureType;
 
@@ -96,6 +106,64 @@ private:
   int8_t m_mwmRegionLang = StringUtf8Multilang::kUnsupportedLanguageCode;
 };
 
+// Drawing rule keys of the feature types combinations per style and zoom level. Mwms contain few distinct
+// combinations of types, so the keys are resolved on the first request of a combination and then
+// Stylist looks them up instead of walking the classificator for every feature.
+class StyleRulesTable
+{
+public:
+  struct Rules
+  {
+    // The type whose overlay drules (captions, symbols, shields, pathtexts) are used.
+    uint32_t m_mainOverlayType = 0;
+    // Keys of all the types before the filtering by runtime selectors.
+    drule::KeysT m_keys;
+  };
+
+  static StyleRulesTable & Instance();
+
+  Rules GetRules(MapStyle style, feature::TypesHolder const & types, uint8_t zoomLevel);
+
+  // Number of the resolved combinations of types, used in tests.
+  size_t GetCombinationsCount(MapStyle style) const;
+
+private:
+  StyleRulesTable() = default;
+
+  static Rules BuildRules(MapStyle style, feature::TypesHolder const & types, uint8_t zoomLevel);
+
+  struct Combination
+  {
+    bool operator==(Combination const & rhs) const
+    {
+      return m_geomType == rhs.m_geomType && m_types == rhs.m_types;
+    }
+
+    feature::GeomType m_geomType = feature::GeomType::Undefined;
+    buffer_vector<uint32_t, feature::kMaxTypesCount> m_types;
+  };
+
+  struct CombinationHash
+  {
+    size_t operator()(Combination const & c) const;
+  };
+
+  using ZoomRules = std::array<std::unique_ptr<Rules const>, scales::UPPER_STYLE_SCALE + 1>;
+
+  struct Table
+  {
+    // Generation of the style's drawing rules the table is built for.
+    uint32_t m_rulesGeneration = 0;
+    std::unordered_map<Combination, uint32_t, CombinationHash> m_ids;
+    // Rules by ids of the combinations and zoom levels, resolved on demand.
+    std::vector<ZoomRules> m_rules;
+  };
+
+  // Readers look the resolved rules up under a shared lock, new rules are inserted under an exclusive one.
+  mutable std::shared_mutex m_mutex;
+  std::array<Table, MapStyleCount> m_tables;
+};
+
 class Stylist
 {
 public:
@@ -119,6 +187,7 @@ public:
 private:
   void ProcessKey(FeatureType & f, drule::Key const & key);
 
+  MapStyle const m_style;
   drule::RulesHolder const & m_rulesHolder;
 };
 
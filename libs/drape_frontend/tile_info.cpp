@@ -8,6 +8,8 @@
 #include "base/scope_guard.hpp"
 
 #include <algorithm>
+#include <memory>
+#include <utility>
 
 namespace df
 {
@@ -47,25 +49,114 @@ void TileInfo::ReadFeatures(MapDataProvider const & model)
   // Reading can be interrupted by exception throwing
   SCOPE_GUARD(ReleaseReadTile, std::bind(&EngineContext::EndReadTile, m_context.get()));
 
+  // Shapes of a recently read tile are sent again without reading its features.
+  if (!m_context->FlushCachedShapes())
+  {
+    ReadShapes(model);
+    m_context->CacheShapes(std::bind(&TileInfo::IsCancelled, this));
+  }
+#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
+  DrapeMeasurer::Instance().EndTileReading();
+#endif
+}
+
+void TileInfo::ReadShapes(MapDataProvider const & model)
+{
   ReadFeatureIndex(model);
   ThrowIfCancelled();
 
   m_context->GetMetalineManager()->Update(m_mwms);
 
-  if (!m_featureInfo.empty())
-  {
-    std::sort(m_featureInfo.begin(), m_featureInfo.end());
+  if (m_featureInfo.empty())
+    return;
+
+  std::sort(m_featureInfo.begin(), m_featureInfo.end());
 
-    RuleDrawer drawer(std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName, make_ref(m_context),
-                      m_context->GetMapLangIndex());
-    model.ReadFeatures([&drawer](FeatureType & ft) { drawer(ft); }, m_featureInfo);
+  RuleDrawer drawer(std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName, make_ref(m_context),
+                    m_context->GetMapLangIndex());
+  model.ReadFeatures([&drawer](FeatureType & ft) { drawer(ft); }, m_featureInfo);
 #ifdef DRAW_TILE_NET
-    drawer.DrawTileNet();
+  drawer.DrawTileNet();
 #endif
+}
+
+// static
+void TileInfo::ReadGroupFeatures(MapDataProvider const & model, TTileInfoGroup const & tiles)
+{
+  for (auto const & tile : tiles)
+    tile->m_context->BeginReadTile();
+
+  SCOPE_GUARD(ReleaseReadTiles, [&tiles]()
+  {
+    for (auto const & tile : tiles)
+      tile->m_context->EndReadTile();
+  });
+
+  // Tiles which are not in the shapes cache and the features of their indices.
+  TTileInfoGroup readTiles;
+  std::vector<std::pair<FeatureID, size_t>> features;
+  for (auto const & tile : tiles)
+  {
+    if (tile->m_context->FlushCachedShapes())
+      continue;
+
+    try
+    {
+      tile->ReadFeatureIndex(model);
+      tile->ThrowIfCancelled();
+    }
+    catch (ReadCanceledException &)
+    {
+      continue;
+    }
+
+    tile->m_context->GetMetalineManager()->Update(tile->m_mwms);
+    for (auto const & id : tile->m_featureInfo)
+      features.emplace_back(id, readTiles.size());
+    readTiles.push_back(tile);
   }
-#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
-  DrapeMeasurer::Instance().EndTileReading();
+
+  std::sort(features.begin(), features.end());
+  std::vector<FeatureID> ids;
+  ids.reserve(features.size());
+  for (auto const & feature : features)
+    if (ids.empty() || ids.back() != feature.first)
+      ids.push_back(feature.first);
+
+  if (!ids.empty())
+  {
+    std::vector<std::unique_ptr<RuleDrawer>> drawers;
+    drawers.reserve(readTiles.size());
+    for (auto const & tile : readTiles)
+    {
+      // Features of the empty tiles are never drawn.
+      if (tile->m_featureInfo.empty())
+      {
+        drawers.emplace_back();
+        continue;
+      }
+      drawers.push_back(std::make_unique<RuleDrawer>(std::bind(&TileInfo::IsCancelled, tile.get()),
+                                                     model.m_isCountryLoadedByName, make_ref(tile->m_context),
+                                                     tile->m_context->GetMapLangIndex()));
+    }
+
+    model.ReadFeatures([&features, &drawers](FeatureType & ft)
+    {
+      auto const & id = ft.GetID();
+      auto it = std::lower_bound(features.begin(), features.end(), id,
+                                 [](auto const & feature, FeatureID const & value) { return feature.first < value; });
+      for (; it != features.end() && it->first == id; ++it)
+        (*drawers[it->second])(ft);
+    }, ids);
+#ifdef DRAW_TILE_NET
+    for (auto const & drawer : drawers)
+      if (drawer)
+        drawer->DrawTileNet();
 #endif
+  }
+
+  for (auto const & tile : readTiles)
+    tile->m_context->CacheShapes(std::bind(&TileInfo::IsCancelled, tile.get()));
 }
 
 void TileInfo::Cancel()
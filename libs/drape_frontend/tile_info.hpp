@@ -5,10 +5,12 @@
 
 #include "indexer/feature_decl.hpp"
 
+#include "base/buffer_vector.hpp"
 #include "base/exception.hpp"
 #include "base/macros.hpp"
 
 #include <atomic>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -17,6 +19,10 @@ class FeatureType;
 namespace df
 {
 class MapDataProvider;
+class TileInfo;
+
+size_t constexpr kMaxTilesInGroup = 4;
+using TTileInfoGroup = buffer_vector<std::shared_ptr<TileInfo>, kMaxTilesInGroup>;
 
 class TileInfo
 {
@@ -26,6 +32,10 @@ public:
   TileInfo(drape_ptr<EngineContext> && engineContext);
 
   void ReadFeatures(MapDataProvider const & model);
+  // Reads neighbouring tiles of the same zoom level together. Features which are indexed in several
+  // tiles of the group, e.g. the ones crossing the tile borders, are read and decoded once.
+  // Cancelled tiles are skipped, the other ones are read to the end.
+  static void ReadGroupFeatures(MapDataProvider const & model, TTileInfoGroup const & tiles);
   void Cancel();
   bool IsCancelled() const;
 
@@ -34,6 +44,7 @@ public:
 
 private:
   void ReadFeatureIndex(MapDataProvider const & model);
+  void ReadShapes(MapDataProvider const & model);
   void ThrowIfCancelled() const;
   bool DoNeedReadIndex() const;
 
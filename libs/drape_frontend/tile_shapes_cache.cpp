@@ -0,0 +1,124 @@
+#include "drape_frontend/tile_shapes_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+namespace df
+{
+TileShapesCache::TileShapesCache(uint64_t maxSizeBytes) : m_maxSizeBytes(maxSizeBytes) {}
+
+TileShapesCache::TileShapesPtr TileShapesCache::Find(TileKey const & key)
+{
+  std::lock_guard<std::mutex> lock(m_mu);
+  auto const it = m_index.find(key);
+  if (it == m_index.end())
+  {
+    ++m_stats.m_misses;
+    return nullptr;
+  }
+
+  ++m_stats.m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->m_shapes;
+}
+
+void TileShapesCache::Add(TileKey const & key, TileShapes && shapes, TCheckCancelledCallback const & isCancelled)
+{
+  uint64_t const sizeBytes = sizeof(Entry) + GetSizeBytes(shapes);
+  if (sizeBytes > m_maxSizeBytes)
+    return;
+
+  auto tileShapes = std::make_shared<TileShapes const>(std::move(shapes));
+
+  std::lock_guard<std::mutex> lock(m_mu);
+  if (isCancelled())
+    return;
+
+  // The tile may be read again while its previous shapes are cached.
+  if (auto const it = m_index.find(key); it != m_index.end())
+    EraseEntry(it->second);
+
+  while (m_stats.m_sizeBytes + sizeBytes > m_maxSizeBytes)
+  {
+    ASSERT(!m_entries.empty(), ());
+    EraseEntry(std::prev(m_entries.end()));
+    ++m_stats.m_evictions;
+  }
+
+  TileKey const coverageKey(key.m_x, key.m_y, key.m_zoomLevel);
+  m_entries.push_front({coverageKey, std::move(tileShapes), sizeBytes});
+  m_index.emplace(coverageKey, m_entries.begin());
+  m_stats.m_sizeBytes += sizeBytes;
+  m_stats.m_entries = m_entries.size();
+}
+
+void TileShapesCache::Erase(m2::RectD const & rect)
+{
+  std::lock_guard<std::mutex> lock(m_mu);
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    auto const next = std::next(it);
+    if (rect.IsIntersect(it->m_key.GetWrappedDataRect()))
+      EraseEntry(it);
+    it = next;
+  }
+}
+
+void TileShapesCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mu);
+  m_index.clear();
+  m_entries.clear();
+  m_stats.m_sizeBytes = 0;
+  m_stats.m_entries = 0;
+}
+
+TileShapesCache::Stats TileShapesCache::GetStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mu);
+  return m_stats;
+}
+
+// static
+uint64_t TileShapesCache::GetSizeBytes(TileShapes const & shapes)
+{
+  uint64_t sizeBytes = 0;
+  auto const addShapes = [&sizeBytes](std::vector<TMapShapesPtr> const & chunks)
+  {
+    for (auto const & chunk : chunks)
+      for (auto const & shape : *chunk)
+        sizeBytes += shape->GetSizeBytes();
+  };
+  addShapes(shapes.m_geometry);
+  addShapes(shapes.m_overlays);
+
+  for (auto const & geometry : shapes.m_trafficGeometry)
+    for (auto const & segment : geometry.second)
+      sizeBytes += sizeof(segment) + segment.second.m_polyline.GetSize() * sizeof(m2::PointD);
+  return sizeBytes;
+}
+
+void TileShapesCache::EraseEntry(Entries::iterator it)
+{
+  m_stats.m_sizeBytes -= it->m_sizeBytes;
+  m_index.erase(it->m_key);
+  m_entries.erase(it);
+  m_stats.m_entries = m_entries.size();
+}
+
+std::string DebugPrint(TileShapesCache::Stats const & stats)
+{
+  std::ostringstream os;
+  os << "TileShapesCache::Stats [";
+  os << "hits: " << stats.m_hits << ", ";
+  os << "misses: " << stats.m_misses << ", ";
+  os << "evictions: " << stats.m_evictions << ", ";
+  os << "entries: " << stats.m_entries << ", ";
+  os << "size bytes: " << stats.m_sizeBytes;
+  os << "]";
+  return os.str();
+}
+}  // namespace df
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/tile_key.hpp"
+#include "drape_frontend/tile_utils.hpp"
+#include "drape_frontend/traffic_generator.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace df
+{
+// LRU cache of the shapes of recently read tiles. The shapes keep their prepared CPU-side geometry,
+// so a tile which comes into view again is batched from them without reading and styling its features.
+// The shapes are valid for the current map data, style and reading mode only, ReadManager clears
+// the cache when any of them changes.
+class TileShapesCache
+{
+public:
+  struct TileShapes
+  {
+    std::vector<TMapShapesPtr> m_geometry;
+    std::vector<TMapShapesPtr> m_overlays;
+    TrafficSegmentsGeometry m_trafficGeometry;
+  };
+
+  using TileShapesPtr = std::shared_ptr<TileShapes const>;
+  using TCheckCancelledCallback = std::function<bool()>;
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    uint64_t m_entries = 0;
+    uint64_t m_sizeBytes = 0;
+  };
+
+  explicit TileShapesCache(uint64_t maxSizeBytes);
+
+  // Tiles are looked up by coordinates and zoom level, generations of the keys are ignored.
+  TileShapesPtr Find(TileKey const & key);
+
+  // |isCancelled| is checked under the lock of the cache. Tiles are cancelled before their shapes
+  // are erased, so shapes of a cancelled tile are never added after Erase() or Clear().
+  void Add(TileKey const & key, TileShapes && shapes, TCheckCancelledCallback const & isCancelled);
+
+  // Erases the shapes of the tiles of all zoom levels which intersect |rect|.
+  void Erase(m2::RectD const & rect);
+  void Clear();
+
+  Stats GetStats() const;
+
+  static uint64_t GetSizeBytes(TileShapes const & shapes);
+
+private:
+  struct Entry
+  {
+    TileKey m_key;
+    TileShapesPtr m_shapes;
+    uint64_t m_sizeBytes = 0;
+  };
+
+  using Entries = std::list<Entry>;
+
+  void EraseEntry(Entries::iterator it);
+
+  uint64_t const m_maxSizeBytes;
+
+  mutable std::mutex m_mu;
+  // The most recently used tiles are in the front.
+  Entries m_entries;
+  std::map<TileKey, Entries::iterator> m_index;
+  Stats m_stats;
+};
+
+std::string DebugPrint(TileShapesCache::Stats const & stats);
+}  // namespace df
@@ -1,5 +1,6 @@
 #include "indexer/centers_table.hpp"
 
+#include "coding/files_container.hpp"
 #include "coding/geometry_coding.hpp"
 #include "coding/point_coding.hpp"
 #include "coding/reader.hpp"
@@ -11,6 +12,8 @@
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 
+#include "defines.hpp"
+
 namespace search
 {
 
@@ -31,16 +34,26 @@ bool CentersTable::Get(uint32_t id, m2::PointD & center)
   if (!m_map->Get(id, pointu))
     return false;
 
-  if (m_version == Version::V0)
-    center = PointUToPointD(pointu, m_codingParams.GetCoordBits());
-  else if (m_version == Version::V1)
-    center = PointUToPointD(pointu, m_codingParams.GetCoordBits(), m_limitRect);
-  else
-    CHECK(false, ("Unknown CentersTable format."));
-
+  center = ToPointD(pointu);
   return true;
 }
 
+void CentersTable::Get(std::vector<uint32_t> const & ids, std::vector<std::optional<m2::PointD>> & centers) const
+{
+  centers.assign(ids.size(), {});
+  m_map->GetThreadsafe(ids, [&](size_t i, m2::PointU const & pointu) { centers[i] = ToPointD(pointu); });
+}
+
+m2::PointD CentersTable::ToPointD(m2::PointU const & pointu) const
+{
+  if (m_version == Version::V0)
+    return PointUToPointD(pointu, m_codingParams.GetCoordBits());
+  if (m_version == Version::V1)
+    return PointUToPointD(pointu, m_codingParams.GetCoordBits(), m_limitRect);
+  CHECK(false, ("Unknown CentersTable format."));
+  return {};
+}
+
 // CentersTable ------------------------------------------------------------------------------------
 std::unique_ptr<CentersTable> CentersTable::LoadV1(Reader & reader)
 {
@@ -69,6 +82,17 @@ std::unique_ptr<CentersTable> CentersTable::LoadV1(Reader & reader)
   return table;
 }
 
+// static
+std::unique_ptr<CentersTable> CentersTable::Load(FilesContainerR const & cont)
+{
+  auto const section = cont.GetReader(CENTERS_FILE_TAG);
+  auto reader = section.GetPtr()->CreateSubReader(0, section.Size());
+  auto table = LoadV1(*reader);
+  if (table)
+    table->m_sectionReader = std::move(reader);
+  return table;
+}
+
 bool CentersTable::Init(Reader & reader, serial::GeometryCodingParams const & codingParams, m2::RectD const & limitRect)
 {
   m_codingParams = codingParams;
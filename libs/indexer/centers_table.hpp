@@ -7,6 +7,7 @@
 #include "geometry/point2d.hpp"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 class FilesContainerR;
@@ -53,6 +54,11 @@ public:
   // false if table does not have entry for the feature.
   [[nodiscard]] bool Get(uint32_t id, m2::PointD & center);
 
+  // Gets centers of all features identified by |ids| decoding every block of the table once.
+  // |centers[i]| is empty if table does not have entry for |ids[i]|. Doesn't use the cache of
+  // single Get calls, so it's safe to call concurrently.
+  void Get(std::vector<uint32_t> const & ids, std::vector<std::optional<m2::PointD>> & centers) const;
+
   uint64_t Count() const { return m_map->Count(); }
 
   /// Loads CentersTable instance.
@@ -60,13 +66,21 @@ public:
   /// @return nullptr if CentersTable can't be loaded.
   static std::unique_ptr<CentersTable> LoadV1(Reader & reader);
 
+  /// Loads CentersTable instance from the CENTERS_FILE_TAG section of |cont|.
+  /// Unlike LoadV1 the table owns a reader of the section.
+  /// @return nullptr if CentersTable can't be loaded.
+  static std::unique_ptr<CentersTable> Load(FilesContainerR const & cont);
+
 private:
   using Map = MapUint32ToValue<m2::PointU>;
 
   bool Init(Reader & reader, serial::GeometryCodingParams const & codingParams, m2::RectD const & limitRect);
 
+  m2::PointD ToPointD(m2::PointU const & pointu) const;
+
   serial::GeometryCodingParams m_codingParams;
   std::unique_ptr<Map> m_map;
+  std::unique_ptr<Reader> m_sectionReader;
   std::unique_ptr<Reader> m_centersSubreader;
   m2::RectD m_limitRect;
   Version m_version = Version::Latest;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "coding/geometry_coding.hpp"
 #include "coding/reader.hpp"
 
 namespace feature
@@ -12,7 +13,8 @@ public:
     V0 = 0,
     V1,  // 2025.06, get some free bits in Feature::Header2
     V2,  // 2026.03, RouteRelation keep members order, prev + ReadVarInt.
-    Latest = V2
+    V3,  // 2026.10, group varint deltas of inner paths, inner triangles and outer paths.
+    Latest = V3
   };
 
   template <typename Sink>
@@ -44,7 +46,15 @@ inline std::string DebugPrint(DatSectionHeader::Version v)
   switch (v)
   {
   case DatSectionHeader::Version::V0: return "V0";
-  default: return "Latest(V1)";
+  case DatSectionHeader::Version::V1: return "V1";
+  case DatSectionHeader::Version::V2: return "V2";
+  case DatSectionHeader::Version::V3: return "V3";
   }
+  return "Unknown";
+}
+
+inline coding::DeltasEncoding GetDeltasEncoding(DatSectionHeader::Version v)
+{
+  return v >= DatSectionHeader::Version::V3 ? coding::DeltasEncoding::GroupVarInt : coding::DeltasEncoding::VarInt;
 }
 }  // namespace feature
@@ -51,8 +51,11 @@ DataHeader::DataHeader(FilesContainerR const & cont)
 
 serial::GeometryCodingParams DataHeader::GetGeometryCodingParams(int scaleIndex) const
 {
-  return {static_cast<uint8_t>(m_codingParams.GetCoordBits() - (m_scales.back() - m_scales[scaleIndex]) / 2),
-          m_codingParams.GetBasePointUint64()};
+  serial::GeometryCodingParams cp(
+      static_cast<uint8_t>(m_codingParams.GetCoordBits() - (m_scales.back() - m_scales[scaleIndex]) / 2),
+      m_codingParams.GetBasePointUint64());
+  cp.SetDeltasEncoding(m_codingParams.GetDeltasEncoding());
+  return cp;
 }
 
 m2::RectD DataHeader::GetBounds() const
@@ -24,7 +24,9 @@ public:
     : m_factory(factory)
     , m_stop(std::move(stop))
   {
-    m_fn = [&fn](uint32_t index, FeatureSource & src) { ReadFeatureType(fn, src, index); };
+    // Original features are loaded into the same object to avoid allocations for every feature.
+    m_fn = [&fn, ft = std::make_shared<FeatureType>()](uint32_t index, FeatureSource & src)
+    { ReadFeatureType(fn, src, index, *ft); };
   }
 
   // Reads features visible at |scale| covered by |cov| from mwm and applies |m_fn| to them.
@@ -85,9 +87,9 @@ private:
   DataSource::StopSearchCallback m_stop;
 
 private:
-  static void ReadFeatureType(DataSource::FeatureCallback const & fn, FeatureSource & src, uint32_t index)
+  static void ReadFeatureType(DataSource::FeatureCallback const & fn, FeatureSource & src, uint32_t index,
+                              FeatureType & original)
   {
-    std::unique_ptr<FeatureType> ft;
     switch (src.GetFeatureStatus(index))
     {
     case FeatureStatus::Deleted:
@@ -95,18 +97,18 @@ private:
     case FeatureStatus::Created:
     case FeatureStatus::Modified:
     {
-      ft = src.GetModifiedFeature(index);
-      break;
+      auto const ft = src.GetModifiedFeature(index);
+      CHECK(ft, ());
+      fn(*ft);
+      return;
     }
     case FeatureStatus::Untouched:
     {
-      ft = src.GetOriginalFeature(index);
-      break;
+      src.GetOriginalFeature(index, original);
+      fn(original);
+      return;
     }
     }
-
-    CHECK(ft, ());
-    fn(*ft);
   }
 };
 
@@ -188,16 +190,46 @@ std::unique_ptr<MwmInfo> DataSource::CreateInfo(platform::LocalCountryFile const
 
 std::unique_ptr<MwmValue> DataSource::CreateValue(MwmInfo & info) const
 {
+  auto & infoEx = dynamic_cast<MwmInfoEx &>(info);
   platform::LocalCountryFile const & localFile = info.GetLocalFile();
-  auto p = std::make_unique<MwmValue>(localFile);
 
-  p->SetTable(dynamic_cast<MwmInfoEx &>(info));
+  std::unique_ptr<MwmValue> p;
+  if (m_mmapMode && !localFile.IsInBundle())
+    p = CreateMappedValue(infoEx);
+  else
+    p = std::make_unique<MwmValue>(localFile);
+
+  p->SetTable(infoEx);
 
   p->m_metaDeserializer = indexer::MetadataDeserializer::Load(p->m_cont);
   CHECK(p->m_metaDeserializer, ());
   return p;
 }
 
+std::unique_ptr<MwmValue> DataSource::CreateMappedValue(MwmInfoEx & info) const
+{
+  std::string const path = info.GetLocalFile().GetPath(MapFileType::Map);
+  if (auto mapping = info.m_mapping.lock())
+    return std::make_unique<MwmValue>(std::make_unique<MmapReader>(path, std::move(mapping)), info.GetLocalFile());
+
+  // Most of the sections are accessed randomly, so readahead only wastes the page cache.
+  auto reader = std::make_unique<MmapReader>(path, MmapReader::Advice::Random);
+  auto const * mapped = reader.get();
+  info.m_mapping = reader->GetInnerData();
+
+  auto value = std::make_unique<MwmValue>(std::move(reader), info.GetLocalFile());
+  value->m_cont.ForEachTagInfo([mapped](FilesContainerR::TagInfo const & section)
+  {
+    // Small sections which are read every time an mwm is opened.
+    if (section.m_tag == HEADER_FILE_TAG || section.m_tag == VERSION_FILE_TAG ||
+        section.m_tag == FEATURE_OFFSETS_FILE_TAG || section.m_tag == REGION_INFO_FILE_TAG)
+    {
+      mapped->Advise(section.m_offset, section.m_size, MmapReader::Advice::WillNeed);
+    }
+  });
+  return value;
+}
+
 std::pair<MwmSet::MwmId, MwmSet::RegResult> DataSource::RegisterMap(LocalCountryFile const & localFile)
 {
   return Register(localFile);
@@ -305,19 +337,23 @@ void DataSource::ReadFeatures(FeatureCallback const & fn, std::vector<FeatureID>
     {
       // Prepare features reading.
       auto src = (*m_factory)(handle);
+      FeatureType original;
       do
       {
         auto const fts = src->GetFeatureStatus(fidIter->m_index);
         ASSERT_NOT_EQUAL(FeatureStatus::Deleted, fts,
                          ("Deleted feature was cached. It should not be here. Please review your code."));
-        std::unique_ptr<FeatureType> ft;
         if (fts == FeatureStatus::Modified || fts == FeatureStatus::Created)
-          ft = src->GetModifiedFeature(fidIter->m_index);
+        {
+          auto const ft = src->GetModifiedFeature(fidIter->m_index);
+          CHECK(ft, ());
+          fn(*ft);
+        }
         else
-          ft = src->GetOriginalFeature(fidIter->m_index);
-
-        CHECK(ft, ());
-        fn(*ft);
+        {
+          src->GetOriginalFeature(fidIter->m_index, original);
+          fn(original);
+        }
       }
       while (++fidIter != endIter && id == fidIter->m_mwmId);
     }
@@ -54,6 +54,13 @@ public:
     return (*m_factory)(handle);
   }
 
+  /// In mmap mode every mwm file is mapped into memory once and all MwmValue-s of the mwm read
+  /// sections right from the mapping: there are no FileReader page cache copies and locks,
+  /// and succinct tables are used in place. Mwms from the application bundle are read as usual.
+  /// Affects mwms opened after the call, so it should be set before the data source is used.
+  void SetMmapMode(bool enabled) { m_mmapMode = enabled; }
+  bool IsMmapMode() const { return m_mmapMode; }
+
 protected:
   using ReaderCallback =
       std::function<void(MwmSet::MwmHandle const & handle, covering::CoveringGetter & cov, int scale)>;
@@ -70,7 +77,10 @@ protected:
   /// @}
 
 private:
+  std::unique_ptr<MwmValue> CreateMappedValue(MwmInfoEx & info) const;
+
   std::unique_ptr<FeatureSourceFactory> m_factory;
+  bool m_mmapMode = false;
 };
 
 // DataSource which operates with features from mwm file and does not support features creation
@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <vector>
 
 namespace covering
@@ -75,6 +76,16 @@ public:
       m_sorter(CellFeatureBucketTuple(CellFeaturePair(cell, index), bucket));
   }
 
+  /// Moves the displaceable features of |rhs| to this manager, e.g. the ones collected by other threads.
+  /// The order of the features doesn't matter, Displace() sorts them.
+  template <typename OtherSorter>
+  void Append(DisplacementManager<OtherSorter> & rhs)
+  {
+    m_storage.insert(m_storage.end(), std::make_move_iterator(rhs.m_storage.begin()),
+                     std::make_move_iterator(rhs.m_storage.end()));
+    rhs.m_storage.clear();
+  }
+
   /// Check features intersection and supress drawing of intersected features.
   /// As a result some features may have bigger scale parameter than style describes.
   /// But every feature has MaxScale at least.
@@ -128,6 +139,9 @@ public:
   }
 
 private:
+  template <typename OtherSorter>
+  friend class DisplacementManager;
+
   struct DisplaceableNode
   {
     uint32_t m_index;
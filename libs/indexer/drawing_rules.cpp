@@ -309,6 +309,7 @@ void RulesHolder::LoadFromFormat(DrulesFormat const & fmt, size_t variant, Class
 
   InitBackgroundColors(fmt, variant);
   InitColors(fmt, variant);
+  ++m_generation;
 }
 
 DrulesFormat DecodeRules(MapStyle mapStyle)
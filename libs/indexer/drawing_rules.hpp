@@ -100,6 +100,9 @@ public:
 
   bool IsEmpty() const { return m_dRules.empty(); }
 
+  // Incremented by every LoadFromFormat(), so caches of resolved keys can detect reloaded rules.
+  uint32_t GetGeneration() const { return m_generation; }
+
   template <class ToDo>
   void ForEachRule(ToDo && toDo)
   {
@@ -127,6 +130,8 @@ private:
   std::deque<ShieldRuleHolder> m_shieldRules;
 
   std::vector<BaseRule *> m_dRules;
+
+  uint32_t m_generation = 0;
 };
 
 RulesHolder & GetCurrentRules();
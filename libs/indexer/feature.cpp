@@ -191,6 +191,34 @@ FeatureType::FeatureType(SharedLoadInfo const * loadInfo, std::vector<uint8_t> &
   m_header = Header(m_data);  // Parse the header and optional name/layer/addinfo.
 }
 
+void FeatureType::Reset(SharedLoadInfo const * loadInfo)
+{
+  CHECK(loadInfo, ());
+  m_loadInfo = loadInfo;
+
+  m_header = 0;
+  m_types = {};
+  m_id = {};
+  m_params.MakeZero();
+  m_center = m2::PointD();
+  m_limitRect = m2::RectD();
+  m_points.clear();
+  m_triangles.clear();
+  m_metadata.Clear();
+  m_metaIds.clear();
+  m_parsed.Reset();
+  m_offsets.Reset();
+  m_ptsSimpMask = 0;
+  m_relationIDs.clear();
+  m_hasRelations = false;
+  m_innerStats = {};
+}
+
+void FeatureType::ParseHeader()
+{
+  m_header = Header(m_data);
+}
+
 FeatureType::FeatureType(FeatureID fid, uint32_t type)
 {
   m_id = std::move(fid);
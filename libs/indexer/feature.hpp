@@ -34,12 +34,16 @@ class FeatureType
   // Test-only friend: lets MockTestFeature populate m_points / m_limitRect /
   // m_header / m_parsed directly without going through a real .mwm load.
   friend class MockTestFeature;
-
-  FeatureType() = default;
+  friend class FeaturesVector;
 
 public:
   using GeometryOffsets = buffer_vector<uint32_t, feature::DataHeader::kMaxScalesCount>;
 
+  /// Empty feature to be loaded with FeaturesVector::GetByIndex(index, ft) or
+  /// FeatureSource::GetOriginalFeature(index, ft). One object may be loaded many times,
+  /// its buffers are reused, so loading of the next feature doesn't allocate memory in most cases.
+  FeatureType() = default;
+
   FeatureType(feature::SharedLoadInfo const * loadInfo, std::vector<uint8_t> && buffer);
   FeatureType(FeatureID fid, uint32_t type);
 
@@ -244,6 +248,11 @@ private:
     }
   };
 
+  /// Clears all loaded and parsed data, but keeps the allocated buffers (including |m_data|).
+  void Reset(feature::SharedLoadInfo const * loadInfo);
+  /// Parses the header from |m_data|.
+  void ParseHeader();
+
   void ParseTypes();
   void ParseCommon();
   void ParseMetadata();
@@ -41,6 +41,14 @@ std::unique_ptr<FeatureType> FeatureSource::GetOriginalFeature(uint32_t index) c
   return ft;
 }
 
+void FeatureSource::GetOriginalFeature(uint32_t index, FeatureType & ft) const
+{
+  ASSERT(m_handle.IsAlive(), ());
+  ASSERT(m_vector, ());
+  m_vector->GetByIndex(index, ft);
+  ft.SetID({GetMwmId(), index});
+}
+
 feature::RouteRelation FeatureSource::GetRelation(uint32_t index) const
 {
   ASSERT(m_handle.IsAlive(), ());
@@ -36,6 +36,8 @@ public:
   size_t GetNumFeatures() const;
 
   std::unique_ptr<FeatureType> GetOriginalFeature(uint32_t index) const;
+  /// Loads the feature into |ft| reusing its memory, @see FeatureType().
+  void GetOriginalFeature(uint32_t index, FeatureType & ft) const;
 
   feature::RouteRelation GetRelation(uint32_t index) const;
 
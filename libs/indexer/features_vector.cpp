@@ -33,6 +33,14 @@ std::unique_ptr<FeatureType> FeaturesVector::GetByIndex(uint32_t index) const
   return std::make_unique<FeatureType>(&m_loadInfo, m_recordReader->ReadRecord(ftOffset));
 }
 
+void FeaturesVector::GetByIndex(uint32_t index, FeatureType & ft) const
+{
+  auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
+  ft.Reset(&m_loadInfo);
+  m_recordReader->ReadRecord(ftOffset, ft.m_data);
+  ft.ParseHeader();
+}
+
 feature::RouteRelation FeaturesVector::GetRelation(uint32_t index) const
 {
   return m_loadInfo.GetRelation(index);
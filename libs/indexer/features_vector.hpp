@@ -24,6 +24,8 @@ public:
                  indexer::MetadataDeserializer * metaDeserializer);
 
   std::unique_ptr<FeatureType> GetByIndex(uint32_t index) const;
+  /// Loads the feature into |ft| reusing its memory.
+  void GetByIndex(uint32_t index, FeatureType & ft) const;
   feature::RouteRelation GetRelation(uint32_t index) const;
 
   size_t GetNumFeatures() const;
@@ -31,10 +33,13 @@ public:
   template <class ToDo>
   void ForEach(ToDo && toDo) const
   {
+    // One feature object is reused for all the records.
+    FeatureType ft;
     uint32_t index = 0;
-    m_recordReader->ForEachRecord([&](uint32_t pos, std::vector<uint8_t> && data)
+    m_recordReader->ForEachRecord(ft.m_data, [&](uint32_t pos)
     {
-      FeatureType ft(&m_loadInfo, std::move(data));
+      ft.Reset(&m_loadInfo);
+      ft.ParseHeader();
 
       // We can't properly set MwmId here, because FeaturesVector
       // works with FileContainerR, not with MwmId/MwmHandle/MwmValue.
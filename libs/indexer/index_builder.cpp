@@ -6,18 +6,29 @@
 
 #include "defines.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace indexer
 {
-bool BuildIndexFromDataFile(std::string const & dataFile, std::string const & tmpFile)
+bool BuildIndexFromDataFile(std::string const & dataFile, std::string const & tmpFile, size_t threadsCount)
 {
   try
   {
     std::string const idxFileName(tmpFile + GEOM_INDEX_TMP_EXT);
     {
-      FeaturesVectorTest features(dataFile);
+      // The file readers aren't thread-safe, so every thread reads the features with its own vector.
+      std::vector<std::unique_ptr<FeaturesVectorTest>> features;
+      std::vector<FeaturesVector const *> vectors;
+      for (size_t i = 0; i < std::max<size_t>(threadsCount, 1); ++i)
+      {
+        features.push_back(std::make_unique<FeaturesVectorTest>(dataFile));
+        vectors.push_back(&features.back()->GetVector());
+      }
       FileWriter writer(idxFileName);
 
-      BuildIndex(features.GetHeader(), features.GetVector(), writer, tmpFile);
+      BuildIndex(features.front()->GetHeader(), vectors, writer);
     }
 
     FilesContainerW(dataFile, FileWriter::OP_WRITE_EXISTING).Write(idxFileName, INDEX_FILE_TAG);
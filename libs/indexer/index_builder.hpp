@@ -3,7 +3,9 @@
 #include "indexer/data_header.hpp"
 #include "indexer/scale_index_builder.hpp"
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace indexer
 {
@@ -21,6 +23,21 @@ void BuildIndex(feature::DataHeader const & header, TFeaturesVector const & feat
   LOG(LINFO, ("Built scale index. Size =", indexSize));
 }
 
+// Builds the index in |features.size()| threads, see covering::IndexScales.
+template <class TFeaturesVector, typename TWriter>
+void BuildIndex(feature::DataHeader const & header, std::vector<TFeaturesVector const *> const & features,
+                TWriter & writer)
+{
+  LOG(LINFO, ("Building scale index in", features.size(), "threads."));
+  uint64_t indexSize;
+  {
+    SubWriter<TWriter> subWriter(writer);
+    covering::IndexScales(header, features, subWriter);
+    indexSize = subWriter.Size();
+  }
+  LOG(LINFO, ("Built scale index. Size =", indexSize));
+}
+
 // doesn't throw exceptions
-bool BuildIndexFromDataFile(std::string const & dataFile, std::string const & tmpFile);
+bool BuildIndexFromDataFile(std::string const & dataFile, std::string const & tmpFile, size_t threadsCount = 1);
 }  // namespace indexer
@@ -17,6 +17,7 @@
 
 #include "base/file_name_utils.hpp"
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -112,5 +113,43 @@ UNIT_CLASS_TEST(TestWithClassificator, CentersTable_Subset)
     }
   }
 }
+
+UNIT_TEST(CentersTable_Batch)
+{
+  TBuffer buffer;
+  {
+    CentersTableBuilder builder;
+
+    builder.SetGeometryParams({{0.0, 0.0}, {100.0, 100.0}});
+    // Several blocks of the table.
+    for (uint32_t id = 0; id < 1000; id += 5)
+      builder.Put(id, m2::PointD(id / 10.0, 100.0 - id / 10.0));
+
+    MemWriter<TBuffer> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto table = CentersTable::LoadV1(reader);
+  TEST(table.get(), ());
+
+  vector<uint32_t> ids;
+  for (uint32_t id = 1000; id > 0; --id)
+    ids.push_back(id - 1);
+  ids.push_back(5);
+  ids.push_back(100500);
+
+  vector<optional<m2::PointD>> centers;
+  table->Get(ids, centers);
+  TEST_EQUAL(centers.size(), ids.size(), ());
+
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    m2::PointD center;
+    TEST_EQUAL(table->Get(ids[i], center), centers[i].has_value(), (ids[i]));
+    if (centers[i])
+      TEST_EQUAL(center, *centers[i], (ids[i]));
+  }
+}
 }  // namespace
 }  // namespace centers_table_test
@@ -2,8 +2,10 @@
 
 #include "indexer/data_header.hpp"
 #include "indexer/data_source.hpp"
+#include "indexer/feature.hpp"
 #include "indexer/feature_source.hpp"
 #include "indexer/mwm_set.hpp"
+#include "indexer/scales.hpp"
 
 #include "coding/internal/file_data.hpp"
 
@@ -19,6 +21,8 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace data_source_test
 {
@@ -154,4 +158,35 @@ UNIT_CLASS_TEST(DataSourceTest, StatusNotifications)
     TEST(CheckExpectations(), ());
   }
 }
+
+UNIT_TEST(DataSource_MmapMode)
+{
+  auto const readFeatures = [](bool mmapMode)
+  {
+    FrozenDataSource dataSource;
+    dataSource.SetMmapMode(mmapMode);
+    auto const result = dataSource.RegisterMap(LocalCountryFile::MakeForTesting("minsk-pass"));
+    TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+    std::vector<std::pair<uint32_t, size_t>> features;
+    dataSource.ForEachInScale([&features](FeatureType & ft)
+    {
+      ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+      features.emplace_back(ft.GetID().m_index, ft.GetPointsCount());
+    }, scales::GetUpperScale());
+
+    // Values of the mapped mwm are opened several times concurrently.
+    MwmSet::MwmHandle const handle1 = dataSource.GetMwmHandleById(result.first);
+    MwmSet::MwmHandle const handle2 = dataSource.GetMwmHandleById(result.first);
+    TEST(handle1.IsAlive() && handle2.IsAlive(), ());
+    TEST_EQUAL(handle1.GetValue()->GetHeader().GetBounds(), handle2.GetValue()->GetHeader().GetBounds(), ());
+
+    return features;
+  };
+
+  auto const fileFeatures = readFeatures(false /* mmapMode */);
+  auto const mmapFeatures = readFeatures(true /* mmapMode */);
+  TEST(!fileFeatures.empty(), ());
+  TEST_EQUAL(fileFeatures, mmapFeatures, ());
+}
 }  // namespace data_source_test
@@ -6,6 +6,7 @@
 
 #include "platform/local_country_file.hpp"
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -60,4 +61,48 @@ UNIT_TEST(FeaturesVectorTest_ParseMetadata)
   });
   TEST_EQUAL(expected, actual, ());
 }
+
+UNIT_TEST(FeaturesVectorTest_ReuseFeatureType)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  auto result = dataSource.RegisterMap(localFile);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  MwmSet::MwmHandle handle = dataSource.GetMwmHandleById(result.first);
+  TEST(handle.IsAlive(), ());
+
+  auto const * value = handle.GetValue();
+  FeaturesVector fv(value->m_cont, value->GetHeader(), value->m_ftTable.get(), value->m_relTable.get(),
+                    value->m_metaDeserializer.get());
+
+  // Every feature loaded into the same object should be equal to the freshly created one.
+  FeatureType reused;
+  for (uint32_t index = 0; index < fv.GetNumFeatures(); ++index)
+  {
+    auto const ft = fv.GetByIndex(index);
+    fv.GetByIndex(index, reused);
+    ft->SetID(FeatureID(MwmSet::MwmId(), index));
+    reused.SetID(FeatureID(MwmSet::MwmId(), index));
+
+    TEST_EQUAL(ft->GetGeomType(), reused.GetGeomType(), (index));
+    feature::TypesHolder const types(*ft), reusedTypes(reused);
+    TEST(std::equal(types.begin(), types.end(), reusedTypes.begin(), reusedTypes.end()), (index));
+    TEST_EQUAL(ft->GetNames(), reused.GetNames(), (index));
+    TEST_EQUAL(ft->GetLayer(), reused.GetLayer(), (index));
+    TEST_EQUAL(ft->GetMetadata(feature::Metadata::FMD_POSTCODE), reused.GetMetadata(feature::Metadata::FMD_POSTCODE),
+               (index));
+
+    if (ft->GetGeomType() == feature::GeomType::Point)
+    {
+      TEST_EQUAL(ft->GetCenter(), reused.GetCenter(), (index));
+      continue;
+    }
+
+    TEST_EQUAL(ft->GetPoints(FeatureType::BEST_GEOMETRY), reused.GetPoints(FeatureType::BEST_GEOMETRY), (index));
+    TEST_EQUAL(ft->GetLimitRect(FeatureType::BEST_GEOMETRY), reused.GetLimitRect(FeatureType::BEST_GEOMETRY),
+               (index));
+  }
+}
 }  // namespace features_vector_test
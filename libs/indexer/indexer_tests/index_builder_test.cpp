@@ -16,6 +16,10 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -67,4 +71,66 @@ UNIT_CLASS_TEST(TestWithClassificator, BuildIndexTest)
   // Clean after the test.
   FileWriter::DeleteFileX(filePath);
 }
+
+UNIT_CLASS_TEST(TestWithClassificator, BuildIndexTest_Parallel)
+{
+  Platform & p = GetPlatform();
+
+  FilesContainerR originalContainer(p.GetReader("minsk-pass" DATA_FILE_EXTENSION));
+
+  vector<char> singleThreadIndex;
+  {
+    FeaturesVectorTest features(originalContainer);
+
+    MemWriter<vector<char>> serialWriter(singleThreadIndex);
+    indexer::BuildIndex(features.GetHeader(), features.GetVector(), serialWriter, "build_index_test");
+  }
+
+  vector<char> parallelIndex;
+  {
+    size_t constexpr kThreadsCount = 4;
+    vector<unique_ptr<FeaturesVectorTest>> features;
+    vector<FeaturesVector const *> vectors;
+    for (size_t i = 0; i < kThreadsCount; ++i)
+    {
+      features.push_back(make_unique<FeaturesVectorTest>(originalContainer));
+      vectors.push_back(&features.back()->GetVector());
+    }
+
+    MemWriter<vector<char>> serialWriter(parallelIndex);
+    indexer::BuildIndex(features.front()->GetHeader(), vectors, serialWriter);
+  }
+
+  TEST(!singleThreadIndex.empty(), ());
+  TEST(singleThreadIndex == parallelIndex, ());
+}
+
+UNIT_TEST(SortCellFeatureBucketTuples_SameAsSort)
+{
+  using covering::CellFeatureBucketTuple;
+
+  mt19937 rng(0);
+  for (uint64_t const maxCell : {uint64_t{0}, uint64_t{1000}, uint64_t{1} << 62})
+  {
+    uniform_int_distribution<uint64_t> cells(0, maxCell);
+    uniform_int_distribution<uint32_t> features(0, 1000);
+    uniform_int_distribution<uint32_t> buckets(0, 17);
+
+    vector<CellFeatureBucketTuple> tuples;
+    for (size_t i = 0; i < 200000; ++i)
+      tuples.emplace_back(CellFeatureBucketTuple::CellFeaturePair(cells(rng), features(rng)), buckets(rng));
+
+    auto expected = tuples;
+    sort(expected.begin(), expected.end());
+
+    covering::SortCellFeatureBucketTuples(tuples, 4 /* threadsCount */);
+    TEST_EQUAL(tuples.size(), expected.size(), ());
+    for (size_t i = 0; i < tuples.size(); ++i)
+    {
+      TEST_EQUAL(tuples[i].GetBucket(), expected[i].GetBucket(), (i));
+      TEST_EQUAL(tuples[i].GetCellFeaturePair().GetCell(), expected[i].GetCellFeaturePair().GetCell(), (i));
+      TEST_EQUAL(tuples[i].GetCellFeaturePair().GetValue(), expected[i].GetCellFeaturePair().GetValue(), (i));
+    }
+  }
+}
 }  // namespace index_builder_test
@@ -8,7 +8,9 @@
 #include "base/macros.hpp"
 
 #include <initializer_list>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace mwm_set_test
 {
@@ -168,4 +170,51 @@ UNIT_TEST(MwmSetLockAndIdTest)
   TEST(!handle.GetId().IsAlive(), ());
   TEST(!handle.GetId().GetInfo().get(), ());
 }
+
+UNIT_TEST(MwmSetCacheTest)
+{
+  ScopedMwm mwm0("0.mwm");
+  ScopedMwm mwm1("1.mwm");
+
+  TestMwmSet mwmSet;
+  auto const id0 = mwmSet.Register(LocalCountryFile::MakeForTesting("0")).first;
+  auto const id1 = mwmSet.Register(LocalCountryFile::MakeForTesting("1")).first;
+
+  {
+    TEST(mwmSet.GetMwmHandleById(id0).IsAlive(), ());
+    TEST_EQUAL(mwmSet.GetCacheStats().m_misses, 1, ());
+    TEST_EQUAL(mwmSet.GetCacheStats().m_hits, 0, ());
+
+    // The released value is taken from the cache.
+    TEST(mwmSet.GetMwmHandleById(id0).IsAlive(), ());
+    TEST_EQUAL(mwmSet.GetCacheStats().m_misses, 1, ());
+    TEST_EQUAL(mwmSet.GetCacheStats().m_hits, 1, ());
+  }
+
+  size_t constexpr kThreads = 8;
+  size_t constexpr kIterations = 1000;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreads; ++i)
+  {
+    threads.emplace_back([&, i]()
+    {
+      for (size_t j = 0; j < kIterations; ++j)
+      {
+        auto const handle = mwmSet.GetMwmHandleById((i + j) % 2 == 0 ? id0 : id1);
+        TEST(handle.IsAlive(), ());
+      }
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  auto const stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(stats.m_hits + stats.m_misses, kThreads * kIterations + 2, ());
+
+  // All handles are released, so the mwms are deregistered at once.
+  TEST(mwmSet.Deregister(CountryFile("0")), ());
+  TEST(!id0.IsAlive(), ());
+  TEST(!mwmSet.GetMwmHandleById(id0).IsAlive(), ());
+  TEST(mwmSet.GetMwmHandleById(id1).IsAlive(), ());
+}
 }  // namespace mwm_set_test
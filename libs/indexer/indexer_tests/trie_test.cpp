@@ -282,4 +282,37 @@ UNIT_TEST(TrieBuilder_Build)
   }
 }
 
+UNIT_TEST(TrieBuilder_Builder)
+{
+  using Key = buffer_vector<trie::TrieChar, 8>;
+  using Value = uint32_t;
+  using KeyValuePair = pair<Key, Value>;
+  using Sink = PushBackByteSink<vector<uint8_t>>;
+
+  auto const makeKey = [](string const & s) { return Key(s.begin(), s.end()); };
+
+  // Sorted pairs with common prefixes, several values of one key and repeated pairs.
+  vector<KeyValuePair> const added = {
+      {makeKey(""), 1},   {makeKey("a"), 2},   {makeKey("a"), 2},    {makeKey("a"), 3},   {makeKey("ab"), 4},
+      {makeKey("abc"), 5}, {makeKey("abd"), 6}, {makeKey("abd"), 6}, {makeKey("b"), 7}, {makeKey("bcdefghijk"), 8}};
+
+  vector<uint8_t> buf;
+  Sink sink(buf);
+  SingleValueSerializer<uint32_t> serializer;
+  trie::Builder<Sink, Key, ValueList<uint32_t>, SingleValueSerializer<uint32_t>> builder(sink, serializer);
+  for (auto const & [key, value] : added)
+    builder.Add(key, value);
+  builder.Finish();
+  reverse(buf.begin(), buf.end());
+
+  MemReader memReader = MemReader(&buf[0], buf.size());
+  auto const root = trie::ReadTrie<MemReader, ValueList<uint32_t>>(memReader, serializer);
+  vector<KeyValuePair> res;
+  trie::ForEachRef(*root, [&res](Key const & k, Value const & v) { res.emplace_back(k, v); }, Key{});
+  sort(res.begin(), res.end());
+
+  vector<KeyValuePair> expected = added;
+  expected.erase(unique(expected.begin(), expected.end()), expected.end());
+  TEST_EQUAL(res, expected, ());
+}
 }  // namespace trie_test
@@ -1,7 +1,9 @@
 #include "indexer/mwm_set.hpp"
 
+#include "indexer/centers_table.hpp"  // needed for MwmValue dtor
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/metadata_serdes.hpp"  // needed for MwmValue dtor
+#include "indexer/rank_table.hpp"  // needed for MwmValue dtor
 #include "indexer/scales.hpp"
 
 #include "platform/local_country_file_utils.hpp"
@@ -13,12 +15,13 @@
 
 #include <algorithm>
 #include <exception>
+#include <iterator>
 #include <sstream>
 
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
-MwmInfo::MwmInfo() : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0) {}
+MwmInfo::MwmInfo() : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0), m_cacheShard(0) {}
 
 MwmInfo::MwmTypeT MwmInfo::GetType() const
 {
@@ -151,6 +154,7 @@ std::pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterImpl(LocalCountryFil
     return std::make_pair(MwmId(), RegResult::UnsupportedFileFormat);
 
   info->m_file = localFile;
+  info->m_cacheShard = m_nextShard++ % kCacheShards;
   SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
 
   {
@@ -169,19 +173,14 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
     return false;
 
   std::shared_ptr<MwmInfo> const & info = id.GetInfo();
+  auto & shard = GetShard(id);
+  auto const lock = LockShard(shard);
   if (info->m_numRefs == 0)
   {
     SetStatus(*info, MwmInfo::STATUS_DEREGISTERED, events);
     std::vector<std::shared_ptr<MwmInfo>> & infos = m_info[info->GetCountryName()];
     infos.erase(std::remove(infos.begin(), infos.end(), info), infos.end());
-    for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
-    {
-      if (it->first == id)
-      {
-        m_cache.erase(it);
-        break;
-      }
-    }
+    ClearCacheImpl(shard, id);
     return true;
   }
 
@@ -272,6 +271,22 @@ void MwmSet::ProcessEventList(EventList & events)
 
 std::unique_ptr<MwmValue> MwmSet::LockValue(MwmId const & id)
 {
+  if (!id.IsAlive())
+    return nullptr;
+
+  // Fast path: take a free value of an already opened mwm.
+  {
+    auto & shard = GetShard(id);
+    auto const lock = LockShard(shard);
+    if (auto value = TakeFromCacheImpl(shard, id))
+    {
+      ++id.GetInfo()->m_numRefs;
+      ++m_cacheHits;
+      return value;
+    }
+  }
+
+  ++m_cacheMisses;
   std::unique_ptr<MwmValue> result;
   WithEventLog([&](EventList & events) { result = LockValueImpl(id, events); });
   return result;
@@ -288,17 +303,14 @@ std::unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & ev
   // if (!info->IsUpToDate())
   //  return TMwmValuePtr();
 
-  ++info->m_numRefs;
-
-  // Search in cache.
-  for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
   {
-    if (it->first == id)
-    {
-      std::unique_ptr<MwmValue> result = std::move(it->second);
-      m_cache.erase(it);
-      return result;
-    }
+    auto & shard = GetShard(id);
+    auto const lock = LockShard(shard);
+    ++info->m_numRefs;
+
+    // The value could be released by another thread after the fast path.
+    if (auto value = TakeFromCacheImpl(shard, id))
+      return value;
   }
 
   try
@@ -323,6 +335,25 @@ std::unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & ev
 
 void MwmSet::UnlockValue(MwmId const & id, std::unique_ptr<MwmValue> p)
 {
+  ASSERT(id.IsAlive(), (id));
+  ASSERT(p.get() != nullptr, ());
+  if (!id.IsAlive() || !p)
+    return;
+
+  // Fast path: put the value of an up to date mwm to the cache, nothing to deregister.
+  {
+    auto & shard = GetShard(id);
+    auto const lock = LockShard(shard);
+    auto const & info = id.GetInfo();
+    if (info->IsUpToDate())
+    {
+      ASSERT_GREATER(info->m_numRefs.load(), 0, ());
+      --info->m_numRefs;
+      PutToCacheImpl(shard, id, std::move(p));
+      return;
+    }
+  }
+
   WithEventLog([&](EventList & events) { UnlockValueImpl(id, std::move(p), events); });
 }
 
@@ -334,37 +365,46 @@ void MwmSet::UnlockValueImpl(MwmId const & id, std::unique_ptr<MwmValue> p, Even
     return;
 
   std::shared_ptr<MwmInfo> const & info = id.GetInfo();
-  ASSERT_GREATER(info->m_numRefs, 0, ());
-  --info->m_numRefs;
-  if (info->m_numRefs == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
-    VERIFY(DeregisterImpl(id, events), ());
-
-  if (info->IsUpToDate())
   {
-    /// @todo Probably, it's better to store only "unique by id" free caches here.
-    /// But it's no obvious if we have many threads working with the single mwm.
+    auto & shard = GetShard(id);
+    auto const lock = LockShard(shard);
+    ASSERT_GREATER(info->m_numRefs.load(), 0, ());
+    --info->m_numRefs;
 
-    m_cache.push_back(std::make_pair(id, std::move(p)));
-    if (m_cache.size() > m_cacheSize)
+    // The mwm may be registered again after the fast path.
+    if (info->IsUpToDate())
     {
-      LOG(LDEBUG, ("MwmValue max cache size reached! Added", id, "removed", m_cache.front().first));
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
-      m_cache.pop_front();
+      PutToCacheImpl(shard, id, std::move(p));
+      return;
     }
   }
+
+  // Does nothing if the mwm has been locked again by the fast path of LockValue().
+  if (info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
+    DeregisterImpl(id, events);
 }
 
 void MwmSet::Clear()
 {
   std::lock_guard<std::mutex> lock(m_lock);
-  ClearCacheImpl(m_cache.begin(), m_cache.end());
+  ClearCacheImpl();
   m_info.clear();
 }
 
 void MwmSet::ClearCache()
 {
   std::lock_guard<std::mutex> lock(m_lock);
-  ClearCacheImpl(m_cache.begin(), m_cache.end());
+  ClearCacheImpl();
+}
+
+MwmSet::CacheStats MwmSet::GetCacheStats() const
+{
+  CacheStats stats;
+  stats.m_hits = m_cacheHits;
+  stats.m_misses = m_cacheMisses;
+  stats.m_shardContentions = m_shardContentions;
+  stats.m_lockContentions = m_lockContentions;
+  return stats;
 }
 
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) const
@@ -375,36 +415,97 @@ MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) con
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleByCountryFile(CountryFile const & countryFile)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events)
-  { handle = GetMwmHandleByIdImpl(GetMwmIdByCountryFileImpl(countryFile), events); });
-  return handle;
+  return GetMwmHandleById(GetMwmIdByCountryFile(countryFile));
 }
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleById(MwmId const & id)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events) { handle = GetMwmHandleByIdImpl(id, events); });
-  return handle;
+  return MwmHandle(*this, id, LockValue(id));
 }
 
-MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id, EventList & events)
+std::unique_lock<std::mutex> MwmSet::LockShard(CacheShard & shard)
 {
-  std::unique_ptr<MwmValue> value;
-  if (id.IsAlive())
-    value = LockValueImpl(id, events);
-  return MwmHandle(*this, id, std::move(value));
+  std::unique_lock<std::mutex> lock(shard.m_lock, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    ++m_shardContentions;
+    lock.lock();
+  }
+  return lock;
 }
 
-void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end)
+std::unique_ptr<MwmValue> MwmSet::TakeFromCacheImpl(CacheShard & shard, MwmId const & id)
 {
-  m_cache.erase(beg, end);
+  // Search from the end, the most recently released values are there.
+  for (auto it = shard.m_cache.rbegin(); it != shard.m_cache.rend(); ++it)
+  {
+    if (it->first == id)
+    {
+      std::unique_ptr<MwmValue> result = std::move(it->second);
+      shard.m_cache.erase(std::next(it).base());
+      --m_cacheCount;
+      return result;
+    }
+  }
+  return nullptr;
 }
 
-void MwmSet::ClearCache(MwmId const & id)
+void MwmSet::PutToCacheImpl(CacheShard & shard, MwmId const & id, std::unique_ptr<MwmValue> p)
+{
+  /// @todo Probably, it's better to store only "unique by id" free caches here.
+  /// But it's no obvious if we have many threads working with the single mwm.
+  shard.m_cache.emplace_back(id, std::move(p));
+  if (++m_cacheCount <= m_cacheSize)
+    return;
+
+  // Evict the oldest value of this shard. If the shard has nothing else, try the other shards,
+  // but don't wait for them: a thread which holds a shard lock never blocks on another one.
+  if (shard.m_cache.size() > 1)
+  {
+    LOG(LDEBUG, ("MwmValue max cache size reached! Added", id, "removed", shard.m_cache.front().first));
+    shard.m_cache.pop_front();
+    --m_cacheCount;
+    return;
+  }
+
+  for (auto & other : m_shards)
+  {
+    if (&other == &shard)
+      continue;
+
+    std::unique_lock<std::mutex> lock(other.m_lock, std::try_to_lock);
+    if (lock.owns_lock() && !other.m_cache.empty())
+    {
+      other.m_cache.pop_front();
+      --m_cacheCount;
+      return;
+    }
+  }
+}
+
+void MwmSet::ClearCacheImpl(CacheShard & shard, MwmId const & id)
 {
   auto sameId = [&id](std::pair<MwmSet::MwmId, std::unique_ptr<MwmValue>> const & p) { return (p.first == id); };
-  ClearCacheImpl(base::RemoveIfKeepValid(m_cache.begin(), m_cache.end(), sameId), m_cache.end());
+  auto const it = base::RemoveIfKeepValid(shard.m_cache.begin(), shard.m_cache.end(), sameId);
+  m_cacheCount -= std::distance(it, shard.m_cache.end());
+  shard.m_cache.erase(it, shard.m_cache.end());
+}
+
+void MwmSet::ClearCacheImpl()
+{
+  for (auto & shard : m_shards)
+  {
+    auto const lock = LockShard(shard);
+    m_cacheCount -= shard.m_cache.size();
+    shard.m_cache.clear();
+  }
+}
+
+void MwmSet::ClearCache(MwmId const & id)
+{
+  auto & shard = GetShard(id);
+  auto const lock = LockShard(shard);
+  ClearCacheImpl(shard, id);
 }
 
 // MwmValue ----------------------------------------------------------------------------------------
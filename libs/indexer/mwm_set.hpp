@@ -7,6 +7,7 @@
 #include "platform/mwm_version.hpp"
 
 #include "coding/files_container.hpp"
+#include "coding/mmap_reader.hpp"
 
 #include "geometry/rect2d.hpp"
 
@@ -15,6 +16,7 @@
 
 #include "defines.hpp"
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <map>
@@ -28,6 +30,12 @@ namespace feature
 {
 class FeaturesOffsetsTable;
 }
+namespace search
+{
+class CentersTable;
+class RankTable;
+}
+
 namespace indexer
 {
 class MetadataDeserializer;
@@ -96,7 +104,8 @@ protected:
 
   platform::LocalCountryFile m_file;  ///< Path to the mwm file.
   std::atomic<Status> m_status;       ///< Current country status.
-  uint32_t m_numRefs;                 ///< Number of active handles.
+  std::atomic<uint32_t> m_numRefs;    ///< Number of active handles.
+  uint32_t m_cacheShard;              ///< Shard of MwmSet cache with free values of this mwm.
 };
 
 class MwmInfoEx : public MwmInfo
@@ -114,6 +123,10 @@ private:
   // only in the MwmSet critical section, protected by a lock.  So,
   // there's an implicit synchronization on this field.
   std::weak_ptr<feature::FeaturesOffsetsTable> m_ftTable, m_relTable;
+
+  // Memory mapping of the mwm file shared by all MwmValue-s of the mwm in DataSource's mmap mode.
+  // Used the same way as |m_ftTable|: only in DataSource::CreateValue() under the MwmSet lock.
+  std::weak_ptr<MmapReader::MmapData> m_mapping;
 };
 
 class MwmValue;
@@ -319,6 +332,16 @@ public:
   /// @todo Actually, we need to define, is this behaviour (getting Handle) const or non-const.
   MwmHandle GetMwmHandleById(MwmId const & id) const { return const_cast<MwmSet *>(this)->GetMwmHandleById(id); }
 
+  struct CacheStats
+  {
+    uint64_t m_hits = 0;              ///< Values taken from the cache without |m_lock|.
+    uint64_t m_misses = 0;            ///< Values which required |m_lock|.
+    uint64_t m_shardContentions = 0;  ///< Waits for a cache shard lock.
+    uint64_t m_lockContentions = 0;   ///< Waits for |m_lock|.
+  };
+
+  CacheStats GetCacheStats() const;
+
 protected:
   virtual std::unique_ptr<MwmInfo> CreateInfo(platform::LocalCountryFile const & localFile) const = 0;
   virtual std::unique_ptr<MwmValue> CreateValue(MwmInfo & info) const = 0;
@@ -326,6 +349,18 @@ protected:
 private:
   using Cache = std::deque<std::pair<MwmId, std::unique_ptr<MwmValue>>>;
 
+  // Free values are kept in shards by mwm. So a handle of an already opened mwm is taken and released
+  // under a shard lock only, and threads which work with different mwms don't wait for each other.
+  // Lock order is |m_lock| -> shard lock. |MwmInfo::m_numRefs| is changed and the status of a mwm is set
+  // to deregistered (or marked to) under the shard lock of the mwm.
+  struct CacheShard
+  {
+    std::mutex m_lock;
+    Cache m_cache;
+  };
+
+  static size_t constexpr kCacheShards = 8;
+
   // This is the only valid way to take |m_lock| and use *Impl()
   // functions. The reason is that event processing requires
   // triggering of observers, but it's generally unsafe to call
@@ -338,7 +373,12 @@ private:
   {
     EventList events;
     {
-      std::lock_guard<std::mutex> lock(m_lock);
+      std::unique_lock<std::mutex> lock(m_lock, std::try_to_lock);
+      if (!lock.owns_lock())
+      {
+        ++m_lockContentions;
+        lock.lock();
+      }
       fn(events);
     }
     ProcessEventList(events);
@@ -350,20 +390,34 @@ private:
   // Triggers observers on each event in |events|.
   void ProcessEventList(EventList & events);
 
-  /// @precondition This function is always called under mutex m_lock.
-  MwmHandle GetMwmHandleByIdImpl(MwmId const & id, EventList & events);
-
   std::unique_ptr<MwmValue> LockValue(MwmId const & id);
   std::unique_ptr<MwmValue> LockValueImpl(MwmId const & id, EventList & events);
   void UnlockValue(MwmId const & id, std::unique_ptr<MwmValue> p);
   void UnlockValueImpl(MwmId const & id, std::unique_ptr<MwmValue> p, EventList & events);
 
-  /// Do the cleaning for [beg, end) without acquiring the mutex.
+  CacheShard & GetShard(MwmId const & id) { return m_shards[id.GetInfo()->m_cacheShard]; }
+  std::unique_lock<std::mutex> LockShard(CacheShard & shard);
+
+  /// @precondition These functions are always called under the shard lock.
+  //@{
+  std::unique_ptr<MwmValue> TakeFromCacheImpl(CacheShard & shard, MwmId const & id);
+  void PutToCacheImpl(CacheShard & shard, MwmId const & id, std::unique_ptr<MwmValue> p);
+  void ClearCacheImpl(CacheShard & shard, MwmId const & id);
+  //@}
+
+  /// Locks every shard in turn.
   /// @precondition This function is always called under mutex m_lock.
-  void ClearCacheImpl(Cache::iterator beg, Cache::iterator end);
+  void ClearCacheImpl();
 
-  Cache m_cache;
+  std::array<CacheShard, kCacheShards> m_shards;
+  std::atomic<size_t> m_cacheCount = 0;
   size_t const m_cacheSize;
+  uint32_t m_nextShard = 0;
+
+  std::atomic<uint64_t> m_cacheHits = 0;
+  std::atomic<uint64_t> m_cacheMisses = 0;
+  std::atomic<uint64_t> m_shardContentions = 0;
+  std::atomic<uint64_t> m_lockContentions = 0;
 
 protected:
   /// @precondition This function is always called under mutex m_lock.
@@ -397,6 +451,10 @@ public:
   std::shared_ptr<feature::FeaturesOffsetsTable> m_ftTable, m_relTable;
   std::unique_ptr<indexer::MetadataDeserializer> m_metaDeserializer;
   std::unique_ptr<HouseToStreetTable> m_house2street, m_house2place;
+  // Search tables are loaded lazily by search and live as long as the value stays in MwmSet cache,
+  // so they are not loaded and decoded again for every query.
+  std::unique_ptr<search::CentersTable> m_centers;
+  std::unique_ptr<search::RankTable> m_searchRanks, m_popularityRanks;
 
 public:
   MwmValue(ModelReaderPtr const & reader, platform::LocalCountryFile const & localFile);
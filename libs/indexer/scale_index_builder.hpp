@@ -16,11 +16,14 @@
 #include "coding/writer.hpp"
 
 #include "base/base.hpp"
+#include "base/bits.hpp"
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/scope_guard.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <future>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -120,30 +123,174 @@ private:
   std::vector<uint32_t> & m_cellsInBucket;
 };
 
+// Sorts |tuples| in the same order as std::sort. The tuples are distributed into ranges by the bucket and
+// the high bits of the cell (one pass of the MSD radix sort) and the ranges are sorted in |threadsCount| threads.
+inline void SortCellFeatureBucketTuples(std::vector<CellFeatureBucketTuple> & tuples, size_t threadsCount)
+{
+  size_t constexpr kMinParallelSize = 1 << 16;
+  if (threadsCount <= 1 || tuples.size() < kMinParallelSize)
+  {
+    std::sort(tuples.begin(), tuples.end());
+    return;
+  }
+
+  uint8_t constexpr kRadixBits = 10;
+  uint64_t maxCell = 0;
+  uint32_t maxBucket = 0;
+  for (auto const & t : tuples)
+  {
+    maxCell = std::max(maxCell, t.GetCellFeaturePair().GetCell());
+    maxBucket = std::max(maxBucket, t.GetBucket());
+  }
+
+  uint8_t const cellBits = maxCell == 0 ? 0 : bits::FloorLog(maxCell) + 1;
+  uint8_t const shift = cellBits > kRadixBits ? cellBits - kRadixBits : 0;
+  auto const getRange = [shift](CellFeatureBucketTuple const & t)
+  { return (static_cast<size_t>(t.GetBucket()) << kRadixBits) + (t.GetCellFeaturePair().GetCell() >> shift); };
+
+  std::vector<size_t> offsets((static_cast<size_t>(maxBucket) + 1) << kRadixBits, 0);
+  for (auto const & t : tuples)
+    ++offsets[getRange(t)];
+  size_t sum = 0;
+  for (auto & offset : offsets)
+  {
+    auto const count = offset;
+    offset = sum;
+    sum += count;
+  }
+
+  std::vector<CellFeatureBucketTuple> distributed(tuples.size());
+  {
+    // |ends| become the ends of the ranges.
+    auto ends = offsets;
+    for (auto const & t : tuples)
+      distributed[ends[getRange(t)]++] = t;
+  }
+  offsets.push_back(tuples.size());
+
+  // Neighbouring ranges are joined into tasks of about the same size.
+  base::ComputationalThreadPool pool(threadsCount);
+  std::vector<std::future<void>> tasks;
+  size_t const taskSize = tuples.size() / (threadsCount * 4) + 1;
+  for (size_t begRange = 0; begRange + 1 < offsets.size();)
+  {
+    size_t endRange = begRange + 1;
+    while (endRange + 1 < offsets.size() && offsets[endRange] - offsets[begRange] < taskSize)
+      ++endRange;
+
+    tasks.push_back(pool.Submit([&distributed, &offsets, begRange, endRange]()
+    {
+      for (size_t range = begRange; range < endRange; ++range)
+        std::sort(distributed.begin() + offsets[range], distributed.begin() + offsets[range + 1]);
+    }));
+    begRange = endRange;
+  }
+  for (auto & task : tasks)
+    task.get();
+
+  tuples.swap(distributed);
+}
+
+// Builds the scale index of |features|. The features are covered in parallel when there are several
+// vectors in |features|: they should be independent readers of the same features.
 template <class FeaturesVector, class Writer>
-void IndexScales(feature::DataHeader const & header, FeaturesVector const & features, Writer & writer,
-                 std::string const &)
+void IndexScales(feature::DataHeader const & header, std::vector<FeaturesVector const *> const & features,
+                 Writer & writer)
 {
+  CHECK(!features.empty(), ());
+
   // TODO: Make scale bucketing dynamic.
 
   uint32_t const bucketsCount = header.GetLastScale() + 1;
 
   std::vector<CellFeatureBucketTuple> cellsToFeaturesAllBuckets;
   {
-    auto const PushCFT = [&cellsToFeaturesAllBuckets](CellFeatureBucketTuple const & v)
-    { cellsToFeaturesAllBuckets.push_back(v); };
-    using TDisplacementManager = DisplacementManager<decltype(PushCFT)>;
+    struct PushCFT
+    {
+      void operator()(CellFeatureBucketTuple const & v) const { m_cells->push_back(v); }
+
+      std::vector<CellFeatureBucketTuple> * m_cells;
+    };
+    using TDisplacementManager = DisplacementManager<PushCFT>;
 
     // Single-point features are heuristically rearranged and filtered to simplify
     // the runtime decision of whether we should draw a feature
     // or sacrifice it for the sake of more important ones ("displacement").
     // Lines and areas are not displaceable and are just passed on to the index.
-    TDisplacementManager manager(PushCFT);
+    PushCFT pushCFT{&cellsToFeaturesAllBuckets};
+    TDisplacementManager manager(pushCFT);
     std::vector<uint32_t> featuresInBucket(bucketsCount);
     std::vector<uint32_t> cellsInBucket(bucketsCount);
-    features.ForEach(FeatureCoverer<TDisplacementManager>(header, manager, featuresInBucket, cellsInBucket));
+
+    // Features are read by index, so the offsets table is needed to cover them in parallel.
+    size_t const numFeatures = features.front()->GetNumFeatures();
+    size_t const threadsCount = numFeatures == 0 ? 1 : std::min(features.size(), numFeatures);
+    if (threadsCount == 1)
+    {
+      features.front()->ForEach(FeatureCoverer<TDisplacementManager>(header, manager, featuresInBucket, cellsInBucket));
+    }
+    else
+    {
+      // Every thread covers a contiguous range of the features into its own cells and displacement manager.
+      // The result doesn't depend on the threads count: the cells are sorted and the displaceable features
+      // are ordered by Displace() anyway.
+      std::vector<std::vector<CellFeatureBucketTuple>> threadCells(threadsCount);
+      std::vector<PushCFT> threadPushCFTs;
+      std::vector<TDisplacementManager> threadManagers;
+      std::vector<std::vector<uint32_t>> threadFeaturesInBucket(threadsCount);
+      std::vector<std::vector<uint32_t>> threadCellsInBucket(threadsCount);
+      threadPushCFTs.reserve(threadsCount);
+      threadManagers.reserve(threadsCount);
+      for (size_t i = 0; i < threadsCount; ++i)
+      {
+        threadPushCFTs.push_back({&threadCells[i]});
+        threadManagers.emplace_back(threadPushCFTs[i]);
+      }
+
+      base::ComputationalThreadPool pool(threadsCount);
+      std::vector<std::future<void>> tasks;
+      for (size_t i = 0; i < threadsCount; ++i)
+      {
+        tasks.push_back(pool.Submit([&, i]()
+        {
+          FeatureCoverer<TDisplacementManager> coverer(header, threadManagers[i], threadFeaturesInBucket[i],
+                                                       threadCellsInBucket[i]);
+          auto const beg = static_cast<uint32_t>(numFeatures * i / threadsCount);
+          auto const end = static_cast<uint32_t>(numFeatures * (i + 1) / threadsCount);
+          FeatureType ft;
+          for (uint32_t index = beg; index < end; ++index)
+          {
+            features[i]->GetByIndex(index, ft);
+            // The same id as FeaturesVector::ForEach sets.
+            ft.SetID(FeatureID(MwmSet::MwmId(), index));
+            coverer(ft, index);
+          }
+        }));
+      }
+      for (auto & task : tasks)
+        task.get();
+
+      size_t totalCells = 0;
+      for (auto const & cells : threadCells)
+        totalCells += cells.size();
+      cellsToFeaturesAllBuckets.reserve(totalCells);
+
+      for (size_t i = 0; i < threadsCount; ++i)
+      {
+        cellsToFeaturesAllBuckets.insert(cellsToFeaturesAllBuckets.end(), threadCells[i].begin(),
+                                         threadCells[i].end());
+        std::vector<CellFeatureBucketTuple>().swap(threadCells[i]);
+        manager.Append(threadManagers[i]);
+        for (uint32_t bucket = 0; bucket < bucketsCount; ++bucket)
+        {
+          featuresInBucket[bucket] += threadFeaturesInBucket[i][bucket];
+          cellsInBucket[bucket] += threadCellsInBucket[i][bucket];
+        }
+      }
+    }
+
     manager.Displace();
-    std::sort(cellsToFeaturesAllBuckets.begin(), cellsToFeaturesAllBuckets.end());
+    SortCellFeatureBucketTuples(cellsToFeaturesAllBuckets, features.size());
 
     for (uint32_t bucket = 0; bucket < bucketsCount; ++bucket)
     {
@@ -183,4 +330,11 @@ void IndexScales(feature::DataHeader const & header, FeaturesVector const & feat
   LOG(LINFO, ("All scale indexes done."));
 }
 
+template <class FeaturesVector, class Writer>
+void IndexScales(feature::DataHeader const & header, FeaturesVector const & features, Writer & writer,
+                 std::string const &)
+{
+  IndexScales(header, std::vector<FeaturesVector const *>{&features}, writer);
+}
+
 }  // namespace covering
@@ -39,15 +39,22 @@ public:
   /// Convenience: read full RouteRelation (with members) at relation index @p index.
   RouteRelation GetRelation(uint32_t id) const;
 
-  serial::GeometryCodingParams const & GetDefGeometryCodingParams() const
+  /// @name The params with the deltas encoding of |m_version|.
+  /// @{
+  serial::GeometryCodingParams GetDefGeometryCodingParams() const
   {
-    return m_header.GetDefGeometryCodingParams();
+    auto cp = m_header.GetDefGeometryCodingParams();
+    cp.SetDeltasEncoding(GetDeltasEncoding(m_version));
+    return cp;
   }
 
   serial::GeometryCodingParams GetGeometryCodingParams(int scaleIndex) const
   {
-    return m_header.GetGeometryCodingParams(scaleIndex);
+    auto cp = m_header.GetGeometryCodingParams(scaleIndex);
+    cp.SetDeltasEncoding(GetDeltasEncoding(m_version));
+    return cp;
   }
+  /// @}
 
   int GetScalesCount() const { return static_cast<int>(m_header.GetScalesCount()); }
   int GetScale(int i) const { return m_header.GetScale(i); }
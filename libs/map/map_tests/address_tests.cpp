@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace address_tests
 {
@@ -106,4 +107,67 @@ UNIT_TEST(ReverseGeocoder_Smoke)
     TestAddress(coder, mwmInfo, {53.89745, 27.55835}, streetNames, "18А");
   }
 }
+
+UNIT_TEST(ReverseGeocoder_Batch)
+{
+  classificator::Load();
+
+  FrozenDataSource dataSource;
+  auto const regResult = dataSource.RegisterMap(LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(regResult.second, MwmSet::RegResult::Success, ());
+
+  ReverseGeocoder coder(dataSource);
+
+  std::vector<ms::LatLon> const known = {{53.89815, 27.54265},
+                                         {53.8997617, 27.5429365},
+                                         {53.89666, 27.54904},
+                                         {53.89724, 27.54983},
+                                         {53.89745, 27.55835}};
+  std::vector<m2::PointD> points;
+  for (auto const & ll : known)
+    points.push_back(mercator::FromLatLon(ll));
+  // A track through the city center.
+  for (size_t i = 0; i < 500; ++i)
+    points.push_back(mercator::FromLatLon(53.895 + 0.00002 * i, 27.54 + 0.00004 * i));
+
+  auto const addrs = coder.GetNearbyAddresses(points, ReverseGeocoder::kLookupRadiusM);
+  TEST_EQUAL(addrs.size(), points.size(), ());
+  for (size_t i = 0; i < known.size(); ++i)
+  {
+    ReverseGeocoder::Address addr;
+    coder.GetNearbyAddress(points[i], addr);
+    TEST_EQUAL(addrs[i].GetHouseNumber(), addr.GetHouseNumber(), (i));
+    TEST_EQUAL(addrs[i].GetStreetName(), addr.GetStreetName(), (i));
+    TEST_EQUAL(addrs[i].GetDistance(), addr.GetDistance(), (i));
+  }
+
+  auto const parallelAddrs = coder.GetNearbyAddresses(points, ReverseGeocoder::kLookupRadiusM, 4 /* threadsCount */);
+  TEST_EQUAL(parallelAddrs.size(), points.size(), ());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    TEST_EQUAL(parallelAddrs[i].m_building.m_id, addrs[i].m_building.m_id, (i));
+    TEST_EQUAL(parallelAddrs[i].m_street.m_id, addrs[i].m_street.m_id, (i));
+  }
+
+  // Radius is less than the minimal cell size, the points are repeated to be looked up by cells.
+  double const smallRadiusM = 0.01;
+  std::vector<m2::PointD> centers;
+  for (size_t i = 0; i < known.size(); ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+      centers.push_back(addrs[i].m_building.m_center);
+  }
+  auto const smallRadiusAddrs = coder.GetNearbyAddresses(centers, smallRadiusM);
+  TEST_EQUAL(smallRadiusAddrs.size(), centers.size(), ());
+  size_t foundCount = 0;
+  for (size_t i = 0; i < centers.size(); ++i)
+  {
+    ReverseGeocoder::Address addr;
+    coder.GetNearbyAddress(centers[i], smallRadiusM, addr);
+    TEST_EQUAL(smallRadiusAddrs[i].m_building.m_id, addr.m_building.m_id, (i));
+    if (addr.IsValid())
+      ++foundCount;
+  }
+  TEST_GREATER(foundCount, 0, ());
+}
 }  // namespace address_tests
@@ -3,6 +3,7 @@
 #include "coding/buffered_file_writer.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/files_container.hpp"
 #include "coding/reader.hpp"
 #include "coding/write_to_sink.hpp"
 #include "coding/writer.hpp"
@@ -12,22 +13,292 @@
 #include "base/cancellable.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
+#include "base/timer.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <future>
 #include <iterator>
+#include <unordered_map>
 #include <vector>
 
 #include "3party/bsdiff-courgette/bsdiff/bsdiff.h"
 
 namespace
 {
-enum Version
+using generator::mwm_diff::DiffApplicationResult;
+using TagInfo = FilesContainerBase::TagInfo;
+
+// Format Version 1: the new mwm is restored chunk by chunk, in the order of its bytes.
+// Sections of the new mwm are matched with the sections of the old mwm by tags. Identical sections
+// are copied from the old mwm, changed sections are bsdiff'ed against their old versions, and new
+// sections and the bytes between sections (the header, paddings and the table of contents) are deflated.
+// The chunks are built independently, so they are built in parallel, and applying a chunk needs
+// the memory for one section at most.
+//
+// Header: uint32_t version, uint64_t size of the new mwm.
+// Chunk: uint8_t type, uint64_t size of the chunk in the new mwm, and then
+//   Copy: uint64_t offset in the old mwm, uint32_t crc32 of the bytes;
+//   Deflate: uint64_t data size, zlib data;
+//   Patch: uint64_t offset in the old mwm, uint64_t size in the old mwm, uint64_t data size,
+//          zlib data of the bsdiff patch.
+enum class ChunkType : uint8_t
+{
+  Copy = 0,
+  Deflate = 1,
+  Patch = 2,
+};
+
+// Deflated ranges are split to bound the memory needed for their inflating.
+uint64_t constexpr kMaxDeflateChunkSize = 4 * 1024 * 1024;
+size_t constexpr kCopyBufferSize = 64 * 1024;
+
+struct Chunk
 {
-  // Format Version 0: bsdiff+gzip.
-  VERSION_V0 = 0,
-  VERSION_LATEST = VERSION_V0
+  ChunkType m_type = ChunkType::Deflate;
+  uint64_t m_newOffset = 0;
+  uint64_t m_newSize = 0;
+  uint64_t m_oldOffset = 0;
+  uint64_t m_oldSize = 0;
+  uint32_t m_crc = 0;
+  std::vector<uint8_t> m_data;
 };
 
+uint32_t UpdateCrc(uint32_t crc, uint8_t const * data, size_t size)
+{
+  return static_cast<uint32_t>(crc32(crc, data, base::checked_cast<uInt>(size)));
+}
+
+bool IsValidRange(uint64_t offset, uint64_t size, uint64_t fileSize)
+{
+  return offset <= fileSize && size <= fileSize - offset;
+}
+
+bool Deflate(uint8_t const * data, size_t size, std::vector<uint8_t> & deflated)
+{
+  using Deflate = coding::ZLib::Deflate;
+  Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+
+  deflated.clear();
+  deflated.reserve(size);
+  return deflate(data, size, std::back_inserter(deflated));
+}
+
+// Returns the non-empty sections of the mwm at |path| sorted by offsets, or nothing if the file
+// is not a files container.
+std::vector<TagInfo> ReadSections(std::string const & path, uint64_t fileSize)
+{
+  // The file starts with the offset of the table of contents.
+  if (fileSize < sizeof(uint64_t))
+    return {};
+
+  std::vector<TagInfo> sections;
+  try
+  {
+    FilesContainerR const container(path);
+    container.ForEachTagInfo([&sections](TagInfo const & info)
+    {
+      if (info.m_size != 0)
+        sections.push_back(info);
+    });
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Could not read sections of", path, e.Msg()));
+    return {};
+  }
+
+  std::sort(sections.begin(), sections.end(),
+            [](TagInfo const & lhs, TagInfo const & rhs) { return lhs.m_offset < rhs.m_offset; });
+
+  uint64_t end = sizeof(uint64_t);
+  for (auto const & section : sections)
+  {
+    if (section.m_offset < end || !IsValidRange(section.m_offset, section.m_size, fileSize))
+    {
+      LOG(LWARNING, ("Overlapping or truncated sections in", path, section));
+      return {};
+    }
+    end = section.m_offset + section.m_size;
+  }
+  return sections;
+}
+
+// Splits the new mwm into chunks. Sections with the same tags in both mwms become patches,
+// which are turned into copies when building if the sections are identical.
+std::vector<Chunk> MakeChunks(std::vector<TagInfo> const & oldSections, uint64_t oldSize,
+                              std::vector<TagInfo> const & newSections, uint64_t newSize)
+{
+  std::vector<Chunk> chunks;
+  auto const addChunk = [&chunks](ChunkType type, uint64_t newOffset, uint64_t newSize, uint64_t oldOffset,
+                                  uint64_t oldSize)
+  {
+    auto & chunk = chunks.emplace_back();
+    chunk.m_type = type;
+    chunk.m_newOffset = newOffset;
+    chunk.m_newSize = newSize;
+    chunk.m_oldOffset = oldOffset;
+    chunk.m_oldSize = oldSize;
+  };
+
+  // The whole files are diffed when any of them is not a files container.
+  if (oldSections.empty() || newSections.empty())
+  {
+    if (newSize != 0)
+      addChunk(ChunkType::Patch, 0 /* newOffset */, newSize, 0 /* oldOffset */, oldSize);
+    return chunks;
+  }
+
+  auto const addDeflate = [&addChunk](uint64_t beg, uint64_t end)
+  {
+    for (; beg < end; beg += kMaxDeflateChunkSize)
+      addChunk(ChunkType::Deflate, beg, std::min(kMaxDeflateChunkSize, end - beg), 0 /* oldOffset */,
+               0 /* oldSize */);
+  };
+
+  std::unordered_map<std::string, TagInfo const *> oldSectionsByTag;
+  for (auto const & section : oldSections)
+    oldSectionsByTag.emplace(section.m_tag, &section);
+
+  uint64_t pos = 0;
+  for (auto const & section : newSections)
+  {
+    addDeflate(pos, section.m_offset);
+
+    auto const it = oldSectionsByTag.find(section.m_tag);
+    if (it == oldSectionsByTag.end())
+      addDeflate(section.m_offset, section.m_offset + section.m_size);
+    else
+      addChunk(ChunkType::Patch, section.m_offset, section.m_size, it->second->m_offset, it->second->m_size);
+
+    pos = section.m_offset + section.m_size;
+  }
+  addDeflate(pos, newSize);
+  return chunks;
+}
+
+// Compares the bytes of the chunk in the old and the new mwms and calculates their crc32.
+bool IsIdentical(FileReader const & oldReader, FileReader const & newReader, Chunk & chunk)
+{
+  if (chunk.m_oldSize != chunk.m_newSize)
+    return false;
+
+  std::vector<uint8_t> oldBuf(kCopyBufferSize);
+  std::vector<uint8_t> newBuf(kCopyBufferSize);
+  uint32_t crc = 0;
+  for (uint64_t pos = 0; pos < chunk.m_newSize; pos += kCopyBufferSize)
+  {
+    auto const size = static_cast<size_t>(std::min<uint64_t>(kCopyBufferSize, chunk.m_newSize - pos));
+    oldReader.Read(chunk.m_oldOffset + pos, oldBuf.data(), size);
+    newReader.Read(chunk.m_newOffset + pos, newBuf.data(), size);
+    if (std::memcmp(oldBuf.data(), newBuf.data(), size) != 0)
+      return false;
+    crc = UpdateCrc(crc, oldBuf.data(), size);
+  }
+
+  chunk.m_crc = crc;
+  return true;
+}
+
+// Every chunk opens its own readers, so chunks are built in different threads.
+bool BuildChunk(std::string const & oldMwmPath, std::string const & newMwmPath, Chunk & chunk)
+{
+  FileReader const oldReader(oldMwmPath);
+  FileReader const newReader(newMwmPath);
+
+  if (chunk.m_type == ChunkType::Deflate)
+  {
+    std::vector<uint8_t> buf(static_cast<size_t>(chunk.m_newSize));
+    newReader.Read(chunk.m_newOffset, buf.data(), buf.size());
+    return Deflate(buf.data(), buf.size(), chunk.m_data);
+  }
+
+  ASSERT(chunk.m_type == ChunkType::Patch, ());
+  if (IsIdentical(oldReader, newReader, chunk))
+  {
+    chunk.m_type = ChunkType::Copy;
+    return true;
+  }
+
+  std::vector<uint8_t> diffBuf;
+  MemWriter<std::vector<uint8_t>> diffMemWriter(diffBuf);
+
+  auto oldSectionReader = oldReader.SubReader(chunk.m_oldOffset, chunk.m_oldSize);
+  auto newSectionReader = newReader.SubReader(chunk.m_newOffset, chunk.m_newSize);
+  auto const status = bsdiff::CreateBinaryPatch(oldSectionReader, newSectionReader, diffMemWriter);
+  if (status != bsdiff::BSDiffStatus::OK)
+  {
+    LOG(LERROR, ("Could not create patch with bsdiff:", status));
+    return false;
+  }
+
+  return Deflate(diffBuf.data(), diffBuf.size(), chunk.m_data);
+}
+
+void WriteChunk(Chunk const & chunk, FileWriter & diffFileWriter)
+{
+  WriteToSink(diffFileWriter, static_cast<uint8_t>(chunk.m_type));
+  WriteToSink(diffFileWriter, chunk.m_newSize);
+  switch (chunk.m_type)
+  {
+  case ChunkType::Copy:
+    WriteToSink(diffFileWriter, chunk.m_oldOffset);
+    WriteToSink(diffFileWriter, chunk.m_crc);
+    return;
+  case ChunkType::Patch:
+    WriteToSink(diffFileWriter, chunk.m_oldOffset);
+    WriteToSink(diffFileWriter, chunk.m_oldSize);
+    [[fallthrough]];
+  case ChunkType::Deflate:
+    WriteToSink(diffFileWriter, static_cast<uint64_t>(chunk.m_data.size()));
+    diffFileWriter.Write(chunk.m_data.data(), chunk.m_data.size());
+    return;
+  }
+  UNREACHABLE();
+}
+
+bool MakeDiffVersion1(std::string const & oldMwmPath, std::string const & newMwmPath, FileReader & oldReader,
+                      FileReader & newReader, FileWriter & diffFileWriter, size_t threadsCount)
+{
+  base::Timer timer;
+
+  auto const oldSize = oldReader.Size();
+  auto const newSize = newReader.Size();
+  std::vector<Chunk> chunks =
+      MakeChunks(ReadSections(oldMwmPath, oldSize), oldSize, ReadSections(newMwmPath, newSize), newSize);
+
+  WriteToSink(diffFileWriter, static_cast<uint32_t>(generator::mwm_diff::DiffFormat::V1));
+  WriteToSink(diffFileWriter, newSize);
+
+  // Chunks are written in order as soon as they are built and then their data are released.
+  std::vector<std::future<bool>> results;
+  results.reserve(chunks.size());
+  base::ComputationalThreadPool pool(std::max<size_t>(threadsCount, 1));
+  for (auto & chunk : chunks)
+    results.push_back(pool.Submit([&oldMwmPath, &newMwmPath, &chunk]()
+    { return BuildChunk(oldMwmPath, newMwmPath, chunk); }));
+
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    if (!results[i].get())
+    {
+      pool.Stop();
+      return false;
+    }
+
+    WriteChunk(chunks[i], diffFileWriter);
+    chunks[i].m_data = {};
+  }
+
+  auto const count = [&chunks](ChunkType type)
+  { return std::count_if(chunks.begin(), chunks.end(), [type](Chunk const & c) { return c.m_type == type; }); };
+  LOG(LINFO, ("Made diff of", chunks.size(), "chunks in", timer.ElapsedSeconds(), "seconds. Copied:",
+              count(ChunkType::Copy), "deflated:", count(ChunkType::Deflate), "patched:", count(ChunkType::Patch)));
+  return true;
+}
+
 bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter & diffFileWriter)
 {
   std::vector<uint8_t> deflatedDiffBuf;
@@ -51,18 +322,16 @@ bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter
     deflate(diffBuf.data(), diffBuf.size(), std::back_inserter(deflatedDiffBuf));
   }
   // A basic header that holds only version.
-  WriteToSink(diffFileWriter, static_cast<uint32_t>(VERSION_V0));
+  WriteToSink(diffFileWriter, static_cast<uint32_t>(generator::mwm_diff::DiffFormat::V0));
   diffFileWriter.Write(deflatedDiffBuf.data(), deflatedDiffBuf.size());
 
   return true;
 }
 
-generator::mwm_diff::DiffApplicationResult ApplyDiffVersion0(FileReader & oldReader, FileWriter & newWriter,
-                                                             ReaderSource<FileReader> & diffFileSource,
-                                                             base::Cancellable const & cancellable)
+DiffApplicationResult ApplyDiffVersion0(FileReader & oldReader, FileWriter & newWriter,
+                                        ReaderSource<FileReader> & diffFileSource,
+                                        base::Cancellable const & cancellable)
 {
-  using generator::mwm_diff::DiffApplicationResult;
-
   std::vector<uint8_t> diffBuf;
   {
     std::string deflatedDiff;
@@ -102,13 +371,140 @@ generator::mwm_diff::DiffApplicationResult ApplyDiffVersion0(FileReader & oldRea
   LOG(LERROR, ("Could not apply patch with bsdiff:", status));
   return DiffApplicationResult::Failed;
 }
+
+bool ReadChunkData(ReaderSource<FileReader> & diffFileSource, std::vector<uint8_t> & deflated,
+                   std::vector<uint8_t> & data)
+{
+  auto const size = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+  if (size > diffFileSource.Size())
+    return false;
+
+  deflated.resize(static_cast<size_t>(size));
+  diffFileSource.Read(deflated.data(), deflated.size());
+
+  using Inflate = coding::ZLib::Inflate;
+  Inflate inflate(Inflate::Format::ZLib);
+  data.clear();
+  return inflate(deflated.data(), deflated.size(), std::back_inserter(data));
+}
+
+DiffApplicationResult ApplyDiffVersion1(FileReader & oldReader, FileWriter & newWriter,
+                                        ReaderSource<FileReader> & diffFileSource,
+                                        base::Cancellable const & cancellable)
+{
+  auto const newSize = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+  auto const oldSize = oldReader.Size();
+
+  // The buffers are reused by the chunks.
+  std::vector<uint8_t> deflated;
+  std::vector<uint8_t> data;
+  for (uint64_t written = 0; written < newSize;)
+  {
+    if (cancellable.IsCancelled())
+    {
+      LOG(LDEBUG, ("Diff application has been cancelled"));
+      return DiffApplicationResult::Cancelled;
+    }
+
+    auto const type = static_cast<ChunkType>(ReadPrimitiveFromSource<uint8_t>(diffFileSource));
+    auto const size = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+    if (size == 0 || size > newSize - written)
+    {
+      LOG(LERROR, ("Bad size of a diff chunk:", size));
+      return DiffApplicationResult::Failed;
+    }
+
+    switch (type)
+    {
+    case ChunkType::Copy:
+    {
+      auto const oldOffset = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+      auto const crc = ReadPrimitiveFromSource<uint32_t>(diffFileSource);
+      if (!IsValidRange(oldOffset, size, oldSize))
+      {
+        LOG(LERROR, ("Bad range of a copied diff chunk:", oldOffset, size));
+        return DiffApplicationResult::Failed;
+      }
+
+      data.resize(kCopyBufferSize);
+      uint32_t oldCrc = 0;
+      for (uint64_t pos = 0; pos < size; pos += kCopyBufferSize)
+      {
+        auto const bufSize = static_cast<size_t>(std::min<uint64_t>(kCopyBufferSize, size - pos));
+        oldReader.Read(oldOffset + pos, data.data(), bufSize);
+        oldCrc = UpdateCrc(oldCrc, data.data(), bufSize);
+        newWriter.Write(data.data(), bufSize);
+      }
+
+      if (oldCrc != crc)
+      {
+        LOG(LERROR, ("The old mwm does not match the diff"));
+        return DiffApplicationResult::Failed;
+      }
+      break;
+    }
+    case ChunkType::Deflate:
+    {
+      if (!ReadChunkData(diffFileSource, deflated, data) || data.size() != size)
+      {
+        LOG(LERROR, ("Could not inflate a diff chunk"));
+        return DiffApplicationResult::Failed;
+      }
+      newWriter.Write(data.data(), data.size());
+      break;
+    }
+    case ChunkType::Patch:
+    {
+      auto const oldOffset = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+      auto const oldChunkSize = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+      if (!IsValidRange(oldOffset, oldChunkSize, oldSize) || !ReadChunkData(diffFileSource, deflated, data))
+      {
+        LOG(LERROR, ("Bad patch diff chunk:", oldOffset, oldChunkSize));
+        return DiffApplicationResult::Failed;
+      }
+
+      // See the comment about MemReaderWithExceptions in ApplyDiffVersion0.
+      MemReaderWithExceptions diffMemReader(data.data(), data.size());
+      auto oldChunkReader = oldReader.SubReader(oldOffset, oldChunkSize);
+      auto const pos = newWriter.Pos();
+      auto const status = bsdiff::ApplyBinaryPatch(oldChunkReader, newWriter, diffMemReader, cancellable);
+      if (status == bsdiff::BSDiffStatus::CANCELLED)
+      {
+        LOG(LDEBUG, ("Diff application has been cancelled"));
+        return DiffApplicationResult::Cancelled;
+      }
+
+      if (status != bsdiff::BSDiffStatus::OK || newWriter.Pos() - pos != size)
+      {
+        LOG(LERROR, ("Could not apply patch with bsdiff:", status));
+        return DiffApplicationResult::Failed;
+      }
+      break;
+    }
+    default:
+      LOG(LERROR, ("Unknown type of a diff chunk:", static_cast<int>(type)));
+      return DiffApplicationResult::Failed;
+    }
+
+    written += size;
+  }
+
+  if (diffFileSource.Size() != 0)
+  {
+    LOG(LERROR, ("Unexpected data at the end of the diff"));
+    return DiffApplicationResult::Failed;
+  }
+
+  return DiffApplicationResult::Ok;
+}
 }  // namespace
 
 namespace generator
 {
 namespace mwm_diff
 {
-bool MakeDiff(std::string const & oldMwmPath, std::string const & newMwmPath, std::string const & diffPath)
+bool MakeDiff(std::string const & oldMwmPath, std::string const & newMwmPath, std::string const & diffPath,
+              DiffFormat format, size_t threadsCount)
 {
   try
   {
@@ -116,10 +512,12 @@ bool MakeDiff(std::string const & oldMwmPath, std::string const & newMwmPath, st
     FileReader newReader(newMwmPath);
     FileWriter diffFileWriter(diffPath);
 
-    switch (VERSION_LATEST)
+    switch (format)
     {
-    case VERSION_V0: return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
-    default: LOG(LERROR, ("Making mwm diffs with diff format version", VERSION_LATEST, "is not implemented"));
+    case DiffFormat::V0: return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
+    case DiffFormat::V1:
+      return MakeDiffVersion1(oldMwmPath, newMwmPath, oldReader, newReader, diffFileWriter, threadsCount);
+    default: LOG(LERROR, ("Making mwm diffs with diff format version", format, "is not implemented"));
     }
   }
   catch (Reader::Exception const & e)
@@ -148,9 +546,10 @@ DiffApplicationResult ApplyDiff(std::string const & oldMwmPath, std::string cons
     ReaderSource<FileReader> diffFileSource(diffFileReader);
     auto const version = ReadPrimitiveFromSource<uint32_t>(diffFileSource);
 
-    switch (version)
+    switch (static_cast<DiffFormat>(version))
     {
-    case VERSION_V0: return ApplyDiffVersion0(oldReader, newWriter, diffFileSource, cancellable);
+    case DiffFormat::V0: return ApplyDiffVersion0(oldReader, newWriter, diffFileSource, cancellable);
+    case DiffFormat::V1: return ApplyDiffVersion1(oldReader, newWriter, diffFileSource, cancellable);
     default: LOG(LERROR, ("Unknown version format of mwm diff:", version)); return DiffApplicationResult::Failed;
     }
   }
@@ -176,5 +575,15 @@ std::string DebugPrint(DiffApplicationResult result)
   }
   UNREACHABLE();
 }
+
+std::string DebugPrint(DiffFormat format)
+{
+  switch (format)
+  {
+  case DiffFormat::V0: return "V0";
+  case DiffFormat::V1: return "V1";
+  }
+  UNREACHABLE();
+}
 }  // namespace mwm_diff
 }  // namespace generator
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace base
@@ -18,11 +20,25 @@ enum class DiffApplicationResult
   Cancelled,
 };
 
+// Versions of the diff format, see diff.cpp for the details.
+enum class DiffFormat : uint32_t
+{
+  // bsdiff+gzip of the whole mwm.
+  V0 = 0,
+  // bsdiff+gzip of every changed section of the mwm.
+  V1 = 1,
+  // The format of the diffs made by default. Apps installed before V1 can apply only V0 diffs,
+  // so it is switched to V1 once the clients in the field read V1.
+  Latest = V0,
+};
+
 // Makes a diff that, when applied to the mwm at |oldMwmPath|, will
 // result in the mwm at |newMwmPath|. The diff is stored at |diffPath|.
 // It is assumed that the files at |oldMwmPath| and |newMwmPath| are valid mwms.
+// Sections of the mwms are diffed in |threadsCount| threads, the format V0 uses one thread.
 // Returns true on success and false on failure.
-bool MakeDiff(std::string const & oldMwmPath, std::string const & newMwmPath, std::string const & diffPath);
+bool MakeDiff(std::string const & oldMwmPath, std::string const & newMwmPath, std::string const & diffPath,
+              DiffFormat format = DiffFormat::Latest, size_t threadsCount = 1);
 
 // Applies the diff at |diffPath| to the mwm at |oldMwmPath|. The resulting
 // mwm is stored at |newMwmPath|.
@@ -34,5 +50,6 @@ DiffApplicationResult ApplyDiff(std::string const & oldMwmPath, std::string cons
                                 std::string const & diffPath, base::Cancellable const & cancellable);
 
 std::string DebugPrint(DiffApplicationResult result);
+std::string DebugPrint(DiffFormat format);
 }  // namespace mwm_diff
 }  // namespace generator
@@ -5,6 +5,7 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_writer.hpp"
+#include "coding/files_container.hpp"
 #include "coding/internal/file_data.hpp"
 
 #include "base/file_name_utils.hpp"
@@ -84,4 +85,54 @@ UNIT_TEST(IncrementalUpdates_Smoke)
 
   TEST_EQUAL(ApplyDiff(oldMwmPath, newMwmPath2, diffPath, cancellable), DiffApplicationResult::Failed, ());
 }
+
+UNIT_TEST(IncrementalUpdates_Sections)
+{
+  base::ScopedLogAbortLevelChanger ignoreLogError(base::LogLevel::LCRITICAL);
+
+  string const oldMwmPath = base::JoinPath(GetPlatform().ResourcesDir(), "minsk-pass.mwm");
+  string const newMwmPath1 = base::JoinPath(GetPlatform().WritableDir(), "minsk-pass-new1.mwm");
+  string const newMwmPath2 = base::JoinPath(GetPlatform().WritableDir(), "minsk-pass-new2.mwm");
+  string const diffPath = base::JoinPath(GetPlatform().WritableDir(), "minsk-pass.mwmdiff");
+
+  SCOPE_GUARD(cleanup, [&]
+  {
+    FileWriter::DeleteFileX(newMwmPath1);
+    FileWriter::DeleteFileX(newMwmPath2);
+    FileWriter::DeleteFileX(diffPath);
+  });
+
+  base::Cancellable cancellable;
+
+  // Identical sections are copied from the old mwm.
+  TEST(MakeDiff(oldMwmPath, oldMwmPath, diffPath, DiffFormat::V1, 2 /* threadsCount */), ());
+  uint64_t diffSize = 0;
+  TEST(base::GetFileSize(diffPath, diffSize), ());
+  TEST_LESS(diffSize, 4 * 1024, ());
+  TEST_EQUAL(ApplyDiff(oldMwmPath, newMwmPath2, diffPath, cancellable), DiffApplicationResult::Ok, ());
+  TEST(base::IsEqualFiles(oldMwmPath, newMwmPath2), ());
+
+  TEST(base::CopyFileX(oldMwmPath, newMwmPath1), ());
+  {
+    FilesContainerW container(newMwmPath1, FileWriter::OP_WRITE_EXISTING);
+    container.Write(vector<uint8_t>(100000, 7), "test_section");
+  }
+
+  for (auto const format : {DiffFormat::V0, DiffFormat::V1})
+  {
+    TEST(MakeDiff(oldMwmPath, newMwmPath1, diffPath, format, 2 /* threadsCount */), (format));
+    TEST_EQUAL(ApplyDiff(oldMwmPath, newMwmPath2, diffPath, cancellable), DiffApplicationResult::Ok, (format));
+    TEST(base::IsEqualFiles(newMwmPath1, newMwmPath2), (format));
+  }
+
+  // The old mwm differs from the one the diff is made for.
+  {
+    vector<uint8_t> oldMwmContents = base::ReadFile(oldMwmPath);
+    oldMwmContents[oldMwmContents.size() / 2] ^= 255;
+    FileWriter writer(newMwmPath1);
+    writer.Write(oldMwmContents.data(), oldMwmContents.size());
+  }
+
+  TEST_EQUAL(ApplyDiff(newMwmPath1, newMwmPath2, diffPath, cancellable), DiffApplicationResult::Failed, ());
+}
 }  // namespace generator::diff_tests
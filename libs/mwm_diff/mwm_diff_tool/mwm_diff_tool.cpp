@@ -1,20 +1,89 @@
 #include "mwm_diff/diff.hpp"
 
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+
 #include "base/cancellable.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
 
 #include <cstring>
 #include <iostream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+// Makes and applies the diffs of all the formats and prints their sizes and timings.
+bool CompareFormats(std::string const & olderMWMPath, std::string const & newerMWMPath, std::string const & diffPath,
+                    size_t threadsCount)
+{
+  using namespace generator::mwm_diff;
+
+  std::string const appliedPath = newerMWMPath + ".applied";
+  bool ok = true;
+  for (auto const format : {DiffFormat::V0, DiffFormat::V1})
+  {
+    base::Timer timer;
+    if (!MakeDiff(olderMWMPath, newerMWMPath, diffPath, format, threadsCount))
+    {
+      std::cout << DebugPrint(format) << ": making failed\n";
+      ok = false;
+      continue;
+    }
+    double const makeSeconds = timer.ElapsedSeconds();
+
+    timer.Reset();
+    base::Cancellable cancellable;
+    auto const res = ApplyDiff(olderMWMPath, appliedPath, diffPath, cancellable);
+    double const applySeconds = timer.ElapsedSeconds();
+
+    uint64_t diffSize = 0;
+    base::GetFileSize(diffPath, diffSize);
+    bool const isEqual = res == DiffApplicationResult::Ok && base::IsEqualFiles(newerMWMPath, appliedPath);
+    ok = ok && isEqual;
+
+    std::cout << DebugPrint(format) << ": diff size " << diffSize << " bytes, making " << makeSeconds
+              << " s, applying " << applySeconds << " s, " << DebugPrint(res)
+              << (isEqual ? "" : ", THE RESULT DIFFERS FROM THE NEWER MWM") << "\n";
+  }
+
+  FileWriter::DeleteFileX(appliedPath);
+  return ok;
+}
+
+bool ParseFormat(char const * s, generator::mwm_diff::DiffFormat & format)
+{
+  using generator::mwm_diff::DiffFormat;
+
+  for (auto const f : {DiffFormat::V0, DiffFormat::V1})
+  {
+    if (DebugPrint(f) == s)
+    {
+      format = f;
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
 
 int main(int argc, char ** argv)
 {
   auto const ShowUsage = [argv]()
   {
     std::cout << "Usage: " << argv[0]
-              << " make|apply olderMWMPath newerMWMPath diffPath\n"
+              << " make|apply|compare olderMWMPath newerMWMPath diffPath [threadsCount] [--format=V0|V1]\n"
                  "make\n"
                  "  Creates the diff between newer and older MWMs at `diffPath`\n"
                  "apply\n"
                  "  Applies the diff at `diffPath` to the mwm at `olderMWMPath` and stores result at `newerMWMPath`.\n"
+                 "compare\n"
+                 "  Makes and applies the diffs of all the formats at `diffPath`, prints their sizes and timings.\n"
+                 "threadsCount\n"
+                 "  Number of threads to make the diff of the mwm sections in, 1 by default.\n"
+                 "--format\n"
+                 "  Format of the diff made by `make`, V0 by default. Apps before V1 support can't apply V1 diffs.\n"
                  "WARNING: THERE IS NO MWM VALIDITY CHECK!\n";
   };
 
@@ -27,9 +96,25 @@ int main(int argc, char ** argv)
   auto const IsEqualUsage = [argv](char const * s) { return 0 == std::strcmp(argv[1], s); };
   char const *olderMWMPath{argv[2]}, *newerMWMPath{argv[3]}, *diffPath{argv[4]};
 
+  size_t threadsCount = 1;
+  auto format = generator::mwm_diff::DiffFormat::Latest;
+  std::string_view const kFormatOption = "--format=";
+  for (int i = 5; i < argc; ++i)
+  {
+    std::string_view const arg = argv[i];
+    bool const isValid = arg.starts_with(kFormatOption)
+                           ? ParseFormat(argv[i] + kFormatOption.size(), format)
+                           : strings::to_size_t(argv[i], threadsCount) && threadsCount != 0;
+    if (!isValid)
+    {
+      ShowUsage();
+      return -1;
+    }
+  }
+
   if (IsEqualUsage("make"))
   {
-    if (generator::mwm_diff::MakeDiff(olderMWMPath, newerMWMPath, diffPath))
+    if (generator::mwm_diff::MakeDiff(olderMWMPath, newerMWMPath, diffPath, format, threadsCount))
       return 0;
   }
   else if (IsEqualUsage("apply"))
@@ -39,6 +124,11 @@ int main(int argc, char ** argv)
     if (res == generator::mwm_diff::DiffApplicationResult::Ok)
       return 0;
   }
+  else if (IsEqualUsage("compare"))
+  {
+    if (CompareFormats(olderMWMPath, newerMWMPath, diffPath, threadsCount))
+      return 0;
+  }
   else
     ShowUsage();
 
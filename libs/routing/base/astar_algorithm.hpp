@@ -1,6 +1,7 @@
 #pragma once
 
 #include "routing/base/astar_graph.hpp"
+#include "routing/base/astar_vertex_map.hpp"
 #include "routing/base/astar_vertex_data.hpp"
 #include "routing/base/astar_weight.hpp"
 #include "routing/base/routing_result.hpp"
@@ -122,28 +123,31 @@ public:
   class Context final
   {
   public:
-    Context(Graph & graph) : m_graph(graph) { m_graph.SetAStarParents(true /* forward */, m_parents); }
+    Context(Graph & graph) : m_graph(graph), m_distanceMap(graph.UseDenseAStarState())
+    {
+      m_graph.SetAStarParents(true /* forward */, m_parents);
+    }
 
     ~Context() { m_graph.DropAStarParents(); }
 
     void Clear()
     {
-      m_distanceMap.clear();
+      m_distanceMap.Clear();
       m_parents.clear();
     }
 
-    bool HasDistance(Vertex const & vertex) const { return m_distanceMap.find(vertex) != m_distanceMap.cend(); }
+    bool HasDistance(Vertex const & vertex) const { return m_distanceMap.Find(vertex) != nullptr; }
 
     Weight GetDistance(Vertex const & vertex) const
     {
-      auto const & it = m_distanceMap.find(vertex);
-      if (it == m_distanceMap.cend())
+      auto const * distance = m_distanceMap.Find(vertex);
+      if (distance == nullptr)
         return kInfiniteDistance;
 
-      return it->second;
+      return *distance;
     }
 
-    void SetDistance(Vertex const & vertex, Weight const & distance) { m_distanceMap[vertex] = distance; }
+    void SetDistance(Vertex const & vertex, Weight const & distance) { m_distanceMap.Set(vertex, distance); }
 
     void SetParent(Vertex const & parent, Vertex const & child) { m_parents[parent] = child; }
 
@@ -162,7 +166,7 @@ public:
 
   private:
     Graph & m_graph;
-    ska::bytell_hash_map<Vertex, Weight> m_distanceMap;
+    astar::VertexMap<Vertex, Weight> m_distanceMap;
     typename Graph::Parents m_parents;
   };
 
@@ -255,6 +259,7 @@ private:
       , startVertex(startVertex)
       , finalVertex(finalVertex)
       , graph(graph)
+      , bestDistance(graph.UseDenseAStarState())
     {
       bestVertex = forward ? startVertex : finalVertex;
       pS = ConsistentHeuristic(bestVertex);
@@ -266,7 +271,9 @@ private:
     Weight TopDistance() const
     {
       ASSERT(!queue.empty(), ());
-      return bestDistance.at(queue.top().vertex);
+      auto const * distance = bestDistance.Find(queue.top().vertex);
+      CHECK(distance, ());
+      return *distance;
     }
 
     // p_f(v) = 0.5*(π_f(v) - π_r(v))
@@ -300,16 +307,16 @@ private:
 
     bool ExistsStateWithBetterDistance(State const & state, Weight const & eps = Weight(0.0)) const
     {
-      auto const it = bestDistance.find(state.vertex);
-      return it != bestDistance.end() && state.distance > it->second - eps;
+      auto const * distance = bestDistance.Find(state.vertex);
+      return distance != nullptr && state.distance > *distance - eps;
     }
 
-    void UpdateDistance(State const & state) { bestDistance.insert_or_assign(state.vertex, state.distance); }
+    void UpdateDistance(State const & state) { bestDistance.Set(state.vertex, state.distance); }
 
     std::optional<Weight> GetDistance(Vertex const & vertex) const
     {
-      auto const it = bestDistance.find(vertex);
-      return it != bestDistance.cend() ? std::optional<Weight>(it->second) : std::nullopt;
+      auto const * distance = bestDistance.Find(vertex);
+      return distance != nullptr ? std::optional<Weight>(*distance) : std::nullopt;
     }
 
     void UpdateParent(Vertex const & to, Vertex const & from) { parent.insert_or_assign(to, from); }
@@ -338,7 +345,7 @@ private:
     Graph & graph;
 
     std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
-    ska::bytell_hash_map<Vertex, Weight> bestDistance;
+    astar::VertexMap<Vertex, Weight> bestDistance;
     Parents parent;
     Vertex bestVertex;
 
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace routing
+{
+namespace astar
+{
+// Position of a vertex in DenseVertexMap. Vertices of one feature of one mwm are numbered by |m_index|.
+// |m_check| distinguishes different vertices which got the same |m_index|.
+struct DenseKey
+{
+  uint32_t m_mwmId = 0;
+  uint32_t m_featureId = 0;
+  uint32_t m_index = 0;
+  uint32_t m_check = 0;
+};
+
+// Should be specialized for vertex types which can be kept in DenseVertexMap.
+// Get() returns false for vertices which can't be numbered (e.g. fake ones).
+template <typename Vertex>
+struct DenseKeyTraits
+{
+  static bool constexpr kSupported = false;
+
+  static bool Get(Vertex const & /* vertex */, DenseKey & /* key */) { return false; }
+};
+}  // namespace astar
+}  // namespace routing
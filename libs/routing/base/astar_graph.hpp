@@ -36,6 +36,9 @@ public:
 
   virtual Weight GetAStarWeightEpsilon();
 
+  // Returns true if A* should keep vertex states in astar::DenseVertexMap instead of hash maps.
+  virtual bool UseDenseAStarState() const;
+
   virtual ~AStarGraph() = default;
 };
 
@@ -60,4 +63,10 @@ WeightType AStarGraph<VertexType, EdgeType, WeightType>::GetAStarWeightEpsilon()
 {
   return routing::GetAStarWeightEpsilon<WeightType>();
 }
+
+template <typename VertexType, typename EdgeType, typename WeightType>
+bool AStarGraph<VertexType, EdgeType, WeightType>::UseDenseAStarState() const
+{
+  return false;
+}
 }  // namespace routing
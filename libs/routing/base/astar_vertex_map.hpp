@@ -0,0 +1,252 @@
+#pragma once
+
+#include "routing/base/astar_dense_key.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "3party/skarupke/bytell_hash_map.hpp"
+
+namespace routing
+{
+namespace astar
+{
+// Flat storage of A* vertex states. Every touched feature gets a block of slots in a shared pool,
+// blocks are found through per-mwm page tables indexed by feature id. So a lookup is a few array
+// accesses without hashing and the storage is reused between searches without reallocation:
+// Clear() bumps the generation and blocks of older generations are treated as empty.
+// A 12 KB page is allocated for every 1024 feature ids range with touched features. If the touched
+// features are sparse, new pages are not allocated and Set() fails, such vertices are kept by the caller.
+template <typename Value>
+class DenseVertexMap
+{
+public:
+  // Fake, guides and transit feature ids are above this limit and are not stored.
+  static uint32_t constexpr kMaxFeatureId = 1 << 28;
+  // Pages and slots above this size are freed by Clear().
+  static size_t constexpr kMaxKeptBytes = 8 * 1024 * 1024;
+
+  static bool IsSupported(DenseKey const & key) { return key.m_featureId < kMaxFeatureId; }
+
+  Value const * Find(DenseKey const & key) const
+  {
+    ASSERT(IsSupported(key), ());
+    if (key.m_mwmId >= m_pages.size())
+      return nullptr;
+
+    auto const & pages = m_pages[key.m_mwmId];
+    auto const pageIdx = key.m_featureId >> kPageBits;
+    if (pageIdx >= pages.size() || !pages[pageIdx])
+      return nullptr;
+
+    auto const & block = pages[pageIdx]->m_blocks[key.m_featureId & kPageMask];
+    if (block.m_generation != m_generation || key.m_index >= block.m_size)
+      return nullptr;
+
+    auto const & slot = m_slots[block.m_offset + key.m_index];
+    return slot.m_used && slot.m_check == key.m_check ? &slot.m_value : nullptr;
+  }
+
+  // Returns false if the slot is occupied by another vertex with the same index or if the vertex
+  // is in a sparse range of feature ids.
+  bool Set(DenseKey const & key, Value const & value)
+  {
+    ASSERT(IsSupported(key), ());
+    auto * block = GetBlock(key);
+    if (!block)
+      return false;
+
+    if (key.m_index >= block->m_size)
+      Grow(*block, key.m_index + 1);
+
+    auto & slot = m_slots[block->m_offset + key.m_index];
+    if (slot.m_used && slot.m_check != key.m_check)
+      return false;
+
+    slot.m_used = true;
+    slot.m_check = key.m_check;
+    slot.m_value = value;
+    return true;
+  }
+
+  void Clear()
+  {
+    m_slots.clear();
+    if (m_slots.capacity() * sizeof(Slot) > kMaxKeptBytes)
+      m_slots.shrink_to_fit();
+
+    m_usedBlocks = 0;
+    m_usedPages = 0;
+    ++m_generation;
+    // Stale blocks may look fresh after the generation counter overflow, so the pages are dropped too.
+    if (m_generation == 0 || m_pagesCount * sizeof(Page) > kMaxKeptBytes)
+    {
+      m_pages.clear();
+      m_pagesCount = 0;
+      m_generation = 1;
+    }
+  }
+
+  size_t GetMemoryBytes() const
+  {
+    size_t bytes = m_slots.capacity() * sizeof(Slot) + m_pagesCount * sizeof(Page);
+    for (auto const & pages : m_pages)
+      bytes += pages.capacity() * sizeof(pages[0]);
+    return bytes + m_pages.capacity() * sizeof(m_pages[0]);
+  }
+
+private:
+  static uint32_t constexpr kPageBits = 10;
+  static uint32_t constexpr kPageMask = (1 << kPageBits) - 1;
+  static uint32_t constexpr kPageSize = 1 << kPageBits;
+  // New pages are allocated while few pages are used by the current search or while there are
+  // at least kPageSize / kMinDensityDivisor touched features per used page on average.
+  static size_t constexpr kMinPagesCount = 16;
+  static size_t constexpr kMinDensityDivisor = 16;
+
+  struct Block
+  {
+    uint32_t m_generation = 0;
+    uint32_t m_offset = 0;
+    uint32_t m_size = 0;
+  };
+
+  struct Slot
+  {
+    bool m_used = false;
+    uint32_t m_check = 0;
+    Value m_value{};
+  };
+
+  struct Page
+  {
+    std::array<Block, kPageSize> m_blocks;
+    uint32_t m_generation = 0;
+  };
+
+  // Returns nullptr if there is no page for the key and the touched features are too sparse to allocate it.
+  Block * GetBlock(DenseKey const & key)
+  {
+    auto const pageIdx = key.m_featureId >> kPageBits;
+    bool const hasPage =
+        key.m_mwmId < m_pages.size() && pageIdx < m_pages[key.m_mwmId].size() && m_pages[key.m_mwmId][pageIdx];
+    if (!hasPage)
+    {
+      if (m_usedPages >= kMinPagesCount && m_usedBlocks * kMinDensityDivisor < m_usedPages * kPageSize)
+        return nullptr;
+
+      if (key.m_mwmId >= m_pages.size())
+        m_pages.resize(key.m_mwmId + 1);
+      auto & pages = m_pages[key.m_mwmId];
+      if (pageIdx >= pages.size())
+        pages.resize(pageIdx + 1);
+      pages[pageIdx] = std::make_unique<Page>();
+      ++m_pagesCount;
+    }
+
+    auto & page = *m_pages[key.m_mwmId][pageIdx];
+    if (page.m_generation != m_generation)
+    {
+      page.m_generation = m_generation;
+      ++m_usedPages;
+    }
+
+    auto & block = page.m_blocks[key.m_featureId & kPageMask];
+    if (block.m_generation != m_generation)
+    {
+      block = {m_generation, static_cast<uint32_t>(m_slots.size()), 0 /* size */};
+      ++m_usedBlocks;
+    }
+    return &block;
+  }
+
+  // Moves the block to the end of the pool if it can't be extended in place.
+  // The old slots are abandoned till the next Clear().
+  void Grow(Block & block, uint32_t minSize)
+  {
+    uint32_t const newSize = std::max(minSize, 2 * block.m_size);
+    if (block.m_offset + block.m_size == m_slots.size())
+    {
+      m_slots.resize(block.m_offset + newSize);
+    }
+    else
+    {
+      auto const offset = static_cast<uint32_t>(m_slots.size());
+      m_slots.resize(offset + newSize);
+      std::copy(m_slots.begin() + block.m_offset, m_slots.begin() + block.m_offset + block.m_size,
+                m_slots.begin() + offset);
+      block.m_offset = offset;
+    }
+    block.m_size = newSize;
+  }
+
+  // [mwm id][feature id >> kPageBits].
+  std::vector<std::vector<std::unique_ptr<Page>>> m_pages;
+  size_t m_pagesCount = 0;
+  // Number of pages and blocks of the current generation.
+  size_t m_usedPages = 0;
+  size_t m_usedBlocks = 0;
+  std::vector<Slot> m_slots;
+  uint32_t m_generation = 1;
+};
+
+// Vertex -> Value map for A* state. Keeps values in DenseVertexMap if |dense| is set and the vertex type
+// supports it, the rest goes to a hash map.
+template <typename Vertex, typename Value>
+class VertexMap
+{
+public:
+  explicit VertexMap(bool dense = false) : m_dense(dense && DenseKeyTraits<Vertex>::kSupported) {}
+
+  Value const * Find(Vertex const & vertex) const
+  {
+    DenseKey key;
+    if (GetDenseKey(vertex, key))
+    {
+      if (auto const * value = m_denseMap.Find(key))
+        return value;
+    }
+
+    if (m_map.empty())
+      return nullptr;
+
+    auto const it = m_map.find(vertex);
+    return it != m_map.cend() ? &it->second : nullptr;
+  }
+
+  void Set(Vertex const & vertex, Value const & value)
+  {
+    DenseKey key;
+    if (GetDenseKey(vertex, key) && m_denseMap.Set(key, value))
+      return;
+
+    m_map.insert_or_assign(vertex, value);
+  }
+
+  void Clear()
+  {
+    m_denseMap.Clear();
+    m_map.clear();
+  }
+
+  bool IsDense() const { return m_dense; }
+
+  DenseVertexMap<Value> const & GetDenseMap() const { return m_denseMap; }
+
+private:
+  bool GetDenseKey(Vertex const & vertex, DenseKey & key) const
+  {
+    return m_dense && DenseKeyTraits<Vertex>::Get(vertex, key) && DenseVertexMap<Value>::IsSupported(key);
+  }
+
+  bool const m_dense;
+  DenseVertexMap<Value> m_denseMap;
+  ska::bytell_hash_map<Vertex, Value> m_map;
+};
+}  // namespace astar
+}  // namespace routing
@@ -0,0 +1,562 @@
+#include "routing/cell_overlay.hpp"
+
+#include "routing/index_graph.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/world_graph.hpp"
+
+#include "indexer/data_source.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "base/logging.hpp"
+#include "base/scope_guard.hpp"
+#include "base/stl_helpers.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+#include "defines.hpp"
+
+namespace routing
+{
+namespace
+{
+uint32_t constexpr kCancelCheckPeriod = 1000;
+
+size_t GetIndex(std::vector<uint32_t> const & sortedIds, uint32_t id)
+{
+  auto const it = std::lower_bound(sortedIds.cbegin(), sortedIds.cend(), id);
+  CHECK(it != sortedIds.cend() && *it == id, (id));
+  return static_cast<size_t>(std::distance(sortedIds.cbegin(), it));
+}
+}  // namespace
+
+CellOverlay::CellOverlay(IndexGraph const & graph, uint8_t depth, std::vector<uint8_t> && levelShifts,
+                         std::vector<uint32_t> && jointCells)
+  : m_depth(depth)
+  , m_levelShifts(std::move(levelShifts))
+  , m_jointCells(std::move(jointCells))
+{
+  CHECK(!m_levelShifts.empty() && m_levelShifts.front() == 0, (m_levelShifts));
+  CHECK(std::is_sorted(m_levelShifts.cbegin(), m_levelShifts.cend()), (m_levelShifts));
+  CHECK_LESS(m_levelShifts.back(), std::max(m_depth, uint8_t(1)), ());
+  CHECK_LESS(m_depth, 32, ());
+  CHECK_EQUAL(m_jointCells.size(), graph.GetNumJoints(), ());
+
+  graph.ForEachRoad([&](uint32_t featureId, RoadJointIds const & /* roadJoints */)
+  {
+    auto const & road = graph.GetRoadGeometry(featureId);
+    if (!road.IsValid())
+      return;
+
+    for (uint32_t i = 0; i + 1 < road.GetPointsCount(); ++i)
+    {
+      uint32_t const back = GetCell(graph, RoadPoint(featureId, i));
+      uint32_t const front = GetCell(graph, RoadPoint(featureId, i + 1));
+      if (back == front || back == kNoCell || front == kNoCell)
+        continue;
+
+      m_transitions.emplace_back(featureId, i, true /* forward */, back, front);
+      if (!road.IsOneWay())
+        m_transitions.emplace_back(featureId, i, false /* forward */, front, back);
+    }
+  });
+
+  // Roads are visited in an arbitrary order.
+  std::sort(m_transitions.begin(), m_transitions.end(), [](Transition const & lhs, Transition const & rhs)
+  {
+    return std::tie(lhs.m_featureId, lhs.m_segmentIdx, lhs.m_forward) <
+           std::tie(rhs.m_featureId, rhs.m_segmentIdx, rhs.m_forward);
+  });
+
+  InitCells();
+}
+
+Segment CellOverlay::GetSegment(uint32_t transitionId) const
+{
+  auto const & t = m_transitions[transitionId];
+  return Segment(m_mwmId, t.m_featureId, t.m_segmentIdx, t.m_forward);
+}
+
+uint32_t CellOverlay::GetTransitionId(Segment const & segment) const
+{
+  if (segment.GetMwmId() != m_mwmId || segment.IsFakeCreated())
+    return kNoTransition;
+
+  auto const it = m_transitionIds.find(GetKey(segment.GetFeatureId(), segment.GetSegmentIdx(), segment.IsForward()));
+  return it == m_transitionIds.cend() ? kNoTransition : it->second;
+}
+
+uint32_t CellOverlay::GetCell(IndexGraph const & graph, RoadPoint const & rp) const
+{
+  if (!graph.IsRoad(rp.GetFeatureId()))
+    return kNoCell;
+
+  auto const & roadJoints = graph.GetRoad(rp.GetFeatureId());
+  Joint::Id jointId = roadJoints.GetJointId(rp.GetPointId());
+  if (jointId == Joint::kInvalidId)
+  {
+    auto const pointsCount = graph.GetRoadGeometry(rp.GetFeatureId()).GetPointsCount();
+    if (pointsCount < 2)
+      return kNoCell;
+
+    jointId = roadJoints.FindNeighbor(rp.GetPointId(), false /* forward */, pointsCount).first;
+    if (jointId == Joint::kInvalidId)
+      jointId = roadJoints.FindNeighbor(rp.GetPointId(), true /* forward */, pointsCount).first;
+  }
+
+  return jointId < m_jointCells.size() ? m_jointCells[jointId] : kNoCell;
+}
+
+float CellOverlay::GetWeight(size_t level, uint32_t enter, uint32_t exit) const
+{
+  auto const & cell = m_cells[level][GetCell(level, m_transitions[enter].m_toCell)];
+  return cell.m_weights[GetIndex(cell.m_enters, enter) * cell.m_exits.size() + GetIndex(cell.m_exits, exit)];
+}
+
+void CellOverlay::Customize(IndexGraph const & graph)
+{
+  for (size_t level = 0; level < m_cells.size(); ++level)
+    for (uint32_t cellId = 0; cellId < m_cells[level].size(); ++cellId)
+      CustomizeCell(graph, level, cellId);
+}
+
+void CellOverlay::CustomizeFeatures(IndexGraph const & graph, std::vector<uint32_t> const & featureIds)
+{
+  std::vector<uint32_t> leafCells;
+  for (auto const featureId : featureIds)
+  {
+    if (!graph.IsRoad(featureId))
+      continue;
+
+    auto const pointsCount = graph.GetRoadGeometry(featureId).GetPointsCount();
+    for (uint32_t i = 0; i < pointsCount; ++i)
+    {
+      auto const cell = GetCell(graph, RoadPoint(featureId, i));
+      if (cell != kNoCell)
+        leafCells.push_back(cell);
+    }
+  }
+  base::SortUnique(leafCells);
+
+  // Weights of a cell depend on the weights of its cells of the lower level only.
+  for (size_t level = 0; level < m_cells.size(); ++level)
+  {
+    std::vector<uint32_t> cells;
+    cells.reserve(leafCells.size());
+    for (auto const leafCell : leafCells)
+      cells.push_back(GetCell(level, leafCell));
+    base::SortUnique(cells);
+
+    for (auto const cellId : cells)
+      CustomizeCell(graph, level, cellId);
+  }
+}
+
+void CellOverlay::UpdateTraffic(IndexGraph const & graph,
+                                std::shared_ptr<traffic::TrafficInfo::Coloring const> coloring)
+{
+  if (coloring == m_coloring)
+    return;
+
+  std::vector<uint32_t> featureIds;
+  auto const addChanged = [&featureIds](traffic::TrafficInfo::Coloring const * from,
+                                        traffic::TrafficInfo::Coloring const * to)
+  {
+    if (!from)
+      return;
+
+    for (auto const & [roadSegment, speedGroup] : *from)
+    {
+      if (to)
+      {
+        auto const it = to->find(roadSegment);
+        if (it != to->cend() && it->second == speedGroup)
+          continue;
+      }
+      featureIds.push_back(roadSegment.GetFid());
+    }
+  };
+  addChanged(m_coloring.get(), coloring.get());
+  addChanged(coloring.get(), m_coloring.get());
+  base::SortUnique(featureIds);
+
+  m_coloring = std::move(coloring);
+  if (featureIds.empty())
+    return;
+
+  LOG(LINFO, ("Traffic of", featureIds.size(), "features has changed, customizing cell overlay of mwm", m_mwmId));
+  CustomizeFeatures(graph, featureIds);
+}
+
+bool CellOverlay::FindRoute(IndexGraphStarter & starter, base::Cancellable const & cancellable,
+                            std::vector<Segment> & waypoints, double & weight) const
+{
+  waypoints.clear();
+  if (m_cells.empty())
+    return false;
+
+  WorldGraph & worldGraph = starter.GetGraph();
+  IndexGraph const & graph = worldGraph.GetIndexGraph(m_mwmId);
+
+  // Leaf cells of the start and the finish. The route goes through the cells which contain them
+  // by the graph edges.
+  std::vector<uint32_t> endingCells;
+  for (auto const * segments : {&starter.GetStartRealSegments(), &starter.GetFinishRealSegments()})
+  {
+    for (auto const & segment : *segments)
+    {
+      if (segment.GetMwmId() != m_mwmId)
+        return false;
+
+      for (bool const front : {false, true})
+      {
+        auto const cell = GetCell(graph, segment.GetRoadPoint(front));
+        if (cell == kNoCell)
+          return false;
+        endingCells.push_back(cell);
+      }
+    }
+  }
+  base::SortUnique(endingCells);
+
+  // Transition is expanded by the weights of the highest level which its cell doesn't contain
+  // the start and the finish at, or by the graph edges.
+  auto const getLevel = [&](uint32_t transitionId)
+  {
+    auto const toCell = m_transitions[transitionId].m_toCell;
+    for (int level = m_transitionLevels[transitionId]; level >= 0; --level)
+    {
+      auto const cell = GetCell(level, toCell);
+      if (std::none_of(endingCells.cbegin(), endingCells.cend(),
+                       [&](uint32_t endingCell) { return GetCell(level, endingCell) == cell; }))
+      {
+        return level;
+      }
+    }
+    return -1;
+  };
+
+  struct VertexInfo
+  {
+    double m_weight;
+    Segment m_parent;
+    // Level of the cell weights the vertex is reached by, -1 for the graph edges.
+    int m_level;
+  };
+  std::unordered_map<Segment, VertexInfo> vertices;
+  // Parents by the graph edges for the restrictions check.
+  IndexGraphStarter::Parents<Segment> forwardParents;
+  IndexGraphStarter::Parents<Segment> backwardParents;
+
+  Segment const start = starter.GetStartSegment();
+  Segment const finish = starter.GetFinishSegment();
+
+  using State = std::tuple<double /* weight with heuristic */, double /* weight */, Segment>;
+  std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
+  auto const relax = [&](Segment const & from, double fromWeight, Segment const & to, double edgeWeight, int level)
+  {
+    double const newWeight = fromWeight + edgeWeight;
+    auto const [it, inserted] = vertices.try_emplace(to, VertexInfo{newWeight, from, level});
+    if (!inserted)
+    {
+      if (newWeight >= it->second.m_weight)
+        return;
+      it->second = {newWeight, from, level};
+    }
+
+    if (level < 0)
+      forwardParents[to] = from;
+    else
+      forwardParents.erase(to);
+    queue.emplace(newWeight + starter.HeuristicCostEstimate(to, finish).GetWeight(), newWeight, to);
+  };
+
+  auto const prevMode = worldGraph.GetMode();
+  worldGraph.SetMode(WorldGraphMode::SingleMwm);
+  starter.SetAStarParents(true /* forward */, forwardParents);
+  starter.SetAStarParents(false /* forward */, backwardParents);
+  SCOPE_GUARD(restoreGraph, [&]()
+  {
+    starter.DropAStarParents();
+    worldGraph.SetMode(prevMode);
+  });
+
+  vertices.emplace(start, VertexInfo{0.0, start, -1});
+  queue.emplace(starter.HeuristicCostEstimate(start, finish).GetWeight(), 0.0, start);
+
+  IndexGraphStarter::EdgeListT edges;
+  uint32_t steps = 0;
+  bool found = false;
+  while (!queue.empty())
+  {
+    if (++steps % kCancelCheckPeriod == 0 && cancellable.IsCancelled())
+      return false;
+
+    auto const [key, uWeight, u] = queue.top();
+    queue.pop();
+    if (uWeight > vertices.at(u).m_weight)
+      continue;
+
+    if (u == finish)
+    {
+      weight = uWeight;
+      found = true;
+      break;
+    }
+
+    auto const transitionId = GetTransitionId(u);
+    int const level = transitionId == kNoTransition ? -1 : getLevel(transitionId);
+    if (level < 0)
+    {
+      edges.clear();
+      starter.GetOutgoingEdgesList({u, RouteWeight(uWeight)}, edges);
+      for (auto const & edge : edges)
+        relax(u, uWeight, edge.GetTarget(), edge.GetWeight().GetIntegratedWeight(), -1 /* level */);
+      continue;
+    }
+
+    auto const & cell = m_cells[level][GetCell(level, m_transitions[transitionId].m_toCell)];
+    size_t const enterIdx = GetIndex(cell.m_enters, transitionId);
+    for (size_t i = 0; i < cell.m_exits.size(); ++i)
+    {
+      auto const cellWeight = cell.m_weights[enterIdx * cell.m_exits.size() + i];
+      if (cellWeight != kNoWeight)
+        relax(u, uWeight, GetSegment(cell.m_exits[i]), cellWeight, level);
+    }
+  }
+
+  if (!found)
+    return false;
+
+  std::vector<std::pair<Segment, int>> path;
+  for (Segment s = finish; s != start;)
+  {
+    auto const & info = vertices.at(s);
+    path.emplace_back(s, info.m_level);
+    s = info.m_parent;
+  }
+  std::reverse(path.begin(), path.end());
+
+  waypoints.push_back(start);
+  Segment prev = start;
+  for (auto const & [segment, level] : path)
+  {
+    if (level >= 0)
+    {
+      if (waypoints.back() != prev)
+        waypoints.push_back(prev);
+      UnpackCellRoute(level, GetTransitionId(prev), GetTransitionId(segment), waypoints);
+    }
+    prev = segment;
+  }
+  if (waypoints.back() != finish)
+    waypoints.push_back(finish);
+
+  return true;
+}
+
+void CellOverlay::InitCells()
+{
+  CHECK_LESS(m_depth, 32, ());
+  m_transitionIds.clear();
+  m_transitionLevels.assign(m_transitions.size(), 0);
+  m_cells.clear();
+  m_cells.resize(m_levelShifts.size());
+  for (size_t level = 0; level < m_cells.size(); ++level)
+    m_cells[level].resize(GetCellsCount(level));
+
+  for (uint32_t id = 0; id < m_transitions.size(); ++id)
+  {
+    auto const & t = m_transitions[id];
+    CHECK(t.m_fromCell < (1U << m_depth) && t.m_toCell < (1U << m_depth), (t.m_fromCell, t.m_toCell));
+    m_transitionIds.emplace(GetKey(t.m_featureId, t.m_segmentIdx, t.m_forward), id);
+
+    for (size_t level = 0; level < m_levelShifts.size(); ++level)
+    {
+      uint32_t const from = GetCell(level, t.m_fromCell);
+      uint32_t const to = GetCell(level, t.m_toCell);
+      if (from == to)
+        break;
+
+      m_transitionLevels[id] = static_cast<uint8_t>(level);
+      m_cells[level][from].m_exits.push_back(id);
+      m_cells[level][to].m_enters.push_back(id);
+    }
+  }
+
+  for (auto & cells : m_cells)
+    for (auto & cell : cells)
+      cell.m_weights.assign(cell.m_enters.size() * cell.m_exits.size(), kNoWeight);
+}
+
+bool CellOverlay::IsExit(size_t level, uint32_t cellId, uint32_t transitionId) const
+{
+  return m_transitionLevels[transitionId] >= level && GetCell(level, m_transitions[transitionId].m_fromCell) == cellId;
+}
+
+void CellOverlay::CustomizeCell(IndexGraph const & graph, size_t level, uint32_t cellId)
+{
+  auto & cell = m_cells[level][cellId];
+  std::fill(cell.m_weights.begin(), cell.m_weights.end(), kNoWeight);
+
+  size_t const exitsCount = cell.m_exits.size();
+  for (size_t i = 0; i < cell.m_enters.size(); ++i)
+  {
+    auto const onExit = [&](uint32_t exit, double weight)
+    { cell.m_weights[i * exitsCount + GetIndex(cell.m_exits, exit)] = static_cast<float>(weight); };
+
+    if (level == 0)
+      ForEachLeafCellExit(graph, cellId, cell.m_enters[i], onExit);
+    else
+      ForEachCellExit(level, cellId, cell.m_enters[i], nullptr /* parents */, onExit);
+  }
+}
+
+template <typename Fn>
+void CellOverlay::ForEachLeafCellExit(IndexGraph const & graph, uint32_t cellId, uint32_t enter, Fn && onExit) const
+{
+  // All the segments which leave the cell are transitions, so the search doesn't leave it.
+  Segment const start = GetSegment(enter);
+  std::unordered_map<Segment, double> weights;
+  IndexGraph::Parents<Segment> parents;
+
+  using State = std::pair<double, Segment>;
+  std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
+  weights.emplace(start, 0.0);
+  queue.emplace(0.0, start);
+
+  IndexGraph::SegmentEdgeListT edges;
+  while (!queue.empty())
+  {
+    auto const [weight, u] = queue.top();
+    queue.pop();
+    if (weight > weights[u])
+      continue;
+
+    if (u != start)
+    {
+      auto const transitionId = GetTransitionId(u);
+      if (transitionId != kNoTransition && IsExit(0 /* level */, cellId, transitionId))
+      {
+        onExit(transitionId, weight);
+        continue;
+      }
+    }
+
+    edges.clear();
+    graph.GetEdgeList(u, true /* isOutgoing */, false /* useRoutingOptions */, edges, parents);
+    for (auto const & edge : edges)
+    {
+      // Access and pass through penalties are added to the weights, like the router compares the routes.
+      double const newWeight = weight + edge.GetWeight().GetIntegratedWeight();
+      auto const [it, inserted] = weights.try_emplace(edge.GetTarget(), newWeight);
+      if (!inserted)
+      {
+        if (newWeight >= it->second)
+          continue;
+        it->second = newWeight;
+      }
+      parents[edge.GetTarget()] = u;
+      queue.emplace(newWeight, edge.GetTarget());
+    }
+  }
+}
+
+template <typename Fn>
+void CellOverlay::ForEachCellExit(size_t level, uint32_t cellId, uint32_t enter,
+                                  std::unordered_map<uint32_t, uint32_t> * parents, Fn && onExit) const
+{
+  CHECK_GREATER(level, 0, ());
+  std::unordered_map<uint32_t, double> weights;
+
+  using State = std::pair<double, uint32_t>;
+  std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
+  weights.emplace(enter, 0.0);
+  queue.emplace(0.0, enter);
+
+  while (!queue.empty())
+  {
+    auto const [weight, u] = queue.top();
+    queue.pop();
+    if (weight > weights[u])
+      continue;
+
+    if (u != enter && IsExit(level, cellId, u))
+    {
+      onExit(u, weight);
+      continue;
+    }
+
+    // |u| enters a cell of the lower level.
+    auto const & cell = m_cells[level - 1][GetCell(level - 1, m_transitions[u].m_toCell)];
+    size_t const enterIdx = GetIndex(cell.m_enters, u);
+    for (size_t i = 0; i < cell.m_exits.size(); ++i)
+    {
+      auto const cellWeight = cell.m_weights[enterIdx * cell.m_exits.size() + i];
+      if (cellWeight == kNoWeight)
+        continue;
+
+      double const newWeight = weight + cellWeight;
+      auto const v = cell.m_exits[i];
+      auto const [it, inserted] = weights.try_emplace(v, newWeight);
+      if (!inserted)
+      {
+        if (newWeight >= it->second)
+          continue;
+        it->second = newWeight;
+      }
+      if (parents)
+        (*parents)[v] = u;
+      queue.emplace(newWeight, v);
+    }
+  }
+}
+
+void CellOverlay::UnpackCellRoute(size_t level, uint32_t enter, uint32_t exit, std::vector<Segment> & waypoints) const
+{
+  CHECK_NOT_EQUAL(enter, kNoTransition, ());
+  CHECK_NOT_EQUAL(exit, kNoTransition, ());
+  if (level == 0)
+  {
+    waypoints.push_back(GetSegment(exit));
+    return;
+  }
+
+  std::unordered_map<uint32_t, uint32_t> parents;
+  ForEachCellExit(level, GetCell(level, m_transitions[enter].m_toCell), enter, &parents,
+                  [](uint32_t /* exit */, double /* weight */) {});
+
+  std::vector<uint32_t> path = {exit};
+  while (path.back() != enter)
+    path.push_back(parents.at(path.back()));
+  std::reverse(path.begin(), path.end());
+
+  for (size_t i = 0; i + 1 < path.size(); ++i)
+    UnpackCellRoute(level - 1, path[i], path[i + 1], waypoints);
+}
+
+std::shared_ptr<CellOverlay> LoadCellOverlay(MwmValue const & mwmValue)
+{
+  if (!mwmValue.m_cont.IsExist(CELL_OVERLAY_FILE_TAG))
+    return nullptr;
+
+  try
+  {
+    auto overlay = std::make_shared<CellOverlay>();
+    auto reader = mwmValue.m_cont.GetReader(CELL_OVERLAY_FILE_TAG);
+    ReaderSource src(reader);
+    overlay->Deserialize(src);
+    return overlay;
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR,
+        ("File", mwmValue.GetCountryFileName(), "Error while reading", CELL_OVERLAY_FILE_TAG, "section.", e.Msg()));
+    return nullptr;
+  }
+}
+}  // namespace routing
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "routing/joint.hpp"
+#include "routing/road_point.hpp"
+#include "routing/segment.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "traffic/traffic_info.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/cancellable.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class MwmValue;
+
+namespace routing
+{
+class IndexGraph;
+class IndexGraphStarter;
+
+/// \brief Multi-level cell overlay of an mwm car road graph (customizable route planning).
+/// Joints of the graph are partitioned into leaf cells, which are united into the bigger cells of the upper
+/// levels. A leaf cell id is a path in a tree of bisections, so the cell of level |l| is the leaf cell id
+/// shifted right by the level shift. A transition is a directed segment between different leaf cells.
+/// For every cell of every level the overlay keeps route weights between the transitions which enter and
+/// leave the cell through it. The partition doesn't depend on the weights, so weights of some cells may be
+/// calculated again (customized) quickly when traffic or road access of their roads changes.
+class CellOverlay
+{
+public:
+  static uint32_t constexpr kNoCell = std::numeric_limits<uint32_t>::max();
+  static uint32_t constexpr kNoTransition = std::numeric_limits<uint32_t>::max();
+  static float constexpr kNoWeight = std::numeric_limits<float>::infinity();
+
+  struct Transition
+  {
+    Transition() = default;
+    Transition(uint32_t featureId, uint32_t segmentIdx, bool forward, uint32_t fromCell, uint32_t toCell)
+      : m_featureId(featureId)
+      , m_segmentIdx(segmentIdx)
+      , m_forward(forward)
+      , m_fromCell(fromCell)
+      , m_toCell(toCell)
+    {}
+
+    uint32_t m_featureId = 0;
+    uint32_t m_segmentIdx = 0;
+    bool m_forward = true;
+    // Leaf cells of the back and the front points of the segment.
+    uint32_t m_fromCell = kNoCell;
+    uint32_t m_toCell = kNoCell;
+  };
+
+  CellOverlay() = default;
+  /// \param depth count of bisections, leaf cell ids are less than 2^depth.
+  /// \param levelShifts increasing shifts of the leaf cell ids for every level, the first one is zero.
+  /// \param jointCells leaf cell of every joint of |graph|.
+  /// \note Weights are unknown until Customize() call.
+  CellOverlay(IndexGraph const & graph, uint8_t depth, std::vector<uint8_t> && levelShifts,
+              std::vector<uint32_t> && jointCells);
+
+  size_t GetLevelsCount() const { return m_levelShifts.size(); }
+  uint32_t GetNumJoints() const { return static_cast<uint32_t>(m_jointCells.size()); }
+  size_t GetTransitionsCount() const { return m_transitions.size(); }
+  Transition const & GetTransition(uint32_t transitionId) const { return m_transitions[transitionId]; }
+  Segment GetSegment(uint32_t transitionId) const;
+  /// \returns id of the transition or kNoTransition.
+  uint32_t GetTransitionId(Segment const & segment) const;
+
+  // Segments of the overlay routes and weights are in this mwm. It's set when the overlay is loaded.
+  NumMwmId GetMwmId() const { return m_mwmId; }
+  void SetMwmId(NumMwmId mwmId) { m_mwmId = mwmId; }
+
+  uint32_t GetCell(size_t level, uint32_t leafCell) const { return leafCell >> m_levelShifts[level]; }
+  /// \returns leaf cell of the point or kNoCell if the road has no joints. A point between joints is
+  /// in the cell of the previous joint of the road.
+  uint32_t GetCell(IndexGraph const & graph, RoadPoint const & rp) const;
+
+  /// \returns route weight through the cell of |level| from the entering transition to the leaving one
+  /// without the weight of the entering segment, or kNoWeight.
+  float GetWeight(size_t level, uint32_t enter, uint32_t exit) const;
+
+  /// \brief Calculates weights of all the cells.
+  void Customize(IndexGraph const & graph);
+  /// \brief Calculates weights of the cells which contain points of the features.
+  void CustomizeFeatures(IndexGraph const & graph, std::vector<uint32_t> const & featureIds);
+  /// \brief Customizes the cells with the features which traffic has changed since the previous call.
+  void UpdateTraffic(IndexGraph const & graph, std::shared_ptr<traffic::TrafficInfo::Coloring const> coloring);
+
+  /// \brief Finds a route from the start to the finish of |starter|, which should be in the mwm of the overlay.
+  /// The route goes through the cells which contain neither start nor finish by their precalculated weights.
+  /// \param waypoints the start, the transitions between leaf cells which the route passes through
+  /// and the finish. Routes between the neighbouring waypoints should be calculated to get the whole route.
+  /// \param weight weight of the route.
+  bool FindRoute(IndexGraphStarter & starter, base::Cancellable const & cancellable, std::vector<Segment> & waypoints,
+                 double & weight) const;
+
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, kVersion);
+    WriteToSink(sink, m_depth);
+    WriteToSink(sink, static_cast<uint8_t>(m_levelShifts.size()));
+    for (auto const shift : m_levelShifts)
+      WriteToSink(sink, shift);
+
+    WriteVarUint(sink, static_cast<uint32_t>(m_jointCells.size()));
+    for (auto const cell : m_jointCells)
+      WriteVarUint(sink, cell);
+
+    WriteVarUint(sink, static_cast<uint32_t>(m_transitions.size()));
+    for (auto const & t : m_transitions)
+    {
+      WriteVarUint(sink, t.m_featureId);
+      WriteVarUint(sink, (t.m_segmentIdx << 1) | (t.m_forward ? 1 : 0));
+      WriteVarUint(sink, t.m_fromCell);
+      WriteVarUint(sink, t.m_toCell);
+    }
+
+    // Weights are rounded to deciseconds, zero means no route.
+    for (auto const & cells : m_cells)
+    {
+      for (auto const & cell : cells)
+      {
+        for (auto const weight : cell.m_weights)
+          WriteVarUint(sink, weight == kNoWeight ? 0 : static_cast<uint32_t>(weight * 10.0f + 0.5f) + 1);
+      }
+    }
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    CHECK_EQUAL(version, kVersion, ());
+    m_depth = ReadPrimitiveFromSource<uint8_t>(src);
+    m_levelShifts.resize(ReadPrimitiveFromSource<uint8_t>(src));
+    for (auto & shift : m_levelShifts)
+      shift = ReadPrimitiveFromSource<uint8_t>(src);
+
+    m_jointCells.resize(ReadVarUint<uint32_t>(src));
+    for (auto & cell : m_jointCells)
+      cell = ReadVarUint<uint32_t>(src);
+
+    m_transitions.resize(ReadVarUint<uint32_t>(src));
+    for (auto & t : m_transitions)
+    {
+      t.m_featureId = ReadVarUint<uint32_t>(src);
+      auto const segment = ReadVarUint<uint32_t>(src);
+      t.m_segmentIdx = segment >> 1;
+      t.m_forward = (segment & 1) != 0;
+      t.m_fromCell = ReadVarUint<uint32_t>(src);
+      t.m_toCell = ReadVarUint<uint32_t>(src);
+    }
+
+    InitCells();
+    for (auto & cells : m_cells)
+    {
+      for (auto & cell : cells)
+      {
+        for (auto & weight : cell.m_weights)
+        {
+          auto const value = ReadVarUint<uint32_t>(src);
+          weight = value == 0 ? kNoWeight : (value - 1) / 10.0f;
+        }
+      }
+    }
+  }
+
+private:
+  static uint16_t constexpr kVersion = 0;
+
+  struct Cell
+  {
+    // Sorted ids of the transitions.
+    std::vector<uint32_t> m_enters;
+    std::vector<uint32_t> m_exits;
+    // Weights by enter and then by exit.
+    std::vector<float> m_weights;
+  };
+
+  static uint64_t GetKey(uint32_t featureId, uint32_t segmentIdx, bool forward)
+  {
+    return (static_cast<uint64_t>(featureId) << 32) | (static_cast<uint64_t>(segmentIdx) << 1) | (forward ? 1 : 0);
+  }
+
+  // Fills the cells and the transition index by |m_transitions|.
+  void InitCells();
+  uint32_t GetCellsCount(size_t level) const { return (1U << m_depth) >> m_levelShifts[level]; }
+  bool IsExit(size_t level, uint32_t cellId, uint32_t transitionId) const;
+  void CustomizeCell(IndexGraph const & graph, size_t level, uint32_t cellId);
+
+  // Runs Dijkstra from the transition |enter| inside the leaf cell and calls |onExit| for the leaving transitions.
+  template <typename Fn>
+  void ForEachLeafCellExit(IndexGraph const & graph, uint32_t cellId, uint32_t enter, Fn && onExit) const;
+  // Runs Dijkstra by the weights of level |level - 1| inside the cell of |level| > 0.
+  template <typename Fn>
+  void ForEachCellExit(size_t level, uint32_t cellId, uint32_t enter,
+                       std::unordered_map<uint32_t, uint32_t> * parents, Fn && onExit) const;
+  // Appends the leaf cells transitions of the route through the cell after |enter| up to |exit|.
+  void UnpackCellRoute(size_t level, uint32_t enter, uint32_t exit, std::vector<Segment> & waypoints) const;
+
+  uint8_t m_depth = 0;
+  std::vector<uint8_t> m_levelShifts;
+  std::vector<uint32_t> m_jointCells;
+  std::vector<Transition> m_transitions;
+  // Max level which the transition is between different cells of.
+  std::vector<uint8_t> m_transitionLevels;
+  std::unordered_map<uint64_t, uint32_t> m_transitionIds;
+  // Cells by level and by cell id.
+  std::vector<std::vector<Cell>> m_cells;
+
+  NumMwmId m_mwmId = kFakeNumMwmId;
+  std::shared_ptr<traffic::TrafficInfo::Coloring const> m_coloring;
+};
+
+/// \returns cell overlay of the mwm or nullptr if there is no CELL_OVERLAY_FILE_TAG section.
+std::shared_ptr<CellOverlay> LoadCellOverlay(MwmValue const & mwmValue);
+}  // namespace routing
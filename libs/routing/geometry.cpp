@@ -2,6 +2,7 @@
 
 #include "routing/city_roads.hpp"
 #include "routing/maxspeeds.hpp"
+#include "routing/road_geometry_cache.hpp"
 
 #include "indexer/altitude_loader.hpp"
 #include "indexer/feature.hpp"
@@ -79,14 +80,14 @@ public:
 
   void Load(uint32_t featureId, RoadGeometry & road) override
   {
-    auto feature = m_source.GetOriginalFeature(featureId);
-    feature->ParseGeometry(FeatureType::BEST_GEOMETRY);
+    m_source.GetOriginalFeature(featureId, m_feature);
+    m_feature.ParseGeometry(FeatureType::BEST_GEOMETRY);
 
     geometry::Altitudes altitudes;
     if (m_loadAltitudes)
-      altitudes = m_altitudeLoader.GetAltitudes(featureId, feature->GetPointsCount());
+      altitudes = m_altitudeLoader.GetAltitudes(featureId, m_feature.GetPointsCount());
 
-    road.Load(*m_vehicleModel, *feature, altitudes.empty() ? nullptr : &altitudes, m_attrsGetter);
+    road.Load(*m_vehicleModel, m_feature, altitudes.empty() ? nullptr : &altitudes, m_attrsGetter);
   }
 
   Maxspeed GetSavedMaxspeed(uint32_t featureId) override { return m_attrsGetter.m_maxSpeeds.GetMaxspeed(featureId); }
@@ -95,6 +96,8 @@ private:
   VehicleModelPtrT m_vehicleModel;
   RoadAttrsGetter m_attrsGetter;
   FeatureSource m_source;
+  // Reused for all roads.
+  FeatureType m_feature;
   feature::AltitudeLoaderBase m_altitudeLoader;
   bool const m_loadAltitudes;
 };
@@ -111,20 +114,21 @@ public:
 
   void Load(uint32_t featureId, RoadGeometry & road) override
   {
-    auto feature = m_featuresVector.GetVector().GetByIndex(featureId);
-    CHECK(feature, ());
-    feature->SetID({{}, featureId});
-    feature->ParseGeometry(FeatureType::BEST_GEOMETRY);
+    m_featuresVector.GetVector().GetByIndex(featureId, m_feature);
+    m_feature.SetID({{}, featureId});
+    m_feature.ParseGeometry(FeatureType::BEST_GEOMETRY);
 
     // Note. If FileGeometryLoader is used for generation cross mwm section for bicycle or
     // pedestrian routing |altitudes| should be used here.
-    road.Load(*m_vehicleModel, *feature, nullptr /* altitudes */, m_attrsGetter);
+    road.Load(*m_vehicleModel, m_feature, nullptr /* altitudes */, m_attrsGetter);
   }
 
 private:
   FeaturesVectorTest m_featuresVector;
   RoadAttrsGetter m_attrsGetter;
   VehicleModelPtrT m_vehicleModel;
+  // Reused for all roads.
+  FeatureType m_feature;
 };
 }  // namespace
 
@@ -290,21 +294,37 @@ double RoadGeometry::GetRoadLengthM() const
   return lenM;
 }
 
+size_t RoadGeometry::GetMemorySize() const
+{
+  return sizeof(RoadGeometry) + m_junctions.capacity() * sizeof(LatLonWithAltitude) +
+         m_distances.capacity() * sizeof(double);
+}
+
 // Geometry ----------------------------------------------------------------------------------------
-Geometry::Geometry(std::unique_ptr<GeometryLoader> loader, size_t roadsCacheSize) : m_loader(std::move(loader))
+Geometry::Geometry(std::unique_ptr<GeometryLoader> loader, size_t roadsCacheSizeBytes)
+  : Geometry(std::move(loader), std::make_shared<RoadGeometryCache>(roadsCacheSizeBytes), 0 /* cacheMwmIdx */)
+{}
+
+Geometry::Geometry(std::unique_ptr<GeometryLoader> loader, std::shared_ptr<RoadGeometryCache> cache,
+                   uint32_t cacheMwmIdx)
+  : m_loader(std::move(loader))
+  , m_cache(std::move(cache))
+  , m_cacheMwmIdx(cacheMwmIdx)
 {
   CHECK(m_loader, ());
+  CHECK(m_cache, ());
 
-  m_featureIdToRoad = std::make_unique<RoutingCacheT>(
-      roadsCacheSize, [this](uint32_t featureId, RoadGeometry & road) { m_loader->Load(featureId, road); });
+  m_loadRoad = [this](uint32_t featureId, RoadGeometry & road) { m_loader->Load(featureId, road); };
 }
 
+Geometry::~Geometry() = default;
+
 RoadGeometry const & Geometry::GetRoad(uint32_t featureId)
 {
-  ASSERT(m_featureIdToRoad, ());
+  ASSERT(m_cache, ());
   ASSERT(m_loader, ());
 
-  return m_featureIdToRoad->GetValue(featureId);
+  return m_cache->GetRoad(m_cacheMwmIdx, featureId, m_loadRoad);
 }
 
 Maxspeed GeometryLoader::GetSavedMaxspeed(uint32_t featureId)
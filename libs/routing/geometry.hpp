@@ -10,23 +10,21 @@
 
 #include "geometry/latlon.hpp"
 
-#include "base/fifo_cache.hpp"
-
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 
-#include "3party/skarupke/bytell_hash_map.hpp"
-
 class DataSource;
 
 namespace routing
 {
 // @TODO(bykoianko) Consider setting cache size based on available memory.
-// Maximum road geometry cache size in items.
-size_t constexpr kRoadsCacheSize = 10000;
+// Maximum road geometry cache size in bytes.
+size_t constexpr kRoadsCacheSizeBytes = 8 * 1024 * 1024;
 
 class RoadAttrsGetter;
+class RoadGeometryCache;
 
 class RoadGeometry final
 {
@@ -81,6 +79,9 @@ public:
 
   RoutingOptions GetRoutingOptions() const { return m_routingOptions; }
 
+  /// \returns approximate memory used by the road, including the object itself.
+  size_t GetMemorySize() const;
+
 private:
   std::vector<LatLonWithAltitude> m_junctions;
   mutable std::vector<double> m_distances;  ///< as cache, @see GetDistance()
@@ -119,11 +120,13 @@ public:
 };
 
 /// \brief This class supports loading geometry of roads for routing.
-/// \note Loaded information about road geometry is kept in a fixed-size cache |m_featureIdToRoad|.
+/// \note Loaded information about road geometry is kept in a memory-limited cache |m_cache|.
 /// On the other hand methods GetRoad() and GetPoint() return geometry information by reference.
 /// The reference may be invalid after the next call of GetRoad() or GetPoint() because the cache
 /// item which is referred by returned reference may be evicted. It's done for performance reasons.
-/// \note The cache |m_featureIdToRoad| is used for road geometry for single-directional
+/// \note The cache may be shared with Geometry of other mwms and of previous route calculations,
+/// see RoadGeometryCache.
+/// \note The cache |m_cache| is used for road geometry for single-directional
 /// and bidirectional A*. According to tests it's faster to use one cache for both directions
 /// in bidirectional A* case than two separate caches, one for each direction (one for each A* wave).
 class Geometry final
@@ -131,8 +134,12 @@ class Geometry final
 public:
   Geometry() = default;
   /// \brief Geometry constructor
-  /// \param roadsCacheSize in-memory geometry elements count limit
-  Geometry(std::unique_ptr<GeometryLoader> loader, size_t roadsCacheSize = kRoadsCacheSize);
+  /// \param roadsCacheSizeBytes in-memory geometry elements size limit
+  Geometry(std::unique_ptr<GeometryLoader> loader, size_t roadsCacheSizeBytes = kRoadsCacheSizeBytes);
+  /// \brief Geometry constructor with the external cache
+  /// \param cacheMwmIdx index of the mwm in |cache|, @see RoadGeometryCache::GetMwmIndex().
+  Geometry(std::unique_ptr<GeometryLoader> loader, std::shared_ptr<RoadGeometryCache> cache, uint32_t cacheMwmIdx);
+  ~Geometry();
 
   /// \note The reference returned by the method is valid until the next call of GetRoad()
   /// of GetPoint() methods.
@@ -145,10 +152,9 @@ public:
   Maxspeed GetSavedMaxspeed(uint32_t featureId) { return m_loader->GetSavedMaxspeed(featureId); }
 
 private:
-  /// @todo Use LRU cache?
-  using RoutingCacheT = FifoCache<uint32_t, RoadGeometry, ska::bytell_hash_map<uint32_t, RoadGeometry>>;
-
   std::unique_ptr<GeometryLoader> m_loader;
-  std::unique_ptr<RoutingCacheT> m_featureIdToRoad;
+  std::function<void(uint32_t, RoadGeometry &)> m_loadRoad;
+  std::shared_ptr<RoadGeometryCache> m_cache;
+  uint32_t m_cacheMwmIdx = 0;
 };
 }  // namespace routing
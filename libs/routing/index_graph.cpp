@@ -39,7 +39,7 @@ IndexGraph::IndexGraph(std::shared_ptr<Geometry> geometry, std::shared_ptr<EdgeE
 
 bool IndexGraph::IsJoint(RoadPoint const & roadPoint) const
 {
-  return m_roadIndex.GetJointId(roadPoint) != Joint::kInvalidId;
+  return m_topology->m_roadIndex.GetJointId(roadPoint) != Joint::kInvalidId;
 }
 
 bool IndexGraph::IsJointOrEnd(Segment const & segment, bool fromStart) const
@@ -77,11 +77,11 @@ void IndexGraph::GetEdgeListImpl(astar::VertexData<Segment, RouteWeight> const &
   auto const & segment = vertexData.m_vertex;
 
   RoadPoint const roadPoint = segment.GetRoadPoint(isOutgoing);
-  Joint::Id const jointId = m_roadIndex.GetJointId(roadPoint);
+  Joint::Id const jointId = m_topology->m_roadIndex.GetJointId(roadPoint);
 
   if (jointId != Joint::kInvalidId)
   {
-    m_jointIndex.ForEachPoint(jointId, [&](RoadPoint const & rp)
+    m_topology->m_jointIndex.ForEachPoint(jointId, [&](RoadPoint const & rp)
     { GetNeighboringEdges(vertexData, rp, isOutgoing, useRoutingOptions, edges, parents, useAccessConditional); });
   }
   else
@@ -178,30 +178,30 @@ std::optional<JointEdge> IndexGraph::GetJointEdgeByLastPoint(Segment const & par
 
 void IndexGraph::Build(uint32_t numJoints)
 {
-  m_jointIndex.Build(m_roadIndex, numJoints);
+  m_topology->m_jointIndex.Build(m_topology->m_roadIndex, numJoints);
 }
 
 void IndexGraph::Import(std::vector<Joint> const & joints)
 {
-  m_roadIndex.Import(joints);
+  m_topology->m_roadIndex.Import(joints);
   CHECK_LESS_OR_EQUAL(joints.size(), std::numeric_limits<uint32_t>::max(), ());
   Build(checked_cast<uint32_t>(joints.size()));
 }
 
 void IndexGraph::SetRestrictions(RestrictionVec && restrictions)
 {
-  m_restrictionsForward.clear();
-  m_restrictionsBackward.clear();
+  m_topology->m_restrictionsForward.clear();
+  m_topology->m_restrictionsBackward.clear();
 
   for (auto const & restriction : restrictions)
   {
     ASSERT(!restriction.empty(), ());
 
-    auto & forward = m_restrictionsForward[restriction.back()];
+    auto & forward = m_topology->m_restrictionsForward[restriction.back()];
     forward.emplace_back(restriction.begin(), prev(restriction.end()));
     reverse(forward.back().begin(), forward.back().end());
 
-    m_restrictionsBackward[restriction.front()].emplace_back(next(restriction.begin()), restriction.end());
+    m_topology->m_restrictionsBackward[restriction.front()].emplace_back(next(restriction.begin()), restriction.end());
   }
 }
 
@@ -209,9 +209,9 @@ void IndexGraph::SetUTurnRestrictions(std::vector<RestrictionUTurn> && noUTurnRe
 {
   for (auto const & noUTurn : noUTurnRestrictions)
     if (noUTurn.m_viaIsFirstPoint)
-      m_noUTurnRestrictions[noUTurn.m_featureId].m_atTheBegin = true;
+      m_topology->m_noUTurnRestrictions[noUTurn.m_featureId].m_atTheBegin = true;
     else
-      m_noUTurnRestrictions[noUTurn.m_featureId].m_atTheEnd = true;
+      m_topology->m_noUTurnRestrictions[noUTurn.m_featureId].m_atTheEnd = true;
 }
 
 void IndexGraph::SetRoadAccess(RoadAccess && roadAccess)
@@ -220,6 +220,81 @@ void IndexGraph::SetRoadAccess(RoadAccess && roadAccess)
   m_roadAccess.SetCurrentTimeGetter(m_currentTimeGetter);
 }
 
+Landmarks const * IndexGraph::GetLandmarks() const
+{
+  // Landmark weights are times, they are not a bound of the shortest strategy weights.
+  if (!m_landmarks || m_estimator->GetStrategy() != EdgeEstimator::Strategy::Normal)
+    return nullptr;
+  return m_landmarks.get();
+}
+
+CellOverlay * IndexGraph::GetCellOverlay() const
+{
+  // Cell weights are times, they are calculated with the Normal strategy.
+  if (!m_cellOverlay || m_estimator->GetStrategy() != EdgeEstimator::Strategy::Normal)
+    return nullptr;
+  return m_cellOverlay.get();
+}
+
+bool IndexGraph::GetLandmarkWeights(RoadPoint const & rp, LandmarkWeights & weights) const
+{
+  auto const * landmarks = GetLandmarks();
+  if (!landmarks || !IsRoad(rp.GetFeatureId()))
+    return false;
+
+  auto const & roadJoints = GetRoad(rp.GetFeatureId());
+  auto const jointId = roadJoints.GetJointId(rp.GetPointId());
+  if (jointId != Joint::kInvalidId)
+  {
+    landmarks->GetWeights(jointId, weights);
+    return true;
+  }
+
+  // Points between joints are connected with the rest of the graph through the neighbouring joints only.
+  auto const & road = GetRoadGeometry(rp.GetFeatureId());
+  if (!road.IsValid() || road.GetPointsCount() < 2)
+    return false;
+
+  bool found = false;
+  LandmarkWeights jointWeights;
+  for (bool const forward : {false, true})
+  {
+    auto const [neighborId, neighborPointId] = roadJoints.FindNeighbor(rp.GetPointId(), forward, road.GetPointsCount());
+    if (neighborId == Joint::kInvalidId)
+      continue;
+
+    // Weights of the road part between the joint and the point. Traffic is not taken into account,
+    // because the weights are a bound.
+    double toPoint = 0.0;
+    double fromPoint = 0.0;
+    uint32_t const begin = std::min(rp.GetPointId(), neighborPointId);
+    uint32_t const end = std::max(rp.GetPointId(), neighborPointId);
+    for (uint32_t i = begin; i < end; ++i)
+    {
+      toPoint += m_estimator->CalcSegmentWeight(Segment(kFakeNumMwmId, rp.GetFeatureId(), i, !forward), road,
+                                                EdgeEstimator::Purpose::Weight);
+      fromPoint += m_estimator->CalcSegmentWeight(Segment(kFakeNumMwmId, rp.GetFeatureId(), i, forward), road,
+                                                  EdgeEstimator::Purpose::Weight);
+    }
+    if (road.IsOneWay())
+      (forward ? toPoint : fromPoint) = LandmarkWeights::kNoWeight;
+
+    landmarks->GetWeights(neighborId, jointWeights);
+    if (!found)
+    {
+      weights.Init(jointWeights.m_count, jointWeights.m_precisionSec);
+      found = true;
+    }
+
+    for (size_t i = 0; i < weights.m_count; ++i)
+    {
+      weights.m_from[i] = std::min(weights.m_from[i], jointWeights.m_from[i] + toPoint);
+      weights.m_to[i] = std::min(weights.m_to[i], fromPoint + jointWeights.m_to[i]);
+    }
+  }
+  return found;
+}
+
 void IndexGraph::GetNeighboringEdges(astar::VertexData<Segment, RouteWeight> const & fromVertexData,
                                      RoadPoint const & rp, bool isOutgoing, bool useRoutingOptions,
                                      SegmentEdgeListT & edges, Parents<Segment> const & parents,
@@ -271,12 +346,12 @@ void IndexGraph::GetSegmentCandidateForRoadPoint(RoadPoint const & rp, NumMwmId
 void IndexGraph::GetSegmentCandidateForJoint(Segment const & parent, bool isOutgoing, SegmentListT & children) const
 {
   RoadPoint const roadPoint = parent.GetRoadPoint(isOutgoing);
-  Joint::Id const jointId = m_roadIndex.GetJointId(roadPoint);
+  Joint::Id const jointId = m_topology->m_roadIndex.GetJointId(roadPoint);
 
   if (jointId == Joint::kInvalidId)
     return;
 
-  m_jointIndex.ForEachPoint(jointId, [&](RoadPoint const & rp)
+  m_topology->m_jointIndex.ForEachPoint(jointId, [&](RoadPoint const & rp)
   { GetSegmentCandidateForRoadPoint(rp, parent.GetMwmId(), isOutgoing, children); });
 }
 
@@ -487,11 +562,11 @@ bool IndexGraph::IsUTurnAndRestricted(Segment const & parent, Segment const & ch
   auto const & roadGeometry = GetRoadGeometry(featureId);
 
   RoadPoint const rp = parent.GetRoadPoint(isOutgoing);
-  if (m_roadIndex.GetJointId(rp) == Joint::kInvalidId && !roadGeometry.IsEndPointId(turnPoint))
+  if (m_topology->m_roadIndex.GetJointId(rp) == Joint::kInvalidId && !roadGeometry.IsEndPointId(turnPoint))
     return true;
 
-  auto const it = m_noUTurnRestrictions.find(featureId);
-  if (it == m_noUTurnRestrictions.cend())
+  auto const it = m_topology->m_noUTurnRestrictions.find(featureId);
+  if (it == m_topology->m_noUTurnRestrictions.cend())
     return false;
 
   auto const & uTurn = it->second;
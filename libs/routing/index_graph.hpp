@@ -8,6 +8,8 @@
 #include "routing/joint.hpp"
 #include "routing/joint_index.hpp"
 #include "routing/joint_segment.hpp"
+#include "routing/cell_overlay.hpp"
+#include "routing/landmarks.hpp"
 #include "routing/restrictions_serialization.hpp"
 #include "routing/road_access.hpp"
 #include "routing/road_index.hpp"
@@ -47,6 +49,31 @@ public:
   using SegmentListT = SmallList<Segment>;
   using PointIdListT = SmallList<uint32_t>;
 
+  /// \brief Joints and turn restrictions of the mwm roads.
+  /// \note They aren't changed after loading, so the graphs of the same mwm in several routers
+  /// may share them, see SharedRoutingData.
+  struct Topology
+  {
+    RoadIndex m_roadIndex;
+    JointIndex m_jointIndex;
+
+    Restrictions m_restrictionsForward;
+    Restrictions m_restrictionsBackward;
+
+    // u_turn can be in both sides of feature.
+    struct UTurnEnding
+    {
+      bool m_atTheBegin = false;
+      bool m_atTheEnd = false;
+    };
+    // Stored featureId and it's UTurnEnding, which shows where is
+    // u_turn restriction is placed - at the beginning or at the ending of feature.
+    //
+    // If m_noUTurnRestrictions.count(featureId) == 0, that means, that there are no any
+    // no_u_turn restriction at the feature with id = featureId.
+    std::unordered_map<uint32_t, UTurnEnding> m_noUTurnRestrictions;
+  };
+
   IndexGraph() = default;
   IndexGraph(std::shared_ptr<Geometry> geometry, std::shared_ptr<EdgeEstimator> estimator,
              RoutingOptions routingOptions = RoutingOptions());
@@ -66,10 +93,10 @@ public:
   std::optional<JointEdge> GetJointEdgeByLastPoint(Segment const & parent, Segment const & firstChild, bool isOutgoing,
                                                    uint32_t lastPoint) const;
 
-  Joint::Id GetJointId(RoadPoint const & rp) const { return m_roadIndex.GetJointId(rp); }
+  Joint::Id GetJointId(RoadPoint const & rp) const { return m_topology->m_roadIndex.GetJointId(rp); }
 
-  bool IsRoad(uint32_t featureId) const { return m_roadIndex.IsRoad(featureId); }
-  RoadJointIds const & GetRoad(uint32_t featureId) const { return m_roadIndex.GetRoad(featureId); }
+  bool IsRoad(uint32_t featureId) const { return m_topology->m_roadIndex.IsRoad(featureId); }
+  RoadJointIds const & GetRoad(uint32_t featureId) const { return m_topology->m_roadIndex.GetRoad(featureId); }
   RoadGeometry const & GetRoadGeometry(uint32_t featureId) const { return m_geometry->GetRoad(featureId); }
 
   Geometry & GetGeometry() const { return *m_geometry; }
@@ -79,9 +106,9 @@ public:
     return m_roadAccess.GetAccessWithoutConditional(segment.GetFeatureId()).first;
   }
 
-  uint32_t GetNumRoads() const { return m_roadIndex.GetSize(); }
-  uint32_t GetNumJoints() const { return m_jointIndex.GetNumJoints(); }
-  uint32_t GetNumPoints() const { return m_jointIndex.GetNumPoints(); }
+  uint32_t GetNumRoads() const { return m_topology->m_roadIndex.GetSize(); }
+  uint32_t GetNumJoints() const { return m_topology->m_jointIndex.GetNumJoints(); }
+  uint32_t GetNumPoints() const { return m_topology->m_jointIndex.GetNumPoints(); }
 
   void Build(uint32_t numJoints);
   void Import(std::vector<Joint> const & joints);
@@ -89,19 +116,39 @@ public:
   void SetRestrictions(RestrictionVec && restrictions);
   void SetUTurnRestrictions(std::vector<RestrictionUTurn> && noUTurnRestrictions);
   void SetRoadAccess(RoadAccess && roadAccess);
+  void SetLandmarks(std::shared_ptr<Landmarks> landmarks) { m_landmarks = std::move(landmarks); }
+
+  std::shared_ptr<Topology> const & GetTopology() const { return m_topology; }
+  /// \brief Replaces joints and restrictions of the graph with the already loaded ones.
+  void SetTopology(std::shared_ptr<Topology> topology) { m_topology = std::move(topology); }
+
+  /// \returns landmarks of the mwm if they are loaded and suit the current weights, nullptr otherwise.
+  Landmarks const * GetLandmarks() const;
 
-  void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp) { m_roadIndex.PushFromSerializer(jointId, rp); }
+  /// \brief Fills route weights between the landmarks and |rp|. Weights of a point between joints are
+  /// calculated along its road from the neighbouring joints.
+  /// \returns false if there are no landmarks or the point is not connected to any joint.
+  bool GetLandmarkWeights(RoadPoint const & rp, LandmarkWeights & weights) const;
+
+  void SetCellOverlay(std::shared_ptr<CellOverlay> cellOverlay) { m_cellOverlay = std::move(cellOverlay); }
+  /// \returns cell overlay of the mwm if it's loaded and suits the current weights, nullptr otherwise.
+  CellOverlay * GetCellOverlay() const;
+
+  void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
+  {
+    m_topology->m_roadIndex.PushFromSerializer(jointId, rp);
+  }
 
   template <typename F>
   void ForEachRoad(F && f) const
   {
-    m_roadIndex.ForEachRoad(std::forward<F>(f));
+    m_topology->m_roadIndex.ForEachRoad(std::forward<F>(f));
   }
 
   template <typename F>
   void ForEachPoint(Joint::Id jointId, F && f) const
   {
-    m_jointIndex.ForEachPoint(jointId, std::forward<F>(f));
+    m_topology->m_jointIndex.ForEachPoint(jointId, std::forward<F>(f));
   }
 
   bool IsJoint(RoadPoint const & roadPoint) const;
@@ -183,27 +230,12 @@ private:
 
   std::shared_ptr<Geometry> m_geometry;
   std::shared_ptr<EdgeEstimator> m_estimator;
-  RoadIndex m_roadIndex;
-  JointIndex m_jointIndex;
-
-  Restrictions m_restrictionsForward;
-  Restrictions m_restrictionsBackward;
-
-  // u_turn can be in both sides of feature.
-  struct UTurnEnding
-  {
-    bool m_atTheBegin = false;
-    bool m_atTheEnd = false;
-  };
-  // Stored featureId and it's UTurnEnding, which shows where is
-  // u_turn restriction is placed - at the beginning or at the ending of feature.
-  //
-  // If m_noUTurnRestrictions.count(featureId) == 0, that means, that there are no any
-  // no_u_turn restriction at the feature with id = featureId.
-  std::unordered_map<uint32_t, UTurnEnding> m_noUTurnRestrictions;
+  std::shared_ptr<Topology> m_topology = std::make_shared<Topology>();
 
   RoadAccess m_roadAccess;
   RoutingOptions m_avoidRoutingOptions;
+  std::shared_ptr<Landmarks> m_landmarks;
+  std::shared_ptr<CellOverlay> m_cellOverlay;
 
   std::function<time_t()> m_currentTimeGetter = []() { return GetCurrentTimestamp(); };
 };
@@ -225,7 +257,7 @@ bool IndexGraph::IsRestricted(ParentVertex const & parent, uint32_t parentFeatur
   if (parentFeatureId == currentFeatureId)
     return false;
 
-  auto const & restrictions = isOutgoing ? m_restrictionsForward : m_restrictionsBackward;
+  auto const & restrictions = isOutgoing ? m_topology->m_restrictionsForward : m_topology->m_restrictionsBackward;
   auto const it = restrictions.find(currentFeatureId);
   if (it == restrictions.cend())
     return false;
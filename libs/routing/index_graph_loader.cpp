@@ -2,10 +2,14 @@
 
 #include "routing/data_source.hpp"
 #include "routing/index_graph_serialization.hpp"
+#include "routing/cell_overlay.hpp"
+#include "routing/landmarks.hpp"
 #include "routing/restriction_loader.hpp"
 #include "routing/road_access.hpp"
 #include "routing/road_access_serialization.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/route.hpp"
+#include "routing/shared_routing_data.hpp"
 #include "routing/speed_camera_ser_des.hpp"
 
 #include "coding/files_container.hpp"
@@ -21,18 +25,72 @@ namespace routing
 {
 namespace
 {
+// Joints and restrictions of the graph, see IndexGraph::Topology.
+void DeserializeIndexGraphTopology(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
+{
+  FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
+  ReaderSource<FilesContainerR::TReader> src(reader);
+
+  IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(vehicleType));
+
+  // Do not load restrictions (relation type = restriction) for pedestrian routing.
+  // https://wiki.openstreetmap.org/wiki/Relation:restriction
+  /// @todo OSM has 49 (April 2022) restriction:foot relations. We should use them someday,
+  /// starting from generator and saving like access, according to the vehicleType.
+  ASSERT(vehicleType != VehicleType::Transit, ());
+  if (vehicleType != VehicleType::Pedestrian)
+  {
+    RestrictionLoader restrictionLoader(mwmValue, graph);
+    if (restrictionLoader.HasRestrictions())
+    {
+      graph.SetRestrictions(restrictionLoader.StealRestrictions());
+      graph.SetUTurnRestrictions(restrictionLoader.StealNoUTurnRestrictions());
+    }
+  }
+}
+
+std::shared_ptr<Landmarks> LoadMatchingLandmarks(MwmValue const & mwmValue, IndexGraph const & graph)
+{
+  auto landmarks = LoadLandmarks(mwmValue);
+  if (landmarks && landmarks->GetNumJoints() != graph.GetNumJoints())
+  {
+    LOG(LWARNING, (LANDMARKS_FILE_TAG, "section doesn't match the routing graph of", mwmValue.GetCountryFileName()));
+    return nullptr;
+  }
+  return landmarks;
+}
+
+void SetMatchingCellOverlay(MwmValue const & mwmValue, IndexGraph & graph)
+{
+  if (auto cellOverlay = LoadCellOverlay(mwmValue))
+  {
+    if (cellOverlay->GetNumJoints() == graph.GetNumJoints())
+    {
+      graph.SetCellOverlay(std::move(cellOverlay));
+    }
+    else
+    {
+      LOG(LWARNING,
+          (CELL_OVERLAY_FILE_TAG, "section doesn't match the routing graph of", mwmValue.GetCountryFileName()));
+    }
+  }
+}
+
 class IndexGraphLoaderImpl final : public IndexGraphLoader
 {
 public:
   IndexGraphLoaderImpl(VehicleType vehicleType, bool loadAltitudes,
                        std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                        std::shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-                       RoutingOptions routingOptions, TimeGetterT timeGetter)
+                       RoutingOptions routingOptions, TimeGetterT timeGetter,
+                       std::shared_ptr<RoadGeometryCache> roadsCache, std::shared_ptr<SharedRoutingData> sharedData)
     : m_vehicleType(vehicleType)
     , m_loadAltitudes(loadAltitudes)
     , m_dataSource(dataSource)
     , m_vehicleModelFactory(std::move(vehicleModelFactory))
     , m_estimator(std::move(estimator))
+    , m_roadsCache(std::move(roadsCache))
+    , m_sharedData(std::move(sharedData))
     , m_avoidRoutingOptions(routingOptions)
   {
     CHECK(m_vehicleModelFactory, ());
@@ -51,6 +109,7 @@ public:
 private:
   using GeometryPtrT = std::shared_ptr<Geometry>;
   GeometryPtrT CreateGeometry(NumMwmId numMwmId);
+  GeometryPtrT CreateGeometry(MwmSet::MwmHandle const & handle);
   using GraphPtrT = std::unique_ptr<IndexGraph>;
   GraphPtrT CreateIndexGraph(NumMwmId numMwmId, GeometryPtrT & geometry);
 
@@ -59,6 +118,8 @@ private:
   MwmDataSource & m_dataSource;
   std::shared_ptr<VehicleModelFactoryInterface> m_vehicleModelFactory;
   std::shared_ptr<EdgeEstimator> m_estimator;
+  std::shared_ptr<RoadGeometryCache> m_roadsCache;
+  std::shared_ptr<SharedRoutingData> m_sharedData;
 
   struct GraphAttrs
   {
@@ -134,16 +195,18 @@ IndexGraphLoaderImpl::GraphPtrT IndexGraphLoaderImpl::CreateIndexGraph(NumMwmId
     base::Timer timer;
 
     if (!geometry)
-    {
-      auto vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(value->GetCountryFileName());
-      geometry = std::make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes));
-    }
+      geometry = CreateGeometry(handle);
 
     LOG(LINFO, ("Loading route graph for", value->GetCountryFileName()));
 
     auto graph = std::make_unique<IndexGraph>(geometry, m_estimator, m_avoidRoutingOptions);
     graph->SetCurrentTimeGetter(m_currentTimeGetter);
-    DeserializeIndexGraph(*value, m_vehicleType, *graph);
+    if (m_sharedData)
+      DeserializeIndexGraph(handle, m_vehicleType, *m_sharedData, *graph);
+    else
+      DeserializeIndexGraph(*value, m_vehicleType, *graph);
+    if (auto * cellOverlay = graph->GetCellOverlay())
+      cellOverlay->SetMwmId(numMwmId);
 
     LOG(LINFO, ("Graph loaded in", timer.ElapsedSeconds(), "seconds"));
     return graph;
@@ -157,11 +220,17 @@ IndexGraphLoaderImpl::GraphPtrT IndexGraphLoaderImpl::CreateIndexGraph(NumMwmId
 
 IndexGraphLoaderImpl::GeometryPtrT IndexGraphLoaderImpl::CreateGeometry(NumMwmId numMwmId)
 {
-  MwmSet::MwmHandle const & handle = m_dataSource.GetHandle(numMwmId);
-  MwmValue const * value = handle.GetValue();
+  return CreateGeometry(m_dataSource.GetHandle(numMwmId));
+}
+
+IndexGraphLoaderImpl::GeometryPtrT IndexGraphLoaderImpl::CreateGeometry(MwmSet::MwmHandle const & handle)
+{
+  auto vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(handle.GetValue()->GetCountryFileName());
+  auto loader = GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes);
+  if (!m_roadsCache)
+    return std::make_shared<Geometry>(std::move(loader));
 
-  auto vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(value->GetCountryFileName());
-  return std::make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes));
+  return std::make_shared<Geometry>(std::move(loader), m_roadsCache, m_roadsCache->GetMwmIndex(handle.GetId()));
 }
 
 void IndexGraphLoaderImpl::Clear()
@@ -215,37 +284,53 @@ bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, VehicleType vehicleType, R
 std::unique_ptr<IndexGraphLoader> IndexGraphLoader::Create(
     VehicleType vehicleType, bool loadAltitudes, std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
     std::shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource, RoutingOptions routingOptions,
-    TimeGetterT timeGetter)
+    TimeGetterT timeGetter, std::shared_ptr<RoadGeometryCache> roadsCache,
+    std::shared_ptr<SharedRoutingData> sharedData)
 {
   return std::make_unique<IndexGraphLoaderImpl>(vehicleType, loadAltitudes, vehicleModelFactory, estimator, dataSource,
-                                                routingOptions, std::move(timeGetter));
+                                                routingOptions, std::move(timeGetter), std::move(roadsCache),
+                                                std::move(sharedData));
 }
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
 {
-  FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
-  ReaderSource<FilesContainerR::TReader> src(reader);
+  DeserializeIndexGraphTopology(mwmValue, vehicleType, graph);
 
-  IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(vehicleType));
+  RoadAccess roadAccess;
+  if (ReadRoadAccessFromMwm(mwmValue, vehicleType, roadAccess))
+    graph.SetRoadAccess(std::move(roadAccess));
 
-  // Do not load restrictions (relation type = restriction) for pedestrian routing.
-  // https://wiki.openstreetmap.org/wiki/Relation:restriction
-  /// @todo OSM has 49 (April 2022) restriction:foot relations. We should use them someday,
-  /// starting from generator and saving like access, according to the vehicleType.
-  ASSERT(vehicleType != VehicleType::Transit, ());
-  if (vehicleType != VehicleType::Pedestrian)
+  // Landmark weights are calculated for cars only.
+  if (vehicleType == VehicleType::Car)
   {
-    RestrictionLoader restrictionLoader(mwmValue, graph);
-    if (restrictionLoader.HasRestrictions())
-    {
-      graph.SetRestrictions(restrictionLoader.StealRestrictions());
-      graph.SetUTurnRestrictions(restrictionLoader.StealNoUTurnRestrictions());
-    }
+    graph.SetLandmarks(LoadMatchingLandmarks(mwmValue, graph));
+    SetMatchingCellOverlay(mwmValue, graph);
   }
+}
 
+void DeserializeIndexGraph(MwmSet::MwmHandle const & handle, VehicleType vehicleType, SharedRoutingData & sharedData,
+                           IndexGraph & graph)
+{
+  MwmValue const & mwmValue = *handle.GetValue();
+  auto const data = sharedData.GetGraphData(handle.GetId(), vehicleType, [&]()
+  {
+    DeserializeIndexGraphTopology(mwmValue, vehicleType, graph);
+    return SharedRoutingData::GraphData{
+        graph.GetTopology(), vehicleType == VehicleType::Car ? LoadMatchingLandmarks(mwmValue, graph) : nullptr};
+  });
+  graph.SetTopology(data.m_topology);
+
+  // Road access depends on the current time getter of the graph and the cell overlay is customized
+  // per graph, so they are not shared.
   RoadAccess roadAccess;
   if (ReadRoadAccessFromMwm(mwmValue, vehicleType, roadAccess))
     graph.SetRoadAccess(std::move(roadAccess));
+
+  if (vehicleType == VehicleType::Car)
+  {
+    graph.SetLandmarks(data.m_landmarks);
+    SetMatchingCellOverlay(mwmValue, graph);
+  }
 }
 
 uint32_t DeserializeIndexGraphNumRoads(MwmValue const & mwmValue, VehicleType vehicleType)
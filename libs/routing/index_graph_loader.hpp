@@ -9,6 +9,8 @@
 #include "routing_common/num_mwm_id.hpp"
 #include "routing_common/vehicle_model.hpp"
 
+#include "indexer/mwm_set.hpp"
+
 #include <memory>
 #include <vector>
 
@@ -17,6 +19,8 @@ class MwmValue;
 namespace routing
 {
 class MwmDataSource;
+class RoadGeometryCache;
+class SharedRoutingData;
 
 class IndexGraphLoader
 {
@@ -30,13 +34,21 @@ public:
   virtual std::vector<RouteSegment::SpeedCamera> GetSpeedCameraInfo(Segment const & segment) = 0;
   virtual void Clear() = 0;
 
+  /// \param roadsCache is shared by geometries of all mwms if set, otherwise every mwm has its own cache.
+  /// \param sharedData if set, the graphs share the read-only data with graphs of other loaders.
   static std::unique_ptr<IndexGraphLoader> Create(VehicleType vehicleType, bool loadAltitudes,
                                                   std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                                                   std::shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-                                                  RoutingOptions routingOptions = {}, TimeGetterT timeGetter = {});
+                                                  RoutingOptions routingOptions = {}, TimeGetterT timeGetter = {},
+                                                  std::shared_ptr<RoadGeometryCache> roadsCache = {},
+                                                  std::shared_ptr<SharedRoutingData> sharedData = {});
 };
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph);
+/// \brief Same as above, but the joints, the restrictions and the landmarks are taken from |sharedData|
+/// if they were loaded by another graph of the mwm.
+void DeserializeIndexGraph(MwmSet::MwmHandle const & handle, VehicleType vehicleType, SharedRoutingData & sharedData,
+                           IndexGraph & graph);
 
 uint32_t DeserializeIndexGraphNumRoads(MwmValue const & mwmValue, VehicleType vehicleType);
 
@@ -55,6 +55,7 @@ void IndexGraphStarter::Append(FakeEdgesContainer const & container)
 {
   m_finish = container.m_finish;
   m_fake.Append(container.m_fake);
+  m_endingLandmarks = {};
 
   // It's important to calculate distance after m_fake.Append() because
   // we don't have finish segment in fake graph before m_fake.Append().
@@ -92,6 +93,26 @@ bool IndexGraphStarter::ConvertToReal(Segment & segment) const
   return IsFakeSegment(segment) ? m_fake.FindReal(segment, segment) : true;
 }
 
+RouteWeight IndexGraphStarter::HeuristicCostEstimate(Vertex const & from, Vertex const & to,
+                                                     ms::LatLon const & toPoint, bool toFinish) const
+{
+  auto const weight = m_graph.HeuristicCostEstimate(GetPoint(from, true /* front */), toPoint);
+  if (!m_graph.IsLandmarksHeuristic() || IsRegionsGraphMode())
+    return weight;
+
+  // Landmark weights are exact inside one mwm only.
+  LandmarksInfo fromInfo;
+  LandmarksInfo toInfo;
+  if (!GetLandmarkWeights(from, fromInfo) || !GetLandmarkWeights(to, toInfo) || fromInfo.m_mwmId != toInfo.m_mwmId)
+    return weight;
+
+  // Landmark weights are calculated without time conditional speeds, so the bound is loosened a little.
+  double constexpr kLandmarksFactor = 0.95;
+  double const bound = toFinish ? GetLowerBound(fromInfo.m_weights, toInfo.m_weights)
+                                : GetLowerBound(toInfo.m_weights, fromInfo.m_weights);
+  return std::max(weight, RouteWeight(kLandmarksFactor * bound));
+}
+
 LatLonWithAltitude const & IndexGraphStarter::GetJunction(Segment const & segment, bool front) const
 {
   if (IsRegionsGraphMode() && !IsFakeSegment(segment))
@@ -630,6 +651,79 @@ Segment IndexGraphStarter::GetFakeSegmentAndIncr()
   return GetFakeSegment(m_fakeNumerationStart++);
 }
 
+bool IndexGraphStarter::GetLandmarkWeights(Segment const & segment, LandmarksInfo & info) const
+{
+  if (segment == GetStartSegment() || segment == GetFinishSegment())
+  {
+    info = GetEndingLandmarkWeights(segment == GetStartSegment());
+    return info.m_valid;
+  }
+
+  Segment real = segment;
+  if (IsGuidesSegment(segment) || !ConvertToReal(real) || real.GetMwmId() == kFakeNumMwmId)
+    return false;
+
+  // A part of a real segment which ends at a projection of the finish is not a real point.
+  if (IsFakeSegment(segment) && !(GetPoint(segment, true /* front */) == m_graph.GetPoint(real, true /* front */)))
+    return false;
+
+  info.m_mwmId = real.GetMwmId();
+  info.m_valid = m_graph.GetIndexGraph(info.m_mwmId).GetLandmarkWeights(real.GetRoadPoint(true /* front */),
+                                                                         info.m_weights);
+  return info.m_valid;
+}
+
+IndexGraphStarter::LandmarksInfo const & IndexGraphStarter::GetEndingLandmarkWeights(bool isStart) const
+{
+  auto & info = m_endingLandmarks[isStart ? 0 : 1];
+  if (info)
+    return *info;
+
+  info.emplace();
+  auto const & ending = isStart ? m_start : m_finish;
+  if (ending.m_real.empty() || ending.m_mwmIds.size() != 1 || *ending.m_mwmIds.begin() == kFakeNumMwmId)
+    return *info;
+
+  // The route between checkpoints on the same segment doesn't pass through its points.
+  auto const & other = isStart ? m_finish : m_start;
+  for (auto const & segment : ending.m_real)
+  {
+    for (auto const & otherSegment : other.m_real)
+    {
+      if (segment.GetMwmId() == otherSegment.GetMwmId() && segment.GetFeatureId() == otherSegment.GetFeatureId() &&
+          segment.GetSegmentIdx() == otherSegment.GetSegmentIdx())
+      {
+        return *info;
+      }
+    }
+  }
+
+  // The route leaves the start through the front points of its segments and comes to the finish
+  // through the back ones.
+  info->m_mwmId = *ending.m_mwmIds.begin();
+  auto const & graph = m_graph.GetIndexGraph(info->m_mwmId);
+  LandmarkWeights weights;
+  for (auto const & segment : ending.m_real)
+  {
+    if (!graph.GetLandmarkWeights(segment.GetRoadPoint(isStart /* front */), weights))
+    {
+      info->m_valid = false;
+      return *info;
+    }
+
+    if (info->m_valid)
+    {
+      info->m_weights.Unite(weights, isStart /* isSource */);
+    }
+    else
+    {
+      info->m_weights = weights;
+      info->m_valid = true;
+    }
+  }
+  return *info;
+}
+
 RouteWeight IndexGraphStarter::GetAStarWeightEpsilon()
 {
   // Epsilon for double calculations.
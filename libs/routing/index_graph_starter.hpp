@@ -16,7 +16,9 @@
 
 #include "routing_common/num_mwm_id.hpp"
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -77,6 +79,9 @@ public:
   LatLonWithAltitude const & GetFinishJunction() const;
   Segment GetStartSegment() const { return GetFakeSegment(m_start.m_id); }
   Segment GetFinishSegment() const { return GetFakeSegment(m_finish.m_id); }
+  // Real segments which the start and the finish are projected to.
+  std::set<Segment> const & GetStartRealSegments() const { return m_start.m_real; }
+  std::set<Segment> const & GetFinishRealSegments() const { return m_finish.m_real; }
   // If segment is real returns true and does not modify segment.
   // If segment is part of real converts it to real and returns true.
   // Otherwise returns false and does not modify segment.
@@ -124,7 +129,7 @@ public:
 
   RouteWeight HeuristicCostEstimate(Vertex const & from, Vertex const & to) override
   {
-    return m_graph.HeuristicCostEstimate(GetPoint(from, true /* front */), GetPoint(to, true /* front */));
+    return HeuristicCostEstimate(from, to, GetPoint(to, true /* front */), to != GetStartSegment() /* toFinish */);
   }
 
   void SetAStarParents(bool forward, Parents<Segment> & parents) override { m_graph.SetAStarParents(forward, parents); }
@@ -138,6 +143,8 @@ public:
   }
 
   RouteWeight GetAStarWeightEpsilon() override;
+
+  bool UseDenseAStarState() const override { return m_graph.IsDenseAStarState(); }
   // @}
 
   void GetEdgesList(Vertex const & vertex, bool isOutgoing, EdgeListT & edges) const
@@ -150,6 +157,13 @@ public:
     return m_graph.HeuristicCostEstimate(GetPoint(from, true /* front */), to);
   }
 
+  /// \brief Estimates the route weight between |from| and |to| with the |toPoint| front point.
+  /// The estimate is made stronger with landmarks when they are enabled in the world graph.
+  /// \param toFinish |to| is the finish of the route, the weight from |from| to |to| is estimated.
+  /// Otherwise |to| is the start of the route and the weight from |to| to |from| is estimated.
+  RouteWeight HeuristicCostEstimate(Vertex const & from, Vertex const & to, ms::LatLon const & toPoint,
+                                    bool toFinish) const;
+
   RouteWeight CalcSegmentWeight(Segment const & segment, EdgeEstimator::Purpose purpose) const;
   RouteWeight CalcGuidesSegmentWeight(Segment const & segment, EdgeEstimator::Purpose purpose) const;
   double CalculateETA(Segment const & from, Segment const & to, time_t arrivalTime) const;
@@ -240,6 +254,17 @@ private:
   // Checks whether ending belongs to non-pass-through zone (service, living street, etc).
   bool HasNoPassThroughAllowed(Ending const & ending) const;
 
+  struct LandmarksInfo
+  {
+    bool m_valid = false;
+    NumMwmId m_mwmId = kFakeNumMwmId;
+    LandmarkWeights m_weights;
+  };
+
+  // Fills landmark weights of the front point of |segment| or of the start or the finish ending.
+  bool GetLandmarkWeights(Segment const & segment, LandmarksInfo & info) const;
+  LandmarksInfo const & GetEndingLandmarkWeights(bool isStart) const;
+
   WorldGraph & m_graph;
   // Start segment id
   Ending m_start;
@@ -252,6 +277,9 @@ private:
 
   std::vector<FakeEnding> m_otherEndings;
 
+  // Landmark weights of the start and the finish endings, they are calculated on demand.
+  mutable std::array<std::optional<LandmarksInfo>, 2> m_endingLandmarks;
+
   // Field for routing in mode for finding all route mwms.
   std::shared_ptr<RegionsSparseGraph> m_regionsGraph = nullptr;
 };
@@ -77,6 +77,8 @@ public:
   }
 
   RouteWeight GetAStarWeightEpsilon() override { return m_graph.GetAStarWeightEpsilon(); }
+
+  bool UseDenseAStarState() const override { return m_graph.UseDenseAStarState(); }
   // @}
 
   WorldGraphMode GetMode() const { return m_graph.GetMode(); }
@@ -279,8 +281,9 @@ RouteWeight IndexGraphStarterJoints<Graph>::HeuristicCostEstimate(JointSegment c
     fromSegment = from.GetSegment(false /* start */);
   }
 
-  return (to == m_endJoint) ? m_graph.HeuristicCostEstimate(fromSegment, m_endPoint)
-                            : m_graph.HeuristicCostEstimate(fromSegment, m_startPoint);
+  return (to == m_endJoint) ? m_graph.HeuristicCostEstimate(fromSegment, m_endSegment, m_endPoint, true /* toFinish */)
+                            : m_graph.HeuristicCostEstimate(fromSegment, m_startSegment, m_startPoint,
+                                                            false /* toFinish */);
 }
 
 template <typename Graph>
@@ -3,6 +3,7 @@
 #include "routing/base/astar_progress.hpp"
 
 #include "routing/car_directions.hpp"
+#include "routing/cell_overlay.hpp"
 #include "routing/fake_ending.hpp"
 #include "routing/index_graph.hpp"
 #include "routing/index_graph_loader.hpp"
@@ -14,6 +15,7 @@
 #include "routing/leaps_postprocessor.hpp"
 #include "routing/mwm_hierarchy_handler.hpp"
 #include "routing/pedestrian_directions.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_helpers.hpp"
 #include "routing/routing_options.hpp"
@@ -80,6 +82,9 @@ double constexpr kAdjustRangeM = 5000.0;
 double constexpr kMinDistanceToFinishM = 10000;
 // Near MWMs criteria when choosing routing mode.
 double constexpr kCloseMwmPointsDistanceM = 300000;
+// Road geometry cache shared by consecutive route calculations gets kRoadsCacheSizeBytes, the limit of
+// a standalone Geometry, for every mwm with loaded roads, but no more than this size for all of them.
+size_t constexpr kSharedRoadsCacheSizeBytes = 32 * 1024 * 1024;
 
 double CalcMaxSpeed(NumMwmIds const & numMwmIds, VehicleModelFactoryInterface const & vehicleModelFactory,
                     VehicleType vehicleType)
@@ -255,6 +260,87 @@ std::vector<RouteWarning> CollectRouteWarnings(std::vector<Segment> const & segm
 
   return warnings;
 }
+
+bool HasCommonSegment(FakeEnding const & lhs, FakeEnding const & rhs)
+{
+  for (auto const & l : lhs.m_projections)
+  {
+    for (auto const & r : rhs.m_projections)
+    {
+      if (l.m_segment == r.m_segment || l.m_segment == r.m_segment.GetReversed())
+        return true;
+    }
+  }
+  return false;
+}
+
+// Propagates the wave from the |starter| start until all |finishToTargets| are reached and fills the cells of
+// the reached targets in |row|. Returns false if the calculation is cancelled.
+bool CalculateMatrixCells(IndexGraphStarter & starter, std::map<Segment, std::vector<size_t>> const & finishToTargets,
+                          RouterDelegate const & delegate, std::vector<IndexRouter::MatrixCell> & row)
+{
+  using Vertex = IndexGraphStarter::Vertex;
+  using Edge = IndexGraphStarter::Edge;
+  using Weight = IndexGraphStarter::Weight;
+
+  AStarAlgorithm<Vertex, Edge, Weight> algorithm;
+  AStarAlgorithm<Vertex, Edge, Weight>::Context context(starter);
+
+  bool cancelled = false;
+  size_t finishesLeft = finishToTargets.size();
+  uint32_t visited = 0;
+  auto const visitVertex = [&](Vertex const & vertex)
+  {
+    if (++visited % kVisitPeriod == 0 && delegate.IsCancelled())
+    {
+      cancelled = true;
+      return false;
+    }
+
+    if (finishToTargets.count(vertex) != 0)
+      --finishesLeft;
+    return finishesLeft != 0;
+  };
+
+  algorithm.PropagateWave(starter, starter.GetStartSegment(), visitVertex, context);
+  if (cancelled)
+    return false;
+
+  std::vector<Vertex> path;
+  for (auto const & [finish, targets] : finishToTargets)
+  {
+    if (!context.HasDistance(finish))
+      continue;
+
+    IndexRouter::MatrixCell cell;
+    cell.m_code = RouterResultCode::NoError;
+    cell.m_weight = context.GetDistance(finish).GetWeight();
+
+    context.ReconstructPath(finish, path);
+    for (auto const & segment : path)
+    {
+      cell.m_etaSec += starter.CalcSegmentWeight(segment, EdgeEstimator::Purpose::ETA).GetWeight();
+      cell.m_distanceM +=
+          ms::DistanceOnEarth(starter.GetPoint(segment, false /* front */), starter.GetPoint(segment, true /* front */));
+    }
+
+    for (auto const i : targets)
+      row[i] = cell;
+  }
+
+  return true;
+}
+
+template <typename Params>
+void SetLandmarksReducedWeightCheck(WorldGraph const & graph, Params & params)
+{
+  if (!graph.IsLandmarksHeuristic())
+    return;
+
+  // Landmark weights are exact inside one mwm only, so the heuristic isn't consistent on mwm borders
+  // and a reduced weight may be negative there. It's expected, such weights are just cut to zero.
+  params.m_badReducedWeight = [](auto const &, auto const &) { return false; };
+}
 }  // namespace
 
 // IndexRouter::BestEdgeComparator ----------------------------------------------------------------
@@ -326,6 +412,7 @@ IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
                                       CalcOffroadSpeed(*m_vehicleModelFactory), m_trafficStash, &dataSource,
                                       m_numMwmIds))
   , m_directionsEngine(CreateDirectionsEngine(m_vehicleType, m_numMwmIds, m_dataSource))
+  , m_roadsCache(std::make_shared<RoadGeometryCache>(kRoadsCacheSizeBytes, kSharedRoadsCacheSizeBytes))
   , m_countryParentNameGetterFn(countryParentNameGetterFn)
 {
   CHECK(!m_name.empty(), ());
@@ -344,6 +431,9 @@ std::unique_ptr<WorldGraph> IndexRouter::MakeSingleMwmWorldGraph()
 
 void IndexRouter::ClearRouteCalculationState()
 {
+  LOG(LDEBUG, ("Roads cache:", m_roadsCache->GetStats(), "roads:", m_roadsCache->GetSize(),
+               "bytes:", m_roadsCache->GetMemorySize(), "limit:", m_roadsCache->GetMaxMemorySize()));
+
   m_roadGraph.ClearState();
   m_directionsEngine->Clear();
   m_dataSource.FreeHandles();
@@ -352,6 +442,7 @@ void IndexRouter::ClearRouteCalculationState()
 void IndexRouter::ClearState()
 {
   ClearRouteCalculationState();
+  m_roadsCache->Clear();
 
   // Drop the adjust-cache for both the active and the alternative route so a later (re)build
   // can't accidentally AdjustRoute against state from a cancelled session.
@@ -824,6 +915,116 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
   return RouterResultCode::NoError;
 }
 
+RouterResultCode IndexRouter::CalculateMatrix(std::vector<m2::PointD> const & sources,
+                                              std::vector<m2::PointD> const & targets, RouterDelegate const & delegate,
+                                              RouteMatrix & matrix)
+{
+  CHECK_NOT_EQUAL(m_vehicleType, VehicleType::Transit, ("Matrix of routes isn't supported for transit."));
+
+  matrix.assign(sources.size(), std::vector<MatrixCell>(targets.size()));
+  if (sources.empty() || targets.empty())
+    return RouterResultCode::NoError;
+
+  try
+  {
+    SCOPE_GUARD(featureRoadGraphClear, [this] { ClearRouteCalculationState(); });
+
+    TrafficStash::Guard guard(m_trafficStash);
+    // One graph for the whole matrix: index graphs and road geometry loaded for one source are
+    // used by the waves of the next ones.
+    auto graph = MakeWorldGraph();
+    graph->SetMode(WorldGraphMode::NoLeaps);
+
+    PointsOnEdgesSnapping snapping(*this, *graph);
+    std::vector<std::optional<FakeEnding>> targetEndings(targets.size());
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+      FakeEnding ending;
+      if (snapping.SnapPoint(targets[i], false /* isOutgoing */, ending))
+        targetEndings[i] = std::move(ending);
+    }
+
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+      if (delegate.IsCancelled())
+        return RouterResultCode::Cancelled;
+
+      auto & row = matrix[i];
+      FakeEnding sourceEnding;
+      if (!snapping.SnapPoint(sources[i], true /* isOutgoing */, sourceEnding))
+      {
+        for (auto & cell : row)
+          cell.m_code = RouterResultCode::StartPointNotFound;
+        continue;
+      }
+
+      auto const code = CalculateMatrixRow(sourceEnding, targetEndings, delegate, *graph, row);
+      if (code != RouterResultCode::NoError)
+        return code;
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate matrix of", sources.size(), "x", targets.size(), "routes:\n ", e.what()));
+    return RouterResultCode::InternalError;
+  }
+
+  return RouterResultCode::NoError;
+}
+
+RouterResultCode IndexRouter::CalculateMatrixRow(FakeEnding const & sourceEnding,
+                                                 std::vector<std::optional<FakeEnding>> const & targetEndings,
+                                                 RouterDelegate const & delegate, WorldGraph & graph,
+                                                 std::vector<MatrixCell> & row)
+{
+  CHECK_EQUAL(row.size(), targetEndings.size(), ());
+
+  // All targets are merged into one starter, the same way as subroutes of a route with intermediate
+  // points. Finish segment of every target gets its own fake id.
+  // Fake edges of a source and a target projected to the same road segment are trimmed to each other,
+  // so such a target can't share the source fake edges with the other targets and gets its own starter.
+  std::unique_ptr<IndexGraphStarter> starter;
+  std::map<Segment, std::vector<size_t>> finishToTargets;
+  std::vector<size_t> sameSegmentTargets;
+  for (size_t i = 0; i < targetEndings.size(); ++i)
+  {
+    if (!targetEndings[i])
+    {
+      row[i].m_code = RouterResultCode::EndPointNotFound;
+      continue;
+    }
+
+    if (HasCommonSegment(sourceEnding, *targetEndings[i]))
+    {
+      sameSegmentTargets.push_back(i);
+      continue;
+    }
+
+    uint32_t const fakeNumerationStart = starter ? starter->GetNumFakeSegments() : 0;
+    IndexGraphStarter targetStarter(sourceEnding, *targetEndings[i], fakeNumerationStart, false /* strictForward */,
+                                    graph);
+    finishToTargets[targetStarter.GetFinishSegment()].push_back(i);
+
+    if (!starter)
+      starter = std::make_unique<IndexGraphStarter>(std::move(targetStarter));
+    else
+      starter->Append(FakeEdgesContainer(std::move(targetStarter)));
+  }
+
+  if (starter && !CalculateMatrixCells(*starter, finishToTargets, delegate, row))
+    return RouterResultCode::Cancelled;
+
+  for (auto const i : sameSegmentTargets)
+  {
+    IndexGraphStarter pairStarter(sourceEnding, *targetEndings[i], 0 /* fakeNumerationStart */,
+                                  false /* strictForward */, graph);
+    if (!CalculateMatrixCells(pairStarter, {{pairStarter.GetFinishSegment(), {i}}}, delegate, row))
+      return RouterResultCode::Cancelled;
+  }
+
+  return RouterResultCode::NoError;
+}
+
 std::vector<Segment> ProcessJoints(std::vector<JointSegment> const & jointsPath,
                                    IndexGraphStarterJoints<IndexGraphStarter> & jointStarter)
 {
@@ -867,7 +1068,17 @@ RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints,
   base::ScopedTimerWithLog timer("Route build");
   switch (mode)
   {
-  case WorldGraphMode::Joints: return CalculateSubrouteJointsMode(starter, delegate, progress, subroute);
+  case WorldGraphMode::Joints:
+    if (auto * cellOverlay = GetCellOverlay(starter))
+    {
+      auto const result = CalculateSubrouteCellOverlayMode(*cellOverlay, starter, delegate, progress, subroute);
+      if (result != RouterResultCode::RouteNotFound)
+        return result;
+
+      LOG(LINFO, ("Route is not found by the cell overlay, routing in mode:", mode));
+      subroute.clear();
+    }
+    return CalculateSubrouteJointsMode(starter, delegate, progress, subroute);
   case WorldGraphMode::NoLeaps: return CalculateSubrouteNoLeapsMode(starter, delegate, progress, subroute);
   case WorldGraphMode::LeapsOnly:
     return CalculateSubrouteLeapsOnlyMode(checkpoints, subrouteIdx, starter, delegate, progress, subroute);
@@ -893,6 +1104,7 @@ RouterResultCode IndexRouter::CalculateSubrouteJointsMode(IndexGraphStarter & st
   AStarAlgorithm<Vertex, Edge, Weight>::Params<Visitor, AStarLengthChecker> params(
       jointStarter, jointStarter.GetStartJoint(), jointStarter.GetFinishJoint(), delegate.GetCancellable(),
       std::move(visitor), AStarLengthChecker(starter));
+  SetLandmarksReducedWeightCheck(starter.GetGraph(), params);
 
   RoutingResult<Vertex, Weight> routingResult;
   RouterResultCode const result = FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult);
@@ -905,6 +1117,60 @@ RouterResultCode IndexRouter::CalculateSubrouteJointsMode(IndexGraphStarter & st
   return result;
 }
 
+RouterResultCode IndexRouter::CalculateSubrouteCellOverlayMode(CellOverlay & cellOverlay, IndexGraphStarter & starter,
+                                                               RouterDelegate const & delegate,
+                                                               std::shared_ptr<AStarProgress> const & progress,
+                                                               std::vector<Segment> & subroute)
+{
+  WorldGraph & worldGraph = starter.GetGraph();
+  NumMwmId const mwmId = cellOverlay.GetMwmId();
+  cellOverlay.UpdateTraffic(worldGraph.GetIndexGraph(mwmId),
+                            m_trafficStash ? m_trafficStash->GetColoring(mwmId) : nullptr);
+
+  std::vector<Segment> waypoints;
+  double weight = 0.0;
+  if (!cellOverlay.FindRoute(starter, delegate.GetCancellable(), waypoints, weight))
+    return delegate.IsCancelled() ? RouterResultCode::Cancelled : RouterResultCode::RouteNotFound;
+
+  LOG(LINFO, ("Cell overlay route weight:", weight, "waypoints:", waypoints.size()));
+  CHECK_GREATER_OR_EQUAL(waypoints.size(), 2, ());
+
+  // Routes between the neighbouring waypoints are inside one leaf cell or go from the start or to the finish.
+  SCOPE_GUARD(restoreMode, [&worldGraph]() { worldGraph.SetMode(WorldGraphMode::Joints); });
+  RoutesCalculator calculator(starter, delegate);
+  double const progressCoef = 1.0 / (waypoints.size() - 1);
+  for (size_t i = 0; i + 1 < waypoints.size(); ++i)
+  {
+    auto const * route = calculator.Calc2Times(waypoints[i], waypoints[i + 1], progress, progressCoef);
+    if (route == nullptr)
+    {
+      subroute.clear();
+      return delegate.IsCancelled() ? RouterResultCode::Cancelled : RouterResultCode::RouteNotFound;
+    }
+
+    // Every route after the first one starts with the last segment of the previous route.
+    auto const & path = route->m_path;
+    subroute.insert(subroute.end(), i == 0 ? path.cbegin() : std::next(path.cbegin()), path.cend());
+  }
+
+  return RouterResultCode::NoError;
+}
+
+CellOverlay * IndexRouter::GetCellOverlay(IndexGraphStarter & starter) const
+{
+  if (!m_useCellOverlay || m_vehicleType != VehicleType::Car)
+    return nullptr;
+
+  auto const mwmIds = starter.GetMwms();
+  if (mwmIds.size() != 1)
+    return nullptr;
+
+  auto * cellOverlay = starter.GetGraph().GetIndexGraph(*mwmIds.cbegin()).GetCellOverlay();
+  if (cellOverlay == nullptr || cellOverlay->GetMwmId() != *mwmIds.cbegin())
+    return nullptr;
+  return cellOverlay;
+}
+
 RouterResultCode IndexRouter::CalculateSubrouteNoLeapsMode(IndexGraphStarter & starter, RouterDelegate const & delegate,
                                                            std::shared_ptr<AStarProgress> const & progress,
                                                            std::vector<Segment> & subroute)
@@ -919,6 +1185,7 @@ RouterResultCode IndexRouter::CalculateSubrouteNoLeapsMode(IndexGraphStarter & s
   AStarAlgorithm<Vertex, Edge, Weight>::Params<Visitor, AStarLengthChecker> params(
       starter, starter.GetStartSegment(), starter.GetFinishSegment(), delegate.GetCancellable(), std::move(visitor),
       AStarLengthChecker(starter));
+  SetLandmarksReducedWeightCheck(starter.GetGraph(), params);
 
   RoutingResult<Vertex, Weight> routingResult;
   std::set<NumMwmId> const mwmIds = starter.GetMwms();
@@ -1263,7 +1530,8 @@ std::unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
 
   auto indexGraphLoader = IndexGraphLoader::Create(
       m_vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : m_vehicleType, m_loadAltitudes,
-      m_vehicleModelFactory, m_estimator, m_dataSource, routingOptions, m_currentTimeGetter);
+      m_vehicleModelFactory, m_estimator, m_dataSource, routingOptions, m_currentTimeGetter, m_roadsCache,
+      m_sharedData);
 
   if (m_vehicleType != VehicleType::Transit)
   {
@@ -1271,6 +1539,9 @@ std::unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
         std::make_unique<SingleVehicleWorldGraph>(std::move(crossMwmGraph), std::move(indexGraphLoader), m_estimator,
                                                   MwmHierarchyHandler(m_numMwmIds, m_countryParentNameGetterFn));
     graph->SetRoutingOptions(routingOptions);
+    // Car routes are long and settle millions of segments, so flat A* state pays off there.
+    graph->SetDenseAStarState(m_vehicleType == VehicleType::Car);
+    graph->SetLandmarksHeuristic(m_vehicleType == VehicleType::Car && m_useLandmarks);
     return graph;
   }
 
@@ -1313,6 +1584,19 @@ int IndexRouter::PointsOnEdgesSnapping::Snap(m2::PointD const & start, m2::Point
   return 0;
 }
 
+bool IndexRouter::PointsOnEdgesSnapping::SnapPoint(m2::PointD const & point, bool isOutgoing, FakeEnding & ending)
+{
+  FillDeadEndsCache(point);
+
+  std::vector<Segment> segments;
+  bool dummy;
+  if (!FindBestSegments(point, {} /* direction */, isOutgoing, segments, dummy))
+    return false;
+
+  ending = MakeFakeEnding(segments, point, m_graph);
+  return true;
+}
+
 void IndexRouter::PointsOnEdgesSnapping::FillDeadEndsCache(m2::PointD const & point)
 {
   auto const rect = mercator::RectByCenterXYAndSizeInMeters(point, kFirstSearchDistanceM);
@@ -1579,6 +1863,7 @@ IndexRouter::RoutingResultT const * IndexRouter::RoutesCalculator::Calc(Segment
     AStarAlgorithm<Vertex, Edge, Weight>::Params<Visitor, AStarLengthChecker> params(
         jointStarter, jointStarter.GetStartJoint(), jointStarter.GetFinishJoint(), m_delegate.GetCancellable(),
         Visitor(jointStarter, m_delegate, kVisitPeriod, progress), AStarLengthChecker(m_starter));
+    SetLandmarksReducedWeightCheck(m_starter.GetGraph(), params);
 
     RoutingResult<JointSegment, RouteWeight> route;
     using AlgoT = AStarAlgorithm<Vertex, Edge, Weight>;
@@ -26,6 +26,7 @@
 #include "geometry/tree4d.hpp"
 
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -37,8 +38,11 @@ class TrafficCache;
 
 namespace routing
 {
+class CellOverlay;
 class IndexGraph;
 class IndexGraphStarter;
+class RoadGeometryCache;
+class SharedRoutingData;
 
 class IndexRouter : public IRouter
 {
@@ -67,6 +71,18 @@ public:
     m2::PointD const m_direction;
   };
 
+  struct MatrixCell
+  {
+    RouterResultCode m_code = RouterResultCode::RouteNotFound;
+    // Routing weight of the best route.
+    double m_weight = 0.0;
+    double m_etaSec = 0.0;
+    double m_distanceM = 0.0;
+  };
+
+  // Rows are sources and columns are targets.
+  using RouteMatrix = std::vector<std::vector<MatrixCell>>;
+
   using TCountryFileFn = std::function<std::string(m2::PointD const &)>;
   IndexRouter(VehicleType vehicleType, bool loadAltitudes, CountryParentNameGetterFn const & countryParentNameGetterFn,
               TCountryFileFn const & countryFileFn, CountryRectFn const & countryRectFn,
@@ -84,6 +100,14 @@ public:
                                   bool adjustToPrevRoute, RouterDelegate const & delegate,
                                   RoutesResult & result) override;
 
+  /// \brief Calculates the best routes from each of |sources| to each of |targets| without geometry
+  /// and turns. Every point is snapped once and one Dijkstra wave per source is spread until all
+  /// targets are reached, so index graphs and road geometry are loaded once for the whole matrix.
+  /// \returns NoError or the code which stopped the whole calculation (e.g. Cancelled). Cells keep
+  /// codes of pairs, e.g. StartPointNotFound or RouteNotFound.
+  RouterResultCode CalculateMatrix(std::vector<m2::PointD> const & sources, std::vector<m2::PointD> const & targets,
+                                   RouterDelegate const & delegate, RouteMatrix & matrix);
+
   bool FindClosestProjectionToRoad(m2::PointD const & point, m2::PointD const & direction, double radius,
                                    EdgeProj & proj) override;
 
@@ -107,6 +131,14 @@ public:
     m_currentTimeGetter = std::forward<T>(getter);
   }
 
+  // Enables the landmark (ALT) heuristic for car routing in mwms with LANDMARKS_FILE_TAG section.
+  // It's enabled by default, benchmarks switch it off for comparison.
+  void SetLandmarksHeuristic(bool useLandmarks) { m_useLandmarks = useLandmarks; }
+  // Enables routing by the cell overlay for car routes inside one mwm with CELL_OVERLAY_FILE_TAG section.
+  void SetCellOverlay(bool useCellOverlay) { m_useCellOverlay = useCellOverlay; }
+  // Routers working in different threads may share the read-only data of the mwm graphs.
+  void SetSharedRoutingData(std::shared_ptr<SharedRoutingData> sharedData) { m_sharedData = std::move(sharedData); }
+
 private:
   // Lightweight cleanup run at the end of every CalculateRoute invocation. Frees the road-graph,
   // directions engine and data-source handles; does NOT touch m_lastRoute/m_lastAltRoute so the
@@ -123,9 +155,20 @@ private:
                                                   IndexGraphStarter & starter, RouterDelegate const & delegate,
                                                   std::shared_ptr<AStarProgress> const & progress,
                                                   std::vector<Segment> & subroute);
+  // Finds the leaf cells transitions of the route by the cell overlay and calculates routes between them.
+  RouterResultCode CalculateSubrouteCellOverlayMode(CellOverlay & cellOverlay, IndexGraphStarter & starter,
+                                                    RouterDelegate const & delegate,
+                                                    std::shared_ptr<AStarProgress> const & progress,
+                                                    std::vector<Segment> & subroute);
+  /// \returns cell overlay which the subroute may be calculated by or nullptr.
+  CellOverlay * GetCellOverlay(IndexGraphStarter & starter) const;
 
   RouterResultCode DoCalculateRoute(Checkpoints const & checkpoints, m2::PointD const & startDirection,
                                     RouterDelegate const & delegate, Route & route);
+  RouterResultCode CalculateMatrixRow(FakeEnding const & sourceEnding,
+                                      std::vector<std::optional<FakeEnding>> const & targetEndings,
+                                      RouterDelegate const & delegate, WorldGraph & graph,
+                                      std::vector<MatrixCell> & row);
   RouterResultCode CalculateSubroute(Checkpoints const & checkpoints, size_t subrouteIdx,
                                      RouterDelegate const & delegate, std::shared_ptr<AStarProgress> const & progress,
                                      IndexGraphStarter & graph, std::vector<Segment> & subroute,
@@ -161,6 +204,10 @@ private:
 
     void SetNextStartSegment(Segment const & seg) { m_startSegments = {seg}; }
 
+    /// \brief Snaps a standalone |point| to the road graph without direction.
+    /// \returns false if there are no roads near |point|.
+    bool SnapPoint(m2::PointD const & point, bool isOutgoing, FakeEnding & ending);
+
   private:
     void FillDeadEndsCache(m2::PointD const & point);
 
@@ -297,6 +344,10 @@ private:
 
   std::shared_ptr<EdgeEstimator> m_estimator;
   std::unique_ptr<DirectionsEngine> m_directionsEngine;
+  // Road geometry of all mwms. It's kept between route calculations, so rebuilding a route
+  // (e.g. after leaving it) doesn't load the same roads again.
+  std::shared_ptr<RoadGeometryCache> m_roadsCache;
+  std::shared_ptr<SharedRoutingData> m_sharedData;
   std::unique_ptr<SegmentedRoute> m_lastRoute;
   std::unique_ptr<FakeEdgesContainer> m_lastFakeEdges;
   // Mirror of the active slots for the alternative route computed in CalculateRoute. Swapped
@@ -313,5 +364,8 @@ private:
   CountryParentNameGetterFn m_countryParentNameGetterFn;
 
   TimeGetterT m_currentTimeGetter;
+
+  bool m_useLandmarks = true;
+  bool m_useCellOverlay = true;
 };
 }  // namespace routing
@@ -64,6 +64,28 @@ private:
 };
 
 std::string DebugPrint(JointSegment const & jointSegment);
+
+namespace astar
+{
+// Joint segments are numbered by the start segment, the end segment tells apart the ones with the same start.
+template <>
+struct DenseKeyTraits<JointSegment>
+{
+  static bool constexpr kSupported = true;
+
+  static bool Get(JointSegment const & segment, DenseKey & key)
+  {
+    if (segment.GetMwmId() == kFakeNumMwmId)
+      return false;
+
+    key.m_mwmId = segment.GetMwmId();
+    key.m_featureId = segment.GetFeatureId();
+    key.m_index = 2 * segment.GetStartSegmentId() + (segment.IsForward() ? 1 : 0);
+    key.m_check = segment.GetEndSegmentId();
+    return true;
+  }
+};
+}  // namespace astar
 }  // namespace routing
 
 namespace std
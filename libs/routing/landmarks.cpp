@@ -0,0 +1,120 @@
+#include "routing/landmarks.hpp"
+
+#include "indexer/data_source.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "defines.hpp"
+
+namespace routing
+{
+void LandmarkWeights::Init(size_t count, double precisionSec)
+{
+  CHECK_LESS_OR_EQUAL(count, kMaxCount, ());
+  m_count = count;
+  m_precisionSec = precisionSec;
+  std::fill(m_from.begin(), m_from.begin() + count, kNoWeight);
+  std::fill(m_to.begin(), m_to.begin() + count, kNoWeight);
+}
+
+void LandmarkWeights::Unite(LandmarkWeights const & rhs, bool isSource)
+{
+  CHECK_EQUAL(m_count, rhs.m_count, ());
+  for (size_t i = 0; i < m_count; ++i)
+  {
+    // The route may pass through any of the points, so the weights which give the least bound are kept:
+    // the greatest weights from the landmarks and the least ones to the landmarks for the source
+    // and vice versa for the target.
+    if (isSource)
+    {
+      m_from[i] = std::max(m_from[i], rhs.m_from[i]);
+      m_to[i] = std::min(m_to[i], rhs.m_to[i]);
+    }
+    else
+    {
+      m_from[i] = std::min(m_from[i], rhs.m_from[i]);
+      m_to[i] = std::max(m_to[i], rhs.m_to[i]);
+    }
+  }
+  m_precisionSec = std::max(m_precisionSec, rhs.m_precisionSec);
+}
+
+double GetLowerBound(LandmarkWeights const & from, LandmarkWeights const & to)
+{
+  if (from.m_count != to.m_count)
+    return 0.0;
+
+  double bound = 0.0;
+  for (size_t i = 0; i < from.m_count; ++i)
+  {
+    // Unknown weights don't give any bound.
+    if (std::isfinite(from.m_from[i]) && std::isfinite(to.m_from[i]))
+      bound = std::max(bound, to.m_from[i] - from.m_from[i]);
+    if (std::isfinite(from.m_to[i]) && std::isfinite(to.m_to[i]))
+      bound = std::max(bound, from.m_to[i] - to.m_to[i]);
+  }
+
+  // The subtracted weight is rounded down too.
+  double const precision = std::max(from.m_precisionSec, to.m_precisionSec);
+  return std::max(bound - precision, 0.0);
+}
+
+Landmarks::Landmarks(std::vector<Joint::Id> && landmarks, uint32_t numJoints, uint32_t precisionDs,
+                     std::vector<uint16_t> && from, std::vector<uint16_t> && to)
+  : m_landmarks(std::move(landmarks))
+  , m_numJoints(numJoints)
+  , m_precisionDs(precisionDs)
+  , m_from(std::move(from))
+  , m_to(std::move(to))
+{
+  CHECK_LESS_OR_EQUAL(m_landmarks.size(), LandmarkWeights::kMaxCount, ());
+  CHECK_GREATER(m_precisionDs, 0, ());
+  CHECK_EQUAL(m_from.size(), m_landmarks.size() * m_numJoints, ());
+  CHECK_EQUAL(m_to.size(), m_landmarks.size() * m_numJoints, ());
+}
+
+void Landmarks::GetWeights(Joint::Id jointId, LandmarkWeights & weights) const
+{
+  double const precision = m_precisionDs / 10.0;
+  weights.Init(m_landmarks.size(), precision);
+  if (jointId >= m_numJoints)
+    return;
+
+  size_t const offset = static_cast<size_t>(jointId) * m_landmarks.size();
+  for (size_t i = 0; i < m_landmarks.size(); ++i)
+  {
+    auto const from = m_from[offset + i];
+    auto const to = m_to[offset + i];
+    if (from != kNoWeight)
+      weights.m_from[i] = from * precision;
+    if (to != kNoWeight)
+      weights.m_to[i] = to * precision;
+  }
+}
+
+std::shared_ptr<Landmarks> LoadLandmarks(MwmValue const & mwmValue)
+{
+  if (!mwmValue.m_cont.IsExist(LANDMARKS_FILE_TAG))
+    return nullptr;
+
+  try
+  {
+    auto landmarks = std::make_shared<Landmarks>();
+    auto reader = mwmValue.m_cont.GetReader(LANDMARKS_FILE_TAG);
+    ReaderSource src(reader);
+    landmarks->Deserialize(src);
+    return landmarks;
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("File", mwmValue.GetCountryFileName(), "Error while reading", LANDMARKS_FILE_TAG, "section.", e.Msg()));
+    return nullptr;
+  }
+}
+}  // namespace routing
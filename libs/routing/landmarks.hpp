@@ -0,0 +1,120 @@
+#pragma once
+
+#include "routing/joint.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+class MwmValue;
+
+namespace routing
+{
+/// \brief Route weights between some point of a road graph and the landmarks.
+struct LandmarkWeights
+{
+  static double constexpr kNoWeight = std::numeric_limits<double>::infinity();
+  static size_t constexpr kMaxCount = 16;
+
+  void Init(size_t count, double precisionSec);
+
+  /// \brief Unites weights of points which the route passes through one of.
+  /// \param isSource the points are at the beginning of the route, otherwise at the end.
+  void Unite(LandmarkWeights const & rhs, bool isSource);
+
+  size_t m_count = 0;
+  // Route weights in seconds from the landmarks to the point and from the point to the landmarks,
+  // kNoWeight if it's unknown.
+  std::array<double, kMaxCount> m_from;
+  std::array<double, kMaxCount> m_to;
+  // Stored weights are rounded down to this precision.
+  double m_precisionSec = 0.0;
+};
+
+/// \returns the lower bound of the route weight from the point with |from| weights to the point
+/// with |to| weights by the triangle inequality:
+/// d(u, v) >= d(L, v) - d(L, u) and d(u, v) >= d(u, L) - d(v, L) for any landmark L.
+double GetLowerBound(LandmarkWeights const & from, LandmarkWeights const & to);
+
+/// \brief Car route weights between all joints of an mwm road graph and a few landmark joints,
+/// which are used to make the A* heuristic stronger (ALT: A*, landmarks, triangle inequality).
+/// The weights are calculated with the car edge estimator without traffic and penalties,
+/// so they are not greater than the ones of routing.
+class Landmarks
+{
+public:
+  static uint16_t constexpr kNoWeight = std::numeric_limits<uint16_t>::max();
+
+  Landmarks() = default;
+  /// \param precisionDs unit of the weights in deciseconds.
+  /// \param from weights from the landmarks to the joints, |landmarks.size()| values per joint.
+  /// \param to weights from the joints to the landmarks in the same layout.
+  Landmarks(std::vector<Joint::Id> && landmarks, uint32_t numJoints, uint32_t precisionDs, std::vector<uint16_t> && from,
+            std::vector<uint16_t> && to);
+
+  size_t GetCount() const { return m_landmarks.size(); }
+  uint32_t GetNumJoints() const { return m_numJoints; }
+  std::vector<Joint::Id> const & GetLandmarks() const { return m_landmarks; }
+
+  void GetWeights(Joint::Id jointId, LandmarkWeights & weights) const;
+
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, kVersion);
+    WriteToSink(sink, static_cast<uint16_t>(m_landmarks.size()));
+    WriteToSink(sink, m_numJoints);
+    WriteToSink(sink, m_precisionDs);
+    for (auto const jointId : m_landmarks)
+      WriteToSink(sink, jointId);
+    for (auto const weight : m_from)
+      WriteToSink(sink, weight);
+    for (auto const weight : m_to)
+      WriteToSink(sink, weight);
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    CHECK_EQUAL(version, kVersion, ());
+    auto const count = ReadPrimitiveFromSource<uint16_t>(src);
+    CHECK_LESS_OR_EQUAL(count, LandmarkWeights::kMaxCount, ());
+    m_numJoints = ReadPrimitiveFromSource<uint32_t>(src);
+    m_precisionDs = ReadPrimitiveFromSource<uint32_t>(src);
+
+    m_landmarks.resize(count);
+    for (auto & jointId : m_landmarks)
+      jointId = ReadPrimitiveFromSource<Joint::Id>(src);
+
+    size_t const size = static_cast<size_t>(count) * m_numJoints;
+    m_from.resize(size);
+    m_to.resize(size);
+    for (auto & weight : m_from)
+      weight = ReadPrimitiveFromSource<uint16_t>(src);
+    for (auto & weight : m_to)
+      weight = ReadPrimitiveFromSource<uint16_t>(src);
+  }
+
+private:
+  static uint16_t constexpr kVersion = 0;
+
+  std::vector<Joint::Id> m_landmarks;
+  uint32_t m_numJoints = 0;
+  // Unit of the weights in deciseconds.
+  uint32_t m_precisionDs = 1;
+  // Weights by joint id and then by landmark.
+  std::vector<uint16_t> m_from;
+  std::vector<uint16_t> m_to;
+};
+
+/// \returns landmarks of the mwm or nullptr if there is no LANDMARKS_FILE_TAG section.
+std::shared_ptr<Landmarks> LoadLandmarks(MwmValue const & mwmValue);
+}  // namespace routing
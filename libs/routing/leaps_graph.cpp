@@ -116,6 +116,11 @@ RouteWeight LeapsGraph::GetAStarWeightEpsilon()
   return m_starter.GetAStarWeightEpsilon();
 }
 
+bool LeapsGraph::UseDenseAStarState() const
+{
+  return m_starter.UseDenseAStarState();
+}
+
 RouteWeight LeapsGraph::CalcMiddleCrossMwmWeight(std::vector<Segment> const & path)
 {
   ASSERT_GREATER(path.size(), 1, ());
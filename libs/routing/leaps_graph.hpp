@@ -25,6 +25,7 @@ public:
   void GetIngoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges) override;
   RouteWeight HeuristicCostEstimate(Segment const & from, Segment const & to) override;
   RouteWeight GetAStarWeightEpsilon() override;
+  bool UseDenseAStarState() const override;
   // @}
 
   Segment const & GetStartSegment() const { return m_startSegment; }
@@ -0,0 +1,198 @@
+#include "routing/road_geometry_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <utility>
+
+namespace routing
+{
+namespace
+{
+// Share of the memory limit for roads which were requested more than once.
+size_t constexpr kProtectedPercent = 80;
+
+// Approximate memory of list and hash map nodes.
+size_t constexpr kNodesBytes = 4 * sizeof(void *) + sizeof(uint64_t);
+}  // namespace
+
+RoadGeometryCache::RoadGeometryCache(size_t maxBytes) : RoadGeometryCache(maxBytes, maxBytes) {}
+
+RoadGeometryCache::RoadGeometryCache(size_t mwmMaxBytes, size_t maxBytes)
+  : m_mwmMaxBytes(mwmMaxBytes)
+  , m_totalMaxBytes(maxBytes)
+{
+  CHECK_GREATER(m_mwmMaxBytes, 0, ());
+  CHECK_GREATER_OR_EQUAL(m_totalMaxBytes, m_mwmMaxBytes, ());
+  UpdateMaxBytes();
+}
+
+RoadGeometry const & RoadGeometryCache::GetRoad(uint32_t mwmIdx, uint32_t featureId, Loader const & loader)
+{
+  uint64_t const key = MakeKey(mwmIdx, featureId);
+  auto const it = m_map.find(key);
+  if (it != m_map.cend())
+  {
+    ++m_stats.m_hits;
+    auto const entryIt = it->second;
+    if (entryIt->m_protected)
+      m_protected.splice(m_protected.begin(), m_protected, entryIt);
+    else
+      Promote(entryIt);
+    return entryIt->m_road;
+  }
+
+  ++m_stats.m_misses;
+
+  // Load before insertion to keep the cache consistent if the loader throws.
+  RoadGeometry road;
+  loader(featureId, road);
+
+  m_probation.emplace_front();
+  auto & entry = m_probation.front();
+  entry.m_key = key;
+  entry.m_road = std::move(road);
+  entry.m_bytes = sizeof(Entry) - sizeof(RoadGeometry) + entry.m_road.GetMemorySize() + kNodesBytes;
+
+  m_map.emplace(key, m_probation.begin());
+  m_bytes += entry.m_bytes;
+
+  Evict();
+  return entry.m_road;
+}
+
+uint32_t RoadGeometryCache::GetMwmIndex(MwmSet::MwmId const & mwmId)
+{
+  CHECK(mwmId.IsAlive(), (mwmId));
+
+  std::optional<uint32_t> freeIdx;
+  std::optional<uint32_t> result;
+  for (uint32_t i = 0; i < m_mwms.size(); ++i)
+  {
+    auto & id = m_mwms[i];
+    if (!id.IsNull() && !id.IsAlive())
+    {
+      RemoveMwm(i);
+      id.Reset();
+    }
+
+    if (id == mwmId)
+      result = i;
+    else if (id.IsNull() && !freeIdx)
+      freeIdx = i;
+  }
+
+  if (!result)
+  {
+    if (freeIdx)
+    {
+      m_mwms[*freeIdx] = mwmId;
+      result = freeIdx;
+    }
+    else
+    {
+      m_mwms.push_back(mwmId);
+      result = static_cast<uint32_t>(m_mwms.size() - 1);
+    }
+  }
+
+  UpdateMaxBytes();
+  return *result;
+}
+
+void RoadGeometryCache::Clear()
+{
+  m_map.clear();
+  m_probation.clear();
+  m_protected.clear();
+  m_bytes = 0;
+  m_protectedBytes = 0;
+  m_mwms.clear();
+  UpdateMaxBytes();
+}
+
+void RoadGeometryCache::Promote(EntryList::iterator it)
+{
+  ASSERT(!it->m_protected, ());
+  it->m_protected = true;
+  m_protected.splice(m_protected.begin(), m_probation, it);
+  m_protectedBytes += it->m_bytes;
+  DemoteProtected();
+}
+
+void RoadGeometryCache::DemoteProtected()
+{
+  // Demote the least recently used protected roads. They get one more chance in the probationary segment.
+  while (m_protectedBytes > m_protectedMaxBytes && m_protected.size() > 1)
+  {
+    auto const last = std::prev(m_protected.end());
+    last->m_protected = false;
+    m_protectedBytes -= last->m_bytes;
+    m_probation.splice(m_probation.begin(), m_protected, last);
+  }
+}
+
+void RoadGeometryCache::Evict()
+{
+  // The front probationary road is the one which has just been loaded, it's never evicted.
+  while (m_bytes > m_maxBytes)
+  {
+    if (m_probation.size() > 1)
+      Erase(m_probation, std::prev(m_probation.end()));
+    else if (!m_protected.empty())
+      Erase(m_protected, std::prev(m_protected.end()));
+    else
+      break;
+    ++m_stats.m_evictions;
+  }
+}
+
+void RoadGeometryCache::UpdateMaxBytes()
+{
+  size_t mwmsCount = 0;
+  for (auto const & id : m_mwms)
+  {
+    if (!id.IsNull())
+      ++mwmsCount;
+  }
+
+  m_maxBytes = std::min(m_totalMaxBytes, m_mwmMaxBytes * std::max(mwmsCount, size_t{1}));
+  m_protectedMaxBytes = m_maxBytes / 100 * kProtectedPercent;
+  DemoteProtected();
+  Evict();
+}
+
+void RoadGeometryCache::Erase(EntryList & list, EntryList::iterator it)
+{
+  m_bytes -= it->m_bytes;
+  if (it->m_protected)
+    m_protectedBytes -= it->m_bytes;
+  m_map.erase(it->m_key);
+  list.erase(it);
+}
+
+void RoadGeometryCache::RemoveMwm(uint32_t mwmIdx)
+{
+  for (auto * list : {&m_probation, &m_protected})
+  {
+    for (auto it = list->begin(); it != list->end();)
+    {
+      auto const next = std::next(it);
+      if (static_cast<uint32_t>(it->m_key >> 32) == mwmIdx)
+        Erase(*list, it);
+      it = next;
+    }
+  }
+}
+
+std::string DebugPrint(RoadGeometryCache::Stats const & stats)
+{
+  std::ostringstream os;
+  os << "RoadGeometryCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+     << ", evictions: " << stats.m_evictions << " ]";
+  return os.str();
+}
+}  // namespace routing
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "routing/geometry.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "3party/skarupke/bytell_hash_map.hpp"
+
+namespace routing
+{
+/// \brief Segmented LRU cache of road geometry limited by memory size.
+/// \note A new road gets into the probationary segment and is promoted to the protected segment
+/// on the next hit. So a one-shot scan (e.g. an A* wave spreading over a big area) evicts
+/// probationary roads only and doesn't wash out roads which are used again and again.
+/// \note The cache may be shared by Geometry instances of several mwms and by consecutive
+/// route calculations. It's not thread-safe.
+/// \note A returned reference is valid until the road is evicted. The most recently requested
+/// roads are evicted last, so it's safe to use the reference until the next GetRoad() call.
+class RoadGeometryCache final
+{
+public:
+  using Loader = std::function<void(uint32_t featureId, RoadGeometry & road)>;
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+  };
+
+  /// \param maxBytes memory limit for all cached roads.
+  explicit RoadGeometryCache(size_t maxBytes);
+  /// \param mwmMaxBytes memory limit for every mwm which has got an index, the limit for all cached roads
+  /// grows with the number of such mwms up to |maxBytes|.
+  RoadGeometryCache(size_t mwmMaxBytes, size_t maxBytes);
+
+  RoadGeometry const & GetRoad(uint32_t mwmIdx, uint32_t featureId, Loader const & loader);
+
+  /// \returns index of |mwmId| to be used in GetRoad(). Roads of deregistered mwms are dropped here,
+  /// so an index of an updated mwm is never mixed up with the index of its previous version.
+  uint32_t GetMwmIndex(MwmSet::MwmId const & mwmId);
+
+  void Clear();
+
+  Stats const & GetStats() const { return m_stats; }
+  size_t GetSize() const { return m_map.size(); }
+  size_t GetMemorySize() const { return m_bytes; }
+  size_t GetMaxMemorySize() const { return m_maxBytes; }
+
+private:
+  struct Entry
+  {
+    uint64_t m_key = 0;
+    size_t m_bytes = 0;
+    bool m_protected = false;
+    RoadGeometry m_road;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  static uint64_t MakeKey(uint32_t mwmIdx, uint32_t featureId)
+  {
+    return (static_cast<uint64_t>(mwmIdx) << 32) | featureId;
+  }
+
+  void Promote(EntryList::iterator it);
+  void DemoteProtected();
+  void Evict();
+  void UpdateMaxBytes();
+  void Erase(EntryList & list, EntryList::iterator it);
+  void RemoveMwm(uint32_t mwmIdx);
+
+  size_t const m_mwmMaxBytes;
+  size_t const m_totalMaxBytes;
+  size_t m_maxBytes = 0;
+  size_t m_protectedMaxBytes = 0;
+
+  EntryList m_probation;
+  EntryList m_protected;
+  ska::bytell_hash_map<uint64_t, EntryList::iterator> m_map;
+  size_t m_bytes = 0;
+  size_t m_protectedBytes = 0;
+
+  // Index in the vector is an mwm index of the cache. Empty ids are free indexes.
+  std::vector<MwmSet::MwmId> m_mwms;
+
+  Stats m_stats;
+};
+
+std::string DebugPrint(RoadGeometryCache::Stats const & stats);
+}  // namespace routing
@@ -16,7 +16,6 @@
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
-#include "base/scope_guard.hpp"
 
 #include <limits>
 
@@ -93,7 +92,9 @@ RoutesBuilder & RoutesBuilder::GetSimpleRoutesBuilder()
   static RoutesBuilder routesBuilder(1 /* threadsNumber */);
   return routesBuilder;
 }
-RoutesBuilder::RoutesBuilder(size_t threadsNumber) : m_threadPool(threadsNumber)
+RoutesBuilder::RoutesBuilder(size_t threadsNumber, bool shareRoutingData)
+  : m_threadPool(threadsNumber)
+  , m_sharedData(shareRoutingData ? std::make_shared<SharedRoutingData>() : nullptr)
 {
   CHECK_GREATER(threadsNumber, 0, ());
   LOG(LINFO, ("Threads number:", threadsNumber));
@@ -104,10 +105,6 @@ RoutesBuilder::RoutesBuilder(size_t threadsNumber) : m_threadPool(threadsNumber)
   std::vector<platform::LocalCountryFile> localFiles;
   platform::FindAllLocalMapsAndCleanup(std::numeric_limits<int64_t>::max(), localFiles);
 
-  std::vector<std::unique_ptr<FrozenDataSource>> dataSources;
-  for (size_t i = 0; i < threadsNumber; ++i)
-    dataSources.emplace_back(std::make_unique<FrozenDataSource>());
-
   for (auto const & localFile : localFiles)
   {
     auto const & countryFile = localFile.GetCountryFile();
@@ -117,35 +114,38 @@ RoutesBuilder::RoutesBuilder(size_t threadsNumber) : m_threadPool(threadsNumber)
 
     m_numMwmIds->RegisterFile(countryFile);
 
-    for (auto & dataSource : dataSources)
-    {
-      auto const result = dataSource->RegisterMap(localFile);
-      CHECK_EQUAL(result.second, MwmSet::RegResult::Success, ("Can't register mwm:", localFile));
-
-      auto const mwmId = dataSource->GetMwmIdByCountryFile(countryFile);
-      if (!mwmId.IsAlive())
-        continue;
-    }
+    auto const result = m_dataSource.RegisterMap(localFile);
+    CHECK_EQUAL(result.second, MwmSet::RegResult::Success, ("Can't register mwm:", localFile));
   }
-
-  for (auto & dataSource : dataSources)
-    m_dataSourcesStorage.PushDataSource(std::move(dataSource));
 }
 
 RoutesBuilder::Result RoutesBuilder::ProcessTask(Params const & params)
 {
-  Processor processor(m_numMwmIds, m_dataSourcesStorage, m_cpg, m_cig);
+  Processor processor(m_numMwmIds, m_dataSource, m_sharedData, m_cpg, m_cig);
   return processor(params);
 }
 
 std::future<RoutesBuilder::Result> RoutesBuilder::ProcessTaskAsync(Params const & params)
 {
   // Should be copyable to workaround MSVC bug (https://developercommunity.visualstudio.com/t/108672)
-  auto task = [processor = std::make_shared<Processor>(m_numMwmIds, m_dataSourcesStorage, m_cpg, m_cig)](
+  auto task = [processor = std::make_shared<Processor>(m_numMwmIds, m_dataSource, m_sharedData, m_cpg, m_cig)](
                   Params const & params) -> Result { return (*processor)(params); };
   return m_threadPool.Submit(std::move(task), params);
 }
 
+RoutesBuilder::MatrixResult RoutesBuilder::ProcessMatrix(MatrixParams const & params)
+{
+  Processor processor(m_numMwmIds, m_dataSource, m_sharedData, m_cpg, m_cig);
+  return processor(params);
+}
+
+std::future<RoutesBuilder::MatrixResult> RoutesBuilder::ProcessMatrixAsync(MatrixParams const & params)
+{
+  auto task = [processor = std::make_shared<Processor>(m_numMwmIds, m_dataSource, m_sharedData, m_cpg, m_cig)](
+                  MatrixParams const & params) -> MatrixResult { return (*processor)(params); };
+  return m_threadPool.Submit(std::move(task), params);
+}
+
 // RoutesBuilder::Result ---------------------------------------------------------------------------
 
 // static
@@ -229,16 +229,18 @@ std::vector<ms::LatLon> RoutesBuilder::Route::GetWaypoints() const
 
 // RoutesBuilder::Processor ------------------------------------------------------------------------
 
-RoutesBuilder::Processor::Processor(std::shared_ptr<NumMwmIds> numMwmIds, DataSourceStorage & dataSourceStorage,
+RoutesBuilder::Processor::Processor(std::shared_ptr<NumMwmIds> numMwmIds, DataSource & dataSource,
+                                    std::shared_ptr<SharedRoutingData> sharedData,
                                     std::weak_ptr<storage::CountryParentGetter> cpg,
                                     std::weak_ptr<storage::CountryInfoGetter> cig)
   : m_numMwmIds(std::move(numMwmIds))
-  , m_dataSourceStorage(dataSourceStorage)
+  , m_dataSource(dataSource)
+  , m_sharedData(std::move(sharedData))
   , m_cpg(std::move(cpg))
   , m_cig(std::move(cig))
 {}
 
-RoutesBuilder::Processor::Processor(Processor && rhs) noexcept : m_dataSourceStorage(rhs.m_dataSourceStorage)
+RoutesBuilder::Processor::Processor(Processor && rhs) noexcept : m_dataSource(rhs.m_dataSource)
 {
   m_start = rhs.m_start;
   m_finish = rhs.m_finish;
@@ -247,9 +249,9 @@ RoutesBuilder::Processor::Processor(Processor && rhs) noexcept : m_dataSourceSto
   m_delegate = std::move(rhs.m_delegate);
   m_numMwmIds = std::move(rhs.m_numMwmIds);
   m_trafficCache = std::move(rhs.m_trafficCache);
+  m_sharedData = std::move(rhs.m_sharedData);
   m_cpg = std::move(rhs.m_cpg);
   m_cig = std::move(rhs.m_cig);
-  m_dataSource = std::move(rhs.m_dataSource);
 }
 
 void RoutesBuilder::Processor::InitRouter(VehicleType type)
@@ -271,26 +273,21 @@ void RoutesBuilder::Processor::InitRouter(VehicleType type)
   };
 
   bool const loadAltitudes = type != VehicleType::Car;
-  if (!m_dataSource)
-    m_dataSource = m_dataSourceStorage.GetDataSource();
-
   m_router = std::make_unique<IndexRouter>(type, loadAltitudes, *m_cpg.lock(), countryFileGetter, getMwmRectByName,
                                            m_numMwmIds, MakeNumMwmTree(*m_numMwmIds, *m_cig.lock()), *m_trafficCache,
-                                           *m_dataSource);
+                                           m_dataSource);
+  m_router->SetSharedRoutingData(m_sharedData);
 }
 
 RoutesBuilder::Result RoutesBuilder::Processor::operator()(Params const & params)
 {
   InitRouter(params.m_type);
-  SCOPE_GUARD(returnDataSource, [&]() { m_dataSourceStorage.PushDataSource(std::move(m_dataSource)); });
 
   LOG(LINFO, ("Start building route, checkpoints:", params.m_checkpoints));
 
   RouterResultCode resultCode = RouterResultCode::RouteNotFound;
   routing::RoutesResult routesResult("" /* router */, 0 /* routesId */);
 
-  CHECK(m_dataSource, ());
-
   double timeSum = 0.0;
   for (size_t i = 0; i < params.m_launchesNumber; ++i)
   {
@@ -323,5 +320,29 @@ RoutesBuilder::Result RoutesBuilder::Processor::operator()(Params const & params
 
   return result;
 }
+
+RoutesBuilder::MatrixResult RoutesBuilder::Processor::operator()(MatrixParams const & params)
+{
+  InitRouter(params.m_type);
+
+  LOG(LINFO, ("Start building matrix, sources:", params.m_sources.size(), "targets:", params.m_targets.size()));
+
+  MatrixResult result;
+  double timeSum = 0.0;
+  for (size_t i = 0; i < params.m_launchesNumber; ++i)
+  {
+    m_delegate->SetTimeout(params.m_timeoutSeconds);
+    base::Timer timer;
+    result.m_code = m_router->CalculateMatrix(params.m_sources, params.m_targets, *m_delegate, result.m_matrix);
+
+    if (result.m_code != RouterResultCode::NoError)
+      break;
+
+    timeSum += timer.ElapsedSeconds();
+  }
+
+  result.m_buildTimeSeconds = timeSum / static_cast<double>(params.m_launchesNumber);
+  return result;
+}
 }  // namespace routes_builder
 }  // namespace routing
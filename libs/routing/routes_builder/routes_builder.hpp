@@ -1,15 +1,16 @@
 #pragma once
 
-#include "routing/routes_builder/data_source_storage.hpp"
-
 #include "routing/checkpoints.hpp"
 #include "routing/index_router.hpp"
 #include "routing/router_delegate.hpp"
 #include "routing/routing_callbacks.hpp"
+#include "routing/shared_routing_data.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "traffic/traffic_cache.hpp"
 
+#include "indexer/data_source.hpp"
+
 #include "storage/country_info_getter.hpp"
 #include "storage/country_parent_getter.hpp"
 
@@ -43,7 +44,9 @@ namespace routes_builder
 class RoutesBuilder
 {
 public:
-  explicit RoutesBuilder(size_t threadsNumber);
+  /// \param shareRoutingData the routers of all threads share the read-only data of the mwm graphs,
+  /// otherwise every route task loads the graphs itself.
+  explicit RoutesBuilder(size_t threadsNumber, bool shareRoutingData = true);
   DISALLOW_COPY(RoutesBuilder);
 
   static RoutesBuilder & GetSimpleRoutesBuilder();
@@ -94,19 +97,43 @@ public:
     double m_buildTimeSeconds = 0.0;
   };
 
+  struct MatrixParams
+  {
+    VehicleType m_type = VehicleType::Car;
+    std::vector<m2::PointD> m_sources;
+    std::vector<m2::PointD> m_targets;
+    uint32_t m_timeoutSeconds = RouterDelegate::kNoTimeout;
+    uint32_t m_launchesNumber = 1;
+  };
+
+  struct MatrixResult
+  {
+    RouterResultCode m_code = RouterResultCode::RouteNotFound;
+    IndexRouter::RouteMatrix m_matrix;
+    double m_buildTimeSeconds = 0.0;
+  };
+
   Result ProcessTask(Params const & params);
   std::future<Result> ProcessTaskAsync(Params const & params);
 
+  MatrixResult ProcessMatrix(MatrixParams const & params);
+  std::future<MatrixResult> ProcessMatrixAsync(MatrixParams const & params);
+
+  /// \returns nullptr if the routing data isn't shared.
+  std::shared_ptr<SharedRoutingData> const & GetSharedRoutingData() const { return m_sharedData; }
+
 private:
   class Processor
   {
   public:
-    Processor(std::shared_ptr<NumMwmIds> numMwmIds, DataSourceStorage & dataSourceStorage,
-              std::weak_ptr<storage::CountryParentGetter> cpg, std::weak_ptr<storage::CountryInfoGetter> cig);
+    Processor(std::shared_ptr<NumMwmIds> numMwmIds, DataSource & dataSource,
+              std::shared_ptr<SharedRoutingData> sharedData, std::weak_ptr<storage::CountryParentGetter> cpg,
+              std::weak_ptr<storage::CountryInfoGetter> cig);
 
     Processor(Processor && rhs) noexcept;
 
     Result operator()(Params const & params);
+    MatrixResult operator()(MatrixParams const & params);
 
   private:
     void InitRouter(VehicleType type);
@@ -119,10 +146,10 @@ private:
 
     std::shared_ptr<NumMwmIds> m_numMwmIds;
     std::shared_ptr<traffic::TrafficCache> m_trafficCache = std::make_shared<traffic::TrafficCache>();
-    DataSourceStorage & m_dataSourceStorage;
+    DataSource & m_dataSource;
+    std::shared_ptr<SharedRoutingData> m_sharedData;
     std::weak_ptr<storage::CountryParentGetter> m_cpg;
     std::weak_ptr<storage::CountryInfoGetter> m_cig;
-    std::unique_ptr<FrozenDataSource> m_dataSource;
   };
 
   base::ComputationalThreadPool m_threadPool;
@@ -134,7 +161,9 @@ private:
 
   std::shared_ptr<NumMwmIds> m_numMwmIds = std::make_shared<NumMwmIds>();
 
-  DataSourceStorage m_dataSourcesStorage;
+  // Mwms are registered once and all threads work with them, MwmSet is thread-safe.
+  FrozenDataSource m_dataSource;
+  std::shared_ptr<SharedRoutingData> m_sharedData;
 };
 }  // namespace routes_builder
 }  // namespace routing
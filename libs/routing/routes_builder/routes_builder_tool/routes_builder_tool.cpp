@@ -42,7 +42,13 @@ DEFINE_int32(timeout, 10 * 60,
 DEFINE_bool(verbose, false, "Verbose logging (default: false)");
 
 DEFINE_int32(launches_number, 1, "Number of launches of routes buildings. Needs for benchmarking (default: 1)");
+DEFINE_bool(matrix, false,
+            "Build the matrix of routes between all points of --routes_file instead of separate routes. "
+            "The file has one point per line in format: lat lon. The matrix is dumped to matrix.csv in --dump_path.");
 DEFINE_string(vehicle_type, "car", "Vehicle type: car|pedestrian|bicycle|transit. (Only for mapsme).");
+DEFINE_bool(share_routing_data, true,
+            "Share the read-only routing data of mwms between threads. Switch it off to compare throughput "
+            "and memory (default: true).");
 
 using namespace routing;
 using namespace routes_builder;
@@ -102,8 +108,15 @@ int Main(int argc, char ** argv)
     if (launchesNumber > 1)
       LOG(LINFO, ("Benchmark mode is activated. Each route will be built", launchesNumber, "times."));
 
+    if (FLAGS_matrix)
+    {
+      BuildMatrix(FLAGS_routes_file, FLAGS_dump_path, FLAGS_threads, FLAGS_timeout, FLAGS_vehicle_type, FLAGS_verbose,
+                  launchesNumber, FLAGS_share_routing_data);
+      return 0;
+    }
+
     BuildRoutes(FLAGS_routes_file, FLAGS_dump_path, FLAGS_start_from, FLAGS_threads, FLAGS_timeout, FLAGS_vehicle_type,
-                FLAGS_verbose, launchesNumber);
+                FLAGS_verbose, launchesNumber, FLAGS_share_routing_data);
   }
 
   if (IsApiBuild())
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <fstream>
 #include <future>
 #include <iostream>
 #include <optional>
@@ -60,11 +61,20 @@ routing::VehicleType ConvertVehicleTypeFromString(std::string const & str)
   CHECK(false, ("Unknown vehicle type:", str));
   UNREACHABLE();
 }
+
+uint64_t GetThreadsNumber(uint64_t threadsNumber)
+{
+  if (threadsNumber)
+    return threadsNumber;
+
+  auto const hardwareConcurrency = std::thread::hardware_concurrency();
+  return hardwareConcurrency > 0 ? hardwareConcurrency : 2;
+}
 }  // namespace
 
 void BuildRoutes(std::string const & routesPath, std::string const & dumpPath, uint64_t startFrom,
                  uint64_t threadsNumber, uint32_t timeoutPerRouteSeconds, std::string const & vehicleTypeStr,
-                 bool verbose, uint32_t launchesNumber)
+                 bool verbose, uint32_t launchesNumber, bool shareRoutingData)
 {
   CHECK(Platform::IsFileExistsByFullPath(routesPath), ("Can not find file:", routesPath));
   CHECK(!dumpPath.empty(), ("Empty dumpPath."));
@@ -72,13 +82,8 @@ void BuildRoutes(std::string const & routesPath, std::string const & dumpPath, u
   std::ifstream input(routesPath);
   CHECK(input.good(), ("Error during opening:", routesPath));
 
-  if (!threadsNumber)
-  {
-    auto const hardwareConcurrency = std::thread::hardware_concurrency();
-    threadsNumber = hardwareConcurrency > 0 ? hardwareConcurrency : 2;
-  }
-
-  RoutesBuilder routesBuilder(threadsNumber);
+  threadsNumber = GetThreadsNumber(threadsNumber);
+  RoutesBuilder routesBuilder(threadsNumber, shareRoutingData);
 
   std::vector<std::future<RoutesBuilder::Result>> tasks;
   double lastPercent = 0.0;
@@ -94,6 +99,8 @@ void BuildRoutes(std::string const & routesPath, std::string const & dumpPath, u
     ms::LatLon start;
     ms::LatLon finish;
     size_t startFromCopy = startFrom;
+    // Tasks are started as soon as they are created.
+    base::Timer timer;
     while (input >> start.m_lat >> start.m_lon >> finish.m_lat >> finish.m_lon)
     {
       if (startFromCopy > 0)
@@ -110,7 +117,7 @@ void BuildRoutes(std::string const & routesPath, std::string const & dumpPath, u
     }
 
     LOG_FORCE(LINFO, ("Created:", tasks.size(), "tasks, vehicle type:", vehicleType));
-    base::Timer timer;
+    size_t found = 0;
     for (size_t i = 0; i < tasks.size(); ++i)
     {
       size_t shiftIndex = i + startFrom;
@@ -118,6 +125,8 @@ void BuildRoutes(std::string const & routesPath, std::string const & dumpPath, u
       task.wait();
 
       auto const result = task.get();
+      if (result.IsCodeOK())
+        ++found;
       if (result.m_code == RouterResultCode::Cancelled)
         LOG_FORCE(LINFO, ("Route:", i, "(", i + 1, "line of file) was building too long."));
 
@@ -134,10 +143,94 @@ void BuildRoutes(std::string const & routesPath, std::string const & dumpPath, u
         LOG_FORCE(LINFO, ("Progress:", lastPercent, "%"));
       }
     }
-    LOG_FORCE(LINFO, ("BuildRoutes() took:", timer.ElapsedSeconds(), "seconds."));
+    double const seconds = timer.ElapsedSeconds();
+    LOG_FORCE(LINFO, ("BuildRoutes() took:", seconds, "seconds."));
+    LOG_FORCE(LINFO, ("Throughput:", tasks.size() * launchesNumber / seconds, "routes per second in", threadsNumber,
+                      "threads, found", found, "routes of", tasks.size(), ", shared routing data:",
+                      shareRoutingData ? DebugPrint(routesBuilder.GetSharedRoutingData()->GetStats()) : "off"));
   }
 }
 
+void BuildMatrix(std::string const & pointsPath, std::string const & dumpPath, uint64_t threadsNumber,
+                 uint32_t timeoutSeconds, std::string const & vehicleTypeStr, bool verbose, uint32_t launchesNumber,
+                 bool shareRoutingData)
+{
+  CHECK(Platform::IsFileExistsByFullPath(pointsPath), ("Can not find file:", pointsPath));
+  CHECK(!dumpPath.empty(), ("Empty dumpPath."));
+
+  std::ifstream input(pointsPath);
+  CHECK(input.good(), ("Error during opening:", pointsPath));
+
+  std::vector<m2::PointD> points;
+  ms::LatLon point;
+  while (input >> point.m_lat >> point.m_lon)
+    points.push_back(mercator::FromLatLon(point));
+  CHECK(!points.empty(), ("No points in:", pointsPath));
+
+  threadsNumber = std::min(GetThreadsNumber(threadsNumber), static_cast<uint64_t>(points.size()));
+  RoutesBuilder routesBuilder(threadsNumber, shareRoutingData);
+
+  auto const vehicleType = ConvertVehicleTypeFromString(vehicleTypeStr);
+  base::ScopedLogLevelChanger changer(verbose ? base::LogLevel::LINFO : base::LogLevel::LERROR);
+
+  RoutesBuilder::MatrixParams params;
+  params.m_type = vehicleType;
+  params.m_targets = points;
+  params.m_timeoutSeconds = timeoutSeconds;
+  params.m_launchesNumber = launchesNumber;
+
+  base::Timer timer;
+  // Contiguous ranges of sources, one task per thread.
+  size_t const chunkSize = (points.size() + threadsNumber - 1) / threadsNumber;
+  std::vector<std::future<RoutesBuilder::MatrixResult>> tasks;
+  for (size_t begin = 0; begin < points.size(); begin += chunkSize)
+  {
+    auto const end = std::min(begin + chunkSize, points.size());
+    params.m_sources.assign(points.begin() + begin, points.begin() + end);
+    tasks.emplace_back(routesBuilder.ProcessMatrixAsync(params));
+  }
+
+  LOG_FORCE(LINFO, ("Created:", tasks.size(), "matrix tasks for", points.size(), "points, vehicle type:", vehicleType));
+
+  std::string const fullPath = base::JoinPath(dumpPath, "matrix.csv");
+  std::ofstream output(fullPath);
+  CHECK(output.good(), ("Error during opening:", fullPath));
+  output << "source,target,code,weight,eta,distance\n";
+
+  size_t source = 0;
+  size_t found = 0;
+  double buildTimeSum = 0.0;
+  for (auto & task : tasks)
+  {
+    auto const result = task.get();
+    if (result.m_code != RouterResultCode::NoError)
+      LOG_FORCE(LWARNING, ("Matrix task from source", source, "failed:", result.m_code));
+
+    buildTimeSum += result.m_buildTimeSeconds;
+    for (auto const & row : result.m_matrix)
+    {
+      for (size_t target = 0; target < row.size(); ++target)
+      {
+        auto const & cell = row[target];
+        if (cell.m_code == RouterResultCode::NoError)
+          ++found;
+        output << source << ',' << target << ',' << static_cast<int>(cell.m_code) << ',' << cell.m_weight << ','
+               << cell.m_etaSec << ',' << cell.m_distanceM << '\n';
+      }
+      ++source;
+    }
+  }
+
+  size_t const pairs = points.size() * points.size();
+  LOG_FORCE(LINFO, ("Found", found, "routes of", pairs, "pairs. Average task build time:",
+                    buildTimeSum / tasks.size(), "seconds."));
+  double const seconds = timer.ElapsedSeconds();
+  LOG_FORCE(LINFO, ("BuildMatrix() took:", seconds, "seconds, result:", fullPath));
+  LOG_FORCE(LINFO, ("Throughput:", pairs * launchesNumber / seconds, "matrix cells per second in", threadsNumber,
+                    "threads, shared routing data:",
+                    shareRoutingData ? DebugPrint(routesBuilder.GetSharedRoutingData()->GetStats()) : "off"));
+}
+
 std::optional<std::tuple<ms::LatLon, ms::LatLon, int32_t>> ParseApiLine(std::ifstream & input)
 {
   std::string line;
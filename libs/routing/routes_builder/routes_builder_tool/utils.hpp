@@ -13,9 +13,16 @@ namespace routing
 {
 namespace routes_builder
 {
+// |shareRoutingData| is passed to RoutesBuilder, the throughput is logged to compare both modes.
 void BuildRoutes(std::string const & routesPath, std::string const & dumpPath, uint64_t startFrom,
                  uint64_t threadsNumber, uint32_t timeoutPerRouteSeconds, std::string const & vehicleType, bool verbose,
-                 uint32_t launchesNumber);
+                 uint32_t launchesNumber, bool shareRoutingData);
+
+// Builds the matrix of routes between all points of |pointsPath|, which has one "lat lon" point per line.
+// Sources are split between threads, every thread calculates routes from its sources to all the points.
+void BuildMatrix(std::string const & pointsPath, std::string const & dumpPath, uint64_t threadsNumber,
+                 uint32_t timeoutSeconds, std::string const & vehicleType, bool verbose, uint32_t launchesNumber,
+                 bool shareRoutingData);
 
 void BuildRoutesWithApi(std::unique_ptr<routing_quality::api::RoutingApi> routingApi, std::string const & routesPath,
                         std::string const & dumpPath, int64_t startFrom);
@@ -3,16 +3,25 @@
 #include "routing/routing_benchmarks/helpers.hpp"
 
 #include "routing/car_directions.hpp"
+#include "routing/index_router.hpp"
 #include "routing/road_graph.hpp"
+#include "routing/router_delegate.hpp"
+
+#include "routing/routing_integration_tests/routing_test_tools.hpp"
 
 #include "routing_common/car_model.hpp"
 
 #include "geometry/latlon.hpp"
 #include "geometry/mercator.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -34,6 +43,65 @@ public:
       TestRouter(*router, startMerc, finalMerc, routeFoundByAstarBidirectional);
   }
 
+  // Compares wall time and count of settled vertices of the routing with and without landmarks.
+  // Landmarks section should be built for the maps with generator_tool --landmarks_count.
+  void CompareLandmarksHeuristic(ms::LatLon const & start, ms::LatLon const & final, size_t reiterations)
+  {
+    CompareRouting("Landmarks:", start, final, reiterations, [](routing::IndexRouter & router, bool enabled)
+    {
+      router.SetCellOverlay(false);
+      router.SetLandmarksHeuristic(enabled);
+    });
+  }
+
+  // Compares the routing inside one mwm with and without the cell overlay.
+  // Cell overlay section should be built for the maps with generator_tool --make_cell_overlay.
+  void CompareCellOverlay(ms::LatLon const & start, ms::LatLon const & final, size_t reiterations)
+  {
+    CompareRouting("Cell overlay:", start, final, reiterations,
+                   [](routing::IndexRouter & router, bool enabled) { router.SetCellOverlay(enabled); });
+  }
+
+  template <typename SetUp>
+  void CompareRouting(std::string const & name, ms::LatLon const & start, ms::LatLon const & final,
+                      size_t reiterations, SetUp && setUp)
+  {
+    std::vector<platform::LocalCountryFile> neededLocalFiles;
+    for (auto const & file : m_localFiles)
+      if (m_neededMaps.count(file.GetCountryName()) != 0)
+        neededLocalFiles.push_back(file);
+
+    auto router = integration::CreateVehicleRouter(m_dataSource, *m_cig, m_trafficCache, neededLocalFiles, m_type);
+    double weights[2] = {};
+    for (bool const enabled : {false, true})
+    {
+      setUp(*router, enabled);
+
+      // The point check callback is called once per a fixed count of settled vertices.
+      uint64_t pointChecks = 0;
+      routing::RouterDelegate delegate;
+      delegate.SetPointCheckCallback([&pointChecks](ms::LatLon const &) { ++pointChecks; });
+
+      base::Timer timer;
+      for (size_t i = 0; i < reiterations; ++i)
+      {
+        routing::RoutesResult res(router->GetName(), 0 /* routes id */);
+        auto const code = router->CalculateRoute(
+            routing::Checkpoints(mercator::FromLatLon(start), mercator::FromLatLon(final)),
+            m2::PointD::Zero() /* startDirection */, false /* adjust */, delegate, res);
+        TEST_EQUAL(code, routing::RouterResultCode::NoError, ());
+        TEST(res.IsValid(), ());
+        weights[enabled] = res.GetActive().GetTotalTimeSec();
+      }
+
+      LOG(LINFO, (name, enabled, "elapsed, seconds:", timer.ElapsedSeconds() / reiterations,
+                  "settled vertices checks:", pointChecks / reiterations, "route time, seconds:", weights[enabled]));
+    }
+
+    // Both ways find the shortest route, so the routes should have the same weight.
+    TEST_ALMOST_EQUAL_ABS(weights[0], weights[1], 1.0, ());
+  }
+
 protected:
   std::unique_ptr<routing::VehicleModelFactoryInterface> CreateModelFactory() override
   {
@@ -61,4 +129,15 @@ UNIT_CLASS_TEST(CarTest, InAirport)
 {
   TestCarRouter(ms::LatLon(55.97285, 37.41275), ms::LatLon(55.96396, 37.41922), 30);
 }
+
+// Start and finish are located on the opposite sides of the city.
+UNIT_CLASS_TEST(CarTest, Landmarks_AcrossCity)
+{
+  CompareLandmarksHeuristic(ms::LatLon(55.57112, 37.47455), ms::LatLon(55.91145, 37.73025), 10);
+}
+
+UNIT_CLASS_TEST(CarTest, CellOverlay_AcrossCity)
+{
+  CompareCellOverlay(ms::LatLon(55.57112, 37.47455), ms::LatLon(55.91145, 37.73025), 10);
+}
 }  // namespace
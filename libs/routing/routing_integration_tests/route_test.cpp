@@ -5,13 +5,17 @@
 
 #include "routing/routing_integration_tests/routing_test_tools.hpp"
 
+#include "routing/index_router.hpp"
 #include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
 
 #include "platform/platform_tests_support/helpers.hpp"
 
 #include "geometry/mercator.hpp"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 namespace route_test
 {
@@ -1011,4 +1015,40 @@ UNIT_TEST(India_Bangalore_ShortRoute)
                                    FromLatLon(12.9600501, 77.6451721), 1997.79);
 }
 
+UNIT_TEST(Moscow_RouteMatrix)
+{
+  auto & components = GetVehicleComponents(VehicleType::Car);
+  auto * router = dynamic_cast<IndexRouter *>(&components.GetRouter());
+  TEST(router, ());
+
+  std::vector<m2::PointD> const sources = {FromLatLon(55.75100, 37.61790), FromLatLon(55.73220, 37.60530)};
+  // The last two targets are the first source itself and a point on the same road segment a few meters away.
+  std::vector<m2::PointD> const targets = {FromLatLon(55.76310, 37.58990), FromLatLon(55.74060, 37.65660),
+                                           FromLatLon(55.77630, 37.65450), sources[0],
+                                           FromLatLon(55.75103, 37.61795)};
+
+  RouterDelegate delegate;
+  IndexRouter::RouteMatrix matrix;
+  TEST_EQUAL(router->CalculateMatrix(sources, targets, delegate, matrix), RouterResultCode::NoError, ());
+  TEST_EQUAL(matrix.size(), sources.size(), ());
+
+  // Every cell is the same route which is built for the pair alone.
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    TEST_EQUAL(matrix[i].size(), targets.size(), ());
+    for (size_t j = 0; j < targets.size(); ++j)
+    {
+      auto const & cell = matrix[i][j];
+      TEST_EQUAL(cell.m_code, RouterResultCode::NoError, (i, j));
+
+      TRouteResult const res = CalculateRoute(components, sources[i], {0., 0.}, targets[j]);
+      TEST_EQUAL(res.second, RouterResultCode::NoError, (i, j));
+      // Short routes are compared with an absolute tolerance.
+      TEST_LESS_OR_EQUAL(cell.m_etaSec, res.first->GetTotalTimeSec() * 1.05 + 1.0, (i, j));
+      TEST_ALMOST_EQUAL_ABS(cell.m_distanceM, res.first->GetTotalDistanceMeters(),
+                            std::max(res.first->GetTotalDistanceMeters() * 0.1, 5.0), (i, j));
+    }
+  }
+}
+
 }  // namespace route_test
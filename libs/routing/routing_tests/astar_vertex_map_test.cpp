@@ -0,0 +1,140 @@
+#include "testing/testing.hpp"
+
+#include "routing/base/astar_vertex_map.hpp"
+#include "routing/joint_segment.hpp"
+#include "routing/segment.hpp"
+
+#include "routing/fake_feature_ids.hpp"
+
+#include "base/logging.hpp"
+
+#include <cstdint>
+#include <map>
+#include <random>
+
+namespace astar_vertex_map_test
+{
+using namespace routing;
+
+UNIT_TEST(AStarVertexMap_Segments)
+{
+  for (bool const dense : {false, true})
+  {
+    astar::VertexMap<Segment, double> map(dense);
+    TEST_EQUAL(map.IsDense(), dense, ());
+
+    Segment const a(1 /* mwmId */, 10 /* featureId */, 0 /* segmentIdx */, true /* forward */);
+    Segment const b(1 /* mwmId */, 10 /* featureId */, 0 /* segmentIdx */, false /* forward */);
+    Segment const c(2 /* mwmId */, 10 /* featureId */, 100 /* segmentIdx */, true /* forward */);
+    Segment const fake(kFakeNumMwmId, FakeFeatureIds::kIndexGraphStarterId, 0 /* segmentIdx */, true /* forward */);
+
+    TEST(!map.Find(a), ());
+    map.Set(a, 1.0);
+    map.Set(c, 3.0);
+    map.Set(fake, 4.0);
+    TEST(map.Find(a), ());
+    TEST_EQUAL(*map.Find(a), 1.0, ());
+    TEST(!map.Find(b), ());
+    TEST_EQUAL(*map.Find(c), 3.0, ());
+    TEST_EQUAL(*map.Find(fake), 4.0, ());
+
+    map.Set(a, 0.5);
+    map.Set(b, 2.0);
+    TEST_EQUAL(*map.Find(a), 0.5, ());
+    TEST_EQUAL(*map.Find(b), 2.0, ());
+
+    map.Clear();
+    TEST(!map.Find(a), ());
+    TEST(!map.Find(b), ());
+    TEST(!map.Find(c), ());
+    TEST(!map.Find(fake), ());
+
+    map.Set(b, 5.0);
+    TEST(!map.Find(a), ());
+    TEST_EQUAL(*map.Find(b), 5.0, ());
+  }
+}
+
+UNIT_TEST(AStarVertexMap_JointSegmentsWithSameStart)
+{
+  astar::VertexMap<JointSegment, double> map(true /* dense */);
+
+  JointSegment const a(Segment(0, 7, 1, true), Segment(0, 7, 3, true));
+  JointSegment const b(Segment(0, 7, 1, true), Segment(0, 7, 5, true));
+
+  map.Set(a, 1.0);
+  map.Set(b, 2.0);
+  TEST_EQUAL(*map.Find(a), 1.0, ());
+  TEST_EQUAL(*map.Find(b), 2.0, ());
+
+  map.Set(b, 3.0);
+  TEST_EQUAL(*map.Find(a), 1.0, ());
+  TEST_EQUAL(*map.Find(b), 3.0, ());
+}
+
+UNIT_TEST(AStarVertexMap_RandomAgainstStdMap)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<uint32_t> mwmDist(0, 3);
+  std::uniform_int_distribution<uint32_t> featureDist(0, 5000);
+  std::uniform_int_distribution<uint32_t> segmentDist(0, 40);
+
+  astar::VertexMap<Segment, uint32_t> map(true /* dense */);
+  for (uint32_t round = 0; round < 3; ++round)
+  {
+    std::map<Segment, uint32_t> expected;
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+      Segment const s(static_cast<NumMwmId>(mwmDist(rng)), featureDist(rng), segmentDist(rng), i % 2 == 0);
+      expected[s] = i;
+      map.Set(s, i);
+    }
+
+    for (auto const & [segment, value] : expected)
+    {
+      auto const * found = map.Find(segment);
+      TEST(found, (segment));
+      TEST_EQUAL(*found, value, (segment));
+    }
+
+    map.Clear();
+    for (auto const & [segment, value] : expected)
+      TEST(!map.Find(segment), (segment));
+  }
+}
+
+UNIT_TEST(AStarVertexMap_Memory)
+{
+  using DenseMap = astar::DenseVertexMap<uint32_t>;
+  astar::VertexMap<Segment, uint32_t> map(true /* dense */);
+
+  // One feature of every 1024 ids range is touched, the pages are not allocated for all of them.
+  uint32_t constexpr kSparseCount = 10000;
+  for (uint32_t i = 0; i < kSparseCount; ++i)
+    map.Set(Segment(0 /* mwmId */, i * 1024 /* featureId */, 0 /* segmentIdx */, true /* forward */), i);
+
+  for (uint32_t i = 0; i < kSparseCount; ++i)
+  {
+    auto const * found = map.Find(Segment(0, i * 1024, 0, true));
+    TEST(found, (i));
+    TEST_EQUAL(*found, i, ());
+  }
+  size_t const sparseBytes = map.GetDenseMap().GetMemoryBytes();
+  LOG(LINFO, ("Dense map of", kSparseCount, "sparse features:", sparseBytes, "bytes"));
+  TEST_LESS(sparseBytes, 1024 * 1024, ());
+
+  // All features of a large range are touched, most of the memory is freed by Clear().
+  map.Clear();
+  uint32_t constexpr kDenseCount = 2000000;
+  for (uint32_t i = 0; i < kDenseCount; ++i)
+    map.Set(Segment(0 /* mwmId */, i /* featureId */, 0 /* segmentIdx */, true /* forward */), i);
+  size_t const denseBytes = map.GetDenseMap().GetMemoryBytes();
+  TEST_GREATER(denseBytes, DenseMap::kMaxKeptBytes, ());
+
+  map.Clear();
+  size_t const clearedBytes = map.GetDenseMap().GetMemoryBytes();
+  LOG(LINFO, ("Dense map of", kDenseCount, "features:", denseBytes, "bytes, after Clear():", clearedBytes, "bytes"));
+  TEST_LESS_OR_EQUAL(clearedBytes, DenseMap::kMaxKeptBytes, ());
+  TEST(!map.Find(Segment(0, 1, 0, true)), ());
+}
+}  // namespace astar_vertex_map_test
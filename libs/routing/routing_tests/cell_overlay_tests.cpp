@@ -0,0 +1,230 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "routing/cell_overlay.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/index_graph_starter.hpp"
+
+#include "traffic/traffic_cache.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace cell_overlay_tests
+{
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+uint32_t constexpr kCitySize = 8;
+
+// Manhattan grid of kCitySize streets and avenues. Joint i * kCitySize + j is at (j, i).
+// Leaf cells are 2x2 joints squares, cells of level 1 are 4x4 joints squares.
+unique_ptr<SingleVehicleWorldGraph> BuildCity(traffic::TrafficCache const & trafficCache)
+{
+  auto loader = make_unique<TestGeometryLoader>();
+  for (uint32_t i = 0; i < kCitySize; ++i)
+  {
+    RoadGeometry::Points street;
+    RoadGeometry::Points avenue;
+    for (uint32_t j = 0; j < kCitySize; ++j)
+    {
+      street.emplace_back(static_cast<double>(j) / 100.0, static_cast<double>(i) / 100.0);
+      avenue.emplace_back(static_cast<double>(i) / 100.0, static_cast<double>(j) / 100.0);
+    }
+    // One street is one-way to make the weights directed.
+    loader->AddRoad(i, i == 3 /* oneWay */, 1.0 /* speed */, street);
+    loader->AddRoad(i + kCitySize, false /* oneWay */, 1.0 /* speed */, avenue);
+  }
+
+  vector<Joint> joints;
+  for (uint32_t i = 0; i < kCitySize; ++i)
+    for (uint32_t j = 0; j < kCitySize; ++j)
+      joints.emplace_back(MakeJoint({{i, j}, {j + kCitySize, i}}));
+
+  return BuildWorldGraph(std::move(loader), CreateEstimatorForCar(trafficCache), joints);
+}
+
+CellOverlay MakeOverlay(IndexGraph const & graph)
+{
+  vector<uint32_t> jointCells;
+  for (uint32_t i = 0; i < kCitySize; ++i)
+  {
+    for (uint32_t j = 0; j < kCitySize; ++j)
+    {
+      uint32_t const x = j;
+      uint32_t const y = i;
+      jointCells.push_back(((x / 4) << 3) | ((y / 4) << 2) | (((x % 4) / 2) << 1) | ((y % 4) / 2));
+    }
+  }
+
+  CellOverlay overlay(graph, 4 /* depth */, {0, 2} /* levelShifts */, std::move(jointCells));
+  overlay.SetMwmId(kTestNumMwmId);
+  return overlay;
+}
+
+void TestEqualWeights(CellOverlay const & lhs, CellOverlay const & rhs, double eps)
+{
+  TEST_EQUAL(lhs.GetTransitionsCount(), rhs.GetTransitionsCount(), ());
+  for (uint32_t enter = 0; enter < lhs.GetTransitionsCount(); ++enter)
+  {
+    for (uint32_t exit = 0; exit < lhs.GetTransitionsCount(); ++exit)
+    {
+      for (size_t level = 0; level < lhs.GetLevelsCount(); ++level)
+      {
+        auto const & enterTransition = lhs.GetTransition(enter);
+        auto const & exitTransition = lhs.GetTransition(exit);
+        auto const cell = lhs.GetCell(level, enterTransition.m_toCell);
+        if (enter == exit || cell == lhs.GetCell(level, enterTransition.m_fromCell) ||
+            cell != lhs.GetCell(level, exitTransition.m_fromCell) ||
+            cell == lhs.GetCell(level, exitTransition.m_toCell))
+        {
+          continue;
+        }
+
+        float const expected = lhs.GetWeight(level, enter, exit);
+        float const actual = rhs.GetWeight(level, enter, exit);
+        if (expected == CellOverlay::kNoWeight)
+          TEST_EQUAL(actual, CellOverlay::kNoWeight, (level, enter, exit));
+        else
+          TEST_ALMOST_EQUAL_ABS(static_cast<double>(actual), static_cast<double>(expected), eps, (level, enter, exit));
+      }
+    }
+  }
+}
+
+UNIT_TEST(CellOverlay_Transitions)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildCity(trafficCache);
+  auto & graph = worldGraph->GetIndexGraphForTests(kTestNumMwmId);
+  auto const overlay = MakeOverlay(graph);
+
+  TEST_EQUAL(overlay.GetLevelsCount(), 2, ());
+  TEST_EQUAL(overlay.GetNumJoints(), kCitySize * kCitySize, ());
+  // Every street and avenue crosses 3 borders of the leaf cells, the one-way street is crossed in one direction.
+  TEST_EQUAL(overlay.GetTransitionsCount(), (2 * kCitySize - 1) * 3 * 2 + 3, ());
+
+  // Avenue 2 goes from cell 0 to cell 1 between (2, 1) and (2, 2).
+  auto const id = overlay.GetTransitionId(Segment(kTestNumMwmId, kCitySize + 2, 1, true /* forward */));
+  TEST_NOT_EQUAL(id, CellOverlay::kNoTransition, ());
+  TEST_EQUAL(overlay.GetTransition(id).m_fromCell, 2, ());
+  TEST_EQUAL(overlay.GetTransition(id).m_toCell, 3, ());
+  TEST_EQUAL(overlay.GetSegment(id), Segment(kTestNumMwmId, kCitySize + 2, 1, true /* forward */), ());
+
+  TEST_EQUAL(overlay.GetTransitionId(Segment(kTestNumMwmId, kCitySize + 2, 0, true /* forward */)),
+             CellOverlay::kNoTransition, ());
+  TEST_EQUAL(overlay.GetTransitionId(Segment(kTestNumMwmId, 3, 1, false /* forward */)), CellOverlay::kNoTransition,
+             ());
+}
+
+UNIT_TEST(CellOverlay_FindRoute)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildCity(trafficCache);
+  auto & graph = worldGraph->GetIndexGraphForTests(kTestNumMwmId);
+  auto overlay = MakeOverlay(graph);
+  overlay.Customize(graph);
+
+  vector<FakeEnding> endings;
+  for (uint32_t featureId = 0; featureId < 2 * kCitySize; featureId += 3)
+  {
+    for (uint32_t segmentIdx = 0; segmentIdx + 1 < kCitySize; segmentIdx += 2)
+    {
+      double const offset = (0.5 + segmentIdx) / 100.0;
+      double const road = static_cast<double>(featureId % kCitySize) / 100.0;
+      m2::PointD const point = featureId < kCitySize ? m2::PointD(offset, road) : m2::PointD(road, offset);
+      endings.push_back(MakeFakeEnding(featureId, segmentIdx, point, *worldGraph));
+    }
+  }
+
+  base::Cancellable const cancellable;
+  for (auto const & start : endings)
+  {
+    for (auto const & finish : endings)
+    {
+      auto starter = MakeStarter(start, finish, *worldGraph);
+      vector<Segment> route;
+      double timeSec = 0.0;
+      TEST_EQUAL(CalculateRoute(*starter, route, timeSec), AlgorithmForWorldGraph::Result::OK, ());
+      // Weight of an edge is the weight of its target segment.
+      double expectedWeight = 0.0;
+      for (size_t i = 1; i < route.size(); ++i)
+        expectedWeight += starter->CalcSegmentWeight(route[i], EdgeEstimator::Purpose::Weight).GetWeight();
+
+      vector<Segment> waypoints;
+      double weight = 0.0;
+      TEST(overlay.FindRoute(*starter, cancellable, waypoints, weight), ());
+      TEST_ALMOST_EQUAL_ABS(weight, expectedWeight, 1e-6 + expectedWeight * 1e-5, (route, waypoints));
+      TEST_GREATER_OR_EQUAL(waypoints.size(), 2, ());
+      TEST_EQUAL(waypoints.front(), starter->GetStartSegment(), ());
+      TEST_EQUAL(waypoints.back(), starter->GetFinishSegment(), ());
+      for (size_t i = 1; i + 1 < waypoints.size(); ++i)
+        TEST_NOT_EQUAL(overlay.GetTransitionId(waypoints[i]), CellOverlay::kNoTransition, (waypoints));
+    }
+  }
+}
+
+UNIT_TEST(CellOverlay_Serialization)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildCity(trafficCache);
+  auto & graph = worldGraph->GetIndexGraphForTests(kTestNumMwmId);
+  auto overlay = MakeOverlay(graph);
+  overlay.Customize(graph);
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    overlay.Serialize(writer);
+  }
+
+  CellOverlay deserialized;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    deserialized.Deserialize(src);
+    TEST_EQUAL(src.Size(), 0, ());
+  }
+
+  TEST_EQUAL(deserialized.GetLevelsCount(), overlay.GetLevelsCount(), ());
+  TEST_EQUAL(deserialized.GetNumJoints(), overlay.GetNumJoints(), ());
+  for (uint32_t id = 0; id < overlay.GetTransitionsCount(); ++id)
+  {
+    deserialized.SetMwmId(kTestNumMwmId);
+    TEST_EQUAL(deserialized.GetSegment(id), overlay.GetSegment(id), ());
+    TEST_EQUAL(deserialized.GetTransition(id).m_toCell, overlay.GetTransition(id).m_toCell, ());
+  }
+  // Weights are rounded to deciseconds.
+  TestEqualWeights(overlay, deserialized, 0.05 + 1e-3);
+}
+
+UNIT_TEST(CellOverlay_CustomizeFeatures)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildCity(trafficCache);
+  auto & graph = worldGraph->GetIndexGraphForTests(kTestNumMwmId);
+  auto overlay = MakeOverlay(graph);
+  overlay.Customize(graph);
+
+  // Only the cells of street 0 are customized.
+  auto partial = MakeOverlay(graph);
+  partial.CustomizeFeatures(graph, {0});
+  uint32_t const enter = partial.GetTransitionId(Segment(kTestNumMwmId, 0, 1, true /* forward */));
+  uint32_t const exit = partial.GetTransitionId(Segment(kTestNumMwmId, 0, 3, true /* forward */));
+  uint32_t const farEnter = partial.GetTransitionId(Segment(kTestNumMwmId, 7, 1, true /* forward */));
+  uint32_t const farExit = partial.GetTransitionId(Segment(kTestNumMwmId, 7, 3, true /* forward */));
+  TEST_NOT_EQUAL(partial.GetWeight(0 /* level */, enter, exit), CellOverlay::kNoWeight, ());
+  TEST_EQUAL(partial.GetWeight(0 /* level */, farEnter, farExit), CellOverlay::kNoWeight, ());
+
+  vector<uint32_t> featureIds;
+  for (uint32_t featureId = 0; featureId < 2 * kCitySize; ++featureId)
+    featureIds.push_back(featureId);
+  partial.CustomizeFeatures(graph, featureIds);
+  TestEqualWeights(overlay, partial, 1e-6);
+}
+}  // namespace cell_overlay_tests
@@ -0,0 +1,107 @@
+#include "testing/testing.hpp"
+
+#include "routing/landmarks.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <vector>
+
+namespace landmarks_tests
+{
+using namespace routing;
+using namespace std;
+
+LandmarkWeights MakeWeights(vector<double> const & from, vector<double> const & to, double precisionSec = 0.0)
+{
+  TEST_EQUAL(from.size(), to.size(), ());
+  LandmarkWeights weights;
+  weights.Init(from.size(), precisionSec);
+  for (size_t i = 0; i < from.size(); ++i)
+  {
+    weights.m_from[i] = from[i];
+    weights.m_to[i] = to[i];
+  }
+  return weights;
+}
+
+UNIT_TEST(Landmarks_Serialization)
+{
+  uint16_t constexpr kNo = Landmarks::kNoWeight;
+  // Two landmarks and three joints, weights are in 2 seconds units.
+  Landmarks const landmarks({2, 0}, 3 /* numJoints */, 20 /* precisionDs */, {5, 10, 0, kNo, 10, 0},
+                            {7, 3, kNo, 8, 0, 1});
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    landmarks.Serialize(writer);
+  }
+
+  Landmarks deserialized;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    deserialized.Deserialize(src);
+    TEST_EQUAL(src.Size(), 0, ());
+  }
+
+  TEST_EQUAL(deserialized.GetCount(), 2, ());
+  TEST_EQUAL(deserialized.GetNumJoints(), 3, ());
+  TEST_EQUAL(deserialized.GetLandmarks(), vector<Joint::Id>({2, 0}), ());
+
+  LandmarkWeights weights;
+  deserialized.GetWeights(1 /* jointId */, weights);
+  TEST_EQUAL(weights.m_count, 2, ());
+  TEST_ALMOST_EQUAL_ABS(weights.m_precisionSec, 2.0, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(weights.m_from[0], 0.0, 1e-9, ());
+  TEST_EQUAL(weights.m_from[1], LandmarkWeights::kNoWeight, ());
+  TEST_EQUAL(weights.m_to[0], LandmarkWeights::kNoWeight, ());
+  TEST_ALMOST_EQUAL_ABS(weights.m_to[1], 16.0, 1e-9, ());
+
+  // Weights of unknown joints are unknown.
+  deserialized.GetWeights(3 /* jointId */, weights);
+  TEST_EQUAL(weights.m_from[0], LandmarkWeights::kNoWeight, ());
+  TEST_EQUAL(weights.m_to[1], LandmarkWeights::kNoWeight, ());
+}
+
+UNIT_TEST(Landmarks_LowerBound)
+{
+  double constexpr kNo = LandmarkWeights::kNoWeight;
+
+  // d(L0, v) - d(L0, u) = 70 and d(u, L1) - d(v, L1) = 40.
+  TEST_ALMOST_EQUAL_ABS(GetLowerBound(MakeWeights({10, 100}, {50, 60}), MakeWeights({80, 120}, {70, 20})), 70.0, 1e-9,
+                        ());
+  // The bound is directed.
+  TEST_ALMOST_EQUAL_ABS(GetLowerBound(MakeWeights({80, 120}, {70, 20}), MakeWeights({10, 100}, {50, 60})), 20.0, 1e-9,
+                        ());
+  // Unknown weights are skipped.
+  TEST_ALMOST_EQUAL_ABS(GetLowerBound(MakeWeights({kNo, 100}, {50, kNo}), MakeWeights({80, 120}, {70, 20})), 20.0,
+                        1e-9, ());
+  // Precision of the weights is subtracted and the bound is not negative.
+  TEST_ALMOST_EQUAL_ABS(GetLowerBound(MakeWeights({10}, {50}, 2.0), MakeWeights({80}, {70}, 1.0)), 68.0, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(GetLowerBound(MakeWeights({10}, {10}, 2.0), MakeWeights({11}, {10})), 0.0, 1e-9, ());
+  // Weights of different mwms are not comparable.
+  TEST_ALMOST_EQUAL_ABS(GetLowerBound(MakeWeights({10}, {50}), MakeWeights({80, 90}, {70, 20})), 0.0, 1e-9, ());
+}
+
+UNIT_TEST(Landmarks_Unite)
+{
+  double constexpr kNo = LandmarkWeights::kNoWeight;
+
+  auto source = MakeWeights({10, kNo}, {50, 30}, 1.0);
+  source.Unite(MakeWeights({20, 5}, {kNo, 40}, 2.0), true /* isSource */);
+  TEST_ALMOST_EQUAL_ABS(source.m_from[0], 20.0, 1e-9, ());
+  TEST_EQUAL(source.m_from[1], kNo, ());
+  TEST_ALMOST_EQUAL_ABS(source.m_to[0], 50.0, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(source.m_to[1], 30.0, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(source.m_precisionSec, 2.0, 1e-9, ());
+
+  auto target = MakeWeights({10, kNo}, {50, 30});
+  target.Unite(MakeWeights({20, 5}, {kNo, 40}), false /* isSource */);
+  TEST_ALMOST_EQUAL_ABS(target.m_from[0], 10.0, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(target.m_from[1], 5.0, 1e-9, ());
+  TEST_EQUAL(target.m_to[0], kNo, ());
+  TEST_ALMOST_EQUAL_ABS(target.m_to[1], 40.0, 1e-9, ());
+}
+}  // namespace landmarks_tests
@@ -0,0 +1,172 @@
+#include "testing/testing.hpp"
+
+#include "routing/geometry.hpp"
+#include "routing/road_geometry_cache.hpp"
+
+#include "routing_common/maxspeed_conversion.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace road_geometry_cache_test
+{
+using namespace routing;
+
+class CountingLoader
+{
+public:
+  RoadGeometryCache::Loader Get()
+  {
+    return [this](uint32_t featureId, RoadGeometry & road)
+    {
+      ++m_loads;
+      // The first point keeps the feature id to check that the right road is returned.
+      RoadGeometry::Points const points = {{featureId * 1e-3, 0.0}, {0.0, 1.0}};
+      road = RoadGeometry(false /* oneWay */, Maxspeed(measurement_utils::Units::Metric, 60, kInvalidSpeed), points);
+    };
+  }
+
+  size_t m_loads = 0;
+};
+
+bool IsRoadOf(RoadGeometry const & road, uint32_t featureId)
+{
+  return road.GetPointsCount() == 2 &&
+         AlmostEqualAbs(road.GetPoint(0).m_lon, featureId * 1e-3, 1e-6);
+}
+
+size_t GetRoadBytes()
+{
+  RoadGeometryCache cache(1 << 20);
+  CountingLoader loader;
+  cache.GetRoad(0 /* mwmIdx */, 0 /* featureId */, loader.Get());
+  return cache.GetMemorySize();
+}
+
+UNIT_TEST(RoadGeometryCache_HitsAndMisses)
+{
+  RoadGeometryCache cache(1 << 20);
+  CountingLoader loader;
+
+  TEST(IsRoadOf(cache.GetRoad(0 /* mwmIdx */, 1 /* featureId */, loader.Get()), 1), ());
+  TEST(IsRoadOf(cache.GetRoad(0 /* mwmIdx */, 2 /* featureId */, loader.Get()), 2), ());
+  TEST(IsRoadOf(cache.GetRoad(0 /* mwmIdx */, 1 /* featureId */, loader.Get()), 1), ());
+  // The same feature id of another mwm is another road.
+  TEST(IsRoadOf(cache.GetRoad(1 /* mwmIdx */, 1 /* featureId */, loader.Get()), 1), ());
+
+  TEST_EQUAL(loader.m_loads, 3, ());
+  TEST_EQUAL(cache.GetSize(), 3, ());
+  TEST_EQUAL(cache.GetStats().m_hits, 1, ());
+  TEST_EQUAL(cache.GetStats().m_misses, 3, ());
+  TEST_EQUAL(cache.GetStats().m_evictions, 0, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  TEST_EQUAL(cache.GetMemorySize(), 0, ());
+}
+
+UNIT_TEST(RoadGeometryCache_MemoryLimit)
+{
+  size_t const roadBytes = GetRoadBytes();
+  RoadGeometryCache cache(10 * roadBytes);
+  CountingLoader loader;
+
+  for (uint32_t featureId = 0; featureId < 100; ++featureId)
+  {
+    TEST(IsRoadOf(cache.GetRoad(0 /* mwmIdx */, featureId, loader.Get()), featureId), ());
+    TEST_LESS_OR_EQUAL(cache.GetMemorySize(), 10 * roadBytes, ());
+  }
+
+  TEST_EQUAL(cache.GetSize(), 10, ());
+  TEST_EQUAL(cache.GetStats().m_evictions, 90, ());
+
+  // The most recent roads are kept.
+  for (uint32_t featureId = 90; featureId < 100; ++featureId)
+    cache.GetRoad(0 /* mwmIdx */, featureId, loader.Get());
+  TEST_EQUAL(loader.m_loads, 100, ());
+}
+
+UNIT_TEST(RoadGeometryCache_ScanResistance)
+{
+  size_t const roadBytes = GetRoadBytes();
+  RoadGeometryCache cache(10 * roadBytes);
+  CountingLoader loader;
+
+  // Roads which are used twice get into the protected segment.
+  std::vector<uint32_t> const hotRoads = {1, 2, 3, 4, 5};
+  for (size_t i = 0; i < 2; ++i)
+  {
+    for (auto const featureId : hotRoads)
+      cache.GetRoad(0 /* mwmIdx */, featureId, loader.Get());
+  }
+  TEST_EQUAL(loader.m_loads, hotRoads.size(), ());
+
+  // A long scan of roads which are used once.
+  for (uint32_t featureId = 100; featureId < 1000; ++featureId)
+    cache.GetRoad(0 /* mwmIdx */, featureId, loader.Get());
+
+  size_t const loads = loader.m_loads;
+  for (auto const featureId : hotRoads)
+    TEST(IsRoadOf(cache.GetRoad(0 /* mwmIdx */, featureId, loader.Get()), featureId), ());
+  TEST_EQUAL(loader.m_loads, loads, ("Hot roads were evicted by the scan."));
+}
+
+class TestMwmInfo : public MwmInfo
+{
+public:
+  TestMwmInfo() { SetStatus(MwmInfo::STATUS_REGISTERED); }
+
+  void Deregister() { SetStatus(MwmInfo::STATUS_DEREGISTERED); }
+};
+
+UNIT_TEST(RoadGeometryCache_LimitOfMwms)
+{
+  size_t const roadBytes = GetRoadBytes();
+  RoadGeometryCache cache(10 * roadBytes /* mwmMaxBytes */, 25 * roadBytes /* maxBytes */);
+  TEST_EQUAL(cache.GetMaxMemorySize(), 10 * roadBytes, ());
+
+  std::vector<std::shared_ptr<TestMwmInfo>> infos;
+  std::vector<uint32_t> mwmIdxs;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    infos.push_back(std::make_shared<TestMwmInfo>());
+    mwmIdxs.push_back(cache.GetMwmIndex(MwmSet::MwmId(infos.back())));
+  }
+  TEST_EQUAL(cache.GetMaxMemorySize(), 25 * roadBytes, ());
+
+  CountingLoader loader;
+  for (auto const mwmIdx : mwmIdxs)
+  {
+    for (uint32_t featureId = 0; featureId < 10; ++featureId)
+      cache.GetRoad(mwmIdx, featureId, loader.Get());
+  }
+  TEST_EQUAL(cache.GetSize(), 25, ());
+  TEST_EQUAL(cache.GetStats().m_evictions, 5, ());
+
+  // Roads of a deregistered mwm are dropped and the limit goes down.
+  infos[0]->Deregister();
+  infos[1]->Deregister();
+  TEST_EQUAL(cache.GetMwmIndex(MwmSet::MwmId(infos[2])), mwmIdxs[2], ());
+  TEST_EQUAL(cache.GetMaxMemorySize(), 10 * roadBytes, ());
+  TEST_LESS_OR_EQUAL(cache.GetMemorySize(), 10 * roadBytes, ());
+  // Dropped roads are not evicted ones.
+  TEST_EQUAL(cache.GetStats().m_evictions, 5, ());
+}
+
+UNIT_TEST(RoadGeometryCache_LastRoadIsKept)
+{
+  size_t const roadBytes = GetRoadBytes();
+  // The limit is less than one road, but the road which has just been loaded is never evicted.
+  RoadGeometryCache cache(roadBytes / 2);
+  CountingLoader loader;
+
+  for (uint32_t featureId = 0; featureId < 10; ++featureId)
+  {
+    TEST(IsRoadOf(cache.GetRoad(0 /* mwmIdx */, featureId, loader.Get()), featureId), ());
+    TEST_EQUAL(cache.GetSize(), 1, ());
+  }
+}
+}  // namespace road_geometry_cache_test
@@ -0,0 +1,96 @@
+#include "testing/testing.hpp"
+
+#include "routing/index_graph.hpp"
+#include "routing/joint.hpp"
+#include "routing/shared_routing_data.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace shared_routing_data_test
+{
+using namespace routing;
+using namespace std;
+
+SharedRoutingData::GraphData MakeGraphData()
+{
+  Joint joint;
+  joint.AddPoint({0 /* feature id */, 1 /* point id */});
+  joint.AddPoint({1 /* feature id */, 0 /* point id */});
+
+  IndexGraph graph;
+  graph.Import({joint});
+  return {graph.GetTopology(), nullptr /* landmarks */};
+}
+
+UNIT_TEST(SharedRoutingData_LoadsOnce)
+{
+  MwmSet::MwmId const mwm1(make_shared<MwmInfo>());
+  MwmSet::MwmId const mwm2(make_shared<MwmInfo>());
+
+  SharedRoutingData sharedData;
+  atomic<size_t> loads = 0;
+  auto const loader = [&loads]()
+  {
+    ++loads;
+    return MakeGraphData();
+  };
+
+  size_t constexpr kThreadsCount = 8;
+  vector<SharedRoutingData::GraphData> results(kThreadsCount);
+  vector<thread> threads;
+  for (size_t i = 0; i < kThreadsCount; ++i)
+    threads.emplace_back([&, i]() { results[i] = sharedData.GetGraphData(mwm1, VehicleType::Car, loader); });
+  for (auto & t : threads)
+    t.join();
+
+  TEST_EQUAL(loads, 1, ());
+  for (auto const & result : results)
+  {
+    TEST_EQUAL(result.m_topology, results.front().m_topology, ());
+    TEST_EQUAL(result.m_topology->m_jointIndex.GetNumJoints(), 1, ());
+  }
+
+  // Other mwms and vehicle types have their own graphs.
+  TEST_NOT_EQUAL(sharedData.GetGraphData(mwm2, VehicleType::Car, loader).m_topology, results.front().m_topology, ());
+  TEST_NOT_EQUAL(sharedData.GetGraphData(mwm1, VehicleType::Bicycle, loader).m_topology, results.front().m_topology,
+                 ());
+  TEST_EQUAL(loads, 3, ());
+
+  auto const stats = sharedData.GetStats();
+  TEST_EQUAL(stats.m_misses, 3, ());
+  TEST_EQUAL(stats.m_hits, kThreadsCount - 1, ());
+  TEST_EQUAL(stats.m_graphs, 3, ());
+}
+
+UNIT_TEST(SharedRoutingData_LoaderThrows)
+{
+  MwmSet::MwmId const mwm(make_shared<MwmInfo>());
+
+  SharedRoutingData sharedData;
+  TEST_ANY_THROW(sharedData.GetGraphData(mwm, VehicleType::Car,
+                                         []() -> SharedRoutingData::GraphData { throw runtime_error("No section"); }),
+                 ());
+
+  // The failed graph is loaded again on the next request.
+  auto const data = sharedData.GetGraphData(mwm, VehicleType::Car, &MakeGraphData);
+  TEST(data.m_topology, ());
+  TEST_EQUAL(sharedData.GetStats().m_misses, 1, ());
+}
+
+UNIT_TEST(IndexGraph_SharedTopology)
+{
+  auto const data = MakeGraphData();
+
+  IndexGraph graph;
+  graph.SetTopology(data.m_topology);
+  TEST_EQUAL(graph.GetNumJoints(), 1, ());
+  TEST_EQUAL(graph.GetJointId({0 /* feature id */, 1 /* point id */}), 0, ());
+  TEST_EQUAL(graph.GetJointId({1 /* feature id */, 0 /* point id */}), 0, ());
+}
+}  // namespace shared_routing_data_test
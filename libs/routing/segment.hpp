@@ -1,5 +1,7 @@
 #pragma once
 
+#include "routing/base/astar_dense_key.hpp"
+
 #include "routing/road_point.hpp"
 #include "routing/route_weight.hpp"
 
@@ -85,6 +87,27 @@ private:
 
 std::string DebugPrint(Segment const & segment);
 std::string DebugPrint(SegmentEdge const & edge);
+
+namespace astar
+{
+template <>
+struct DenseKeyTraits<Segment>
+{
+  static bool constexpr kSupported = true;
+
+  static bool Get(Segment const & segment, DenseKey & key)
+  {
+    if (segment.GetMwmId() == kFakeNumMwmId)
+      return false;
+
+    key.m_mwmId = segment.GetMwmId();
+    key.m_featureId = segment.GetFeatureId();
+    key.m_index = 2 * segment.GetSegmentIdx() + (segment.IsForward() ? 1 : 0);
+    key.m_check = 0;
+    return true;
+  }
+};
+}  // namespace astar
 }  // namespace routing
 
 namespace std
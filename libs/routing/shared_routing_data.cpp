@@ -0,0 +1,64 @@
+#include "routing/shared_routing_data.hpp"
+
+#include "base/assert.hpp"
+
+#include <sstream>
+
+namespace routing
+{
+SharedRoutingData::GraphData SharedRoutingData::GetGraphData(MwmSet::MwmId const & mwmId, VehicleType vehicleType,
+                                                             Loader const & loader)
+{
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto & ptr = m_entries[Key(mwmId, vehicleType)];
+    if (!ptr)
+      ptr = std::make_shared<Entry>();
+    entry = ptr;
+  }
+
+  // Graphs of different mwms are loaded in parallel, so the entry is locked, not the whole cache.
+  std::lock_guard<std::mutex> lock(entry->m_mutex);
+  if (entry->m_loaded)
+  {
+    std::lock_guard<std::mutex> statsLock(m_mutex);
+    ++m_stats.m_hits;
+    return entry->m_data;
+  }
+
+  entry->m_data = loader();
+  CHECK(entry->m_data.m_topology, ());
+  entry->m_loaded = true;
+
+  std::lock_guard<std::mutex> statsLock(m_mutex);
+  ++m_stats.m_misses;
+  return entry->m_data;
+}
+
+void SharedRoutingData::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_stats = {};
+}
+
+SharedRoutingData::Stats SharedRoutingData::GetStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Stats stats = m_stats;
+  stats.m_graphs = m_entries.size();
+  return stats;
+}
+
+std::string DebugPrint(SharedRoutingData::Stats const & stats)
+{
+  std::ostringstream os;
+  os << "SharedRoutingData::Stats [";
+  os << "hits: " << stats.m_hits << ", ";
+  os << "misses: " << stats.m_misses << ", ";
+  os << "graphs: " << stats.m_graphs;
+  os << "]";
+  return os.str();
+}
+}  // namespace routing
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "routing/index_graph.hpp"
+#include "routing/landmarks.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace routing
+{
+/// \brief Read-only routing data of mwms shared by routers working in different threads,
+/// e.g. by the routers of routes_builder_tool. Every router still has its own road geometry cache,
+/// road access and cross-mwm connectors, but the joints, the restrictions and the landmarks
+/// of an mwm are loaded once and are not copied per router.
+/// \note This class is thread-safe.
+class SharedRoutingData
+{
+public:
+  struct GraphData
+  {
+    std::shared_ptr<IndexGraph::Topology> m_topology;
+    std::shared_ptr<Landmarks> m_landmarks;
+  };
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    size_t m_graphs = 0;
+  };
+
+  using Loader = std::function<GraphData()>;
+
+  /// \returns the data of the graph of |mwmId| for |vehicleType|. The data is loaded by |loader|
+  /// on the first request, concurrent requests of the same graph wait for it.
+  /// \note If |loader| throws, the exception is passed to the caller and the next request loads the data again.
+  GraphData GetGraphData(MwmSet::MwmId const & mwmId, VehicleType vehicleType, Loader const & loader);
+
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  struct Entry
+  {
+    std::mutex m_mutex;
+    bool m_loaded = false;
+    GraphData m_data;
+  };
+
+  using Key = std::pair<MwmSet::MwmId, VehicleType>;
+
+  mutable std::mutex m_mutex;
+  std::map<Key, std::shared_ptr<Entry>> m_entries;
+  Stats m_stats;
+};
+
+std::string DebugPrint(SharedRoutingData::Stats const & stats);
+}  // namespace routing
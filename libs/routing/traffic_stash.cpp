@@ -41,6 +41,12 @@ bool TrafficStash::Has(NumMwmId numMwmId) const
   return m_mwmToTraffic.find(numMwmId) != m_mwmToTraffic.cend();
 }
 
+std::shared_ptr<traffic::TrafficInfo::Coloring const> TrafficStash::GetColoring(NumMwmId numMwmId) const
+{
+  auto const it = m_mwmToTraffic.find(numMwmId);
+  return it == m_mwmToTraffic.cend() ? nullptr : it->second;
+}
+
 void TrafficStash::CopyTraffic()
 {
   traffic::AllMwmTrafficInfo copy;
@@ -44,6 +44,8 @@ public:
   traffic::SpeedGroup GetSpeedGroup(Segment const & segment) const;
   void SetColoring(NumMwmId numMwmId, std::shared_ptr<traffic::TrafficInfo::Coloring const> coloring);
   bool Has(NumMwmId numMwmId) const;
+  /// \returns traffic of the mwm or nullptr if there is no traffic.
+  std::shared_ptr<traffic::TrafficInfo::Coloring const> GetColoring(NumMwmId numMwmId) const;
 
 private:
   void CopyTraffic();
@@ -58,6 +58,18 @@ public:
 
   void SetRegionsGraphMode(bool isRegionsGraphMode) { m_isRegionsGraphMode = isRegionsGraphMode; }
 
+  /// \brief When set, A* keeps vertex states in flat per-mwm arrays (astar::DenseVertexMap)
+  /// which are much more cache friendly than hash maps on long routes.
+  bool IsDenseAStarState() const { return m_isDenseAStarState; }
+
+  void SetDenseAStarState(bool isDenseAStarState) { m_isDenseAStarState = isDenseAStarState; }
+
+  /// \brief When set, the A* heuristic is made stronger with landmark weights (see routing::Landmarks)
+  /// of mwms which have them.
+  bool IsLandmarksHeuristic() const { return m_isLandmarksHeuristic; }
+
+  void SetLandmarksHeuristic(bool isLandmarksHeuristic) { m_isLandmarksHeuristic = isLandmarksHeuristic; }
+
   void GetEdgeList(Segment const & vertex, bool isOutgoing, bool useRoutingOptions, SegmentEdgeListT & edges);
 
   // Checks whether path length meets restrictions. Restrictions may depend on the distance from
@@ -124,6 +136,8 @@ protected:
   void GetTwins(Segment const & segment, bool isOutgoing, bool useRoutingOptions, SegmentEdgeListT & edges);
 
   bool m_isRegionsGraphMode = false;
+  bool m_isDenseAStarState = false;
+  bool m_isLandmarksHeuristic = false;
 };
 
 std::string DebugPrint(WorldGraphMode mode);
@@ -121,4 +121,31 @@ uint64_t CBV::Hash() const
     return kModulo;
   return coding::CompressedBitVectorHasher::Hash(*m_p) % kModulo;
 }
+
+uint64_t CBV::GetSizeBytes() const
+{
+  if (IsEmpty() || IsFull())
+    return 0;
+
+  switch (m_p->GetStorageStrategy())
+  {
+  case coding::CompressedBitVector::StorageStrategy::Dense:
+    return static_cast<coding::DenseCBV const &>(*m_p).NumBitGroups() * sizeof(uint64_t);
+  case coding::CompressedBitVector::StorageStrategy::Sparse:
+    return m_p->PopCount() * sizeof(uint64_t);
+  case coding::CompressedBitVector::StorageStrategy::Roaring:
+  {
+    auto const & roaring = static_cast<coding::RoaringCBV const &>(*m_p);
+    uint64_t size = 0;
+    for (size_t i = 0; i < roaring.NumContainers(); ++i)
+    {
+      auto const & container = roaring.GetContainer(i);
+      size += sizeof(container) + container.m_values.size() * sizeof(uint16_t) +
+              container.m_bitmap.size() * sizeof(uint64_t);
+    }
+    return size;
+  }
+  }
+  UNREACHABLE();
+}
 }  // namespace search
@@ -49,6 +49,9 @@ public:
 
   uint64_t Hash() const;
 
+  // Returns an estimate of the memory used by the bit vector.
+  uint64_t GetSizeBytes() const;
+
 private:
   explicit CBV(bool full);
 
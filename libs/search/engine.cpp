@@ -17,6 +17,8 @@ namespace search
 {
 namespace
 {
+uint64_t constexpr kRetrievalCacheSizeBytes = 32 * 1024 * 1024;
+
 class InitSuggestions
 {
   std::map<std::pair<strings::UniString, int8_t>, uint8_t> m_suggests;
@@ -76,7 +78,8 @@ Engine::Params::Params(std::string const & locale, size_t numThreads) : m_locale
 // Engine ------------------------------------------------------------------------------------------
 Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
                storage::CountryInfoGetter const & infoGetter, Params const & params)
-  : m_shutdown(false)
+  : m_retrievalCache(kRetrievalCacheSizeBytes)
+  , m_shutdown(false)
 {
   InitSuggestions doInit;
   categories.ForEachName(doInit);
@@ -85,7 +88,7 @@ Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
   m_contexts.resize(params.m_numThreads);
   for (size_t i = 0; i < params.m_numThreads; ++i)
   {
-    auto processor = std::make_unique<Processor>(dataSource, categories, m_suggests, infoGetter);
+    auto processor = std::make_unique<Processor>(dataSource, categories, m_suggests, infoGetter, m_retrievalCache);
     processor->SetPreferredLocale(params.m_locale);
     m_contexts[i].m_processor = std::move(processor);
   }
@@ -130,6 +133,12 @@ size_t Engine::GetNumThreads() const
 void Engine::ClearCaches()
 {
   PostMessage(Message::TYPE_BROADCAST, [](Processor & processor) { processor.ClearCaches(); });
+  m_retrievalCache.Clear();
+}
+
+RetrievalCache::Stats Engine::GetRetrievalCacheStats() const
+{
+  return m_retrievalCache.GetStats();
 }
 
 void Engine::InitAfterWorldLoaded()
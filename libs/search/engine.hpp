@@ -1,5 +1,6 @@
 #pragma once
 
+#include "search/retrieval_cache.hpp"
 #include "search/search_params.hpp"
 #include "search/suggest.hpp"
 
@@ -99,6 +100,9 @@ public:
   // Posts request to clear caches to the queue.
   void ClearCaches();
 
+  // Returns statistics of the retrieval cache shared by all processors.
+  RetrievalCache::Stats GetRetrievalCacheStats() const;
+
   void InitAfterWorldLoaded();
 
   // Posts request to load countries tree.
@@ -166,6 +170,8 @@ private:
 
   std::vector<Suggest> m_suggests;
 
+  RetrievalCache m_retrievalCache;
+
   bool m_shutdown;
   std::mutex m_mu;
   std::condition_variable m_cv;
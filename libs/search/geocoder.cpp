@@ -13,10 +13,13 @@
 #include "search/tracer.hpp"
 #include "search/utils.hpp"
 
+#include "editor/osm_editor.hpp"
+
 #include "storage/country_info_getter.hpp"
 
 #include "indexer/data_source.hpp"
 #include "indexer/feature_decl.hpp"
+#include "indexer/feature_source.hpp"
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/postcodes_matcher.hpp"
 #include "indexer/rank_table.hpp"
@@ -36,8 +39,12 @@
 #include "base/macros.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <future>
 
 #include "defines.hpp"
 
@@ -71,6 +78,17 @@ size_t constexpr kPostcodesRectsCacheSize = 10;
 size_t constexpr kSuburbsRectsCacheSize = 10;
 size_t constexpr kLocalityRectsCacheSize = 10;
 
+// Retrieval merges the edited features into the search index results, so the results for the mwms
+// with edits are not cached: they would become stale after the next edit.
+bool HasEdits(MwmSet::MwmId const & id)
+{
+  auto const & editor = osm::Editor::Instance();
+  for (auto const status : {FeatureStatus::Created, FeatureStatus::Modified, FeatureStatus::Deleted})
+    if (!editor.GetFeaturesByStatus(id, status).empty())
+      return true;
+  return false;
+}
+
 struct ScopedMarkTokens
 {
   static BaseContext::TokenType constexpr kUnused = BaseContext::TOKEN_TYPE_COUNT;
@@ -316,13 +334,15 @@ void Geocoder::LocalitiesCaches::Clear()
 // Geocoder::Geocoder ------------------------------------------------------------------------------
 Geocoder::Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
                    CategoriesHolder const & categories, CitiesBoundariesTable const & citiesBoundaries,
-                   PreRanker & preRanker, LocalitiesCaches & localitiesCaches, base::Cancellable const & cancellable)
+                   PreRanker & preRanker, LocalitiesCaches & localitiesCaches, RetrievalCache & retrievalCache,
+                   base::Cancellable const & cancellable)
   : m_dataSource(dataSource)
   , m_infoGetter(infoGetter)
   , m_categories(categories)
   , m_streetsCache(cancellable)
   , m_suburbsCache(cancellable)
   , m_localitiesCaches(localitiesCaches)
+  , m_retrievalCache(retrievalCache)
   , m_hotelsCache(cancellable)
   , m_foodCache(cancellable)
   , m_cuisineFilter(m_foodCache)
@@ -360,8 +380,11 @@ void Geocoder::SetParams(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_retrievalKeys.clear();
   for (size_t i = 0; i < m_params.GetNumTokens(); ++i)
   {
+    m_retrievalKeys.push_back(RetrievalCache::MakeKey(m_params, i));
+
     if (!m_params.IsPrefixToken(i))
     {
       m_tokenRequests.emplace_back();
@@ -440,6 +463,7 @@ void Geocoder::SetParamsForCategorialSearch(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_retrievalKeys.clear();
 
   LOG(LDEBUG, (static_cast<QueryParams const &>(m_params)));
 }
@@ -560,12 +584,23 @@ void Geocoder::GoImpl(std::vector<MwmInfoPtr> const & infos, bool inViewport)
   // found.
   auto const infosWithType = OrderCountries(inViewport, infos);
 
+  if (m_params.m_threadsCount <= 1)
+  {
+    m_threadPool.reset();
+    m_threadPoolSize = 0;
+  }
+  else if (m_threadPoolSize != m_params.m_threadsCount)
+  {
+    m_threadPool = std::make_unique<base::ComputationalThreadPool>(m_params.m_threadsCount);
+    m_threadPoolSize = m_params.m_threadsCount;
+  }
+
   // MatchAroundPivot() should always be matched in mwms
   // intersecting with position and viewport.
-  auto processCountry = [&](std::unique_ptr<MwmContext> context, bool updatePreranker)
+  auto processCountry = [&](PreparedMwm && mwm, bool updatePreranker)
   {
-    ASSERT(context, ());
-    m_context = std::move(context);
+    ASSERT(mwm.m_context, ());
+    m_context = std::move(mwm.m_context);
 
     SCOPE_GUARD(cleanup, [&]()
     {
@@ -587,7 +622,7 @@ void Geocoder::GoImpl(std::vector<MwmInfoPtr> const & infos, bool inViewport)
     m_matcher->SetContext(m_context.get());
 
     BaseContext ctx;
-    InitBaseContext(ctx);
+    InitBaseContext(ctx, std::move(mwm.m_features));
 
     if (inViewport)
     {
@@ -632,31 +667,80 @@ void Geocoder::GoImpl(std::vector<MwmInfoPtr> const & infos, bool inViewport)
 
 void Geocoder::InitBaseContext(BaseContext & ctx)
 {
-  Retrieval retrieval(*m_context, m_cancellable);
+  InitBaseContext(ctx, RetrieveTokenFeatures(*m_context));
+}
+
+void Geocoder::InitBaseContext(BaseContext & ctx, std::vector<Retrieval::ExtendedFeatures> && features)
+{
+  ASSERT_EQUAL(features.size(), m_params.GetNumTokens(), ());
 
+  ctx.m_tokens.assign(m_params.GetNumTokens(), BaseContext::TOKEN_TYPE_COUNT);
+  ctx.m_features = std::move(features);
+  ctx.m_cuisineFilter = m_cuisineFilter.MakeScopedFilter(*m_context, m_params.m_cuisineTypes);
+}
+
+std::vector<Retrieval::ExtendedFeatures> Geocoder::RetrieveTokenFeatures(MwmContext const & context) const
+{
   size_t const numTokens = m_params.GetNumTokens();
-  ctx.m_tokens.assign(numTokens, BaseContext::TOKEN_TYPE_COUNT);
-  ctx.m_features.resize(numTokens);
+  std::vector<Retrieval::ExtendedFeatures> features(numTokens);
+  if (numTokens == 0)
+    return features;
+
+  if (m_params.IsCategorialRequest())
+  {
+    // Implementation-wise, the simplest way to match a feature by
+    // its category bypassing the matching by name is by using a CategoriesCache.
+    CategoriesCache cache(m_params.m_preferredTypes, m_cancellable);
+    auto const cbv = cache.Get(context);
+    for (auto & f : features)
+      f = Retrieval::ExtendedFeatures(cbv);
+    return features;
+  }
+
+  ASSERT_EQUAL(m_retrievalKeys.size(), numTokens, ());
+  bool const useCache = !HasEdits(context.GetId());
+
+  // The search index is opened only when some token is not cached.
+  std::optional<Retrieval> retrieval;
   for (size_t i = 0; i < numTokens; ++i)
   {
-    if (m_params.IsCategorialRequest())
+    if (useCache)
     {
-      // Implementation-wise, the simplest way to match a feature by
-      // its category bypassing the matching by name is by using a CategoriesCache.
-      CategoriesCache cache(m_params.m_preferredTypes, m_cancellable);
-      ctx.m_features[i] = Retrieval::ExtendedFeatures(cache.Get(*m_context));
-    }
-    else if (m_params.IsPrefixToken(i))
-    {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
+      if (auto cached = m_retrievalCache.Find(context.GetId(), m_retrievalKeys[i]))
+      {
+        features[i] = std::move(*cached);
+        continue;
+      }
     }
+
+    if (!retrieval)
+      retrieval.emplace(context, m_cancellable);
+
+    if (m_params.IsPrefixToken(i))
+      features[i] = retrieval->RetrieveAddressFeatures(m_prefixTokenRequest);
     else
-    {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
-    }
+      features[i] = retrieval->RetrieveAddressFeatures(m_tokenRequests[i]);
+
+    if (useCache)
+      m_retrievalCache.Add(context.GetId(), m_retrievalKeys[i], features[i]);
   }
+  return features;
+}
 
-  ctx.m_cuisineFilter = m_cuisineFilter.MakeScopedFilter(*m_context, m_params.m_cuisineTypes);
+Geocoder::PreparedMwm Geocoder::PrepareMwm(ExtendedMwmInfos::ExtendedMwmInfo const & info) const
+{
+  PreparedMwm mwm;
+
+  auto handle = m_dataSource.GetMwmHandleById(MwmSet::MwmId(info.m_info));
+  if (!handle.IsAlive())
+    return mwm;
+  auto & value = *handle.GetValue();
+  if (!value.HasSearchIndex() || !value.HasGeometryIndex())
+    return mwm;
+
+  mwm.m_context = std::make_unique<MwmContext>(std::move(handle), info.m_type);
+  mwm.m_features = RetrieveTokenFeatures(*mwm.m_context);
+  return mwm;
 }
 
 void Geocoder::InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer)
@@ -864,6 +948,7 @@ bool Geocoder::CityHasPostcode(BaseContext const & ctx) const
 template <typename Fn>
 void Geocoder::ForEachCountry(ExtendedMwmInfos const & extendedInfos, Fn && fn)
 {
+  std::vector<size_t> indices;
   for (size_t i = 0; i < extendedInfos.m_infos.size(); ++i)
   {
     auto const & info = extendedInfos.m_infos[i].m_info;
@@ -871,16 +956,51 @@ void Geocoder::ForEachCountry(ExtendedMwmInfos const & extendedInfos, Fn && fn)
       continue;
     if (info->GetType() == MwmInfo::COUNTRY && m_params.m_mode == Mode::Downloader)
       continue;
+    indices.push_back(i);
+  }
 
-    auto handle = m_dataSource.GetMwmHandleById(MwmSet::MwmId(info));
-    if (!handle.IsAlive())
-      continue;
-    auto & value = *handle.GetValue();
-    if (!value.HasSearchIndex() || !value.HasGeometryIndex())
-      continue;
+  auto const process = [&](size_t i, PreparedMwm && mwm)
+  {
+    if (!mwm.m_context)
+      return base::ControlFlow::Continue;
     bool const updatePreranker = i + 1 >= extendedInfos.m_firstBatchSize;
-    auto const & mwmType = extendedInfos.m_infos[i].m_type;
-    if (fn(std::make_unique<MwmContext>(std::move(handle), mwmType), updatePreranker) == base::ControlFlow::Break)
+    return fn(std::move(mwm), updatePreranker);
+  };
+
+  if (!m_threadPool)
+  {
+    for (auto const i : indices)
+      if (process(i, PrepareMwm(extendedInfos.m_infos[i])) == base::ControlFlow::Break)
+        break;
+    return;
+  }
+
+  // Up to |m_threadsCount| mwms are prepared by the pool ahead of the one being matched.
+  // They are matched in the original order, so the results are the same as in the serial mode.
+  std::atomic<bool> stopped = false;
+  std::deque<std::future<PreparedMwm>> prepared;
+  SCOPE_GUARD(waitPrepared, [&]()
+  {
+    // Tasks refer to this method's locals, so they must complete before it returns.
+    stopped = true;
+    for (auto & f : prepared)
+      f.wait();
+  });
+
+  size_t next = 0;
+  for (auto const i : indices)
+  {
+    for (; next < indices.size() && prepared.size() < m_params.m_threadsCount; ++next)
+    {
+      auto const & info = extendedInfos.m_infos[indices[next]];
+      prepared.push_back(m_threadPool->Submit([this, &info, &stopped]()
+      { return stopped ? PreparedMwm() : PrepareMwm(info); }));
+    }
+
+    auto f = std::move(prepared.front());
+    prepared.pop_front();
+    // Rethrows CancelException from the pool.
+    if (process(i, f.get()) == base::ControlFlow::Break)
       break;
   }
 }
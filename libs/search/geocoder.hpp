@@ -17,6 +17,7 @@
 #include "search/mwm_context.hpp"
 #include "search/postcode_points.hpp"
 #include "search/query_params.hpp"
+#include "search/retrieval_cache.hpp"
 #include "search/streets_matcher.hpp"
 #include "search/token_range.hpp"
 #include "search/tracer.hpp"
@@ -39,6 +40,11 @@ class CategoriesHolder;
 class DataSource;
 class MwmValue;
 
+namespace base
+{
+class ComputationalThreadPool;
+}  // namespace base
+
 namespace storage
 {
 class CountryInfoGetter;
@@ -84,6 +90,11 @@ public:
     int m_scale = scales::GetUpperScale();
 
     bool m_useDebugInfo = false;  // Set to true for debug logs and tests.
+
+    // Number of threads used to retrieve features from mwms. When it's greater than one, mwms
+    // are prepared in parallel a few steps ahead, but are still matched one by one in the same
+    // order as with a single thread, so the results don't depend on it.
+    size_t m_threadsCount = 1;
   };
 
   struct LocalitiesCaches
@@ -99,7 +110,7 @@ public:
 
   Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
            CategoriesHolder const & categories, CitiesBoundariesTable const & citiesBoundaries, PreRanker & preRanker,
-           LocalitiesCaches & localitiesCaches, base::Cancellable const & cancellable);
+           LocalitiesCaches & localitiesCaches, RetrievalCache & retrievalCache, base::Cancellable const & cancellable);
   ~Geocoder();
 
   // Sets search query params.
@@ -155,6 +166,13 @@ private:
     size_t m_firstBatchSize = 0;
   };
 
+  // Mwm with features retrieved for every token of the query.
+  struct PreparedMwm
+  {
+    std::unique_ptr<MwmContext> m_context;
+    std::vector<Retrieval::ExtendedFeatures> m_features;
+  };
+
   struct Postcodes
   {
     void Clear()
@@ -191,6 +209,15 @@ private:
   // Creates a cache of posting lists corresponding to features in m_context
   // for each token and saves it to m_addressFeatures.
   void InitBaseContext(BaseContext & ctx);
+  void InitBaseContext(BaseContext & ctx, std::vector<Retrieval::ExtendedFeatures> && features);
+
+  // Retrieves features for every token of the query. Doesn't touch the state of Geocoder,
+  // so it may be called concurrently for different contexts.
+  std::vector<Retrieval::ExtendedFeatures> RetrieveTokenFeatures(MwmContext const & context) const;
+
+  // Opens the mwm and retrieves its features. Returns an empty context if the mwm can't be searched.
+  // Thread-safe as well as RetrieveTokenFeatures().
+  PreparedMwm PrepareMwm(ExtendedMwmInfos::ExtendedMwmInfo const & info) const;
 
   void InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer);
 
@@ -313,12 +340,17 @@ private:
   StreetsCache m_streetsCache;
   SuburbsCache m_suburbsCache;
   LocalitiesCaches & m_localitiesCaches;
+  RetrievalCache & m_retrievalCache;
   HotelsCache m_hotelsCache;
   FoodCache m_foodCache;
   cuisine_filter::CuisineFilter m_cuisineFilter;
 
   base::Cancellable const & m_cancellable;
 
+  // Pool which prepares mwms when Params::m_threadsCount is greater than one.
+  std::unique_ptr<base::ComputationalThreadPool> m_threadPool;
+  size_t m_threadPoolSize = 0;
+
   // Geocoder params.
   Params m_params;
 
@@ -365,6 +397,8 @@ private:
   // Search query params prepared for retrieval.
   std::vector<SearchTrieRequest<strings::LevenshteinDFA>> m_tokenRequests;
   SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> m_prefixTokenRequest;
+  // Keys of the token requests in |m_retrievalCache|.
+  std::vector<std::string> m_retrievalKeys;
 
   ResultTracer m_resultTracer;
 
@@ -8,33 +8,31 @@
 
 namespace search
 {
-LazyCentersTable::LazyCentersTable(MwmValue const & value)
-  : m_value(value)
-  , m_state(STATE_NOT_LOADED)
-  , m_reader(std::unique_ptr<ModelReader>())
-{}
+LazyCentersTable::LazyCentersTable(MwmValue & value) : m_value(value), m_state(STATE_NOT_LOADED) {}
 
 void LazyCentersTable::EnsureTableLoaded()
 {
   if (m_state != STATE_NOT_LOADED)
     return;
 
-  try
+  if (!m_value.m_centers)
   {
-    m_reader = m_value.m_cont.GetReader(CENTERS_FILE_TAG);
-  }
-  catch (RootException const & ex)
-  {
-    LOG(LERROR, ("Unable to load", CENTERS_FILE_TAG, ex.Msg()));
-    m_state = STATE_FAILED;
-    return;
+    auto const format = version::MwmTraits(m_value.GetMwmVersion()).GetCentersTableFormat();
+    CHECK_EQUAL(format, version::MwmTraits::CentersTableFormat::EliasFanoMapWithHeader, ());
+
+    try
+    {
+      m_value.m_centers = CentersTable::Load(m_value.m_cont);
+    }
+    catch (RootException const & ex)
+    {
+      LOG(LERROR, ("Unable to load", CENTERS_FILE_TAG, ex.Msg()));
+      m_state = STATE_FAILED;
+      return;
+    }
   }
 
-  auto const format = version::MwmTraits(m_value.GetMwmVersion()).GetCentersTableFormat();
-  CHECK_EQUAL(format, version::MwmTraits::CentersTableFormat::EliasFanoMapWithHeader, ());
-  m_table = CentersTable::LoadV1(*m_reader.GetPtr());
-
-  if (m_table)
+  if (m_value.m_centers)
     m_state = STATE_LOADED;
   else
     m_state = STATE_FAILED;
@@ -45,6 +43,17 @@ bool LazyCentersTable::Get(uint32_t id, m2::PointD & center)
   EnsureTableLoaded();
   if (m_state != STATE_LOADED)
     return false;
-  return m_table->Get(id, center);
+  return m_value.m_centers->Get(id, center);
+}
+
+void LazyCentersTable::Get(std::vector<uint32_t> const & ids, std::vector<std::optional<m2::PointD>> & centers)
+{
+  EnsureTableLoaded();
+  if (m_state != STATE_LOADED)
+  {
+    centers.assign(ids.size(), {});
+    return;
+  }
+  m_value.m_centers->Get(ids, centers);
 }
 }  // namespace search
@@ -2,17 +2,18 @@
 
 #include "indexer/centers_table.hpp"
 
-#include "coding/files_container.hpp"
-
 #include "geometry/point2d.hpp"
 
 #include <cstdint>
-#include <memory>
+#include <optional>
+#include <vector>
 
 class MwmValue;
 
 namespace search
 {
+// Loads the centers table of |value| on the first request. The table is kept in the value and
+// is reused by all further LazyCentersTable instances of the same value.
 class LazyCentersTable
 {
 public:
@@ -23,7 +24,7 @@ public:
     STATE_FAILED
   };
 
-  explicit LazyCentersTable(MwmValue const & value);
+  explicit LazyCentersTable(MwmValue & value);
 
   inline State GetState() const { return m_state; }
 
@@ -31,11 +32,11 @@ public:
 
   [[nodiscard]] bool Get(uint32_t id, m2::PointD & center);
 
+  // Batch version of Get(), see CentersTable::Get. All |centers| are empty if the table can't be loaded.
+  void Get(std::vector<uint32_t> const & ids, std::vector<std::optional<m2::PointD>> & centers);
+
 private:
-  MwmValue const & m_value;
+  MwmValue & m_value;
   State m_state;
-
-  FilesContainerR::TReader m_reader;
-  std::unique_ptr<CentersTable> m_table;
 };
 }  // namespace search
@@ -17,7 +17,12 @@
 
 #include <algorithm>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
 #include <random>
+#include <string>
+#include <vector>
 
 namespace search
 {
@@ -63,6 +68,17 @@ void SweepNearbyResults(m2::PointD const & eps, std::unordered_set<FeatureID> co
 
   results.swap(filtered);
 }
+
+// Returns the rank table from |sectionName| cached in |table|, loads it on the first call.
+RankTable const & GetRankTable(FilesContainerR const & cont, std::string const & sectionName,
+                               std::unique_ptr<RankTable> & table)
+{
+  if (!table)
+    table = RankTable::Load(cont, sectionName);
+  if (!table)
+    table = std::make_unique<DummyRankTable>();
+  return *table;
+}
 }  // namespace
 
 PreRanker::PreRanker(DataSource const & dataSource, Ranker & ranker)
@@ -89,66 +105,70 @@ void PreRanker::Finish(bool cancelled)
 
 void PreRanker::FillMissingFieldsInPreResults()
 {
-  MwmSet::MwmId mwmId;
-  MwmSet::MwmHandle mwmHandle;
-  std::unique_ptr<RankTable> ranks = std::make_unique<DummyRankTable>();
-  std::unique_ptr<RankTable> popularityRanks = std::make_unique<DummyRankTable>();
-  std::unique_ptr<LazyCentersTable> centers;
+  // Results are processed per mwm: the tables of the mwm are taken once and the centers of all its
+  // results are decoded in one batch, every block of the centers table at most once.
+  std::map<MwmSet::MwmId, std::vector<size_t>> mwmResults;
+  for (size_t i = 0; i < m_results.size(); ++i)
+    mwmResults[m_results[i].GetId().m_mwmId].push_back(i);
+
+  DummyRankTable const dummyRanks;
+  std::vector<uint32_t> ids;
+  std::vector<std::optional<m2::PointD>> centers;
   bool pivotFeaturesInitialized = false;
 
   auto const & editor = osm::Editor::Instance();
-  ForEachMwmOrder(m_results, [&](PreRankerResult & r)
+  for (auto const & [mwmId, indices] : mwmResults)
   {
-    FeatureID const & id = r.GetId();
-    if (id.m_mwmId != mwmId)
-    {
-      mwmId = id.m_mwmId;
-      mwmHandle = m_dataSource.GetMwmHandleById(mwmId);
-
-      ranks.reset();
-      centers.reset();
-      if (mwmHandle.IsAlive())
-      {
-        auto const * value = mwmHandle.GetValue();
+    ids.clear();
+    for (auto const i : indices)
+      ids.push_back(m_results[i].GetId().m_index);
 
-        ranks = RankTable::Load(value->m_cont, SEARCH_RANKS_FILE_TAG);
-        popularityRanks = RankTable::Load(value->m_cont, POPULARITY_RANKS_FILE_TAG);
-        centers = std::make_unique<LazyCentersTable>(*value);
-      }
-      if (!ranks)
-        ranks = std::make_unique<DummyRankTable>();
-      if (!popularityRanks)
-        popularityRanks = std::make_unique<DummyRankTable>();
-    }
+    RankTable const * ranks = &dummyRanks;
+    RankTable const * popularityRanks = &dummyRanks;
+    centers.assign(ids.size(), {});
 
-    r.SetRank(ranks->Get(id.m_index));
-    r.SetPopularity(popularityRanks->Get(id.m_index));
-
-    m2::PointD center;
-    if (centers && centers->Get(id.m_index, center))
-    {
-      r.SetDistanceToPivot(mercator::DistanceOnEarth(m_params.m_accuratePivotCenter, center));
-      r.SetCenter(center);
-    }
-    else if (editor.GetFeatureStatus(id.m_mwmId, id.m_index) == FeatureStatus::Created)
+    auto const mwmHandle = m_dataSource.GetMwmHandleById(mwmId);
+    if (mwmHandle.IsAlive())
     {
-      auto const emo = editor.GetEditedFeature(id);
-      CHECK(emo, ());
-      center = emo->GetMercator();
-      r.SetDistanceToPivot(mercator::DistanceOnEarth(m_params.m_accuratePivotCenter, center));
-      r.SetCenter(center);
+      auto & value = *mwmHandle.GetValue();
+      ranks = &GetRankTable(value.m_cont, SEARCH_RANKS_FILE_TAG, value.m_searchRanks);
+      popularityRanks = &GetRankTable(value.m_cont, POPULARITY_RANKS_FILE_TAG, value.m_popularityRanks);
+      LazyCentersTable(value).Get(ids, centers);
     }
-    else
+
+    for (size_t j = 0; j < indices.size(); ++j)
     {
-      // Possible when search while MWM is reloading or updating (!IsAlive).
-      if (!pivotFeaturesInitialized)
+      PreRankerResult & r = m_results[indices[j]];
+      FeatureID const & id = r.GetId();
+
+      r.SetRank(ranks->Get(id.m_index));
+      r.SetPopularity(popularityRanks->Get(id.m_index));
+
+      if (centers[j])
+      {
+        r.SetDistanceToPivot(mercator::DistanceOnEarth(m_params.m_accuratePivotCenter, *centers[j]));
+        r.SetCenter(*centers[j]);
+      }
+      else if (editor.GetFeatureStatus(id.m_mwmId, id.m_index) == FeatureStatus::Created)
+      {
+        auto const emo = editor.GetEditedFeature(id);
+        CHECK(emo, ());
+        auto const center = emo->GetMercator();
+        r.SetDistanceToPivot(mercator::DistanceOnEarth(m_params.m_accuratePivotCenter, center));
+        r.SetCenter(center);
+      }
+      else
       {
-        m_pivotFeatures.SetPosition(m_params.m_accuratePivotCenter, m_params.m_scale);
-        pivotFeaturesInitialized = true;
+        // Possible when search while MWM is reloading or updating (!IsAlive).
+        if (!pivotFeaturesInitialized)
+        {
+          m_pivotFeatures.SetPosition(m_params.m_accuratePivotCenter, m_params.m_scale);
+          pivotFeaturesInitialized = true;
+        }
+        r.SetDistanceToPivot(m_pivotFeatures.GetDistanceToFeatureMeters(id));
       }
-      r.SetDistanceToPivot(m_pivotFeatures.GetDistanceToFeatureMeters(id));
     }
-  });
+  }
 }
 
 namespace
@@ -160,7 +160,8 @@ bool EatVersion(std::string & s, uint32_t & version)
 }  // namespace
 
 Processor::Processor(DataSource const & dataSource, CategoriesHolder const & categories,
-                     std::vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter)
+                     std::vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter,
+                     RetrievalCache & retrievalCache)
   : m_categories(categories)
   , m_infoGetter(infoGetter)
   , m_dataSource(dataSource)
@@ -171,7 +172,7 @@ Processor::Processor(DataSource const & dataSource, CategoriesHolder const & cat
              m_localitiesCaches.m_villages, static_cast<base::Cancellable const &>(*this))
   , m_preRanker(m_dataSource, m_ranker)
   , m_geocoder(m_dataSource, infoGetter, categories, m_citiesBoundaries, m_preRanker, m_localitiesCaches,
-               static_cast<base::Cancellable const &>(*this))
+               retrievalCache, static_cast<base::Cancellable const &>(*this))
   , m_bookmarksProcessor(m_emitter, static_cast<base::Cancellable const &>(*this))
 {
   // Current and input langs are to be set later.
@@ -893,6 +894,7 @@ void Processor::InitGeocoder(Geocoder::Params & geocoderParams, SearchParams con
   geocoderParams.m_tracer = searchParams.m_tracer;
   geocoderParams.m_filteringParams = searchParams.m_filteringParams;
   geocoderParams.m_useDebugInfo = searchParams.m_useDebugInfo;
+  geocoderParams.m_threadsCount = searchParams.m_geocoderThreadsCount;
 
   m_geocoder.SetParams(geocoderParams);
 }
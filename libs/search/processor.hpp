@@ -54,7 +54,7 @@ public:
   static size_t const kPreResultsCount;
 
   Processor(DataSource const & dataSource, CategoriesHolder const & categories, std::vector<Suggest> const & suggests,
-            storage::CountryInfoGetter const & infoGetter);
+            storage::CountryInfoGetter const & infoGetter, RetrievalCache & retrievalCache);
 
   void SetViewport(m2::RectD const & viewport);
   void SetPreferredLocale(std::string const & locale);
@@ -0,0 +1,103 @@
+#include "search/retrieval_cache.hpp"
+
+#include "search/query_params.hpp"
+
+#include "base/assert.hpp"
+
+#include <sstream>
+
+namespace search
+{
+RetrievalCache::RetrievalCache(uint64_t maxSizeBytes) : m_maxSizeBytes(maxSizeBytes) {}
+
+// static
+std::string RetrievalCache::MakeKey(QueryParams const & params, size_t i)
+{
+  std::string key(1, params.IsPrefixToken(i) ? 'p' : 'f');
+
+  // Zero bytes never appear in utf8 strings and separate the synonyms.
+  params.GetToken(i).ForOriginalAndSynonyms([&key](strings::UniString const & s)
+  {
+    key += strings::ToUtf8(s);
+    key += '\0';
+  });
+
+  for (auto const index : params.GetTypeIndices(i))
+    key += 't' + std::to_string(index);
+  for (auto const lang : params.GetLangs())
+    key += 'l' + std::to_string(lang);
+  return key;
+}
+
+std::optional<RetrievalCache::Features> RetrievalCache::Find(MwmSet::MwmId const & id, std::string const & key)
+{
+  std::lock_guard<std::mutex> lock(m_mu);
+  auto const it = m_index.find(Key(id, key));
+  if (it == m_index.end())
+  {
+    ++m_stats.m_misses;
+    return {};
+  }
+
+  ++m_stats.m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->m_features;
+}
+
+void RetrievalCache::Add(MwmSet::MwmId const & id, std::string const & key, Features const & features)
+{
+  uint64_t const sizeBytes =
+      sizeof(Entry) + key.size() + features.m_features.GetSizeBytes() + features.m_exactMatchingFeatures.GetSizeBytes();
+  if (sizeBytes > m_maxSizeBytes)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_mu);
+  Key k(id, key);
+  // The same request may be retrieved by several processors at the same time.
+  if (m_index.count(k) != 0)
+    return;
+
+  while (m_stats.m_sizeBytes + sizeBytes > m_maxSizeBytes)
+  {
+    ASSERT(!m_entries.empty(), ());
+    auto const & last = m_entries.back();
+    m_stats.m_sizeBytes -= last.m_sizeBytes;
+    m_index.erase(last.m_key);
+    m_entries.pop_back();
+    ++m_stats.m_evictions;
+  }
+
+  m_entries.push_front({k, features, sizeBytes});
+  m_index.emplace(std::move(k), m_entries.begin());
+  m_stats.m_sizeBytes += sizeBytes;
+  m_stats.m_entries = m_entries.size();
+}
+
+void RetrievalCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mu);
+  m_index.clear();
+  m_entries.clear();
+  m_stats.m_sizeBytes = 0;
+  m_stats.m_entries = 0;
+}
+
+RetrievalCache::Stats RetrievalCache::GetStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mu);
+  return m_stats;
+}
+
+std::string DebugPrint(RetrievalCache::Stats const & stats)
+{
+  std::ostringstream os;
+  os << "RetrievalCache::Stats [";
+  os << "hits: " << stats.m_hits << ", ";
+  os << "misses: " << stats.m_misses << ", ";
+  os << "evictions: " << stats.m_evictions << ", ";
+  os << "entries: " << stats.m_entries << ", ";
+  os << "size bytes: " << stats.m_sizeBytes;
+  os << "]";
+  return os.str();
+}
+}  // namespace search
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "search/retrieval.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace search
+{
+class QueryParams;
+
+// Cache of the features retrieved from the search index for single query tokens. Unlike the
+// Geocoder caches it is shared by all search processors of the Engine and survives between
+// queries, so while a user types "restaurant mosc", "restaurant mosco", ... the retrieval of
+// the already typed tokens is not repeated on every keystroke.
+//
+// The least recently used entries are evicted when the total size of the cached bit vectors
+// exceeds the budget.
+//
+// NOTE: this class is thread-safe.
+class RetrievalCache
+{
+public:
+  using Features = Retrieval::ExtendedFeatures;
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    size_t m_entries = 0;
+    uint64_t m_sizeBytes = 0;
+  };
+
+  explicit RetrievalCache(uint64_t maxSizeBytes);
+
+  // Returns the key of the retrieval request for the |i|-th token of |params|. The key depends on
+  // everything the request is built from: the token and its synonyms, its prefixness, the
+  // categories the token matches and the query langs.
+  static std::string MakeKey(QueryParams const & params, size_t i);
+
+  std::optional<Features> Find(MwmSet::MwmId const & id, std::string const & key);
+  void Add(MwmSet::MwmId const & id, std::string const & key, Features const & features);
+
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  using Key = std::pair<MwmSet::MwmId, std::string>;
+
+  struct Entry
+  {
+    Key m_key;
+    Features m_features;
+    uint64_t m_sizeBytes = 0;
+  };
+
+  using Entries = std::list<Entry>;
+
+  uint64_t const m_maxSizeBytes;
+
+  mutable std::mutex m_mu;
+  // Most recently used entries are at the front.
+  Entries m_entries;
+  std::map<Key, Entries::iterator> m_index;
+  Stats m_stats;
+};
+
+std::string DebugPrint(RetrievalCache::Stats const & stats);
+}  // namespace search
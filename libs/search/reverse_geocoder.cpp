@@ -16,9 +16,17 @@
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/scales.hpp"
 
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/triangle2d.hpp"
+
+#include "base/checked_cast.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <future>
+#include <limits>
+#include <numeric>
 
 namespace search
 {
@@ -33,12 +41,68 @@ m2::RectD GetLookupRect(m2::PointD const & center, double radiusM)
   return mercator::RectByCenterXYAndSizeInMeters(center, radiusM);
 }
 
+/// Cells with fewer points are processed point by point: it's cheaper than loading all the houses of a cell.
+size_t constexpr kMinPointsPerCell = 4;
+/// Max number of cached building addresses per batch thread.
+size_t constexpr kMaxSavedAddresses = 100000;
+
 ReverseGeocoder::Building FromFeatureImpl(FeatureType & ft, std::string const & hn, double distMeters)
 {
   return {ft.GetID(), distMeters, hn, feature::GetCenter(ft), ft.GetMetadata(feature::Metadata::FMD_POSTCODE)};
 }
+
+bool IsCloser(m2::PointD const & center, ReverseGeocoder::Building const & b1, ReverseGeocoder::Building const & b2)
+{
+  if (b1.m_distanceMeters != b2.m_distanceMeters)
+    return b1.m_distanceMeters < b2.m_distanceMeters;
+
+  /// @todo Check area instead? Like smaller is better (inner).
+  /// In case of overlapped polygons (m_distanceMeters == 0).
+  return b1.m_center.SquaredLength(center) < b2.m_center.SquaredLength(center);
+}
 }  // namespace
 
+struct ReverseGeocoder::HNObject
+{
+  Building m_building;
+  feature::GeomType m_geomType = feature::GeomType::Undefined;
+  /// Points of a line or vertices of the triangles of an area, the best geometry.
+  std::vector<m2::PointD> m_points;
+  m2::RectD m_rect;
+
+  /// Same as feature::GetMinDistanceMeters.
+  double GetMinDistanceMeters(m2::PointD const & pt) const
+  {
+    double res = std::numeric_limits<double>::max();
+    auto const updateDistance = [&](m2::PointD const & x1, m2::PointD const & x2)
+    {
+      m2::ParametrizedSegment<m2::PointD> const segment(x1, x2);
+      res = std::min(res, mercator::DistanceOnEarth(segment.ClosestPointTo(pt), pt));
+    };
+
+    switch (m_geomType)
+    {
+    case feature::GeomType::Point: return mercator::DistanceOnEarth(m_points.front(), pt);
+    case feature::GeomType::Line:
+      for (size_t i = 1; i < m_points.size(); ++i)
+        updateDistance(m_points[i - 1], m_points[i]);
+      return res;
+    default:
+      ASSERT_EQUAL(m_geomType, feature::GeomType::Area, ());
+      for (size_t i = 0; i + 2 < m_points.size(); i += 3)
+      {
+        if (m2::IsPointInsideTriangle(pt, m_points[i], m_points[i + 1], m_points[i + 2]))
+          return 0.0;
+
+        updateDistance(m_points[i], m_points[i + 1]);
+        updateDistance(m_points[i + 1], m_points[i + 2]);
+        updateDistance(m_points[i + 2], m_points[i]);
+      }
+      return res;
+    }
+  }
+};
+
 ReverseGeocoderBase::ReverseGeocoderBase()
   : m_isAddressInterpol(ftypes::IsAddressInterpolChecker::Instance())
   , m_isStreetOrSquare(ftypes::IsStreetOrSquareChecker::Instance())
@@ -180,6 +244,63 @@ bool ReverseGeocoder::GetExactAddress(FeatureID const & fid, Address & addr) con
   return res;
 }
 
+std::vector<ReverseGeocoder::Address> ReverseGeocoder::GetNearbyAddresses(std::vector<m2::PointD> const & points,
+                                                                         double maxDistanceM,
+                                                                         size_t threadsCount) const
+{
+  CHECK_GREATER(maxDistanceM, 0.0, ());
+  CHECK_GREATER(threadsCount, 0, ());
+
+  // Cell coordinates must fit into 31 bits to be packed into one key.
+  double const minCellSize = mercator::Bounds::kRangeX / (1 << 30);
+  double const cellSize = std::max(mercator::MetersToMercator(maxDistanceM), minCellSize);
+  auto const toCell = [cellSize](m2::PointD p)
+  {
+    mercator::ClampPoint(p);
+    auto const x = base::checked_cast<uint32_t>(static_cast<int64_t>((p.x - mercator::Bounds::kMinX) / cellSize));
+    auto const y = base::checked_cast<uint32_t>(static_cast<int64_t>((p.y - mercator::Bounds::kMinY) / cellSize));
+    return (static_cast<int64_t>(y) << 32) | x;
+  };
+
+  std::vector<size_t> indices(points.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::vector<int64_t> pointCells(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    pointCells[i] = toCell(points[i]);
+  std::sort(indices.begin(), indices.end(), [&pointCells](size_t lhs, size_t rhs)
+  { return pointCells[lhs] != pointCells[rhs] ? pointCells[lhs] < pointCells[rhs] : lhs < rhs; });
+
+  std::vector<int64_t> cells(points.size());
+  for (size_t i = 0; i < indices.size(); ++i)
+    cells[i] = pointCells[indices[i]];
+
+  std::vector<Address> addrs(points.size());
+  if (threadsCount == 1)
+  {
+    GetNearbyAddresses(points, indices, cells, cellSize, 0 /* beg */, points.size(), maxDistanceM, addrs);
+    return addrs;
+  }
+
+  // Several chunks per thread to balance dense and sparse cells. Chunks don't split cells.
+  size_t const chunkSize = std::max<size_t>(1, points.size() / (threadsCount * 4));
+  base::ComputationalThreadPool pool(threadsCount);
+  std::vector<std::future<void>> chunks;
+  for (size_t beg = 0; beg < points.size();)
+  {
+    size_t end = std::min(beg + chunkSize, points.size());
+    while (end < points.size() && cells[end] == cells[end - 1])
+      ++end;
+
+    chunks.push_back(pool.Submit([&, beg, end]()
+    { GetNearbyAddresses(points, indices, cells, cellSize, beg, end, maxDistanceM, addrs); }));
+    beg = end;
+  }
+
+  for (auto & chunk : chunks)
+    chunk.get();
+  return addrs;
+}
+
 bool ReverseGeocoder::GetFeatureAddress(FeatureType & ft, Address & addr) const
 {
   /// @todo Duplicate feature::GetCenter call. Add m_geomCenter cached into FeatureType?
@@ -265,15 +386,144 @@ void ReverseGeocoder::GetNearbyHNObjects(m2::PointD const & center, double radiu
   auto const stopFn = [&]() { return buildings.size() >= kMaxNumTriesToApproxAddress; };
 
   m_dataSource.ForClosestToPoint(addFn, stopFn, center, radius, kQueryScale);
-  std::sort(buildings.begin(), buildings.end(), [&center](Building const & b1, Building const & b2)
+  std::sort(buildings.begin(), buildings.end(),
+            [&center](Building const & b1, Building const & b2) { return IsCloser(center, b1, b2); });
+}
+
+void ReverseGeocoder::GetHNObjects(m2::RectD const & rect, std::vector<HNObject> & objects) const
+{
+  m_dataSource.ForEachInRect([&](FeatureType & ft)
+  {
+    std::string const & hn = GetHouseNumber(ft);
+    if (hn.empty())
+      return;
+
+    HNObject obj;
+    obj.m_building = FromFeatureImpl(ft, hn, 0.0 /* distMeters */);
+    obj.m_geomType = ft.GetGeomType();
+    switch (obj.m_geomType)
+    {
+    case feature::GeomType::Point: obj.m_points.push_back(ft.GetCenter()); break;
+    case feature::GeomType::Line:
+      ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+      for (size_t i = 0; i < ft.GetPointsCount(); ++i)
+        obj.m_points.push_back(ft.GetPoint(i));
+      break;
+    default:
+      ft.ForEachTriangle([&obj](m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3)
+      {
+        obj.m_points.push_back(p1);
+        obj.m_points.push_back(p2);
+        obj.m_points.push_back(p3);
+      }, FeatureType::BEST_GEOMETRY);
+    }
+    if (obj.m_points.empty())
+      return;
+
+    obj.m_rect = ft.GetLimitRect(FeatureType::BEST_GEOMETRY);
+    objects.push_back(std::move(obj));
+  }, rect, kQueryScale);
+}
+
+void ReverseGeocoder::GetSavedNearbyAddress(std::vector<Building> const & buildings, HouseTable & table,
+                                            SavedAddresses & saved, Address & addr) const
+{
+  size_t triesCount = 0;
+  for (auto const & b : buildings)
   {
-    if (b1.m_distanceMeters != b2.m_distanceMeters)
-      return b1.m_distanceMeters < b2.m_distanceMeters;
+    auto it = saved.find(b.m_id);
+    if (it == saved.end())
+    {
+      Address savedAddr;
+      std::optional<Address> res;
+      if (GetSavedAddress(table, b, false /* ignoreEdits */, savedAddr))
+        res = std::move(savedAddr);
+      it = saved.emplace(b.m_id, std::move(res)).first;
+    }
 
-    /// @todo Check area instead? Like smaller is better (inner).
-    /// In case of overlapped polygons (m_distanceMeters == 0).
-    return b1.m_center.SquaredLength(center) < b2.m_center.SquaredLength(center);
-  });
+    if (it->second)
+    {
+      addr = *it->second;
+      addr.m_building.m_distanceMeters = b.m_distanceMeters;
+      return;
+    }
+
+    if (++triesCount == kMaxNumTriesToApproxAddress)
+      return;
+  }
+}
+
+void ReverseGeocoder::GetNearbyAddresses(std::vector<m2::PointD> const & points, std::vector<size_t> const & indices,
+                                         std::vector<int64_t> const & cells, double cellSize, size_t beg,
+                                         size_t end, double maxDistanceM, std::vector<Address> & addrs) const
+{
+  HouseTable table(m_dataSource);
+  SavedAddresses saved;
+  std::vector<HNObject> objects;
+  std::vector<Building> buildings;
+
+  for (size_t cellBeg = beg; cellBeg < end;)
+  {
+    size_t cellEnd = cellBeg + 1;
+    while (cellEnd < end && cells[cellEnd] == cells[cellBeg])
+      ++cellEnd;
+
+    if (saved.size() > kMaxSavedAddresses)
+      saved.clear();
+
+    bool const pointByPoint = cellEnd - cellBeg < kMinPointsPerCell;
+    if (!pointByPoint)
+    {
+      // All the houses which may be within |maxDistanceM| from the points of the cell.
+      m2::PointD const cellMin(mercator::Bounds::kMinX + (cells[cellBeg] & 0xFFFFFFFF) * cellSize,
+                               mercator::Bounds::kMinY + (cells[cellBeg] >> 32) * cellSize);
+      m2::RectD rect = GetLookupRect(cellMin, maxDistanceM);
+      rect.Add(GetLookupRect(cellMin + m2::PointD(cellSize, cellSize), maxDistanceM));
+      objects.clear();
+      GetHNObjects(rect, objects);
+    }
+
+    for (size_t i = cellBeg; i < cellEnd; ++i)
+    {
+      m2::PointD const & center = points[indices[i]];
+      buildings.clear();
+      if (pointByPoint)
+      {
+        GetNearbyHNObjects(center, maxDistanceM, buildings);
+      }
+      else
+      {
+        m2::RectD const lookupRect = GetLookupRect(center, maxDistanceM);
+        for (auto const & obj : objects)
+        {
+          if (!obj.m_rect.IsIntersect(lookupRect))
+            continue;
+          double const distance = obj.GetMinDistanceMeters(center);
+          if (distance <= maxDistanceM)
+          {
+            buildings.push_back(obj.m_building);
+            buildings.back().m_distanceMeters = distance;
+          }
+        }
+
+        auto const less = [&center](Building const & b1, Building const & b2) { return IsCloser(center, b1, b2); };
+        if (buildings.size() > kMaxNumTriesToApproxAddress)
+        {
+          std::partial_sort(buildings.begin(), buildings.begin() + kMaxNumTriesToApproxAddress, buildings.end(),
+                            less);
+          buildings.resize(kMaxNumTriesToApproxAddress);
+        }
+        else
+        {
+          std::sort(buildings.begin(), buildings.end(), less);
+        }
+      }
+
+      GetSavedNearbyAddress(buildings, table, saved, addrs[indices[i]]);
+    }
+
+    cellBeg = cellEnd;
+  }
 }
 
 // static
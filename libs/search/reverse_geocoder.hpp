@@ -7,6 +7,7 @@
 
 #include "coding/string_utf8_multilang.hpp"
 
+#include <map>
 #include <optional>
 #include <string>
 #include <vector>
@@ -206,6 +207,15 @@ public:
 
   bool GetExactAddress(FeatureID const & fid, Address & addr) const;
 
+  /// Batch version of GetNearbyAddress(center, maxDistanceM, addr) for many points, e.g. of GPS tracks.
+  /// The points are processed in the order of the grid cells they belong to, so the houses and the mwm
+  /// tables are loaded once for the neighbouring points. The cells are processed in |threadsCount| threads.
+  /// @return Addresses in the order of |points|.
+  /// @note Nearest houses are chosen among all the ones within |maxDistanceM|, while GetNearbyAddress
+  /// takes the first ones met by the spiral covering, so very rarely the results may differ.
+  std::vector<Address> GetNearbyAddresses(std::vector<m2::PointD> const & points, double maxDistanceM,
+                                          size_t threadsCount = 1) const;
+
   bool GetFeatureAddress(FeatureType & ft, Address & addr) const;
 
   /// Returns the nearest region address where mwm or exact city is known.
@@ -230,6 +240,11 @@ private:
     bool m_placeAsStreet;
   };
 
+  /// Feature with house number and its geometry to calculate distances to many points.
+  struct HNObject;
+  /// Addresses of the buildings (without the distance to a point) or empty values if not found.
+  using SavedAddresses = std::map<FeatureID, std::optional<Address>>;
+
   /// Ignores changes from editor if |ignoreEdits| is true.
   bool GetSavedAddress(HouseTable & table, Building const & bld, bool ignoreEdits, Address & addr) const;
 
@@ -238,6 +253,19 @@ private:
   /// Get sorted by distance objects (not only building, but any address-like object) vector with valid house number.
   void GetNearbyHNObjects(m2::PointD const & center, double maxDistanceM, std::vector<Building> & buildings) const;
 
+  /// Appends all objects with valid house number which intersect |rect|.
+  void GetHNObjects(m2::RectD const & rect, std::vector<HNObject> & objects) const;
+
+  /// Tries the nearest |buildings| as GetNearbyAddress does, the results for the buildings are cached in |saved|.
+  void GetSavedNearbyAddress(std::vector<Building> const & buildings, HouseTable & table, SavedAddresses & saved,
+                             Address & addr) const;
+
+  /// Calculates addresses of |points[indices[i]]| for i in [beg, end). The indices are sorted by the |cells|,
+  /// keys of the grid with |cellSize| cells.
+  void GetNearbyAddresses(std::vector<m2::PointD> const & points, std::vector<size_t> const & indices,
+                          std::vector<int64_t> const & cells, double cellSize, size_t beg, size_t end,
+                          double maxDistanceM, std::vector<Address> & addrs) const;
+
   static Building FromFeature(FeatureType & ft, double distMeters);
 };
 
@@ -3816,4 +3816,41 @@ UNIT_CLASS_TEST(ProcessorTest, USAddress_WState_NY)
   }
 }
 
+UNIT_CLASS_TEST(ProcessorTest, ParallelGeocoding)
+{
+  std::vector<TestCafe> cafes;
+  for (int i = 0; i < 8; ++i)
+    cafes.emplace_back(m2::PointD(i * 0.1, 0.0), "Lermontov", "en");
+
+  Rules rules;
+  for (size_t i = 0; i < cafes.size(); ++i)
+  {
+    auto const countryId =
+        BuildCountry("Wonderland" + strings::to_string(i), [&](TestMwmBuilder & builder) { builder.Add(cafes[i]); });
+    rules.push_back(ExactMatch(countryId, cafes[i]));
+  }
+
+  SearchParams params;
+  params.m_query = "Lermontov";
+  params.m_inputLocale = "en";
+  params.m_viewport = m2::RectD(-1.0, -1.0, 1.0, 1.0);
+  params.m_mode = Mode::Everywhere;
+
+  TestSearchRequest serial(m_engine, params);
+  serial.Run();
+  TEST(ResultsMatch(serial.Results(), rules), ());
+
+  // Results and their order don't depend on the threads count.
+  params.m_geocoderThreadsCount = 4;
+  TestSearchRequest parallel(m_engine, params);
+  parallel.Run();
+  TEST(ResultsMatch(parallel.Results(), rules), ());
+
+  auto const & serialResults = serial.Results();
+  auto const & parallelResults = parallel.Results();
+  TEST_EQUAL(serialResults.size(), parallelResults.size(), ());
+  for (size_t i = 0; i < serialResults.size(); ++i)
+    TEST_EQUAL(serialResults[i].GetFeatureID(), parallelResults[i].GetFeatureID(), (i));
+}
+
 }  // namespace processor_test
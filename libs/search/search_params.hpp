@@ -94,6 +94,10 @@ struct SearchParams
   // True if you need *pure* category results only, without names/addresses/etc matching.
   bool m_categorialRequest = false;
 
+  // Number of threads to retrieve features from different mwms of one query. It's worth to set
+  // when many mwms are searched, e.g. on a server. Doesn't affect results.
+  size_t m_geocoderThreadsCount = 1;
+
   // Set to true for debug logs and tests.
 #ifdef DEBUG
   bool m_useDebugInfo = true;
@@ -0,0 +1,147 @@
+#include "search/search_quality/helpers.hpp"
+
+#include "search/reverse_geocoder.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+
+#include "platform/platform_tests_support/helpers.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+using namespace search::search_quality;
+using namespace search;
+
+DEFINE_string(data_path, "", "Path to data directory (resources dir)");
+DEFINE_string(mwm_path, "", "Path to mwm files (writable dir)");
+DEFINE_string(mwm_list_path, "", "Path to a file with the names of mwms to load (default: all mwms)");
+DEFINE_string(points_path, "", "Path to a file with \"lat lon\" lines, random tracks are used when empty");
+DEFINE_uint64(num_random_points, 100000, "Number of points of the random tracks");
+DEFINE_string(out_path, "", "Path to write the addresses of the batch geocoding to");
+DEFINE_uint64(num_threads, 1, "Number of threads of the batch geocoding");
+DEFINE_double(radius_m, ReverseGeocoder::kLookupRadiusM, "Lookup radius in meters");
+DEFINE_bool(compare, true, "Geocode the points one by one too and compare the results");
+
+namespace
+{
+std::vector<m2::PointD> ReadPoints(std::string const & path)
+{
+  std::ifstream ifs(path);
+  CHECK(ifs.is_open(), ("Can't open input file", path));
+
+  std::vector<m2::PointD> points;
+  std::string line;
+  while (std::getline(ifs, line))
+  {
+    auto const tokens = strings::Tokenize(line, " \t,");
+    double lat, lon;
+    if (tokens.size() < 2 || !strings::to_double(tokens[0], lat) || !strings::to_double(tokens[1], lon))
+    {
+      LOG(LWARNING, ("Bad line:", line));
+      continue;
+    }
+    points.push_back(mercator::FromLatLon(lat, lon));
+  }
+  return points;
+}
+
+// Random walks of about 10 m steps, like GPS tracks, inside the country mwms.
+std::vector<m2::PointD> GenerateTracks(DataSource const & dataSource, size_t count)
+{
+  std::vector<std::shared_ptr<MwmInfo>> infos;
+  dataSource.GetMwmsInfo(infos);
+  std::erase_if(infos, [](auto const & info) { return info->GetType() != MwmInfo::COUNTRY; });
+  CHECK(!infos.empty(), ("No country mwms"));
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::normal_distribution<double> step(0.0, mercator::MetersToMercator(10.0));
+  size_t constexpr kTrackSize = 1000;
+
+  std::vector<m2::PointD> points;
+  points.reserve(count);
+  while (points.size() < count)
+  {
+    auto const & rect = infos[points.size() / kTrackSize % infos.size()]->m_bordersRect;
+    m2::PointD pt(rect.minX() + uniform(rng) * rect.SizeX(), rect.minY() + uniform(rng) * rect.SizeY());
+    for (size_t i = 0; i < kTrackSize && points.size() < count; ++i)
+    {
+      pt += m2::PointD(step(rng), step(rng));
+      points.push_back(pt);
+    }
+  }
+  return points;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  platform::tests_support::ChangeMaxNumberOfOpenFiles(kMaxOpenFiles);
+
+  gflags::SetUsageMessage("Reverse geocoding benchmark.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  SetPlatformDirs(FLAGS_data_path, FLAGS_mwm_path);
+
+  classificator::Load();
+  FrozenDataSource dataSource;
+  InitDataSource(dataSource, FLAGS_mwm_list_path);
+  ReverseGeocoder const coder(dataSource);
+
+  auto const points =
+      FLAGS_points_path.empty() ? GenerateTracks(dataSource, FLAGS_num_random_points) : ReadPoints(FLAGS_points_path);
+  LOG(LINFO, ("Points:", points.size()));
+
+  base::Timer timer;
+  auto const addrs = coder.GetNearbyAddresses(points, FLAGS_radius_m, FLAGS_num_threads);
+  double const batchSeconds = timer.ElapsedSeconds();
+
+  size_t found = 0;
+  for (auto const & addr : addrs)
+    if (addr.IsValid())
+      ++found;
+
+  LOG(LINFO, ("Batch geocoding in", FLAGS_num_threads, "threads:", batchSeconds, "seconds,",
+              points.size() / batchSeconds, "points/second, addresses found:", found));
+
+  if (FLAGS_compare)
+  {
+    timer.Reset();
+    size_t diffs = 0;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      ReverseGeocoder::Address addr;
+      coder.GetNearbyAddress(points[i], FLAGS_radius_m, addr);
+      if (addr.m_building.m_id != addrs[i].m_building.m_id || addr.m_street.m_id != addrs[i].m_street.m_id)
+        ++diffs;
+    }
+    double const seconds = timer.ElapsedSeconds();
+    LOG(LINFO, ("One by one geocoding:", seconds, "seconds,", points.size() / seconds,
+                "points/second, different addresses:", diffs));
+  }
+
+  if (!FLAGS_out_path.empty())
+  {
+    std::ofstream ofs(FLAGS_out_path);
+    CHECK(ofs.is_open(), ("Can't open output file", FLAGS_out_path));
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      auto const ll = mercator::ToLatLon(points[i]);
+      ofs << ll.m_lat << ' ' << ll.m_lon << '\t' << addrs[i].FormatAddress() << '\n';
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+#include "testing/testing.hpp"
+
+#include "search/cbv.hpp"
+#include "search/query_params.hpp"
+#include "search/retrieval_cache.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace retrieval_cache_tests
+{
+using namespace search;
+using namespace std;
+
+RetrievalCache::Features MakeFeatures(vector<uint64_t> const & setBits)
+{
+  return RetrievalCache::Features(CBV(coding::CompressedBitVectorBuilder::FromBitPositions(setBits)));
+}
+
+QueryParams MakeParams(string const & query, bool isLastPrefix)
+{
+  vector<strings::UniString> tokens;
+  for (auto const & token : strings::Tokenize(query, " "))
+    tokens.push_back(strings::MakeUniString(token));
+
+  QueryParams params;
+  params.Init(query, tokens, isLastPrefix);
+  params.GetLangs().Insert(StringUtf8Multilang::kDefaultCode);
+  return params;
+}
+
+UNIT_TEST(RetrievalCache_MakeKey)
+{
+  auto const full = MakeParams("cafe resta", false /* isLastPrefix */);
+  auto const prefix = MakeParams("cafe resta", true /* isLastPrefix */);
+  auto const longer = MakeParams("cafe restau", true /* isLastPrefix */);
+
+  TEST_EQUAL(RetrievalCache::MakeKey(full, 0), RetrievalCache::MakeKey(prefix, 0), ());
+  TEST_NOT_EQUAL(RetrievalCache::MakeKey(full, 1), RetrievalCache::MakeKey(prefix, 1), ());
+  TEST_NOT_EQUAL(RetrievalCache::MakeKey(prefix, 1), RetrievalCache::MakeKey(longer, 1), ());
+
+  auto otherLangs = prefix;
+  otherLangs.GetLangs().Insert(StringUtf8Multilang::kEnglishCode);
+  TEST_NOT_EQUAL(RetrievalCache::MakeKey(prefix, 0), RetrievalCache::MakeKey(otherLangs, 0), ());
+}
+
+UNIT_TEST(RetrievalCache_FindAdd)
+{
+  MwmSet::MwmId const mwm1(make_shared<MwmInfo>());
+  MwmSet::MwmId const mwm2(make_shared<MwmInfo>());
+
+  RetrievalCache cache(1024 * 1024 /* maxSizeBytes */);
+  TEST(!cache.Find(mwm1, "cafe"), ());
+
+  cache.Add(mwm1, "cafe", MakeFeatures({1, 5, 7}));
+  auto const features = cache.Find(mwm1, "cafe");
+  TEST(features, ());
+  TEST_EQUAL(features->m_features.PopCount(), 3, ());
+  TEST(features->m_exactMatchingFeatures.HasBit(5), ());
+
+  TEST(!cache.Find(mwm2, "cafe"), ());
+  TEST(!cache.Find(mwm1, "bar"), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 1, ());
+  TEST_EQUAL(stats.m_misses, 3, ());
+  TEST_EQUAL(stats.m_entries, 1, ());
+
+  cache.Clear();
+  TEST(!cache.Find(mwm1, "cafe"), ());
+  TEST_EQUAL(cache.GetStats().m_sizeBytes, 0, ());
+}
+
+UNIT_TEST(RetrievalCache_Eviction)
+{
+  MwmSet::MwmId const mwm(make_shared<MwmInfo>());
+
+  vector<uint64_t> setBits;
+  for (uint64_t i = 0; i < 1000; ++i)
+    setBits.push_back(i * 1000);
+
+  // Room for two entries only.
+  RetrievalCache cache(2 * MakeFeatures(setBits).m_features.GetSizeBytes() * 2 + 1024 /* maxSizeBytes */);
+  cache.Add(mwm, "a", MakeFeatures(setBits));
+  cache.Add(mwm, "b", MakeFeatures(setBits));
+  // "a" becomes the most recently used one.
+  TEST(cache.Find(mwm, "a"), ());
+  cache.Add(mwm, "c", MakeFeatures(setBits));
+
+  TEST(cache.Find(mwm, "a"), ());
+  TEST(!cache.Find(mwm, "b"), ());
+  TEST(cache.Find(mwm, "c"), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_evictions, 1, ());
+  TEST_EQUAL(stats.m_entries, 2, ());
+  TEST_LESS_OR_EQUAL(stats.m_sizeBytes, 2 * MakeFeatures(setBits).m_features.GetSizeBytes() * 2 + 1024, ());
+}
+}  // namespace retrieval_cache_tests
@@ -0,0 +1,84 @@
+// Compares the time of Intersect() and IntersectionPopCount() of the compressed bit vectors in Dense, Sparse
+// and Roaring storage strategies. Typical search case: a large set of features is intersected with the
+// features of the tokens.
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+DEFINE_uint64(bits, 1 << 22, "Number of bits in the vectors");
+DEFINE_uint64(percent1, 40, "Percent of the set bits in the first vector");
+DEFINE_uint64(percent2, 5, "Percent of the set bits in the second vector");
+DEFINE_uint64(iterations, 20, "Number of intersections of every pair of the vectors");
+
+namespace
+{
+using Strategy = coding::CompressedBitVector::StorageStrategy;
+
+std::unique_ptr<coding::CompressedBitVector> Build(std::vector<uint64_t> const & setBits, Strategy strategy)
+{
+  switch (strategy)
+  {
+  case Strategy::Dense: return std::make_unique<coding::DenseCBV>(setBits);
+  case Strategy::Sparse: return std::make_unique<coding::SparseCBV>(setBits);
+  case Strategy::Roaring: return std::make_unique<coding::RoaringCBV>(setBits);
+  }
+  UNREACHABLE();
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  gflags::SetUsageMessage("Intersection time of the compressed bit vectors in the different storage strategies.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_bits == 0 || FLAGS_iterations == 0 || FLAGS_percent1 > 100 || FLAGS_percent2 > 100)
+  {
+    LOG(LERROR, ("--bits and --iterations must be positive, the percents must be at most 100."));
+    return -1;
+  }
+
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<uint32_t> percent(0, 99);
+  std::vector<uint64_t> setBits1;
+  std::vector<uint64_t> setBits2;
+  for (uint64_t i = 0; i < FLAGS_bits; ++i)
+  {
+    if (percent(rng) < FLAGS_percent1)
+      setBits1.push_back(i);
+    if (percent(rng) < FLAGS_percent2)
+      setBits2.push_back(i);
+  }
+
+  std::cout << "strategy\tIntersect (ms)\tIntersectionPopCount (ms)\n";
+  for (auto const strategy : {Strategy::Dense, Strategy::Sparse, Strategy::Roaring})
+  {
+    auto const cbv1 = Build(setBits1, strategy);
+    auto const cbv2 = Build(setBits2, strategy);
+
+    uint64_t intersection = 0;
+    base::HighResTimer timer;
+    for (uint64_t i = 0; i < FLAGS_iterations; ++i)
+      intersection += coding::CompressedBitVector::Intersect(*cbv1, *cbv2)->PopCount();
+    auto const intersectMs = timer.ElapsedMilliseconds();
+
+    uint64_t popCount = 0;
+    timer.Reset();
+    for (uint64_t i = 0; i < FLAGS_iterations; ++i)
+      popCount += coding::CompressedBitVector::IntersectionPopCount(*cbv1, *cbv2);
+    auto const popCountMs = timer.ElapsedMilliseconds();
+
+    CHECK_EQUAL(intersection, popCount, (strategy));
+    std::cout << DebugPrint(strategy) << "\t" << intersectMs << "\t" << popCountMs << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,118 @@
+// Compares the decoding time of the features geometry, which is read by FeatureType::ParseGeometry() and
+// FeatureType::ParseTriangles(), for the deltas written with coding::DeltasEncoding::VarInt and GroupVarInt.
+// The points are the random walks with --max_step steps and a jump every 100 points.
+
+#include "coding/geometry_coding.hpp"
+#include "coding/point_coding.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+DEFINE_uint64(points, 10000, "Number of points in the decoded geometry");
+DEFINE_uint64(iterations, 1000, "Number of decodings of every geometry");
+DEFINE_uint64(max_step, 1000, "Maximum step of the random walks in the coordinate units");
+
+namespace
+{
+using BatchFnT = uint8_t const * (*)(uint8_t const *, size_t, coding::DeltasEncoding, m2::PointU const &,
+                                     m2::PointU const &, uint8_t, m2::PointD *);
+
+std::vector<m2::PointU> MakePoints(m2::PointU const & maxPoint, size_t count, int32_t maxStep)
+{
+  std::mt19937 rng(0);
+  // Walks of 100 steps from the random points stay within the bounds.
+  uint32_t const margin = static_cast<uint32_t>(maxStep) * 100;
+  std::uniform_int_distribution<uint32_t> coord(margin, maxPoint.x - margin);
+  std::uniform_int_distribution<int32_t> step(-maxStep, maxStep);
+
+  std::vector<m2::PointU> points;
+  points.push_back(m2::PointU(coord(rng), coord(rng)));
+  for (size_t i = 1; i < count; ++i)
+  {
+    if (i % 100 == 0)
+      points.push_back(m2::PointU(coord(rng), coord(rng)));
+    else
+      points.push_back(points.back() + m2::PointU(step(rng), step(rng)));
+  }
+  return points;
+}
+
+// Returns nanoseconds per point.
+double GetDecodeTime(BatchFnT batch, std::vector<uint8_t> const & data, size_t count,
+                     coding::DeltasEncoding encoding, m2::PointU const & basePoint, m2::PointU const & maxPoint,
+                     uint64_t iterations)
+{
+  std::vector<m2::PointD> points(count);
+  base::HighResTimer timer;
+  for (uint64_t i = 0; i < iterations; ++i)
+  {
+    CHECK_EQUAL(batch(data.data(), count, encoding, basePoint, maxPoint, kPointCoordBits, points.data()),
+                data.data() + data.size(), ());
+  }
+  return static_cast<double>(timer.ElapsedNanoseconds()) / (iterations * count);
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  gflags::SetUsageMessage("Decoding time of the geometry deltas in VarInt and GroupVarInt encodings.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_points < 3 || FLAGS_iterations == 0 || FLAGS_max_step == 0 || FLAGS_max_step > 100000)
+  {
+    LOG(LERROR, ("--points must be at least 3, --iterations positive and --max_step in [1, 100000]."));
+    return -1;
+  }
+
+  m2::PointU const maxPoint =
+      PointDToPointU(m2::PointD(mercator::Bounds::kMaxX, mercator::Bounds::kMaxY), kPointCoordBits);
+  auto const points = MakePoints(maxPoint, FLAGS_points, static_cast<int32_t>(FLAGS_max_step));
+  m2::PointU const basePoint = points[points.size() / 2];
+
+  struct Geometry
+  {
+    char const * m_name;
+    serial::EncodeFunT m_encode;
+    BatchFnT m_batch;
+  };
+  Geometry const geometries[] = {
+      {"Polyline", &coding::EncodePolyline, &coding::DecodePolylineBatch},
+      {"TriangleStrip", &coding::EncodeTriangleStrip, &coding::DecodeTriangleStripBatch},
+  };
+
+  std::cout << "geometry\tencoding\tbytes per point\tns per point\n";
+  for (auto const & geometry : geometries)
+  {
+    std::vector<uint64_t> deltas(points.size());
+    coding::OutDeltasT deltasA(deltas);
+    geometry.m_encode(make_read_adapter(points), basePoint, maxPoint, deltasA);
+
+    for (auto const encoding : {coding::DeltasEncoding::VarInt, coding::DeltasEncoding::GroupVarInt})
+    {
+      std::vector<uint8_t> data;
+      {
+        MemWriter<std::vector<uint8_t>> writer(data);
+        if (encoding == coding::DeltasEncoding::GroupVarInt)
+          coding::WriteGroupVarIntDeltas(deltas, writer);
+        else
+          WriteVarUintArray(deltas, writer);
+      }
+
+      auto const ns =
+          GetDecodeTime(geometry.m_batch, data, points.size(), encoding, basePoint, maxPoint, FLAGS_iterations);
+      std::cout << geometry.m_name << "\t" << DebugPrint(encoding) << "\t"
+                << static_cast<double>(data.size()) / points.size() << "\t" << ns << "\n";
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,64 @@
+// Compares the throughput of tiny tasks which are submitted by one thread, like in generator::GetAffiliations(),
+// in ComputationalThreadPool and WorkStealingThreadPool for 1, 2, 4, ... threads.
+
+#include "base/logging.hpp"
+#include "base/thread.hpp"
+#include "base/thread_pool_computational.hpp"
+#include "base/thread_pool_work_stealing.hpp"
+#include "base/timer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+#include <gflags/gflags.h>
+
+DEFINE_uint64(tasks, 1000000, "Number of tasks submitted to every pool");
+DEFINE_uint64(max_threads, 0, "Maximum number of threads, twice the number of available cpus when 0");
+DEFINE_bool(pin_threads, false, "Bind the threads of WorkStealingThreadPool to the available cpus");
+
+namespace
+{
+template <typename MakePool>
+double GetTasksPerSecond(MakePool && makePool, uint64_t taskCount)
+{
+  std::atomic<uint64_t> sum{0};
+  base::HighResTimer timer;
+  {
+    auto pool = makePool();
+    for (uint64_t i = 0; i < taskCount; ++i)
+      pool->SubmitWork([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); });
+  }
+  auto const seconds = timer.ElapsedNanoseconds() / 1e9;
+  CHECK_EQUAL(sum, taskCount * (taskCount - 1) / 2, ());
+  return taskCount / seconds;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  gflags::SetUsageMessage("Throughput of tiny tasks in ComputationalThreadPool and WorkStealingThreadPool.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_tasks == 0)
+  {
+    LOG(LERROR, ("--tasks must be positive."));
+    return -1;
+  }
+
+  uint64_t maxThreadCount = FLAGS_max_threads;
+  if (maxThreadCount == 0)
+    maxThreadCount = threads::GetAvailableCpus().size() * 2;
+
+  std::cout << "threads\tComputationalThreadPool\tWorkStealingThreadPool (tasks per second)\n";
+  for (uint64_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+  {
+    auto const computational = GetTasksPerSecond(
+        [threadCount]() { return std::make_unique<base::ComputationalThreadPool>(threadCount); }, FLAGS_tasks);
+    auto const workStealing = GetTasksPerSecond([threadCount]()
+    { return std::make_unique<base::WorkStealingThreadPool>(threadCount, FLAGS_pin_threads); }, FLAGS_tasks);
+    std::cout << threadCount << "\t" << computational << "\t" << workStealing << "\n";
+  }
+  return 0;
+}
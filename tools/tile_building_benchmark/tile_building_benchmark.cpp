@@ -0,0 +1,623 @@
+// Measures the CPU cost of turning mwm features into render data without a window and a GPU.
+// Every tile goes through the same stages as in the app: the feature index of the tile is read
+// (TileInfo), the features are read and processed by RuleDrawer, Stylist and Apply*Feature, and
+// the produced shapes are batched into vertex buffers like BackendRenderer does.
+//
+// With --group_tiles neighbouring tiles are read together like ReadManager does after zoom changes
+// in the grouped reading mode, the stats are per tile anyway.
+//
+// With --shapes_cache_mb the tiles which are built again are taken from TileShapesCache like in
+// the app, only their batching is repeated.
+//
+// Graphics resources (textures and buffers) live in an offscreen OpenGL context of the "offscreen"
+// Qt platform, so the tool runs on software OpenGL implementations too.
+
+#include "drape_frontend/base_renderer.hpp"
+#include "drape_frontend/engine_context.hpp"
+#include "drape_frontend/map_data_provider.hpp"
+#include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/message_subclasses.hpp"
+#include "drape_frontend/metaline_manager.hpp"
+#include "drape_frontend/overlay_batcher.hpp"
+#include "drape_frontend/threads_commutator.hpp"
+#include "drape_frontend/tile_info.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
+#include "drape_frontend/tile_utils.hpp"
+#include "drape_frontend/visual_params.hpp"
+
+#include "drape/batcher.hpp"
+#include "drape/drape_routine.hpp"
+#include "drape/oglcontext.hpp"
+#include "drape/render_bucket.hpp"
+#include "drape/support_manager.hpp"
+#include "drape/texture_manager.hpp"
+#include "drape/vertex_array_buffer.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/map_style_reader.hpp"
+
+#include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
+
+#include "coding/string_utf8_multilang.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <QtGui/QGuiApplication>
+#include <QtGui/QOffscreenSurface>
+#include <QtGui/QOpenGLContext>
+
+#include <gflags/gflags.h>
+
+DEFINE_string(data_path, "", "Path to data directory (resources dir)");
+DEFINE_string(mwm_path, "", "Path to mwm files (writable dir)");
+DEFINE_string(tiles_path, "", "Path to a file with \"zoom x y\" lines, tiles around the center are used when empty");
+DEFINE_double(lat, 53.9, "Latitude of the center of the tiles");
+DEFINE_double(lon, 27.56, "Longitude of the center of the tiles");
+DEFINE_double(radius_m, 2000.0, "Radius in meters of the area around the center covered by tiles");
+DEFINE_string(zooms, "10,13,15,17", "Comma separated zoom levels of the tiles around the center");
+DEFINE_double(visual_scale, 2.0, "Visual scale of the device");
+DEFINE_int32(runs, 1, "Number of times to build every tile");
+DEFINE_bool(per_tile, false, "Print the stats of every tile or group of tiles");
+DEFINE_bool(group_tiles, false, "Read neighbouring tiles in 2x2 blocks together");
+DEFINE_uint64(shapes_cache_mb, 0, "Size of the cache of the tile shapes in MiB, 0 disables the cache");
+
+namespace
+{
+// Allocations of the benchmark thread only, metalines are read in the background.
+thread_local uint64_t g_allocs = 0;
+thread_local uint64_t g_allocBytes = 0;
+}  // namespace
+
+void * operator new(size_t size)
+{
+  ++g_allocs;
+  g_allocBytes += size;
+  if (void * p = std::malloc(size != 0 ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void * operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void * p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void * p, size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+struct StageStats
+{
+  StageStats & operator+=(StageStats const & rhs)
+  {
+    m_seconds += rhs.m_seconds;
+    m_allocs += rhs.m_allocs;
+    m_allocBytes += rhs.m_allocBytes;
+    return *this;
+  }
+
+  StageStats & operator-=(StageStats const & rhs)
+  {
+    m_seconds -= rhs.m_seconds;
+    m_allocs -= rhs.m_allocs;
+    m_allocBytes -= rhs.m_allocBytes;
+    return *this;
+  }
+
+  double m_seconds = 0.0;
+  uint64_t m_allocs = 0;
+  uint64_t m_allocBytes = 0;
+};
+
+// Accumulates the time and the allocations of the scope to |stats|.
+class ScopedStage
+{
+public:
+  explicit ScopedStage(StageStats & stats) : m_stats(stats), m_allocs(g_allocs), m_allocBytes(g_allocBytes) {}
+
+  ~ScopedStage()
+  {
+    m_stats.m_seconds += m_timer.ElapsedSeconds();
+    m_stats.m_allocs += g_allocs - m_allocs;
+    m_stats.m_allocBytes += g_allocBytes - m_allocBytes;
+  }
+
+private:
+  StageStats & m_stats;
+  base::Timer m_timer;
+  uint64_t const m_allocs;
+  uint64_t const m_allocBytes;
+};
+
+struct TileStats
+{
+  TileStats & operator+=(TileStats const & rhs)
+  {
+    m_index += rhs.m_index;
+    m_features += rhs.m_features;
+    m_rules += rhs.m_rules;
+    m_batching += rhs.m_batching;
+    m_tiles += rhs.m_tiles;
+    m_featuresCount += rhs.m_featuresCount;
+    m_shapes += rhs.m_shapes;
+    m_overlayShapes += rhs.m_overlayShapes;
+    m_buckets += rhs.m_buckets;
+    m_vertices += rhs.m_vertices;
+    m_indices += rhs.m_indices;
+    return *this;
+  }
+
+  // Reading of the feature ids of the tile from the geometry index.
+  StageStats m_index;
+  // Reading of the features, without their processing.
+  StageStats m_features;
+  // RuleDrawer: drawing rules, geometry and shapes of the features.
+  StageStats m_rules;
+  // Batching of the shapes into vertex and index buffers.
+  StageStats m_batching;
+
+  size_t m_tiles = 0;
+  size_t m_featuresCount = 0;
+  size_t m_shapes = 0;
+  size_t m_overlayShapes = 0;
+  size_t m_buckets = 0;
+  uint64_t m_vertices = 0;
+  uint64_t m_indices = 0;
+};
+
+// Keeps the shapes of the tile instead of sending them to BackendRenderer.
+class BenchmarkEngineContext : public df::EngineContext
+{
+public:
+  BenchmarkEngineContext(df::TileKey const & tileKey, ref_ptr<df::ThreadsCommutator> commutator,
+                         ref_ptr<dp::TextureManager> texMng, ref_ptr<df::MetalineManager> metalineMng,
+                         ref_ptr<df::TileShapesCache> shapesCache, std::vector<drape_ptr<df::Message>> & messages)
+    : EngineContext(tileKey, commutator, texMng, metalineMng, {} /* customFeaturesContext */,
+                    true /* is3dBuildingsEnabled */, false /* isTrafficEnabled */, false /* isolinesEnabled */,
+                    StringUtf8Multilang::kDefaultCode, dp::BackgroundMode::Default, 1.0f /* areaOpacity */,
+                    shapesCache)
+    , m_messages(messages)
+  {}
+
+protected:
+  void PostMessage(drape_ptr<df::Message> && message, df::MessagePriority) override
+  {
+    auto const type = message->GetType();
+    if (type == df::Message::Type::MapShapeReaded || type == df::Message::Type::OverlayMapShapeReaded)
+      m_messages.push_back(std::move(message));
+  }
+
+private:
+  std::vector<drape_ptr<df::Message>> & m_messages;
+};
+
+// Takes the place of FrontendRenderer in ThreadsCommutator, e.g. for messages of MetalineManager.
+// Its thread is never started, so it can't receive messages and they are dropped.
+class DiscardingRenderer : public df::BaseRenderer
+{
+public:
+  explicit DiscardingRenderer(ref_ptr<df::ThreadsCommutator> commutator)
+    : BaseRenderer(df::ThreadsCommutator::RenderThread,
+                   Params(dp::ApiVersion::OpenGLES3, commutator, nullptr /* factory */, nullptr /* texMng */,
+                          nullptr /* onGraphicsContextInitialized */))
+  {}
+
+protected:
+  void AcceptMessage(ref_ptr<df::Message>) override {}
+  std::unique_ptr<threads::IRoutine> CreateRoutine() override { return nullptr; }
+  void RenderFrame() override {}
+  void OnContextCreate() override {}
+  void OnContextDestroy() override {}
+};
+
+// OpenGL context of the current thread, made current by the caller.
+class HeadlessContext : public dp::OGLContext
+{
+public:
+  void MakeCurrent() override {}
+  void DoneCurrent() override {}
+  void Present() override {}
+  void SetFramebuffer(ref_ptr<dp::BaseFramebuffer>) override {}
+  void ForgetFramebuffer(ref_ptr<dp::BaseFramebuffer>) override {}
+  void ApplyFramebuffer(std::string const &) override {}
+};
+
+// Reads features from |dataSource|, the time and the allocations are accounted for in |stats| if it's set.
+df::MapDataProvider MakeDataProvider(DataSource const & dataSource, TileStats * stats)
+{
+  auto readIds = [&dataSource, stats](auto const & fn, m2::RectD const & r, int scale)
+  {
+    StageStats index;
+    {
+      ScopedStage const stage(index);
+      dataSource.ForEachFeatureIDInRect(fn, r, scale, covering::LowLevelsOnly);
+    }
+    if (stats)
+      stats->m_index += index;
+  };
+
+  auto readFeatures = [&dataSource, stats](auto const & fn, std::vector<FeatureID> const & ids)
+  {
+    if (!stats)
+    {
+      dataSource.ReadFeatures(fn, ids);
+      return;
+    }
+
+    stats->m_featuresCount += ids.size();
+    ScopedStage const stage(stats->m_features);
+    dataSource.ReadFeatures([&](FeatureType & ft)
+    {
+      // The processing of the features is accounted for in the rules stage.
+      StageStats processing;
+      {
+        ScopedStage const processingStage(processing);
+        fn(ft);
+      }
+      stats->m_features -= processing;
+    }, ids);
+  };
+
+  return df::MapDataProvider(std::move(readIds), std::move(readFeatures),
+                             [](std::string_view) { return true; } /* isCountryLoadedByName */,
+                             [](m2::PointD const &, int) {} /* updateCurrentCountry */,
+                             [](df::TileKey const &, dp::BackgroundMode) { return false; } /* tileBackgroundRead */,
+                             [](df::TileKey const &, dp::BackgroundMode) {} /* cancelTileBackgroundReading */);
+}
+
+class TileBuilder
+{
+public:
+  TileBuilder(DataSource const & dataSource, uint64_t shapesCacheSizeBytes)
+    : m_renderer(make_ref(&m_commutator))
+    , m_model(MakeDataProvider(dataSource, &m_stats))
+    // Metalines are read in the background, out of the stats.
+    , m_metalineModel(MakeDataProvider(dataSource, nullptr /* stats */))
+    , m_metalineManager(make_ref(&m_commutator), m_metalineModel)
+  {
+    if (shapesCacheSizeBytes != 0)
+      m_shapesCache = make_unique_dp<df::TileShapesCache>(shapesCacheSizeBytes);
+  }
+
+  ~TileBuilder()
+  {
+    // The cached shapes refer to the textures.
+    m_shapesCache.reset();
+    m_metalineManager.Stop();
+    if (m_texMng)
+      m_texMng->Release();
+  }
+
+  void Init()
+  {
+    auto context = make_unique_dp<HeadlessContext>();
+    context->Init(dp::ApiVersion::OpenGLES3);
+    dp::SupportManager::Instance().Init(make_ref(context));
+    m_context = std::move(context);
+
+    dp::TextureManager::Params params;
+    params.m_resPostfix = df::VisualParams::GetResourcePostfix(df::VisualParams::Instance().GetVisualScale());
+    params.m_visualScale = df::VisualParams::Instance().GetVisualScale();
+    params.m_colors = "colors.txt";
+    params.m_patterns = "patterns.txt";
+    params.m_glyphMngParams.m_uniBlocks = base::JoinPath("fonts", "unicode_blocks.txt");
+    params.m_glyphMngParams.m_whitelist = base::JoinPath("fonts", "whitelist.txt");
+    params.m_glyphMngParams.m_blacklist = base::JoinPath("fonts", "blacklist.txt");
+    GetPlatform().GetFontNames(params.m_glyphMngParams.m_fonts);
+
+    m_texMng = make_unique_dp<dp::TextureManager>();
+    m_texMng->Init(make_ref(m_context), params);
+    m_texMng->UpdateDynamicTextures(make_ref(m_context));
+  }
+
+  // Several tiles are read together by TileInfo::ReadGroupFeatures.
+  TileStats Build(std::vector<df::TileKey> const & tileKeys)
+  {
+    m_stats = {};
+    m_stats.m_tiles = tileKeys.size();
+
+    std::vector<std::vector<drape_ptr<df::Message>>> messages(tileKeys.size());
+    {
+      StageStats reading;
+      {
+        ScopedStage const stage(reading);
+        df::TTileInfoGroup tiles;
+        for (size_t i = 0; i < tileKeys.size(); ++i)
+        {
+          tiles.push_back(std::make_shared<df::TileInfo>(make_unique_dp<BenchmarkEngineContext>(
+              tileKeys[i], make_ref(&m_commutator), make_ref(m_texMng), make_ref(&m_metalineManager),
+              make_ref(m_shapesCache), messages[i])));
+        }
+
+        if (tiles.size() == 1)
+          tiles.front()->ReadFeatures(m_model);
+        else
+          df::TileInfo::ReadGroupFeatures(m_model, tiles);
+      }
+      reading -= m_stats.m_index;
+      reading -= m_stats.m_features;
+      m_stats.m_rules += reading;
+    }
+
+    {
+      ScopedStage const stage(m_stats.m_batching);
+      for (size_t i = 0; i < tileKeys.size(); ++i)
+        Batch(tileKeys[i], messages[i]);
+    }
+
+    // Glyphs and colors of the tile are uploaded to the textures like on every frame of the app.
+    m_texMng->UpdateDynamicTextures(make_ref(m_context));
+    return m_stats;
+  }
+
+  ref_ptr<df::TileShapesCache> GetShapesCache() const { return make_ref(m_shapesCache); }
+
+private:
+  void Batch(df::TileKey const & tileKey, std::vector<drape_ptr<df::Message>> const & messages)
+  {
+    // The same buffer sizes as in BackendRenderer.
+    uint32_t constexpr kBatchSize = 5000;
+    auto const context = make_ref(m_context);
+    auto const texMng = make_ref(m_texMng);
+
+    auto const addBucket = [this](drape_ptr<dp::RenderBucket> const & bucket)
+    {
+      ++m_stats.m_buckets;
+      m_stats.m_vertices += bucket->GetBuffer()->GetStartIndexValue();
+      m_stats.m_indices += bucket->GetBuffer()->GetIndexCount();
+    };
+
+    dp::Batcher batcher(kBatchSize, kBatchSize);
+    batcher.SetBatcherHash(tileKey.GetHashValue(df::BatcherBucket::Default));
+    batcher.StartSession([&addBucket](dp::RenderState const &, drape_ptr<dp::RenderBucket> && bucket)
+    { addBucket(bucket); });
+
+    for (auto const & message : messages)
+    {
+      if (message->GetType() == df::Message::Type::MapShapeReaded)
+      {
+        ref_ptr<df::MapShapeReadedMessage> msg = make_ref(message);
+        for (auto const & shape : msg->GetShapes())
+        {
+          batcher.SetFeatureMinZoom(shape->GetFeatureMinZoom());
+          shape->Draw(context, make_ref(&batcher), texMng);
+        }
+        m_stats.m_shapes += msg->GetShapes().size();
+      }
+      else
+      {
+        ref_ptr<df::OverlayMapShapeReadedMessage> msg = make_ref(message);
+        df::OverlayBatcher overlayBatcher(tileKey);
+        for (auto const & shape : msg->GetShapes())
+          overlayBatcher.Batch(context, shape, texMng);
+
+        df::TOverlaysRenderData renderData;
+        overlayBatcher.Finish(context, renderData);
+        for (auto const & data : renderData)
+          addBucket(data.m_bucket);
+        m_stats.m_overlayShapes += msg->GetShapes().size();
+      }
+    }
+    batcher.EndSession(context);
+  }
+
+  TileStats m_stats;
+  df::ThreadsCommutator m_commutator;
+  DiscardingRenderer m_renderer;
+  df::MapDataProvider m_model;
+  df::MapDataProvider m_metalineModel;
+  df::MetalineManager m_metalineManager;
+  drape_ptr<dp::GraphicsContext> m_context;
+  drape_ptr<dp::TextureManager> m_texMng;
+  drape_ptr<df::TileShapesCache> m_shapesCache;
+};
+
+std::vector<df::TileKey> ReadTiles(std::string const & path)
+{
+  std::ifstream ifs(path);
+  CHECK(ifs.is_open(), ("Can't open input file", path));
+
+  std::vector<df::TileKey> tiles;
+  std::string line;
+  while (std::getline(ifs, line))
+  {
+    auto const tokens = strings::Tokenize(line, " \t,");
+    int zoom, x, y;
+    if (tokens.size() < 3 || !strings::to_int(tokens[0], zoom) || !strings::to_int(tokens[1], x) ||
+        !strings::to_int(tokens[2], y))
+    {
+      LOG(LWARNING, ("Bad line:", line));
+      continue;
+    }
+    tiles.emplace_back(x, y, static_cast<uint8_t>(zoom));
+  }
+  return tiles;
+}
+
+std::vector<df::TileKey> MakeTiles(m2::PointD const & center, double radiusM, std::string const & zooms)
+{
+  auto const rect = mercator::RectByCenterXYAndSizeInMeters(center, radiusM);
+
+  std::vector<df::TileKey> tiles;
+  for (auto const & token : strings::Tokenize(zooms, ","))
+  {
+    int zoom;
+    CHECK(strings::to_int(token, zoom), ("Bad zoom:", token));
+    df::CalcTilesCoverage(rect, zoom, [&](int x, int y) { tiles.emplace_back(x, y, static_cast<uint8_t>(zoom)); });
+  }
+  return tiles;
+}
+
+void PrintStage(std::string const & name, StageStats const & stats, size_t tiles)
+{
+  std::cout << "  " << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(3)
+            << " ms/tile: " << std::setw(9) << stats.m_seconds * 1000.0 / tiles
+            << "  allocs/tile: " << std::setw(9) << stats.m_allocs / tiles
+            << "  KiB/tile: " << std::setw(9) << stats.m_allocBytes / 1024.0 / tiles << '\n';
+}
+
+void PrintStats(std::string const & title, TileStats const & stats)
+{
+  if (stats.m_tiles == 0)
+    return;
+
+  std::cout << title << ": tiles: " << stats.m_tiles << " features: " << stats.m_featuresCount
+            << " shapes: " << stats.m_shapes << " overlay shapes: " << stats.m_overlayShapes
+            << " buckets: " << stats.m_buckets << " vertices: " << stats.m_vertices
+            << " indices: " << stats.m_indices << '\n';
+  PrintStage("index", stats.m_index, stats.m_tiles);
+  PrintStage("features", stats.m_features, stats.m_tiles);
+  PrintStage("rules", stats.m_rules, stats.m_tiles);
+  PrintStage("batching", stats.m_batching, stats.m_tiles);
+}
+
+// Every tile is a group of its own without |groupTiles|.
+std::vector<std::vector<df::TileKey>> GroupTiles(std::vector<df::TileKey> const & tiles, bool groupTiles)
+{
+  std::vector<std::vector<df::TileKey>> groups;
+  std::map<std::tuple<int, int, int>, size_t> blocks;
+  for (auto const & tileKey : tiles)
+  {
+    if (!groupTiles)
+    {
+      groups.push_back({tileKey});
+      continue;
+    }
+
+    // The same 2x2 blocks as in ReadManager.
+    auto const [it, inserted] =
+        blocks.emplace(std::make_tuple(tileKey.m_zoomLevel, tileKey.m_x >> 1, tileKey.m_y >> 1), groups.size());
+    if (inserted)
+      groups.emplace_back();
+    groups[it->second].push_back(tileKey);
+  }
+  return groups;
+}
+
+void RunBenchmark(DataSource const & dataSource, std::vector<df::TileKey> const & tiles)
+{
+  TileBuilder builder(dataSource, FLAGS_shapes_cache_mb * 1024 * 1024);
+  builder.Init();
+
+  auto const groups = GroupTiles(tiles, FLAGS_group_tiles);
+
+  std::map<int, TileStats> zoomStats;
+  TileStats total;
+  for (int run = 0; run < FLAGS_runs; ++run)
+  {
+    for (auto const & group : groups)
+    {
+      auto const stats = builder.Build(group);
+      if (FLAGS_per_tile)
+        PrintStats(DebugPrint(group.front()) + (group.size() > 1 ? " group" : ""), stats);
+      zoomStats[group.front().m_zoomLevel] += stats;
+      total += stats;
+    }
+  }
+
+  for (auto const & [zoom, stats] : zoomStats)
+    PrintStats("Zoom " + std::to_string(zoom), stats);
+  PrintStats("Total", total);
+
+  if (auto const cache = builder.GetShapesCache())
+    std::cout << DebugPrint(cache->GetStats()) << '\n';
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  gflags::SetUsageMessage(
+      "Headless benchmark of the tiles building: reading of features, drawing rules processing and batching "
+      "of shapes. Tiles are taken from --tiles_path or cover --radius_m around --lat, --lon on --zooms.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  Platform & platform = GetPlatform();
+  if (!FLAGS_data_path.empty())
+    platform.SetResourceDir(FLAGS_data_path);
+  if (!FLAGS_mwm_path.empty())
+    platform.SetWritableDirForTests(FLAGS_mwm_path);
+
+  // No windows are created, so the tool doesn't need a display.
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  QGuiApplication app(argc, argv);
+
+  GetStyleReader().SetCurrentStyle(kDefaultMapStyle);
+  classificator::Load();
+  df::VisualParams::Init(FLAGS_visual_scale, df::CalculateTileSize(1024, 1024));
+
+  FrozenDataSource dataSource;
+  std::vector<platform::LocalCountryFile> mwms;
+  platform::FindAllLocalMapsAndCleanup(std::numeric_limits<int64_t>::max() /* the latest version */, mwms);
+  for (auto & mwm : mwms)
+  {
+    mwm.SyncWithDisk();
+    dataSource.RegisterMap(mwm);
+  }
+  LOG(LINFO, ("Mwms:", mwms.size()));
+
+  auto const tiles = FLAGS_tiles_path.empty()
+                       ? MakeTiles(mercator::FromLatLon(FLAGS_lat, FLAGS_lon), FLAGS_radius_m, FLAGS_zooms)
+                       : ReadTiles(FLAGS_tiles_path);
+  LOG(LINFO, ("Tiles:", tiles.size()));
+
+  QSurfaceFormat format;
+  format.setProfile(QSurfaceFormat::CoreProfile);
+  format.setVersion(3, 2);
+
+  QOffscreenSurface surface;
+  surface.setFormat(format);
+  surface.create();
+
+  QOpenGLContext context;
+  context.setFormat(format);
+  if (!context.create() || !context.makeCurrent(&surface))
+  {
+    LOG(LERROR, ("Can't create an OpenGL context"));
+    return 1;
+  }
+
+  RunBenchmark(dataSource, tiles);
+
+  context.doneCurrent();
+  dp::DrapeRoutine::Shutdown();
+  return 0;
+}